@@ -0,0 +1,38 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+// Baked vmap floor layers of one map tile, written by floor_baker to floors/MMMM_XX_YY.flr
+// (map id and tile coordinates as in maps/MMMM_XX_YY.map).
+//
+// Layout: FloorTileHeader, one uint8_t layer count per cell (FLOOR_GRID_SIZE * FLOOR_GRID_SIZE cells, x major
+// like the height maps) and then the layer heights as float, every cell from top to bottom.
+// A layer is a vmap surface hit by a vertical ray through the cell center. Surfaces closer than
+// FLOOR_LAYER_MERGE_DISTANCE are stored once.
+
+const uint32_t FLOOR_MAGIC = 0x524f4c46; // 'FLOR'
+#define FLOOR_VERSION 1
+
+#define FLOOR_GRID_SIZE 256
+#define FLOOR_MAX_LAYERS 32
+
+// the surfaces in this cell differ too much from its center, lookups have to cast a ray
+#define FLOOR_CELL_RAY_CAST 0xFF
+
+#define FLOOR_LAYER_MERGE_DISTANCE 0.05f
+#define FLOOR_CELL_TOLERANCE 0.25f
+
+struct FloorTileHeader
+{
+    uint32_t floorMagic;
+    uint32_t floorVersion;
+    uint32_t gridSize;
+    uint32_t layerCount;
+
+    FloorTileHeader() : floorMagic(FLOOR_MAGIC), floorVersion(FLOOR_VERSION), gridSize(FLOOR_GRID_SIZE), layerCount(0) {}
+};
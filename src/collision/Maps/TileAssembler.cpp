@@ -25,12 +25,19 @@
 #include <set>
 #include <iomanip>
 #include <sstream>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
 
 using G3D::Vector3;
 using G3D::AABox;
 using G3D::inf;
 using std::pair;
 
+// bump when the layout of vmaps/model_cache changes
+#define MODEL_CACHE_VERSION 2
+
 template<> struct BoundsTrait<VMAP::ModelSpawn*>
 {
     static void getBounds(const VMAP::ModelSpawn* const &obj, G3D::AABox& out) { out = obj->getBounds(); }
@@ -58,7 +65,7 @@ namespace VMAP
     //=================================================================
 
     TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName)
-        : iDestDir(pDestDirName), iSrcDir(pSrcDirName), iFilterMethod(NULL), iCurrentUniqueNameId(0)
+        : iDestDir(pDestDirName), iSrcDir(pSrcDirName), iFilterMethod(NULL), iCurrentUniqueNameId(0), iThreadCount(1)
     {
         //mkdir(iDestDir);
         //init();
@@ -235,15 +242,9 @@ namespace VMAP
         exportGameobjectModels();
         // export objects
         std::cout << "\nConverting Model Files" << std::endl;
-        for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+        if (!convertModelFiles())
         {
-            std::cout << "Converting " << *mfile << std::endl;
-            if (!convertRawFile(*mfile))
-            {
-                std::cout << "error converting " << *mfile << std::endl;
-                success = false;
-                break;
-            }
+            success = false;
         }
 
         //cleanup:
@@ -417,11 +418,230 @@ namespace VMAP
             model.setGroupModels(groupsArray);
         }
 
-        success = model.writeFile(iDestDir + "/" + pModelFilename + ".vmo");
+        // written under a temporary name first, an interrupted run must not leave a truncated vmo behind
+        const std::string vmoFilename = iDestDir + "/" + pModelFilename + ".vmo";
+        const std::string tempFilename = vmoFilename + ".tmp";
+        success = model.writeFile(tempFilename);
+        if (success)
+        {
+            std::remove(vmoFilename.c_str());
+            success = std::rename(tempFilename.c_str(), vmoFilename.c_str()) == 0;
+        }
+
+        if (!success)
+        {
+            std::remove(tempFilename.c_str());
+        }
         //std::cout << "readRawFile2: '" << pModelFilename << "' tris: " << nElements << " nodes: " << nNodes << std::endl;
         return success;
     }
 
+    bool TileAssembler::convertModelFiles()
+    {
+        const std::vector<std::string> modelFiles(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        const ModelCache modelCache = readModelCache();
+
+        // rawHash 0 = not converted
+        std::vector<ModelCacheEntry> modelEntries(modelFiles.size(), ModelCacheEntry{ 0, 0 });
+
+        std::atomic<size_t> nextModel(0);
+        std::atomic<bool> failed(false);
+        std::mutex outputLock;
+
+        auto convertModels = [&]()
+        {
+            for (size_t i = nextModel++; i < modelFiles.size() && !failed; i = nextModel++)
+            {
+                const std::string& modelFile = modelFiles[i];
+                const uint64 hash = getRawFileHash(modelFile);
+
+                ModelCache::const_iterator cached = modelCache.find(modelFile);
+                if (hash != 0 && cached != modelCache.end() && cached->second.rawHash == hash)
+                {
+                    // the vmo has to be there and complete as well
+                    if (isCachedModelValid(modelFile, cached->second))
+                    {
+                        modelEntries[i] = cached->second;
+                        continue;
+                    }
+                }
+
+                {
+                    std::lock_guard<std::mutex> guard(outputLock);
+                    std::cout << "Converting " << modelFile << std::endl;
+                }
+
+                if (!convertRawFile(modelFile))
+                {
+                    std::lock_guard<std::mutex> guard(outputLock);
+                    std::cout << "error converting " << modelFile << std::endl;
+                    failed = true;
+                    break;
+                }
+
+                modelEntries[i].rawHash = hash;
+                modelEntries[i].vmoSize = 0;
+                if (FILE* vmoFile = fopen((iDestDir + "/" + modelFile + ".vmo").c_str(), "rb"))
+                {
+                    fseek(vmoFile, 0, SEEK_END);
+                    modelEntries[i].vmoSize = static_cast<uint32>(ftell(vmoFile));
+                    fclose(vmoFile);
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned int i = 1; i < iThreadCount; ++i)
+        {
+            workers.push_back(std::thread(convertModels));
+        }
+
+        convertModels();
+
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+
+        // models of the last run that were not converted again keep their entry, their vmo is unchanged
+        ModelCache newCache = modelCache;
+        for (size_t i = 0; i < modelFiles.size(); ++i)
+        {
+            if (modelEntries[i].rawHash != 0 && modelEntries[i].vmoSize != 0)
+            {
+                newCache[modelFiles[i]] = modelEntries[i];
+            }
+            else
+            {
+                newCache.erase(modelFiles[i]);
+            }
+        }
+
+        writeModelCache(newCache);
+
+        return !failed;
+    }
+
+    uint64 TileAssembler::getRawFileHash(const std::string& pModelFilename)
+    {
+        FILE* rf = fopen((iSrcDir + "/" + pModelFilename).c_str(), "rb");
+        if (!rf)
+        {
+            return 0;
+        }
+
+        // FNV-1a, seeded with the vmap version so a format change converts every model again
+        uint64 hash = 0xcbf29ce484222325ULL;
+        for (const char* magic = VMAP_MAGIC; *magic; ++magic)
+        {
+            hash = (hash ^ uint8(*magic)) * 0x100000001b3ULL;
+        }
+
+        uint8 buffer[16384];
+        size_t readBytes;
+        while ((readBytes = fread(buffer, 1, sizeof(buffer), rf)) > 0)
+        {
+            for (size_t i = 0; i < readBytes; ++i)
+            {
+                hash = (hash ^ buffer[i]) * 0x100000001b3ULL;
+            }
+        }
+
+        const bool success = ferror(rf) == 0;
+        fclose(rf);
+
+        return success ? hash : 0;
+    }
+
+    bool TileAssembler::isCachedModelValid(const std::string& pModelFilename, const ModelCacheEntry& entry)
+    {
+        const std::string vmoFilename = iDestDir + "/" + pModelFilename + ".vmo";
+
+        FILE* vmoFile = fopen(vmoFilename.c_str(), "rb");
+        if (!vmoFile)
+        {
+            return false;
+        }
+
+        fseek(vmoFile, 0, SEEK_END);
+        const long vmoSize = ftell(vmoFile);
+        fclose(vmoFile);
+
+        if (vmoSize != static_cast<long>(entry.vmoSize))
+        {
+            return false;
+        }
+
+        // a vmo of the right size can still be damaged, it has to load like the server loads it
+        WorldModel model;
+        return model.readFile(vmoFilename);
+    }
+
+    TileAssembler::ModelCache TileAssembler::readModelCache()
+    {
+        ModelCache modelCache;
+
+        FILE* rf = fopen((iDestDir + "/model_cache").c_str(), "rb");
+        if (!rf)
+        {
+            return modelCache;
+        }
+
+        char magic[8];
+        uint32 version = 0;
+        uint32 count = 0;
+        if (readChunk(rf, magic, VMAP_MAGIC, 8) && fread(&version, sizeof(uint32), 1, rf) == 1 && version == MODEL_CACHE_VERSION &&
+            fread(&count, sizeof(uint32), 1, rf) == 1)
+        {
+            for (uint32 i = 0; i < count; ++i)
+            {
+                ModelCacheEntry entry;
+                uint32 nameLength;
+                if (fread(&entry.rawHash, sizeof(uint64), 1, rf) != 1 || fread(&entry.vmoSize, sizeof(uint32), 1, rf) != 1 ||
+                    fread(&nameLength, sizeof(uint32), 1, rf) != 1 || nameLength > 1024)
+                {
+                    break;
+                }
+
+                std::string name(nameLength, '\0');
+                if (nameLength && fread(&name[0], sizeof(char), nameLength, rf) != nameLength)
+                {
+                    break;
+                }
+
+                modelCache[name] = entry;
+            }
+        }
+
+        fclose(rf);
+        return modelCache;
+    }
+
+    void TileAssembler::writeModelCache(const ModelCache& modelCache)
+    {
+        FILE* wf = fopen((iDestDir + "/model_cache").c_str(), "wb");
+        if (!wf)
+        {
+            return;
+        }
+
+        const uint32 version = MODEL_CACHE_VERSION;
+        const uint32 count = static_cast<uint32>(modelCache.size());
+        fwrite(VMAP_MAGIC, 1, 8, wf);
+        fwrite(&version, sizeof(uint32), 1, wf);
+        fwrite(&count, sizeof(uint32), 1, wf);
+        for (ModelCache::const_iterator itr = modelCache.begin(); itr != modelCache.end(); ++itr)
+        {
+            const uint32 nameLength = static_cast<uint32>(itr->first.size());
+            fwrite(&itr->second.rawHash, sizeof(uint64), 1, wf);
+            fwrite(&itr->second.vmoSize, sizeof(uint32), 1, wf);
+            fwrite(&nameLength, sizeof(uint32), 1, wf);
+            fwrite(itr->first.data(), sizeof(char), nameLength, wf);
+        }
+
+        fclose(wf);
+    }
+
     void TileAssembler::exportGameobjectModels()
     {
         FILE* model_list = fopen((iSrcDir + "/" + "temp_gameobject_models").c_str(), "rb");
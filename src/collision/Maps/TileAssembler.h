@@ -101,6 +101,21 @@ namespace VMAP
             unsigned int iCurrentUniqueNameId;
             MapData mapData;
             std::set<std::string> spawnedModelFiles;
+            unsigned int iThreadCount;
+
+            struct ModelCacheEntry
+            {
+                uint64 rawHash;                             // hash of the raw model the vmo was converted from, 0 = none
+                uint32 vmoSize;                             // size of the complete vmo
+            };
+
+            // model file name => cache entry
+            typedef std::map<std::string, ModelCacheEntry> ModelCache;
+            ModelCache readModelCache();
+            void writeModelCache(const ModelCache& modelCache);
+            uint64 getRawFileHash(const std::string& pModelFilename);
+            // the vmo has the size it was written with and loads
+            bool isCachedModelValid(const std::string& pModelFilename, const ModelCacheEntry& entry);
 
         public:
             TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
@@ -112,6 +127,9 @@ namespace VMAP
             void exportGameobjectModels();
 
             bool convertRawFile(const std::string& pModelFilename);
+            // converts the models on iThreadCount threads, models whose raw file did not change are kept
+            bool convertModelFiles();
+            void setThreadCount(unsigned int pThreadCount) { iThreadCount = pThreadCount > 0 ? pThreadCount : 1; }
             void setModelNameFilterMethod(bool (*pFilterMethod)(char *pName)) { iFilterMethod = pFilterMethod; }
             std::string getDirEntryNameFromModName(unsigned int pMapId, const std::string& pModPosName);
     };
@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "LogonStdAfx.h"
+#include "AuthCryptoPool.h"
+
+AuthCryptoPool& AuthCryptoPool::getInstance()
+{
+    static AuthCryptoPool mInstance;
+    return mInstance;
+}
+
+void AuthCryptoPool::initialize(uint32_t threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    m_running = true;
+
+    m_workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+        m_workers.emplace_back(&AuthCryptoPool::workerLoop, this);
+
+    LogDetail("AuthCryptoPool : Started %u worker threads", threadCount);
+}
+
+void AuthCryptoPool::finalize()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_jobsMutex);
+        m_running = false;
+    }
+    m_jobsCondition.notify_all();
+
+    for (auto& worker : m_workers)
+        worker.join();
+
+    m_workers.clear();
+
+    LogDetail("AuthCryptoPool : Stopped after %llu jobs", static_cast<unsigned long long>(m_processedJobs.load()));
+}
+
+void AuthCryptoPool::queueJob(CryptoJob job)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_jobsMutex);
+        if (m_running)
+        {
+            m_jobs.push(std::move(job));
+            m_jobsCondition.notify_one();
+            return;
+        }
+    }
+
+    job();
+    ++m_processedJobs;
+}
+
+size_t AuthCryptoPool::getQueueSize()
+{
+    std::lock_guard<std::mutex> guard(m_jobsMutex);
+    return m_jobs.size();
+}
+
+void AuthCryptoPool::workerLoop()
+{
+    for (;;)
+    {
+        CryptoJob job;
+        {
+            std::unique_lock<std::mutex> lock(m_jobsMutex);
+            m_jobsCondition.wait(lock, [this] { return !m_running || !m_jobs.empty(); });
+
+            // drain the queue before shutting down so no socket waits forever
+            if (m_jobs.empty())
+                return;
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop();
+        }
+
+        job();
+        ++m_processedJobs;
+    }
+}
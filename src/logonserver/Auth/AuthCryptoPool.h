@@ -0,0 +1,57 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Runs the SRP6 big number math of AuthSocket (challenge/proof) outside of the socket worker threads.
+// A mass re-login after a realm restart is bound by BN_mod_exp, this spreads it over all cores.
+class AuthCryptoPool
+{
+    typedef std::function<void()> CryptoJob;
+
+private:
+    AuthCryptoPool() = default;
+    ~AuthCryptoPool() = default;
+
+public:
+    static AuthCryptoPool& getInstance();
+
+    AuthCryptoPool(AuthCryptoPool&&) = delete;
+    AuthCryptoPool(AuthCryptoPool const&) = delete;
+    AuthCryptoPool& operator=(AuthCryptoPool&&) = delete;
+    AuthCryptoPool& operator=(AuthCryptoPool const&) = delete;
+
+    // threadCount 0 = one worker per hardware thread
+    void initialize(uint32_t threadCount);
+    void finalize();
+
+    // runs the job inline when the pool is not running
+    void queueJob(CryptoJob job);
+
+    size_t getQueueSize();
+    uint64_t getProcessedJobCount() const { return m_processedJobs; }
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::queue<CryptoJob> m_jobs;
+    std::mutex m_jobsMutex;
+    std::condition_variable m_jobsCondition;
+
+    std::atomic<bool> m_running{ false };
+    std::atomic<uint64_t> m_processedJobs{ 0 };
+};
+
+#define sAuthCryptoPool AuthCryptoPool::getInstance()
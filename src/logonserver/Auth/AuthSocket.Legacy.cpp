@@ -40,6 +40,8 @@ AuthSocket::AuthSocket(SOCKET fd) : Socket(fd, 32768, 4096)
     g.SetDword(7);
     s.SetRand(256);
     m_authenticated = false;
+    m_cryptoPending = false;
+    m_cryptoJobs = 0;
     m_account = NULL;
     last_recv = time(NULL);
     removedFromSet = false;
@@ -246,6 +248,40 @@ void AuthSocket::HandleChallenge()
         //m_account->forcedLanguage = temp;
     }
 
+    // The SRP6 math runs on the crypto pool, OnRead ignores further input until the challenge was sent
+    queueCryptoJob([this]() { computeChallenge(); });
+}
+
+void AuthSocket::queueCryptoJob(std::function<void()> job)
+{
+    // m_cryptoJobs keeps the socket out of the garbage collector until the job returned
+    ++m_cryptoJobs;
+    m_cryptoPending = true;
+
+    sAuthCryptoPool.queueJob([this, job]()
+    {
+        // the job clears m_cryptoPending on each of its paths right before its reply goes out. Once the reply
+        // is out the client may already have sent its next packet and a new job owns the flag, so it is only
+        // cleared here when the job did not run at all.
+        if (!IsDeleted() && IsConnected())
+            job();
+        else
+            m_cryptoPending = false;
+
+        // input that arrived while the job was running was held back by OnRead, handle it now.
+        // m_readMutex serializes this with the read callback of the socket thread.
+        m_readMutex.Acquire();
+        if (!IsDeleted() && IsConnected() && readBuffer.GetSize() > 0)
+            OnRead();
+        m_readMutex.Release();
+
+        // last access to this socket
+        --m_cryptoJobs;
+    });
+}
+
+void AuthSocket::computeChallenge()
+{
     //////////////////////////////////////////////// SRP6 Challenge ////////////////////////////////////////////////
     //
     //
@@ -302,6 +338,7 @@ void AuthSocket::HandleChallenge()
     memcpy(challenge.unk3, unk.AsByteArray(), 16);
     challenge.unk4 = 0;
 
+    m_cryptoPending = false;
     Send(reinterpret_cast<uint8*>(&challenge), sizeof(sAuthLogonChallenge_S));
 }
 
@@ -334,7 +371,11 @@ void AuthSocket::HandleProof()
     //Read(sizeof(sAuthLogonProof_C), (uint8*)&lp);
     readBuffer.Read(&lp, sizeof(sAuthLogonProof_C));
 
+    queueCryptoJob([this, lp]() { computeProof(lp); });
+}
 
+void AuthSocket::computeProof(const sAuthLogonProof_C& lp)
+{
     ////////////////////////////////////////////////////// SRP6 ///////////////////////////////////////////////
     //Now comes the famous secret Xi Chi fraternity handshake ( http://www.youtube.com/watch?v=jJSYBoI2si0 ),
     //generating a session key
@@ -424,6 +465,7 @@ void AuthSocket::HandleProof()
     {
         // Authentication failed.
         //SendProofError(4, 0);
+        m_cryptoPending = false;
         SendChallengeError(CE_NO_ACCOUNT);
         LOG_DEBUG("[AuthLogonProof] M values don't match. ( Either invalid password or the logon server is bugged. )");
         return;
@@ -437,13 +479,14 @@ void AuthSocket::HandleProof()
     sha.UpdateBigNumbers(&A, &M, &m_sessionkey, 0);
     sha.Finalize();
 
+    // we're authenticated now :)
+    m_authenticated = true;
+    m_cryptoPending = false;
+
     //SendProofError(0, sha.GetDigest());
     sendAuthProof(sha);
     LOG_DEBUG("[AuthLogonProof] Authentication Success.");
 
-    // we're authenticated now :)
-    m_authenticated = true;
-
     // Don't update when IP banned, but update anyway if it's an account ban
     sLogonSQL->Execute("UPDATE accounts SET lastlogin=NOW(), lastip='%s' WHERE id = %u;", GetRemoteIP().c_str(), m_account->AccountId);
 }
@@ -557,6 +600,13 @@ void AuthSocket::OnRead()
         return;
     }
 
+    // SRP6 challenge/proof still in flight on the crypto pool, the client waits for its answer anyway
+    if (m_cryptoPending)
+    {
+        LOG_DEBUG("Crypto job pending, delaying %u bytes", static_cast<uint32>(readBuffer.GetSize()));
+        return;
+    }
+
     uint8 Command = *(uint8*)readBuffer.GetBufferStart();
     last_recv = UNIXTIME;
     if (Command < MAX_AUTH_CMD && Handlers[Command] != NULL)
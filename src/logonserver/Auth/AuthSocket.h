@@ -54,6 +54,13 @@ class AuthSocket : public Socket
 
         // Server Packet Builders
         void SendChallengeError(uint8 Error);
+
+        // SRP6 math, executed by sAuthCryptoPool
+        void computeChallenge();
+        void computeProof(const sAuthLogonProof_C& lp);
+        void queueCryptoJob(std::function<void()> job);
+        bool HasPendingJobs() override { return m_cryptoJobs != 0; }
+
         void SendProofError(uint8 Error, uint8* M2);
         inline sAuthLogonChallenge_C* GetChallenge() { return &m_challenge; }
         inline void SendPacket(const uint8* data, const uint16 len) { Send(data, len); }
@@ -66,7 +73,9 @@ class AuthSocket : public Socket
 
         sAuthLogonChallenge_C m_challenge;
         std::shared_ptr<Account> m_account;
-        bool m_authenticated;
+        std::atomic<bool> m_authenticated;
+        std::atomic<bool> m_cryptoPending;
+        std::atomic<uint32> m_cryptoJobs;
 
         // BigNumbers for the SRP6 implementation
         BigNumber N; // Safe prime
@@ -46,6 +46,7 @@
 #include "Server/AccountMgr.h"
 #include "Server/IpBanMgr.h"
 #include "Auth/AutoPatcher.h"
+#include "Auth/AuthCryptoPool.h"
 #include "Auth/AuthSocket.h"
 #include "Auth/AuthStructs.h"
 #include "LogonCommServer/LogonCommServer.h"
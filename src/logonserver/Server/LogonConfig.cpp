@@ -21,6 +21,9 @@ LogonConfig::LogonConfig()
 
     // logon.conf - Rates
     rates.accountRefreshTime = 600;
+
+    // logon.conf - LogonServer
+    logonServer.cryptoThreads = 0;
 }
 
 void LogonConfig::loadConfigValues(bool reload /*false*/)
@@ -62,4 +65,5 @@ void LogonConfig::loadConfigValues(bool reload /*false*/)
     ASSERT(Config.MainConfig.tryGetBool("LogonServer", "DisablePings", &logonServer.disablePings));
     ASSERT(Config.MainConfig.tryGetString("LogonServer", "AllowedIPs", &logonServer.allowedIps));
     ASSERT(Config.MainConfig.tryGetString("LogonServer", "AllowedModIPs", &logonServer.allowedModIps));
+    Config.MainConfig.tryGetInt("LogonServer", "CryptoThreads", &logonServer.cryptoThreads);
 }
@@ -56,5 +56,6 @@ class SERVER_DECL LogonConfig
             bool disablePings;
             std::string allowedIps;
             std::string allowedModIps;
+            uint32_t cryptoThreads;
         } logonServer;
 };
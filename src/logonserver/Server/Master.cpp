@@ -86,6 +86,8 @@ void MasterLogon::Run(int /*argc*/, char** /*argv*/)
     clientMinBuild = 5875;
     clientMaxBuild = 15595;
 
+    sAuthCryptoPool.initialize(logonConfig.logonServer.cryptoThreads);
+
     ThreadPool.ExecuteTask(new LogonConsoleThread);
 
     sSocketMgr.initialize();
@@ -148,6 +150,7 @@ void MasterLogon::Run(int /*argc*/, char** /*argv*/)
 #ifdef WIN32
     sSocketMgr.ShutdownThreads();
 #endif
+    sAuthCryptoPool.finalize();
     sLogonConsole.Kill();
     sAccountMgr.finalize();
     sRealmsMgr.finalize();
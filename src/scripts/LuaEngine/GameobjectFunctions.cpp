@@ -33,13 +33,13 @@ int LuaGameObject::GossipCreateMenu(lua_State* L, GameObject* ptr)
     if (!target || !ptr)
         return 0;
 
-    if (LuaGlobal::instance()->m_menu != NULL)
-        delete LuaGlobal::instance()->m_menu;
+    if (LuaGlobal::instance()->luaEngine()->m_menu != NULL)
+        delete LuaGlobal::instance()->luaEngine()->m_menu;
 
-    LuaGlobal::instance()->m_menu = new GossipMenu(ptr->getGuid(), text_id);
+    LuaGlobal::instance()->luaEngine()->m_menu = new GossipMenu(ptr->getGuid(), text_id);
 
     if (autosend)
-        LuaGlobal::instance()->m_menu->sendGossipPacket(target);
+        LuaGlobal::instance()->luaEngine()->m_menu->sendGossipPacket(target);
 
     return 0;
 }
@@ -53,13 +53,13 @@ int LuaGameObject::GossipMenuAddItem(lua_State* L, GameObject* /*ptr*/)
     const char* boxmessage = luaL_optstring(L, 5, "");
     uint32_t boxmoney = static_cast<uint32_t>(luaL_optinteger(L, 6, 0));
 
-    if (LuaGlobal::instance()->m_menu == NULL)
+    if (LuaGlobal::instance()->luaEngine()->m_menu == NULL)
     {
         DLLLogDetail("There is no menu to add items to!");
         return 0;
     }
 
-    LuaGlobal::instance()->m_menu->addItem(icon, 0, IntId, menu_text, boxmoney, boxmessage, coded);
+    LuaGlobal::instance()->luaEngine()->m_menu->addItem(icon, 0, IntId, menu_text, boxmoney, boxmessage, coded);
     return 0;
 }
 
@@ -69,13 +69,13 @@ int LuaGameObject::GossipSendMenu(lua_State* L, GameObject* /*ptr*/)
     if (!target)
         return 0;
 
-    if (LuaGlobal::instance()->m_menu == NULL)
+    if (LuaGlobal::instance()->luaEngine()->m_menu == NULL)
     {
         DLLLogDetail("There is no menu to send!");
         return 0;
     }
 
-    LuaGlobal::instance()->m_menu->sendGossipPacket(target);
+    LuaGlobal::instance()->luaEngine()->m_menu->sendGossipPacket(target);
 
     return 0;
 }
@@ -86,13 +86,13 @@ int LuaGameObject::GossipComplete(lua_State* L, GameObject* /*ptr*/)
     if (!target)
         return 0;
 
-    if (LuaGlobal::instance()->m_menu == NULL)
+    if (LuaGlobal::instance()->luaEngine()->m_menu == NULL)
     {
         DLLLogDetail("There is no menu to complete!");
         return 0;
     }
 
-    LuaGlobal::instance()->m_menu->senGossipComplete(target);
+    LuaGlobal::instance()->luaEngine()->m_menu->senGossipComplete(target);
 
     return 0;
 }
@@ -1116,7 +1116,7 @@ int LuaGameObject::RegisterEvent(lua_State* L, GameObject* ptr)
         functionRef = LuaHelpers::ExtractfRefFromCString(L, luaL_checkstring(L, 1));
     if (functionRef)
     {
-        TimedEvent* ev = TimedEvent::Allocate(ptr, new CallbackP1<LuaEngine, int>(LuaGlobal::instance()->luaEngine().get(), &LuaEngine::CallFunctionByReference, functionRef), EVENT_LUA_GAMEOBJ_EVENTS, delay, repeats);
+        TimedEvent* ev = TimedEvent::Allocate(ptr, new CallbackP1<LuaEngine, int>(LuaGlobal::instance()->luaEngine(), &LuaEngine::CallFunctionByReference, functionRef), EVENT_LUA_GAMEOBJ_EVENTS, delay, repeats);
         ptr->event_AddEvent(ev);
         std::map<uint64, std::set<int>>& objRefs = LuaGlobal::instance()->luaEngine()->getObjectFunctionRefs();
         std::map<uint64, std::set<int>>::iterator itr = objRefs.find(ptr->getGuid());
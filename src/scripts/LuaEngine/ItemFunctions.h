@@ -38,13 +38,13 @@ namespace luaItem
         if (player == nullptr)
             return 0;
 
-        if (LuaGlobal::instance()->m_menu != nullptr)
-            delete LuaGlobal::instance()->m_menu;
+        if (LuaGlobal::instance()->luaEngine()->m_menu != nullptr)
+            delete LuaGlobal::instance()->luaEngine()->m_menu;
 
-        LuaGlobal::instance()->m_menu = new GossipMenu(ptr->getGuid(), text_id);
+        LuaGlobal::instance()->luaEngine()->m_menu = new GossipMenu(ptr->getGuid(), text_id);
 
         if (autosend != 0)
-            LuaGlobal::instance()->m_menu->sendGossipPacket(player);
+            LuaGlobal::instance()->luaEngine()->m_menu->sendGossipPacket(player);
 
         return 1;
     }
@@ -58,13 +58,13 @@ namespace luaItem
         const char* boxmessage = luaL_optstring(L, 5, "");
         uint32 boxmoney = static_cast<uint32>(luaL_optinteger(L, 6, 0));
 
-        if (LuaGlobal::instance()->m_menu == NULL)
+        if (LuaGlobal::instance()->luaEngine()->m_menu == NULL)
         {
             DLLLogDetail("There is no menu to add items to!");
             return 0;
         }
 
-        LuaGlobal::instance()->m_menu->addItem(icon, 0, IntId, menu_text,boxmoney, boxmessage, coded);
+        LuaGlobal::instance()->luaEngine()->m_menu->addItem(icon, 0, IntId, menu_text,boxmoney, boxmessage, coded);
 
         return 0;
     }
@@ -73,13 +73,13 @@ namespace luaItem
     {
         Player* plr = CHECK_PLAYER(L, 1);
 
-        if (LuaGlobal::instance()->m_menu == NULL)
+        if (LuaGlobal::instance()->luaEngine()->m_menu == NULL)
         {
             DLLLogDetail("There is no menu to send!");
             return 0;
         }
 
-        LuaGlobal::instance()->m_menu->sendGossipPacket(plr);
+        LuaGlobal::instance()->luaEngine()->m_menu->sendGossipPacket(plr);
 
         return 1;
     }
@@ -88,13 +88,13 @@ namespace luaItem
     {
         Player* plr = CHECK_PLAYER(L, 1);
 
-        if (LuaGlobal::instance()->m_menu == NULL)
+        if (LuaGlobal::instance()->luaEngine()->m_menu == NULL)
         {
             DLLLogDetail("There is no menu to complete!");
             return 0;
         }
 
-        LuaGlobal::instance()->m_menu->senGossipComplete(plr);
+        LuaGlobal::instance()->luaEngine()->m_menu->senGossipComplete(plr);
 
         return 1;
     }
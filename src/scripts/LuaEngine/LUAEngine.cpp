@@ -47,17 +47,44 @@ extern "C" SCRIPT_DECL uint32_t _exp_get_script_type()
 extern "C" SCRIPT_DECL void _exp_script_register(ScriptMgr* mgr)
 {
     m_scriptMgr = mgr;
-    LuaGlobal::instance()->luaEngine()->Startup();
+    LuaGlobal::instance()->startup();
 }
 
 extern "C" SCRIPT_DECL void _exp_engine_unload()
 {
     DLLLogDetail("exp_engine_unload was called");
+    LuaGlobal::instance()->logProfiles();
 }
 
 extern "C" SCRIPT_DECL void _export_engine_reload()
 {
-    LuaGlobal::instance()->luaEngine()->Restart();
+    LuaGlobal::instance()->logProfiles();
+    LuaGlobal::instance()->restart();
+
+    //hyper: do OnSpawns for spawned creatures.
+    std::vector<uint32_t> temp = LuaGlobal::instance()->takeOnLoadInfo();
+    for (auto itr = temp.begin(); itr != temp.end(); itr += 3)
+    {
+        //*itr = mapid; *(itr+1) = iid; *(itr+2) = lowguid
+        MapMgr* mgr = nullptr;
+        if (*(itr + 1) == 0) //no instance
+        {
+            mgr = sInstanceMgr.GetMapMgr(*itr);
+        }
+        else
+        {
+            Instance* inst = sInstanceMgr.GetInstanceByIds(*itr, *(itr + 1));
+            if (inst != nullptr)
+                mgr = inst->m_mapMgr;
+        }
+
+        if (mgr != nullptr)
+        {
+            Creature* unit = mgr->GetCreature(*(itr + 2));
+            if (unit != nullptr && unit->IsInWorld() && unit->GetScript() != nullptr)
+                unit->GetScript()->OnLoad();
+        }
+    }
 }
 
 void report(lua_State* L)
@@ -73,7 +100,9 @@ void report(lua_State* L)
     }
 }
 
-LuaEngine::LuaEngine() : lu(nullptr) {}
+static std::atomic<uint32_t> s_engineCount(0);
+
+LuaEngine::LuaEngine() : lu(nullptr), m_currentReference(0), m_engineId(++s_engineCount), m_menu(nullptr) {}
 
 void LuaEngine::ScriptLoadDir(std::string Dirname, LUALoadScripts* pak)
 {
@@ -139,6 +168,7 @@ void LuaEngine::BeginCall(uint16_t fReference)
 {
     lua_settop(lu, 0); //stack should be empty
     lua_rawgeti(lu, LUA_REGISTRYINDEX, fReference);
+    m_currentReference = fReference;
 }
 
 bool LuaEngine::ExecuteCall(uint8_t params, uint8_t res)
@@ -158,11 +188,13 @@ bool LuaEngine::ExecuteCall(uint8_t params, uint8_t res)
     }
     else
     {
+        const auto startTime = std::chrono::steady_clock::now();
         if (lua_pcall(lu, params, res, 0))
         {
             report(lu);
             ret = false;
         }
+        addProfile(m_currentReference, startTime);
     }
     return ret;
 }
@@ -173,6 +205,67 @@ void LuaEngine::EndCall(uint8_t res)
             lua_remove(lu, res);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// PROFILING
+
+void LuaEngine::addProfile(int reference, std::chrono::steady_clock::time_point startTime)
+{
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+    const uint64_t microseconds = static_cast<uint64_t>(duration.count());
+
+    HookProfile& profile = m_hookProfiles[reference];
+    ++profile.calls;
+    profile.totalMicroseconds += microseconds;
+    if (microseconds > profile.maxMicroseconds)
+        profile.maxMicroseconds = microseconds;
+}
+
+void LuaEngine::logProfile()
+{
+    GET_LOCK
+
+    std::vector<std::pair<int, HookProfile>> profiles(m_hookProfiles.begin(), m_hookProfiles.end());
+    std::sort(profiles.begin(), profiles.end(), [](std::pair<int, HookProfile> const& a, std::pair<int, HookProfile> const& b)
+    {
+        return a.second.totalMicroseconds > b.second.totalMicroseconds;
+    });
+
+    uint64_t calls = 0;
+    uint64_t totalMicroseconds = 0;
+    for (const auto& profile : profiles)
+    {
+        calls += profile.second.calls;
+        totalMicroseconds += profile.second.totalMicroseconds;
+    }
+
+    DLLLogDetail("LuaEngineMgr : Engine %u called %llu Lua functions in %llu ms", m_engineId, static_cast<unsigned long long>(calls), static_cast<unsigned long long>(totalMicroseconds / 1000));
+
+    const size_t shownProfiles = std::min<size_t>(profiles.size(), 20);
+    for (size_t i = 0; i < shownProfiles; ++i)
+    {
+        const auto& profile = profiles[i];
+
+        std::string name = profile.second.name;
+        if (name.empty())
+        {
+            lua_rawgeti(lu, LUA_REGISTRYINDEX, profile.first);
+            lua_Debug debugInfo;
+            if (lua_isfunction(lu, -1) && lua_getinfo(lu, ">S", &debugInfo))
+                name = std::string(debugInfo.short_src) + ":" + std::to_string(debugInfo.linedefined);
+            else
+            {
+                lua_pop(lu, 1);
+                name = "unknown";
+            }
+        }
+
+        DLLLogDetail("LuaEngineMgr : Engine %u %s (ref %d) %llu calls, %llu us total, %llu us max", m_engineId, name.c_str(), profile.first,
+            static_cast<unsigned long long>(profile.second.calls), static_cast<unsigned long long>(profile.second.totalMicroseconds), static_cast<unsigned long long>(profile.second.maxMicroseconds));
+    }
+
+    RELEASE_LOCK
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // PUSH METHODS
 
@@ -274,6 +367,8 @@ END PUSH METHODS
 
 void LuaEngine::HyperCallFunction(const char* FuncName, int ref)  //hyper as in hypersniper :3
 {
+    // timed events are executed by the world thread
+    LuaEngineScope scope(this);
     GET_LOCK
     std::string sFuncName = std::string(FuncName);
     char* copy = strdup(FuncName);
@@ -340,8 +435,8 @@ void LuaEngine::HyperCallFunction(const char* FuncName, int ref)  //hyper as in
         {
             free((void*)FuncName);
             luaL_unref(lu, LUA_REGISTRYINDEX, ref);
-            const auto itr = LuaGlobal::instance()->luaEngine()->m_registeredTimedEvents.find(ref);
-            LuaGlobal::instance()->luaEngine()->m_registeredTimedEvents.erase(itr);
+            const auto itr = m_registeredTimedEvents.find(ref);
+            m_registeredTimedEvents.erase(itr);
         }
         else
         {
@@ -351,9 +446,12 @@ void LuaEngine::HyperCallFunction(const char* FuncName, int ref)  //hyper as in
         }
     }
     lua_remove(lu, thread); //now we can remove the thread object
+    const auto startTime = std::chrono::steady_clock::now();
     int r = lua_pcall(lu, nargs + (colon ? 1 : 0), 0, 0);
     if (r)
         report(lu);
+    addProfile(ref, startTime);
+    m_hookProfiles[ref].name = sFuncName;
 
     free((void*)copy);
     lua_settop(lu, 0);
@@ -372,9 +470,10 @@ static int CreateLuaEvent(lua_State* L)
     {
         lua_settop(L, 1);
         int functionRef = luaL_ref(L, LUA_REGISTRYINDEX);
-        TimedEvent* ev = TimedEvent::Allocate(&sWorld, new CallbackP1<LuaEngine, int>(LuaGlobal::instance()->luaEngine().get(), &LuaEngine::CallFunctionByReference, functionRef), 0, delay, repeats);
+        // added to the event holder of the engine, the references of the engines overlap
+        TimedEvent* ev = TimedEvent::Allocate(&sLuaEventMgr, new CallbackP1<LuaEngine, int>(LuaGlobal::instance()->luaEngine(), &LuaEngine::CallFunctionByReference, functionRef), 0, delay, repeats);
         ev->eventType = LUA_EVENTS_END + functionRef; //Create custom reference by adding the ref number to the max lua event type to get a unique reference for every function.
-        sWorld.event_AddEvent(ev);
+        sLuaEventMgr.event_AddEvent(ev);
         LuaGlobal::instance()->luaEngine()->getFunctionRefs().insert(functionRef);
         lua_pushinteger(L, functionRef);
     }
@@ -389,11 +488,14 @@ static int CreateLuaEvent(lua_State* L)
 
 void LuaEngine::CallFunctionByReference(int ref)
 {
+    LuaEngineScope scope(this);
     GET_LOCK
 
     lua_rawgeti(lu, LUA_REGISTRYINDEX, ref);
+    const auto startTime = std::chrono::steady_clock::now();
     if (lua_pcall(lu, 0, 0, 0))
         report(lu);
+    addProfile(ref, startTime);
 
     RELEASE_LOCK
 }
@@ -405,7 +507,7 @@ void LuaEngine::DestroyAllLuaEvents()
     //Clean up for all events.
     for (auto itr = m_functionRefs.begin(); itr != m_functionRefs.end(); ++itr)
     {
-        sEventMgr.RemoveEvents(&sWorld, (*itr) + LUA_EVENTS_END);
+        sEventMgr.RemoveEvents(&LuaEventMgr, (*itr) + LUA_EVENTS_END);
         luaL_unref(lu, LUA_REGISTRYINDEX, (*itr));
     }
     m_functionRefs.clear();
@@ -421,7 +523,7 @@ static int ModifyLuaEventInterval(lua_State* L)
     int newinterval = static_cast<int>(luaL_checkinteger(L, 2));
     ref += LUA_EVENTS_END;
     //Easy interval modification.
-    sEventMgr.ModifyEventTime(&sWorld, ref, newinterval);
+    sEventMgr.ModifyEventTime(&sLuaEventMgr, ref, newinterval);
 
     RELEASE_LOCK
 
@@ -436,13 +538,91 @@ static int DestroyLuaEvent(lua_State* L)
     int ref = static_cast<int>(luaL_checkinteger(L, 1));
     luaL_unref(L, LUA_REGISTRYINDEX, ref);
     LuaGlobal::instance()->luaEngine()->getFunctionRefs().erase(ref);
-    sEventMgr.RemoveEvents(&sWorld, ref + LUA_EVENTS_END);
+    sEventMgr.RemoveEvents(&sLuaEventMgr, ref + LUA_EVENTS_END);
 
     RELEASE_LOCK
 
     return 0;
 }
 
+/*
+Every map thread runs its own Lua state, globals set by a script are only visible in that state.
+Values that have to be seen by all maps are stored with SetSharedValue(key, value) and read with GetSharedValue(key).
+*/
+static int SetSharedValue(lua_State* L)
+{
+    const char* key = luaL_checkstring(L, 1);
+
+    LuaSharedValue value;
+    switch (lua_type(L, 2))
+    {
+        case LUA_TNONE:
+        case LUA_TNIL:
+            LuaGlobal::instance()->removeSharedValue(key);
+            return 0;
+        case LUA_TBOOLEAN:
+            value.type = LuaSharedValue::TYPE_BOOL;
+            value.boolean = lua_toboolean(L, 2) != 0;
+            break;
+        case LUA_TNUMBER:
+            value.type = LuaSharedValue::TYPE_NUMBER;
+            value.number = lua_tonumber(L, 2);
+            break;
+        case LUA_TSTRING:
+            value.type = LuaSharedValue::TYPE_STRING;
+            value.string = lua_tostring(L, 2);
+            break;
+        default:
+            return luaL_error(L, "SetSharedValue : values of type %s can not be shared", luaL_typename(L, 2));
+    }
+
+    LuaGlobal::instance()->setSharedValue(key, value);
+    return 0;
+}
+
+static int GetSharedValue(lua_State* L)
+{
+    const char* key = luaL_checkstring(L, 1);
+
+    LuaSharedValue value;
+    if (!LuaGlobal::instance()->getSharedValue(key, value))
+    {
+        lua_pushnil(L);
+        return 1;
+    }
+
+    switch (value.type)
+    {
+        case LuaSharedValue::TYPE_BOOL:
+            lua_pushboolean(L, value.boolean ? 1 : 0);
+            break;
+        case LuaSharedValue::TYPE_NUMBER:
+            lua_pushnumber(L, value.number);
+            break;
+        case LuaSharedValue::TYPE_STRING:
+            lua_pushstring(L, value.string.c_str());
+            break;
+    }
+
+    return 1;
+}
+
+// adds the amount in one step, returns the new value
+static int AddSharedValue(lua_State* L)
+{
+    const char* key = luaL_checkstring(L, 1);
+    const double amount = luaL_optnumber(L, 2, 1.0);
+
+    lua_pushnumber(L, LuaGlobal::instance()->addSharedNumber(key, amount));
+    return 1;
+}
+
+static int LogLuaProfile(lua_State* /*L*/)
+{
+    LuaGlobal::instance()->luaEngine()->logProfile();
+    return 0;
+}
+
 void LuaEngine::RegisterCoreFunctions()
 {
     lua_register(lu, "RegisterUnitEvent", RegisterUnitEvent);
@@ -462,6 +642,11 @@ void LuaEngine::RegisterCoreFunctions()
     lua_register(lu, "ModifyLuaEventInterval", &ModifyLuaEventInterval);
     lua_register(lu, "DestroyLuaEvent", &DestroyLuaEvent);
 
+    lua_register(lu, "SetSharedValue", &SetSharedValue);
+    lua_register(lu, "GetSharedValue", &GetSharedValue);
+    lua_register(lu, "AddSharedValue", &AddSharedValue);
+    lua_register(lu, "LogLuaProfile", &LogLuaProfile);
+
     RegisterGlobalFunctions(lu);
 
     ArcLuna<Unit>::Register(lu);
@@ -521,7 +706,7 @@ static int RegisterDummySpell(lua_State* L)
     if (!entry || typeName == nullptr)
         return 0;
 
-    if (LuaGlobal::instance()->m_luaDummySpells.find(entry) != LuaGlobal::instance()->m_luaDummySpells.end())
+    if (LuaGlobal::instance()->luaEngine()->m_luaDummySpells.find(entry) != LuaGlobal::instance()->luaEngine()->m_luaDummySpells.end())
         luaL_error(L, "LuaEngineMgr : RegisterDummySpell failed! Spell %d already has a registered Lua function!", entry);
     if (!strcmp(typeName, "function"))
         functionRef = static_cast<uint16_t>(luaL_ref(L, LUA_REGISTRYINDEX));
@@ -718,7 +903,7 @@ static int SuspendLuaThread(lua_State* L)
     if (ref == LUA_REFNIL || ref == LUA_NOREF)
         return luaL_error(L, "Error in SuspendLuaThread! Failed to create a valid reference.");
 
-    TimedEvent* evt = TimedEvent::Allocate(thread, new CallbackP1<LuaEngine, int>(LuaGlobal::instance()->luaEngine().get(), &LuaEngine::ResumeLuaThread, ref), 0, waitime, 1);
+    TimedEvent* evt = TimedEvent::Allocate(thread, new CallbackP1<LuaEngine, int>(LuaGlobal::instance()->luaEngine(), &LuaEngine::ResumeLuaThread, ref), 0, waitime, 1);
     sWorld.event_AddEvent(evt);
     lua_remove(L, 1); // remove thread object
     lua_remove(L, 1); // remove timer.
@@ -750,7 +935,7 @@ static int RegisterTimedEvent(lua_State* L)  //in this case, L == lu
     if (ref == LUA_REFNIL || ref == LUA_NOREF)
         return luaL_error(L, "Error in RegisterTimedEvent! Failed to create a valid reference.");
    
-    TimedEvent* te = TimedEvent::Allocate(LuaGlobal::instance()->luaEngine().get(), new CallbackP2<LuaEngine, const char*, int>(LuaGlobal::instance()->luaEngine().get(), &LuaEngine::HyperCallFunction, funcName, ref), EVENT_LUA_TIMED, delay, repeats);
+    TimedEvent* te = TimedEvent::Allocate(LuaGlobal::instance()->luaEngine(), new CallbackP2<LuaEngine, const char*, int>(LuaGlobal::instance()->luaEngine(), &LuaEngine::HyperCallFunction, funcName, ref), EVENT_LUA_TIMED, delay, repeats);
     EventInfoHolder* ek = new EventInfoHolder;
     ek->funcName = funcName;
     ek->te = te;
@@ -774,7 +959,7 @@ bool LuaHookOnNewCharacter(uint32_t Race, uint32_t Class, WorldSession* /*Sessio
     GET_LOCK
 
     bool result = true;
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_NEW_CHARACTER])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_NEW_CHARACTER])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_NEW_CHARACTER);
@@ -799,7 +984,7 @@ void LuaHookOnKillPlayer(Player* pPlayer, Player* pVictim)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_KILL_PLAYER])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_KILL_PLAYER])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_KILL_PLAYER);
@@ -815,7 +1000,7 @@ void LuaHookOnFirstEnterWorld(Player* pPlayer)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_FIRST_ENTER_WORLD])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_FIRST_ENTER_WORLD])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_FIRST_ENTER_WORLD);
@@ -830,7 +1015,7 @@ void LuaHookOnEnterWorld(Player* pPlayer)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_ENTER_WORLD])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_ENTER_WORLD])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_ENTER_WORLD);
@@ -845,7 +1030,7 @@ void LuaHookOnGuildJoin(Player* pPlayer, Guild* pGuild)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_GUILD_JOIN])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_GUILD_JOIN])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_GUILD_JOIN);
@@ -861,7 +1046,7 @@ void LuaHookOnDeath(Player* pPlayer)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_DEATH])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_DEATH])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_DEATH);
@@ -877,7 +1062,7 @@ bool LuaHookOnRepop(Player* pPlayer)
     GET_LOCK
 
     bool result = true;
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_REPOP])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_REPOP])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_REPOP);
@@ -900,7 +1085,7 @@ void LuaHookOnEmote(Player* pPlayer, uint32_t Emote, Unit* pUnit)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_EMOTE])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_EMOTE])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_EMOTE);
@@ -917,7 +1102,7 @@ void LuaHookOnEnterCombat(Player* pPlayer, Unit* pTarget)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_ENTER_COMBAT])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_ENTER_COMBAT])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_ENTER_COMBAT);
@@ -934,7 +1119,7 @@ bool LuaHookOnCastSpell(Player* pPlayer, SpellInfo const* pSpell, Spell* spell)
     GET_LOCK
 
     bool result = true;
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_CAST_SPELL])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_CAST_SPELL])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_CAST_SPELL);
@@ -960,7 +1145,7 @@ void LuaHookOnTick()
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_TICK])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_TICK])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->ExecuteCall();
@@ -974,7 +1159,7 @@ bool LuaHookOnLogoutRequest(Player* pPlayer)
     GET_LOCK
 
     bool result = true;
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_LOGOUT_REQUEST])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_LOGOUT_REQUEST])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_LOGOUT_REQUEST);
@@ -998,7 +1183,7 @@ void LuaHookOnLogout(Player* pPlayer)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_LOGOUT])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_LOGOUT])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_LOGOUT);
@@ -1013,7 +1198,7 @@ void LuaHookOnQuestAccept(Player* pPlayer, QuestProperties* pQuest, Object* pQue
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_QUEST_ACCEPT])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_QUEST_ACCEPT])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_QUEST_ACCEPT);
@@ -1041,7 +1226,7 @@ void LuaHookOnZone(Player* pPlayer, uint32_t Zone, uint32_t oldZone)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_ZONE])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_ZONE])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_ZONE);
@@ -1059,7 +1244,7 @@ bool LuaHookOnChat(Player* pPlayer, uint32_t Type, uint32_t Lang, const char* Me
     GET_LOCK
 
     bool result = true;
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_CHAT])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_CHAT])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_CHAT);
@@ -1087,7 +1272,7 @@ void LuaHookOnLoot(Player* pPlayer, Unit* pTarget, uint32_t Money, uint32_t Item
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_LOOT])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_LOOT])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_LOOT);
@@ -1105,7 +1290,7 @@ void LuaHookOnGuildCreate(Player* pLeader, Guild* pGuild)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_GUILD_CREATE])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_GUILD_CREATE])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_GUILD_CREATE);
@@ -1121,7 +1306,7 @@ void LuaHookOnEnterWorld2(Player* pPlayer)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_FULL_LOGIN])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_FULL_LOGIN])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_FULL_LOGIN);
@@ -1136,7 +1321,7 @@ void LuaHookOnCharacterCreate(Player* pPlayer)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_CHARACTER_CREATE])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_CHARACTER_CREATE])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_CHARACTER_CREATE);
@@ -1151,7 +1336,7 @@ void LuaHookOnQuestCancelled(Player* pPlayer, QuestProperties* pQuest)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_QUEST_CANCELLED])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_QUEST_CANCELLED])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_QUEST_CANCELLED);
@@ -1167,7 +1352,7 @@ void LuaHookOnQuestFinished(Player* pPlayer, QuestProperties* pQuest, Object* pQ
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_QUEST_FINISHED])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_QUEST_FINISHED])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_QUEST_FINISHED);
@@ -1195,7 +1380,7 @@ void LuaHookOnHonorableKill(Player* pPlayer, Player* pKilled)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_HONORABLE_KILL])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_HONORABLE_KILL])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_HONORABLE_KILL);
@@ -1211,7 +1396,7 @@ void LuaHookOnArenaFinish(Player* pPlayer, ArenaTeam* pTeam, bool victory, bool
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_ARENA_FINISH])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_ARENA_FINISH])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_ARENA_FINISH);
@@ -1229,7 +1414,7 @@ void LuaHookOnObjectLoot(Player* pPlayer, Object* pTarget, uint32_t Money, uint3
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_OBJECTLOOT])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_OBJECTLOOT])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_OBJECTLOOT);
@@ -1247,7 +1432,7 @@ void LuaHookOnAreaTrigger(Player* pPlayer, uint32_t areaTrigger)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_AREATRIGGER])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_AREATRIGGER])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_AREATRIGGER);
@@ -1263,7 +1448,7 @@ void LuaHookOnPostLevelUp(Player* pPlayer)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_POST_LEVELUP])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_POST_LEVELUP])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_POST_LEVELUP);
@@ -1279,7 +1464,7 @@ bool LuaHookOnPreUnitDie(Unit* Killer, Unit* Victim)
     GET_LOCK
 
     bool result = true;
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_PRE_DIE])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_PRE_DIE])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_PRE_DIE);
@@ -1304,7 +1489,7 @@ void LuaHookOnAdvanceSkillLine(Player* pPlayer, uint32_t SkillLine, uint32_t Cur
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_ADVANCE_SKILLLINE])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_ADVANCE_SKILLLINE])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_ADVANCE_SKILLLINE);
@@ -1321,7 +1506,7 @@ void LuaHookOnDuelFinished(Player* pWinner, Player* pLoser)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_DUEL_FINISHED])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_DUEL_FINISHED])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_DUEL_FINISHED);
@@ -1337,7 +1522,7 @@ void LuaHookOnAuraRemove(Aura* aura)
 {
     GET_LOCK
 
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_AURA_REMOVE])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_AURA_REMOVE])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_AURA_REMOVE);
@@ -1353,7 +1538,7 @@ bool LuaHookOnResurrect(Player* pPlayer)
     GET_LOCK
 
     bool result = true;
-    for (auto itr : LuaGlobal::instance()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_RESURRECT])
+    for (auto itr : LuaGlobal::instance()->luaEngine()->EventAsToFuncName[SERVER_HOOK_EVENT_ON_RESURRECT])
     {
         LuaGlobal::instance()->luaEngine()->BeginCall(itr);
         LuaGlobal::instance()->luaEngine()->PUSH_INT(SERVER_HOOK_EVENT_ON_RESURRECT);
@@ -1377,7 +1562,7 @@ bool LuaOnDummySpell(uint8_t effectIndex, Spell* pSpell)
 {
     GET_LOCK
 
-    LuaGlobal::instance()->luaEngine()->BeginCall(LuaGlobal::instance()->m_luaDummySpells[pSpell->getSpellInfo()->getId()]);
+    LuaGlobal::instance()->luaEngine()->BeginCall(LuaGlobal::instance()->luaEngine()->m_luaDummySpells[pSpell->getSpellInfo()->getId()]);
     LuaGlobal::instance()->luaEngine()->PUSH_UINT(effectIndex);
     LuaGlobal::instance()->luaEngine()->PushSpell(pSpell);
     LuaGlobal::instance()->luaEngine()->ExecuteCall(2);
@@ -1391,15 +1576,20 @@ class LuaCreature : public CreatureAIScript
 {
 public:
 
-    LuaCreature(Creature* creature) : CreatureAIScript(creature), m_binding(nullptr) {}
+    LuaCreature(Creature* creature) : CreatureAIScript(creature) {}
     ~LuaCreature()
     {}
 
+    LuaObjectBinding* getBinding()
+    {
+        return LuaGlobal::instance()->luaEngine()->getUnitBinding(getCreature()->getEntry());
+    }
+
     void OnCombatStart(Unit* mTarget)
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_ENTER_COMBAT]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_ENTER_COMBAT]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_ENTER_COMBAT);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
@@ -1412,7 +1602,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_LEAVE_COMBAT]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_LEAVE_COMBAT]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_LEAVE_COMBAT);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
@@ -1425,7 +1615,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_TARGET_DIED]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_TARGET_DIED]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_TARGET_DIED);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
@@ -1438,7 +1628,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_DIED]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_DIED]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_DIED);
         LuaGlobal::instance()->luaEngine()->PushUnit(mKiller);
@@ -1451,7 +1641,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_TARGET_PARRIED]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_TARGET_PARRIED]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_TARGET_PARRIED);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
@@ -1464,7 +1654,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_TARGET_DODGED]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_TARGET_DODGED]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_TARGET_DODGED);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
@@ -1477,7 +1667,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_TARGET_BLOCKED]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_TARGET_BLOCKED]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_TARGET_BLOCKED);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
@@ -1491,7 +1681,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_TARGET_CRIT_HIT]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_TARGET_CRIT_HIT]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_TARGET_CRIT_HIT);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
@@ -1505,7 +1695,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_PARRY]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_PARRY]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_PARRY);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
@@ -1518,7 +1708,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_DODGED]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_DODGED]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_DODGED);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
@@ -1531,7 +1721,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_BLOCKED]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_BLOCKED]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_BLOCKED);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
@@ -1545,7 +1735,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_CRIT_HIT]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_CRIT_HIT]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_CRIT_HIT);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
@@ -1559,7 +1749,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_HIT]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_HIT]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_HIT);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
@@ -1573,7 +1763,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_ASSIST_TARGET_DIED]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_ASSIST_TARGET_DIED]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_ASSIST_TARGET_DIED);
         LuaGlobal::instance()->luaEngine()->PushUnit(mAssistTarget);
@@ -1586,7 +1776,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_FEAR]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_FEAR]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_FEAR);
         LuaGlobal::instance()->luaEngine()->PushUnit(mFeared);
@@ -1600,7 +1790,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_FLEE]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_FLEE]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_FLEE);
         LuaGlobal::instance()->luaEngine()->PushUnit(mFlee);
@@ -1613,7 +1803,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_CALL_FOR_HELP]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_CALL_FOR_HELP]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_CALL_FOR_HELP);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(2);
@@ -1625,7 +1815,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_LOAD]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_LOAD]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_LOAD);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(2);
@@ -1638,16 +1828,14 @@ public:
         WoWGuid wowGuid;
         wowGuid.Init(getCreature()->getGuid());
 
-        LuaGlobal::instance()->m_onLoadInfo.push_back(getCreature()->GetMapId());
-        LuaGlobal::instance()->m_onLoadInfo.push_back(iid);
-        LuaGlobal::instance()->m_onLoadInfo.push_back(wowGuid.getGuidLowPart());
+        LuaGlobal::instance()->addOnLoadInfo(getCreature()->GetMapId(), iid, wowGuid.getGuidLowPart());
     }
 
     void OnReachWP(uint32_t iWaypointId, bool bForwards)
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_REACH_WP]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_REACH_WP]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_REACH_WP);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(iWaypointId);
@@ -1661,7 +1849,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_LOOT_TAKEN]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_LOOT_TAKEN]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_LOOT_TAKEN);
         LuaGlobal::instance()->luaEngine()->PushUnit(pPlayer);
@@ -1675,7 +1863,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_AIUPDATE]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_AIUPDATE]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_AIUPDATE);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(2);
@@ -1687,7 +1875,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_EMOTE]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_EMOTE]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_EMOTE);
         LuaGlobal::instance()->luaEngine()->PushUnit(pPlayer);
@@ -1701,7 +1889,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_DAMAGE_TAKEN]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_DAMAGE_TAKEN]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PUSH_INT(CREATURE_EVENT_ON_DAMAGE_TAKEN);
         LuaGlobal::instance()->luaEngine()->PushUnit(mAttacker);
@@ -1715,7 +1903,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK;
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_ENTER_VEHICLE]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_ENTER_VEHICLE]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->ExecuteCall(1);
 
@@ -1726,7 +1914,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK;
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_EXIT_VEHICLE]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_EXIT_VEHICLE]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->ExecuteCall(1);
 
@@ -1737,7 +1925,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK;
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_FIRST_PASSENGER_ENTERED]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_FIRST_PASSENGER_ENTERED]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PushUnit(passenger);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(2);
@@ -1749,7 +1937,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK;
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_VEHICLE_FULL]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_VEHICLE_FULL]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->ExecuteCall(1);
 
@@ -1760,7 +1948,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK;
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[CREATURE_EVENT_ON_LAST_PASSENGER_LEFT]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[CREATURE_EVENT_ON_LAST_PASSENGER_LEFT]);
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
         LuaGlobal::instance()->luaEngine()->PushUnit(passenger);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(2);
@@ -1770,7 +1958,12 @@ public:
 
     void StringFunctionCall(int fRef)
     {
-        CHECK_BINDING_ACQUIRELOCK
+        GET_LOCK
+        if (getBinding() == nullptr)
+        {
+            RELEASE_LOCK
+            return;
+        }
 
         LuaGlobal::instance()->luaEngine()->BeginCall(static_cast<uint16_t>(fRef));
         LuaGlobal::instance()->luaEngine()->PushUnit(getCreature());
@@ -1781,20 +1974,6 @@ public:
 
     void Destroy()
     {
-        {
-            typedef std::multimap<uint32_t, LuaCreature*> CMAP;
-            CMAP& cMap = LuaGlobal::instance()->luaEngine()->getLuCreatureMap();
-            auto itr = cMap.find(getCreature()->getEntry());
-            auto itend = cMap.upper_bound(getCreature()->getEntry());
-            CMAP::iterator it;
-            for (; itr != cMap.end() && itr != itend;)
-            {
-                it = itr++;
-                if (it->second != nullptr && it->second == this)
-                    cMap.erase(it);
-            }
-        }
-
         {
             //Function Ref clean up
             std::map< uint64_t, std::set<int> >& objRefs = LuaGlobal::instance()->luaEngine()->getObjectFunctionRefs();
@@ -1812,16 +1991,20 @@ public:
         }
         delete this;
     }
-    LuaObjectBinding* m_binding;
 };
 
 class LuaGameObjectScript : public GameObjectAIScript
 {
 public:
 
-    explicit LuaGameObjectScript(GameObject* go) : GameObjectAIScript(go), m_binding(nullptr) {}
+    explicit LuaGameObjectScript(GameObject* go) : GameObjectAIScript(go) {}
     ~LuaGameObjectScript() {}
 
+    LuaObjectBinding* getBinding()
+    {
+        return LuaGlobal::instance()->luaEngine()->getGameObjectBinding(_gameobject->getEntry());
+    }
+
     GameObject* getGO()
     {
         return _gameobject;
@@ -1831,7 +2014,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[GAMEOBJECT_EVENT_ON_CREATE]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GAMEOBJECT_EVENT_ON_CREATE]);
         LuaGlobal::instance()->luaEngine()->PushGo(_gameobject);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(1);
 
@@ -1842,7 +2025,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[GAMEOBJECT_EVENT_ON_SPAWN]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GAMEOBJECT_EVENT_ON_SPAWN]);
         LuaGlobal::instance()->luaEngine()->PushGo(_gameobject);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(1);
 
@@ -1853,7 +2036,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[GAMEOBJECT_EVENT_ON_DESPAWN]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GAMEOBJECT_EVENT_ON_DESPAWN]);
         LuaGlobal::instance()->luaEngine()->PushGo(_gameobject);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(1);
 
@@ -1864,7 +2047,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[GAMEOBJECT_EVENT_ON_LOOT_TAKEN]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GAMEOBJECT_EVENT_ON_LOOT_TAKEN]);
         LuaGlobal::instance()->luaEngine()->PushGo(_gameobject);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(GAMEOBJECT_EVENT_ON_LOOT_TAKEN);
         LuaGlobal::instance()->luaEngine()->PushUnit(pLooter);
@@ -1878,7 +2061,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[GAMEOBJECT_EVENT_ON_USE]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GAMEOBJECT_EVENT_ON_USE]);
         LuaGlobal::instance()->luaEngine()->PushGo(_gameobject);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(GAMEOBJECT_EVENT_ON_USE);
         LuaGlobal::instance()->luaEngine()->PushUnit(pPlayer);
@@ -1891,7 +2074,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[GAMEOBJECT_EVENT_AIUPDATE]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GAMEOBJECT_EVENT_AIUPDATE]);
         LuaGlobal::instance()->luaEngine()->PushGo(_gameobject);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(1);
 
@@ -1902,7 +2085,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK;
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[GAMEOBJECT_EVENT_ON_DAMAGED]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GAMEOBJECT_EVENT_ON_DAMAGED]);
         LuaGlobal::instance()->luaEngine()->PushGo(_gameobject);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(damage);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(2);
@@ -1914,7 +2097,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK;
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[GAMEOBJECT_EVENT_ON_DESTROYED]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GAMEOBJECT_EVENT_ON_DESTROYED]);
         LuaGlobal::instance()->luaEngine()->PushGo(_gameobject);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(1);
 
@@ -1923,20 +2106,6 @@ public:
 
     void Destroy()
     {
-        typedef std::multimap<uint32_t, LuaGameObjectScript*> GMAP;
-        GMAP& gMap = LuaGlobal::instance()->luaEngine()->getLuGameObjectMap();
-        auto itr = gMap.find(_gameobject->getEntry());
-        auto itend = gMap.upper_bound(_gameobject->getEntry());
-        GMAP::iterator it;
-
-        //uint64_t guid = _gameobject->getGuid(); Unused?
-        for (; itr != itend;)
-        {
-            it = itr++;
-            if (it->second != nullptr && it->second == this)
-                gMap.erase(it);
-        }
-
         std::map< uint64_t, std::set<int> >& objRefs = LuaGlobal::instance()->luaEngine()->getObjectFunctionRefs();
         auto itr2 = objRefs.find(_gameobject->getGuid());
         if (itr2 != objRefs.end())
@@ -1949,55 +2118,14 @@ public:
         }
         delete this;
     }
-    LuaObjectBinding* m_binding;
 };
 
 class LuaGossip : public GossipScript
 {
 public:
 
-    LuaGossip() : GossipScript(), m_unit_gossip_binding(nullptr), m_item_gossip_binding(nullptr), m_go_gossip_binding(nullptr) {}
-    ~LuaGossip()
-    {
-        typedef std::unordered_map<uint32_t, LuaGossip*> MapType;
-        MapType gMap;
-        if (this->m_go_gossip_binding != nullptr)
-        {
-            gMap = LuaGlobal::instance()->luaEngine()->getGameObjectGossipInterfaceMap();
-            for (auto itr = gMap.begin(); itr != gMap.end(); ++itr)
-            {
-                if (itr->second == this)
-                {
-                    gMap.erase(itr);
-                    break;
-                }
-            }
-        }
-        else if (this->m_unit_gossip_binding != nullptr)
-        {
-            gMap = LuaGlobal::instance()->luaEngine()->getUnitGossipInterfaceMap();
-            for (auto itr = gMap.begin(); itr != gMap.end(); ++itr)
-            {
-                if (itr->second == this)
-                {
-                    gMap.erase(itr);
-                    break;
-                }
-            }
-        }
-        else if (this->m_item_gossip_binding != nullptr)
-        {
-            gMap = LuaGlobal::instance()->luaEngine()->getItemGossipInterfaceMap();
-            for (auto itr = gMap.begin(); itr != gMap.end(); ++itr)
-            {
-                if (itr->second == this)
-                {
-                    gMap.erase(itr);
-                    break;
-                }
-            }
-        }
-    }
+    LuaGossip() : GossipScript() {}
+    ~LuaGossip() {}
 
     void onHello(Object* pObject, Player* plr) override
     {
@@ -2005,13 +2133,14 @@ public:
 
         if (pObject->isCreature())
         {
-            if (m_unit_gossip_binding == nullptr)
+            LuaObjectBinding* binding = LuaGlobal::instance()->luaEngine()->getLuaUnitGossipBinding(pObject->getEntry());
+            if (binding == nullptr)
             {
                 RELEASE_LOCK;
                 return;
             }
 
-            LuaGlobal::instance()->luaEngine()->BeginCall(m_unit_gossip_binding->m_functionReferences[GOSSIP_EVENT_ON_TALK]);
+            LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GOSSIP_EVENT_ON_TALK]);
             LuaGlobal::instance()->luaEngine()->PushUnit(pObject);
             LuaGlobal::instance()->luaEngine()->PUSH_UINT(GOSSIP_EVENT_ON_TALK);
             LuaGlobal::instance()->luaEngine()->PushUnit(plr);
@@ -2019,13 +2148,14 @@ public:
         }
         else if (pObject->isItem())
         {
-            if (m_item_gossip_binding == nullptr)
+            LuaObjectBinding* binding = LuaGlobal::instance()->luaEngine()->getLuaItemGossipBinding(pObject->getEntry());
+            if (binding == nullptr)
             {
                 RELEASE_LOCK;
                 return;
             }
 
-            LuaGlobal::instance()->luaEngine()->BeginCall(m_item_gossip_binding->m_functionReferences[GOSSIP_EVENT_ON_TALK]);
+            LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GOSSIP_EVENT_ON_TALK]);
             LuaGlobal::instance()->luaEngine()->PushItem(pObject);
             LuaGlobal::instance()->luaEngine()->PUSH_UINT(GOSSIP_EVENT_ON_TALK);
             LuaGlobal::instance()->luaEngine()->PushUnit(plr);
@@ -2033,13 +2163,14 @@ public:
         }
         else if (pObject->isGameObject())
         {
-            if (m_go_gossip_binding == nullptr)
+            LuaObjectBinding* binding = LuaGlobal::instance()->luaEngine()->getLuaGOGossipBinding(pObject->getEntry());
+            if (binding == nullptr)
             {
                 RELEASE_LOCK;
                 return;
             }
 
-            LuaGlobal::instance()->luaEngine()->BeginCall(m_go_gossip_binding->m_functionReferences[GOSSIP_EVENT_ON_TALK]);
+            LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GOSSIP_EVENT_ON_TALK]);
             LuaGlobal::instance()->luaEngine()->PushGo(pObject);
             LuaGlobal::instance()->luaEngine()->PUSH_UINT(GOSSIP_EVENT_ON_TALK);
             LuaGlobal::instance()->luaEngine()->PushUnit(plr);
@@ -2055,13 +2186,14 @@ public:
 
         if (pObject->isCreature())
         {
-            if (m_unit_gossip_binding == nullptr)
+            LuaObjectBinding* binding = LuaGlobal::instance()->luaEngine()->getLuaUnitGossipBinding(pObject->getEntry());
+            if (binding == nullptr)
             {
                 RELEASE_LOCK;
                 return;
             }
 
-            LuaGlobal::instance()->luaEngine()->BeginCall(m_unit_gossip_binding->m_functionReferences[GOSSIP_EVENT_ON_SELECT_OPTION]);
+            LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GOSSIP_EVENT_ON_SELECT_OPTION]);
             LuaGlobal::instance()->luaEngine()->PushUnit(pObject);
             LuaGlobal::instance()->luaEngine()->PUSH_UINT(GOSSIP_EVENT_ON_SELECT_OPTION);
             LuaGlobal::instance()->luaEngine()->PushUnit(Plr);
@@ -2072,12 +2204,13 @@ public:
         }
         else if (pObject->isItem())
         {
-            if (m_item_gossip_binding == nullptr)
+            LuaObjectBinding* binding = LuaGlobal::instance()->luaEngine()->getLuaItemGossipBinding(pObject->getEntry());
+            if (binding == nullptr)
             {
                 RELEASE_LOCK;
                 return;
             }
-            LuaGlobal::instance()->luaEngine()->BeginCall(m_item_gossip_binding->m_functionReferences[GOSSIP_EVENT_ON_SELECT_OPTION]);
+            LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GOSSIP_EVENT_ON_SELECT_OPTION]);
             LuaGlobal::instance()->luaEngine()->PushItem(pObject);
             LuaGlobal::instance()->luaEngine()->PUSH_UINT(GOSSIP_EVENT_ON_SELECT_OPTION);
             LuaGlobal::instance()->luaEngine()->PushUnit(Plr);
@@ -2088,12 +2221,13 @@ public:
         }
         else if (pObject->isGameObject())
         {
-            if (m_go_gossip_binding == nullptr)
+            LuaObjectBinding* binding = LuaGlobal::instance()->luaEngine()->getLuaGOGossipBinding(pObject->getEntry());
+            if (binding == nullptr)
             {
                 RELEASE_LOCK;
                 return;
             }
-            LuaGlobal::instance()->luaEngine()->BeginCall(m_go_gossip_binding->m_functionReferences[GOSSIP_EVENT_ON_SELECT_OPTION]);
+            LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GOSSIP_EVENT_ON_SELECT_OPTION]);
             LuaGlobal::instance()->luaEngine()->PushGo(pObject);
             LuaGlobal::instance()->luaEngine()->PUSH_UINT(GOSSIP_EVENT_ON_SELECT_OPTION);
             LuaGlobal::instance()->luaEngine()->PushUnit(Plr);
@@ -2112,12 +2246,13 @@ public:
 
         if (pObject->isCreature())
         {
-            if (m_unit_gossip_binding == nullptr)
+            LuaObjectBinding* binding = LuaGlobal::instance()->luaEngine()->getLuaUnitGossipBinding(pObject->getEntry());
+            if (binding == nullptr)
             {
                 RELEASE_LOCK;
                 return;
             }
-            LuaGlobal::instance()->luaEngine()->BeginCall(m_unit_gossip_binding->m_functionReferences[GOSSIP_EVENT_ON_END]);
+            LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GOSSIP_EVENT_ON_END]);
             LuaGlobal::instance()->luaEngine()->PushUnit(pObject);
             LuaGlobal::instance()->luaEngine()->PUSH_UINT(GOSSIP_EVENT_ON_END);
             LuaGlobal::instance()->luaEngine()->PushUnit(Plr);
@@ -2125,12 +2260,13 @@ public:
         }
         else if (pObject->isItem())
         {
-            if (m_item_gossip_binding == nullptr)
+            LuaObjectBinding* binding = LuaGlobal::instance()->luaEngine()->getLuaItemGossipBinding(pObject->getEntry());
+            if (binding == nullptr)
             {
                 RELEASE_LOCK;
                 return;
             }
-            LuaGlobal::instance()->luaEngine()->BeginCall(m_item_gossip_binding->m_functionReferences[GOSSIP_EVENT_ON_END]);
+            LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GOSSIP_EVENT_ON_END]);
             LuaGlobal::instance()->luaEngine()->PushItem(pObject);
             LuaGlobal::instance()->luaEngine()->PUSH_UINT(GOSSIP_EVENT_ON_END);
             LuaGlobal::instance()->luaEngine()->PushUnit(Plr);
@@ -2138,12 +2274,13 @@ public:
         }
         else if (pObject->isGameObject())
         {
-            if (m_go_gossip_binding == nullptr)
+            LuaObjectBinding* binding = LuaGlobal::instance()->luaEngine()->getLuaGOGossipBinding(pObject->getEntry());
+            if (binding == nullptr)
             {
                 RELEASE_LOCK;
                 return;
             }
-            LuaGlobal::instance()->luaEngine()->BeginCall(m_go_gossip_binding->m_functionReferences[GOSSIP_EVENT_ON_END]);
+            LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[GOSSIP_EVENT_ON_END]);
             LuaGlobal::instance()->luaEngine()->PushGo(pObject);
             LuaGlobal::instance()->luaEngine()->PUSH_UINT(GOSSIP_EVENT_ON_END);
             LuaGlobal::instance()->luaEngine()->PushUnit(Plr);
@@ -2152,40 +2289,25 @@ public:
 
         RELEASE_LOCK
     }
-
-    LuaObjectBinding* m_unit_gossip_binding;
-    LuaObjectBinding* m_item_gossip_binding;
-    LuaObjectBinding* m_go_gossip_binding;
 };
 
 class LuaQuest : public QuestScript
 {
 public:
 
-    LuaQuest() : QuestScript()
-    {
-        m_binding = nullptr;
-    }
+    explicit LuaQuest(uint32_t questId) : QuestScript(), m_questId(questId) {}
+    ~LuaQuest() {}
 
-    ~LuaQuest()
+    LuaObjectBinding* getBinding()
     {
-        typedef std::unordered_map<uint32_t, LuaQuest*> QuestType;
-        QuestType qMap = LuaGlobal::instance()->luaEngine()->getLuQuestMap();
-        for (auto itr = qMap.begin(); itr != qMap.end(); ++itr)
-        {
-            if (itr->second == this)
-            {
-                qMap.erase(itr);
-                break;
-            }
-        }
+        return LuaGlobal::instance()->luaEngine()->getQuestBinding(m_questId);
     }
 
     void OnQuestStart(Player* mTarget, QuestLogEntry* qLogEntry)
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[QUEST_EVENT_ON_ACCEPT]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[QUEST_EVENT_ON_ACCEPT]);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(qLogEntry->GetQuest()->id);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(2);
@@ -2197,7 +2319,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[QUEST_EVENT_ON_COMPLETE]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[QUEST_EVENT_ON_COMPLETE]);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(qLogEntry->GetQuest()->id);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(2);
@@ -2209,7 +2331,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[QUEST_EVENT_ON_CANCEL]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[QUEST_EVENT_ON_CANCEL]);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(1);
 
@@ -2220,7 +2342,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[QUEST_EVENT_GAMEOBJECT_ACTIVATE]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[QUEST_EVENT_GAMEOBJECT_ACTIVATE]);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(entry);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(qLogEntry->GetQuest()->id);
@@ -2233,7 +2355,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[QUEST_EVENT_ON_CREATURE_KILL]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[QUEST_EVENT_ON_CREATURE_KILL]);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(entry);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(qLogEntry->GetQuest()->id);
@@ -2246,7 +2368,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[QUEST_EVENT_ON_EXPLORE_AREA]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[QUEST_EVENT_ON_EXPLORE_AREA]);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(areaId);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(qLogEntry->GetQuest()->id);
@@ -2259,7 +2381,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[QUEST_EVENT_ON_PLAYER_ITEMPICKUP]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[QUEST_EVENT_ON_PLAYER_ITEMPICKUP]);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(itemId);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(totalCount);
         LuaGlobal::instance()->luaEngine()->PushUnit(mTarget);
@@ -2268,22 +2390,28 @@ public:
 
         RELEASE_LOCK
     }
-    LuaObjectBinding* m_binding;
+
+    uint32_t m_questId;
 };
 
 class LuaInstance : public InstanceScript
 {
 public:
 
-    explicit LuaInstance(MapMgr* pMapMgr) : InstanceScript(pMapMgr), m_instanceId(pMapMgr->GetInstanceID()), m_binding(nullptr) {}
+    explicit LuaInstance(MapMgr* pMapMgr) : InstanceScript(pMapMgr), m_instanceId(pMapMgr->GetInstanceID()), m_mapId(pMapMgr->GetMapId()) {}
     ~LuaInstance() {}
 
+    LuaObjectBinding* getBinding()
+    {
+        return LuaGlobal::instance()->luaEngine()->getInstanceBinding(m_mapId);
+    }
+
     // Player
     void OnPlayerDeath(Player* pVictim, Unit* pKiller)
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[INSTANCE_EVENT_ON_PLAYER_DEATH]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[INSTANCE_EVENT_ON_PLAYER_DEATH]);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(m_instanceId);
         LuaGlobal::instance()->luaEngine()->PushUnit(pVictim);
         LuaGlobal::instance()->luaEngine()->PushUnit(pKiller);
@@ -2296,7 +2424,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[INSTANCE_EVENT_ON_PLAYER_ENTER]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[INSTANCE_EVENT_ON_PLAYER_ENTER]);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(m_instanceId);
         LuaGlobal::instance()->luaEngine()->PushUnit(pPlayer);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(2);
@@ -2308,7 +2436,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[INSTANCE_EVENT_ON_AREA_TRIGGER]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[INSTANCE_EVENT_ON_AREA_TRIGGER]);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(m_instanceId);
         LuaGlobal::instance()->luaEngine()->PushUnit(pPlayer);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(uAreaId);
@@ -2321,7 +2449,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[INSTANCE_EVENT_ON_ZONE_CHANGE]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[INSTANCE_EVENT_ON_ZONE_CHANGE]);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(m_instanceId);
         LuaGlobal::instance()->luaEngine()->PushUnit(pPlayer);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(uNewZone);
@@ -2336,7 +2464,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[INSTANCE_EVENT_ON_CREATURE_DEATH]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[INSTANCE_EVENT_ON_CREATURE_DEATH]);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(m_instanceId);
         LuaGlobal::instance()->luaEngine()->PushUnit(pVictim);
         LuaGlobal::instance()->luaEngine()->PushUnit(pKiller);
@@ -2349,7 +2477,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[INSTANCE_EVENT_ON_CREATURE_PUSH]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[INSTANCE_EVENT_ON_CREATURE_PUSH]);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(m_instanceId);
         LuaGlobal::instance()->luaEngine()->PushUnit(pCreature);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(2);
@@ -2361,7 +2489,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[INSTANCE_EVENT_ON_GO_ACTIVATE]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[INSTANCE_EVENT_ON_GO_ACTIVATE]);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(m_instanceId);
         LuaGlobal::instance()->luaEngine()->PushGo(pGameObject);
         LuaGlobal::instance()->luaEngine()->PushUnit(pPlayer);
@@ -2374,7 +2502,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[INSTANCE_EVENT_ON_GO_PUSH]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[INSTANCE_EVENT_ON_GO_PUSH]);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(m_instanceId);
         LuaGlobal::instance()->luaEngine()->PushGo(pGameObject);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(2);
@@ -2387,7 +2515,7 @@ public:
     {
         CHECK_BINDING_ACQUIRELOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[INSTANCE_EVENT_ONLOAD]);
+        LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[INSTANCE_EVENT_ONLOAD]);
         LuaGlobal::instance()->luaEngine()->PUSH_UINT(m_instanceId);
         LuaGlobal::instance()->luaEngine()->ExecuteCall(1);
 
@@ -2396,68 +2524,41 @@ public:
 
     void Destroy()
     {
-        CHECK_BINDING_ACQUIRELOCK
+        GET_LOCK
 
-        LuaGlobal::instance()->luaEngine()->BeginCall(m_binding->m_functionReferences[INSTANCE_EVENT_DESTROY]);
-        LuaGlobal::instance()->luaEngine()->PUSH_UINT(m_instanceId);
-        LuaGlobal::instance()->luaEngine()->ExecuteCall(1);
+        LuaObjectBinding* binding = getBinding();
+        if (binding != nullptr)
+        {
+            LuaGlobal::instance()->luaEngine()->BeginCall(binding->m_functionReferences[INSTANCE_EVENT_DESTROY]);
+            LuaGlobal::instance()->luaEngine()->PUSH_UINT(m_instanceId);
+            LuaGlobal::instance()->luaEngine()->ExecuteCall(1);
+        }
 
         RELEASE_LOCK
 
-        typedef std::unordered_map<uint32_t, LuaInstance*> IMAP;
-        IMAP& iMap = LuaGlobal::instance()->luaEngine()->getLuInstanceMap();
-        for (auto itr = iMap.begin(); itr != iMap.end(); ++itr)
-        {
-            if (itr->second == this)
-            {
-                iMap.erase(itr);
-                break;
-            }
-        }
         delete this;
     }
 
     uint32_t m_instanceId;
-    LuaObjectBinding* m_binding;
+    uint32_t m_mapId;
 };
 
+// creature, gameobject and instance scripts only keep their entry, every hook looks up the binding
+// in the engine of the thread calling it. The quest and gossip scripts are shared by all engines.
 CreatureAIScript* CreateLuaCreature(Creature* src)
 {
-    LuaCreature* script = nullptr;
-    if (src != nullptr)
-    {
-        uint32_t id = src->getEntry();
-        LuaObjectBinding* pBinding = LuaGlobal::instance()->luaEngine()->getUnitBinding(id);
-        if (pBinding != nullptr)
-        {
-            typedef std::multimap<uint32_t, LuaCreature*> CRCMAP;
-            CRCMAP& cMap = LuaGlobal::instance()->luaEngine()->getLuCreatureMap();
-            script = new LuaCreature(src);
-            cMap.insert(std::make_pair(id, script));
-            script->m_binding = pBinding;
-        }
-    }
-    return script;
+    if (src == nullptr || LuaGlobal::instance()->luaEngine()->getUnitBinding(src->getEntry()) == nullptr)
+        return nullptr;
+
+    return new LuaCreature(src);
 }
 
 GameObjectAIScript* CreateLuaGameObjectScript(GameObject* src)
 {
-    LuaGameObjectScript* script = nullptr;
-    if (src != nullptr)
-    {
-        uint32_t id = src->GetGameObjectProperties()->entry;
-        LuaObjectBinding* pBinding = nullptr;
-        pBinding = LuaGlobal::instance()->luaEngine()->getGameObjectBinding(id);
-        if (pBinding != nullptr)
-        {
-            typedef std::multimap<uint32_t, LuaGameObjectScript*> GMAP;
-            GMAP& gMap = LuaGlobal::instance()->luaEngine()->getLuGameObjectMap();
-            script = new LuaGameObjectScript(src);
-            gMap.insert(std::make_pair(id, script));
-            script->m_binding = pBinding;
-        }
-    }
-    return script;
+    if (src == nullptr || LuaGlobal::instance()->luaEngine()->getGameObjectBinding(src->GetGameObjectProperties()->entry) == nullptr)
+        return nullptr;
+
+    return new LuaGameObjectScript(src);
 }
 
 QuestScript* CreateLuaQuestScript(uint32_t id)
@@ -2472,45 +2573,26 @@ QuestScript* CreateLuaQuestScript(uint32_t id)
         if (itr != qMap.end())
         {
             if (itr->second == nullptr)
-                pLua = itr->second = new LuaQuest();
+                pLua = itr->second = new LuaQuest(id);
             else
                 pLua = itr->second;
         }
         else
         {
-            pLua = new LuaQuest();
+            pLua = new LuaQuest(id);
             qMap.insert(std::make_pair(id, pLua));
         }
-        pLua->m_binding = pBinding;
     }
     return pLua;
 }
 
 InstanceScript* CreateLuaInstance(MapMgr* pMapMgr)
 {
-    LuaInstance* pLua = nullptr;
-    uint32_t id = pMapMgr->GetMapId();
-    LuaObjectBinding* pBinding = LuaGlobal::instance()->luaEngine()->getInstanceBinding(id);
-    if (pBinding != nullptr)
-    {
-        typedef std::unordered_map<uint32_t, LuaInstance*> IMAP;
-        IMAP& iMap = LuaGlobal::instance()->luaEngine()->getLuInstanceMap();
-        auto itr = iMap.find(id);
-        if (itr != iMap.end())
-        {
-            if (itr->second == nullptr)
-                pLua = itr->second = new LuaInstance(pMapMgr);
-            else
-                pLua = itr->second;
-        }
-        else
-        {
-            pLua = new LuaInstance(pMapMgr);
-            iMap.insert(std::make_pair(id, pLua));
-        }
-        pLua->m_binding = pBinding;
-    }
-    return pLua;
+    // every instance gets its own script, it is deleted with the instance
+    if (LuaGlobal::instance()->luaEngine()->getInstanceBinding(pMapMgr->GetMapId()) == nullptr)
+        return nullptr;
+
+    return new LuaInstance(pMapMgr);
 }
 
 GossipScript* CreateLuaUnitGossipScript(uint32_t id)
@@ -2534,7 +2616,6 @@ GossipScript* CreateLuaUnitGossipScript(uint32_t id)
             pLua = new LuaGossip();
             gMap.insert(std::make_pair(id, pLua));
         }
-        pLua->m_unit_gossip_binding = pBinding;
     }
     return pLua;
 }
@@ -2560,7 +2641,6 @@ GossipScript* CreateLuaItemGossipScript(uint32_t id)
             gMap.insert(std::make_pair(id, pLua));
 
         }
-        pLua->m_item_gossip_binding = pBinding;
     }
     return pLua;
 }
@@ -2586,75 +2666,92 @@ GossipScript* CreateLuaGOGossipScript(uint32_t id)
             pLua = new LuaGossip();
             gMap.insert(std::make_pair(id, pLua));
         }
-        pLua->m_go_gossip_binding = pBinding;
     }
     return pLua;
 }
 
 void LuaEngine::Startup()
 {
+    // the scripts register their bindings through luaEngine()
+    LuaEngineScope scope(this);
+
     DLLLogDetail("LuaEngineMgr : AscEmu Lua Engine ( ALE ) %s: Loaded", ARCH);
     //Create a new global state that will server as the lua universe.
     lu = luaL_newstate();
 
     LoadScripts();
+}
+
+void LuaEngine::registerScripts()
+{
+    LuaEngineScope scope(this);
 
     // stuff is registered, so lets go ahead and make our emulated C++ scripted lua classes.
+    // The maps remember which entries are registered already, a restart only adds the new ones.
     for (auto& itr : m_unitBinding)
     {
-        m_scriptMgr->register_creature_script(itr.first, CreateLuaCreature);
-        LuaGlobal::instance()->luaEngine()->getLuCreatureMap().insert(std::make_pair(itr.first, (LuaCreature*)nullptr));
+        if (m_cAIScripts.find(itr.first) == m_cAIScripts.end())
+        {
+            m_scriptMgr->register_creature_script(itr.first, CreateLuaCreature);
+            m_cAIScripts.insert(std::make_pair(itr.first, (LuaCreature*)nullptr));
+        }
     }
 
     for (auto& itr : m_gameobjectBinding)
     {
-        m_scriptMgr->register_gameobject_script(itr.first, CreateLuaGameObjectScript);
-        LuaGlobal::instance()->luaEngine()->getLuGameObjectMap().insert(std::make_pair(itr.first, (LuaGameObjectScript*)nullptr));
+        if (m_gAIScripts.find(itr.first) == m_gAIScripts.end())
+        {
+            m_scriptMgr->register_gameobject_script(itr.first, CreateLuaGameObjectScript);
+            m_gAIScripts.insert(std::make_pair(itr.first, (LuaGameObjectScript*)nullptr));
+        }
     }
 
     for (auto& itr : m_questBinding)
     {
-        QuestScript* qs = CreateLuaQuestScript(itr.first);
-        if (qs != nullptr)
+        if (m_qAIScripts.find(itr.first) == m_qAIScripts.end())
         {
-            m_scriptMgr->register_quest_script(itr.first, qs);
-            LuaGlobal::instance()->luaEngine()->getLuQuestMap().insert(std::make_pair(itr.first, (LuaQuest*)nullptr));
+            QuestScript* qs = CreateLuaQuestScript(itr.first);
+            if (qs != nullptr)
+                m_scriptMgr->register_quest_script(itr.first, qs);
         }
     }
 
     for (auto& itr : m_instanceBinding)
     {
-        m_scriptMgr->register_instance_script(itr.first, CreateLuaInstance);
-        LuaGlobal::instance()->luaEngine()->getLuInstanceMap().insert(std::make_pair(itr.first, (LuaInstance*)nullptr));
+        if (m_iAIScripts.find(itr.first) == m_iAIScripts.end())
+        {
+            m_scriptMgr->register_instance_script(itr.first, CreateLuaInstance);
+            m_iAIScripts.insert(std::make_pair(itr.first, (LuaInstance*)nullptr));
+        }
     }
 
     for (auto& itr : m_unit_gossipBinding)
     {
-        GossipScript* gs = CreateLuaUnitGossipScript(itr.first);
-        if (gs != nullptr)
+        if (m_unitgAIScripts.find(itr.first) == m_unitgAIScripts.end())
         {
-            m_scriptMgr->register_creature_gossip(itr.first, gs);
-            LuaGlobal::instance()->luaEngine()->getUnitGossipInterfaceMap().insert(std::make_pair(itr.first, (LuaGossip*)nullptr));
+            GossipScript* gs = CreateLuaUnitGossipScript(itr.first);
+            if (gs != nullptr)
+                m_scriptMgr->register_creature_gossip(itr.first, gs);
         }
     }
 
     for (auto& itr : m_item_gossipBinding)
     {
-        GossipScript* gs = CreateLuaItemGossipScript(itr.first);
-        if (gs != nullptr)
+        if (m_itemgAIScripts.find(itr.first) == m_itemgAIScripts.end())
         {
-            m_scriptMgr->register_item_gossip(itr.first, gs);
-            LuaGlobal::instance()->luaEngine()->getItemGossipInterfaceMap().insert(std::make_pair(itr.first, (LuaGossip*)nullptr));
+            GossipScript* gs = CreateLuaItemGossipScript(itr.first);
+            if (gs != nullptr)
+                m_scriptMgr->register_item_gossip(itr.first, gs);
         }
     }
 
     for (auto& itr : m_go_gossipBinding)
     {
-        GossipScript* gs = CreateLuaGOGossipScript(itr.first);
-        if (gs != nullptr)
+        if (m_gogAIScripts.find(itr.first) == m_gogAIScripts.end())
         {
-            m_scriptMgr->register_go_gossip(itr.first, gs);
-            LuaGlobal::instance()->luaEngine()->getGameObjectGossipInterfaceMap().insert(std::make_pair(itr.first, (LuaGossip*)nullptr));
+            GossipScript* gs = CreateLuaGOGossipScript(itr.first);
+            if (gs != nullptr)
+                m_scriptMgr->register_go_gossip(itr.first, gs);
         }
     }
 
@@ -2693,16 +2790,16 @@ void LuaEngine::Startup()
     RegisterHook(SERVER_HOOK_EVENT_ON_AURA_REMOVE, (void*)LuaHookOnAuraRemove)
     RegisterHook(SERVER_HOOK_EVENT_ON_RESURRECT, (void*)LuaHookOnResurrect)
 
-    for (const auto& dummySpell : LuaGlobal::instance()->m_luaDummySpells)
+    for (const auto& dummySpell : m_luaDummySpells)
     {
-        auto dummyHook = LuaGlobal::instance()->luaEngine()->HookInfo.dummyHooks;
-        if (std::find(dummyHook.begin(), dummyHook.end(), dummySpell.first) == dummyHook.end())
+        if (std::find(HookInfo.dummyHooks.begin(), HookInfo.dummyHooks.end(), dummySpell.first) == HookInfo.dummyHooks.end())
         {
             m_scriptMgr->register_dummy_spell(dummySpell.first, &LuaOnDummySpell);
-            LuaGlobal::instance()->luaEngine()->HookInfo.dummyHooks.push_back(dummySpell.first);
+            HookInfo.dummyHooks.push_back(dummySpell.first);
         }
     }
 }
+
 void LuaEngine::RegisterEvent(uint8_t regtype, uint32_t id, uint32_t evt, uint16_t functionRef)
 {
     switch (regtype)
@@ -2776,13 +2873,13 @@ void LuaEngine::RegisterEvent(uint8_t regtype, uint32_t id, uint32_t evt, uint16
         case REGTYPE_SERVHOOK:
         {
             if (evt < NUM_SERVER_HOOKS)
-                LuaGlobal::instance()->EventAsToFuncName[evt].push_back(functionRef);
+                EventAsToFuncName[evt].push_back(functionRef);
         }
         break;
         case REGTYPE_DUMMYSPELL:
         {
             if (id)
-                LuaGlobal::instance()->m_luaDummySpells.insert(std::pair<uint32_t, uint16_t>(id, functionRef));
+                m_luaDummySpells.insert(std::pair<uint32_t, uint16_t>(id, functionRef));
         }
         break;
         case REGTYPE_INSTANCE:
@@ -2940,7 +3037,7 @@ void LuaEngine::Unload()
     m_go_gossipBinding.clear();
 
     //Serv hooks : had forgotten these.
-    for (auto& next : LuaGlobal::instance()->EventAsToFuncName)
+    for (auto& next : EventAsToFuncName)
     {
         for (auto itr = next.begin(); itr != next.end(); ++itr)
             luaL_unref(lu, LUA_REGISTRYINDEX, (*itr));
@@ -2948,11 +3045,11 @@ void LuaEngine::Unload()
         next.clear();
     }
 
-    for (auto& m_luaDummySpell : LuaGlobal::instance()->m_luaDummySpells)
+    for (auto& m_luaDummySpell : m_luaDummySpells)
     {
         luaL_unref(lu, LUA_REGISTRYINDEX, m_luaDummySpell.second);
     }
-    LuaGlobal::instance()->m_luaDummySpells.clear();
+    m_luaDummySpells.clear();
 
     for (auto itr : m_pendingThreads)
     {
@@ -2964,233 +3061,31 @@ void LuaEngine::Unload()
     lua_close(lu);
 }
 
-void LuaEngine::Restart()
+void LuaEngine::Restart(bool isMasterEngine)
 {
-    DLLLogDetail("LuaEngineMgr : Restarting Engine.");
+    // may be called for the engine of another thread
+    LuaEngineScope scope(this);
+
+    DLLLogDetail("LuaEngineMgr : Restarting Engine %u.", m_engineId);
     GET_LOCK
     getcoLock().Acquire();
     Unload();
+    m_hookProfiles.clear();
     lu = luaL_newstate();
     LoadScripts();
-    for (auto& itr : m_unitBinding)
-    {
-        typedef std::multimap<uint32_t, LuaCreature*> CMAP;
-        CMAP& cMap = LuaGlobal::instance()->luaEngine()->getLuCreatureMap();
-        auto it = cMap.find(itr.first);
-        auto itend = cMap.upper_bound(itr.first);
-        if (it == cMap.end())
-        {
-            m_scriptMgr->register_creature_script(itr.first, CreateLuaCreature);
-            cMap.insert(std::make_pair(itr.first, (LuaCreature*)nullptr));
-        }
-        else
-        {
-            for (; it != itend; ++it)
-                if (it->second != nullptr)
-                    it->second->m_binding = &itr.second;
-        }
-    }
 
-    for (auto& itr : m_gameobjectBinding)
-    {
-        typedef std::multimap<uint32_t, LuaGameObjectScript*> GMAP;
-        GMAP& gMap = LuaGlobal::instance()->luaEngine()->getLuGameObjectMap();
-        auto it = gMap.find(itr.first);
-        auto itend = gMap.upper_bound(itr.first);
-        if (it == gMap.end())
-        {
-            m_scriptMgr->register_gameobject_script(itr.first, CreateLuaGameObjectScript);
-            gMap.insert(std::make_pair(itr.first, (LuaGameObjectScript*)nullptr));
-        }
-        else
-        {
-            for (; it != itend; ++it)
-                if (it->second != nullptr)
-                    it->second->m_binding = &itr.second;
-        }
-    }
+    if (isMasterEngine)
+        registerScripts();
 
-    for (auto& itr : m_questBinding)
-    {
-        typedef std::unordered_map<uint32_t, LuaQuest*> QMAP;
-        QMAP& qMap = LuaGlobal::instance()->luaEngine()->getLuQuestMap();
-        auto it = qMap.find(itr.first);
-        if (it == qMap.end())
-        {
-            m_scriptMgr->register_quest_script(itr.first, CreateLuaQuestScript(itr.first));
-            qMap.insert(std::make_pair(itr.first, (LuaQuest*)nullptr));
-        }
-        else
-        {
-            LuaQuest* q_interface = it->second;
-            if (q_interface != nullptr)
-                q_interface->m_binding = &itr.second;
-        }
-    }
-
-    for (auto& itr : m_instanceBinding)
-    {
-        typedef std::unordered_map<uint32_t, LuaInstance*> IMAP;
-        IMAP& iMap = LuaGlobal::instance()->luaEngine()->getLuInstanceMap();
-        auto it = iMap.find(itr.first);
-        if (it == iMap.end())
-        {
-            m_scriptMgr->register_instance_script(itr.first, CreateLuaInstance);
-            iMap.insert(std::make_pair(itr.first, (LuaInstance*)nullptr));
-        }
-        else
-        {
-            if (it->second != nullptr)
-                it->second->m_binding = &itr.second;
-        }
-    }
-
-    for (auto itr = this->m_unit_gossipBinding.begin(); itr != m_unit_gossipBinding.end(); ++itr)
-    {
-        typedef std::unordered_map<uint32_t, LuaGossip*> GMAP;
-        GMAP& gMap = LuaGlobal::instance()->luaEngine()->getUnitGossipInterfaceMap();
-        auto it = gMap.find(itr->first);
-        if (it == gMap.end())
-        {
-            GossipScript* gs = CreateLuaUnitGossipScript(itr->first);
-            if (gs != nullptr)
-            {
-                m_scriptMgr->register_creature_gossip(itr->first, gs);
-                gMap.insert(std::make_pair(itr->first, (LuaGossip*)nullptr));
-            }
-        }
-        else
-        {
-            LuaGossip* u_gossip = it->second;
-            if (u_gossip != nullptr)
-                u_gossip->m_unit_gossip_binding = &itr->second;
-        }
-    }
-
-    for (auto itr = this->m_item_gossipBinding.begin(); itr != m_item_gossipBinding.end(); ++itr)
-    {
-        typedef std::unordered_map<uint32_t, LuaGossip*> GMAP;
-        GMAP& gMap = LuaGlobal::instance()->luaEngine()->getItemGossipInterfaceMap();
-        auto it = gMap.find(itr->first);
-        if (it == gMap.end())
-        {
-            GossipScript* gs = CreateLuaItemGossipScript(itr->first);
-            if (gs != nullptr)
-            {
-                m_scriptMgr->register_item_gossip(itr->first, gs);
-                gMap.insert(std::make_pair(itr->first, (LuaGossip*)nullptr));
-            }
-        }
-        else
-        {
-            LuaGossip* i_gossip = it->second;
-            if (i_gossip != nullptr)
-                i_gossip->m_item_gossip_binding = &itr->second;
-        }
-    }
-
-    for (auto itr = this->m_go_gossipBinding.begin(); itr != m_go_gossipBinding.end(); ++itr)
-    {
-        typedef std::unordered_map<uint32_t, LuaGossip*> GMAP;
-        GMAP& gMap = LuaGlobal::instance()->luaEngine()->getGameObjectGossipInterfaceMap();
-        auto it = gMap.find(itr->first);
-        if (it == gMap.end())
-        {
-            GossipScript* gs = CreateLuaGOGossipScript(itr->first);
-            if (gs != nullptr)
-            {
-                m_scriptMgr->register_go_gossip(itr->first, gs);
-                gMap.insert(std::make_pair(itr->first, (LuaGossip*)nullptr));
-            }
-        }
-        else
-        {
-            LuaGossip* g_gossip = it->second;
-            if (g_gossip != nullptr)
-                g_gossip->m_go_gossip_binding = &itr->second;
-        }
-    }
-
-    /*
-    BIG SERV HOOK CHUNK EEK
-    */
-    RegisterHook(SERVER_HOOK_EVENT_ON_NEW_CHARACTER, (void*)LuaHookOnNewCharacter)
-    RegisterHook(SERVER_HOOK_EVENT_ON_KILL_PLAYER, (void*)LuaHookOnKillPlayer)
-    RegisterHook(SERVER_HOOK_EVENT_ON_FIRST_ENTER_WORLD, (void*)LuaHookOnFirstEnterWorld)
-    RegisterHook(SERVER_HOOK_EVENT_ON_ENTER_WORLD, (void*)LuaHookOnEnterWorld)
-    RegisterHook(SERVER_HOOK_EVENT_ON_GUILD_JOIN, (void*)LuaHookOnGuildJoin)
-    RegisterHook(SERVER_HOOK_EVENT_ON_DEATH, (void*)LuaHookOnDeath)
-    RegisterHook(SERVER_HOOK_EVENT_ON_REPOP, (void*)LuaHookOnRepop)
-    RegisterHook(SERVER_HOOK_EVENT_ON_EMOTE, (void*)LuaHookOnEmote)
-    RegisterHook(SERVER_HOOK_EVENT_ON_ENTER_COMBAT, (void*)LuaHookOnEnterCombat)
-    RegisterHook(SERVER_HOOK_EVENT_ON_CAST_SPELL, (void*)LuaHookOnCastSpell)
-    RegisterHook(SERVER_HOOK_EVENT_ON_TICK, (void*)LuaHookOnTick)
-    RegisterHook(SERVER_HOOK_EVENT_ON_LOGOUT_REQUEST, (void*)LuaHookOnLogoutRequest)
-    RegisterHook(SERVER_HOOK_EVENT_ON_LOGOUT, (void*)LuaHookOnLogout)
-    RegisterHook(SERVER_HOOK_EVENT_ON_QUEST_ACCEPT, (void*)LuaHookOnQuestAccept)
-    RegisterHook(SERVER_HOOK_EVENT_ON_ZONE, (void*)LuaHookOnZone)
-    RegisterHook(SERVER_HOOK_EVENT_ON_CHAT, (void*)LuaHookOnChat)
-    RegisterHook(SERVER_HOOK_EVENT_ON_LOOT, (void*)LuaHookOnLoot)
-    RegisterHook(SERVER_HOOK_EVENT_ON_GUILD_CREATE, (void*)LuaHookOnGuildCreate)
-    RegisterHook(SERVER_HOOK_EVENT_ON_FULL_LOGIN, (void*)LuaHookOnEnterWorld2)
-    RegisterHook(SERVER_HOOK_EVENT_ON_CHARACTER_CREATE, (void*)LuaHookOnCharacterCreate)
-    RegisterHook(SERVER_HOOK_EVENT_ON_QUEST_CANCELLED, (void*)LuaHookOnQuestCancelled)
-    RegisterHook(SERVER_HOOK_EVENT_ON_QUEST_FINISHED, (void*)LuaHookOnQuestFinished)
-    RegisterHook(SERVER_HOOK_EVENT_ON_HONORABLE_KILL, (void*)LuaHookOnHonorableKill)
-    RegisterHook(SERVER_HOOK_EVENT_ON_ARENA_FINISH, (void*)LuaHookOnArenaFinish)
-    RegisterHook(SERVER_HOOK_EVENT_ON_OBJECTLOOT, (void*)LuaHookOnObjectLoot)
-    RegisterHook(SERVER_HOOK_EVENT_ON_AREATRIGGER, (void*)LuaHookOnAreaTrigger)
-    RegisterHook(SERVER_HOOK_EVENT_ON_POST_LEVELUP, (void*)LuaHookOnPostLevelUp)
-    RegisterHook(SERVER_HOOK_EVENT_ON_PRE_DIE, (void*)LuaHookOnPreUnitDie)
-    RegisterHook(SERVER_HOOK_EVENT_ON_ADVANCE_SKILLLINE, (void*)LuaHookOnAdvanceSkillLine)
-    RegisterHook(SERVER_HOOK_EVENT_ON_DUEL_FINISHED, (void*)LuaHookOnDuelFinished)
-    RegisterHook(SERVER_HOOK_EVENT_ON_AURA_REMOVE, (void*)LuaHookOnAuraRemove)
-    RegisterHook(SERVER_HOOK_EVENT_ON_RESURRECT, (void*)LuaHookOnResurrect)
-
-    for (const auto& dummySpell : LuaGlobal::instance()->m_luaDummySpells)
-    {
-        auto dummyHook = LuaGlobal::instance()->luaEngine()->HookInfo.dummyHooks;
-        if (std::find(dummyHook.begin(), dummyHook.end(), dummySpell.first) == dummyHook.end())
-        {
-            m_scriptMgr->register_dummy_spell(dummySpell.first, &LuaOnDummySpell);
-            LuaGlobal::instance()->luaEngine()->HookInfo.dummyHooks.push_back(dummySpell.first);
-        }
-    }
     RELEASE_LOCK
     getcoLock().Release();
 
-    //hyper: do OnSpawns for spawned creatures.
-    std::vector<uint32_t> temp = LuaGlobal::instance()->m_onLoadInfo;
-    LuaGlobal::instance()->m_onLoadInfo.clear();
-    for (auto itr = temp.begin(); itr != temp.end(); itr += 3)
-    {
-        //*itr = mapid; *(itr+1) = iid; *(itr+2) = lowguid
-        MapMgr* mgr = nullptr;
-        if (*(itr + 1) == 0) //no instance
-        {
-            mgr = sInstanceMgr.GetMapMgr(*itr);
-        }
-        else
-        {
-            Instance* inst = sInstanceMgr.GetInstanceByIds(*itr, *(itr + 1));
-            if (inst != nullptr)
-                mgr = inst->m_mapMgr;
-        }
-
-        if (mgr != nullptr)
-        {
-            Creature* unit = mgr->GetCreature(*(itr + 2));
-            if (unit != nullptr && unit->IsInWorld() && unit->GetScript() != nullptr)
-                unit->GetScript()->OnLoad();
-        }
-    }
-    temp.clear();
-
-    DLLLogDetail("LuaEngineMgr : Done restarting engine.");
+    DLLLogDetail("LuaEngineMgr : Done restarting engine %u.", m_engineId);
 }
 
 void LuaEngine::ResumeLuaThread(int ref)
 {
+    LuaEngineScope scope(this);
     getcoLock().Acquire();
     lua_State* expectedThread = nullptr;
     lua_rawgeti(lu, LUA_REGISTRYINDEX, ref);
@@ -9,6 +9,7 @@ This file is released under the MIT license. See README-MIT for more information
 #include <Server/EventMgr.h>
 #include <Server/Script/ScriptMgr.h>
 
+#include <chrono>
 #include <set>
 #include "LuaMacros.h"
 #include "LuaGlobal.h"
@@ -38,8 +39,8 @@ class LuaGossip;
 class ArcLuna;
 
 #define RegisterHook(evt, _func) { \
-    if(LuaGlobal::instance()->EventAsToFuncName[(evt)].size() > 0 && !(LuaGlobal::instance()->luaEngine()->HookInfo.hooks[(evt)])) { \
-        LuaGlobal::instance()->luaEngine()->HookInfo.hooks[(evt)] = true; \
+    if(EventAsToFuncName[(evt)].size() > 0 && !(HookInfo.hooks[(evt)])) { \
+        HookInfo.hooks[(evt)] = true; \
         m_scriptMgr->register_hook( (ServerHookEvents)(evt), (_func) ); } }
 
 enum QuestEvents
@@ -216,13 +217,34 @@ class LuaEngine
     LuaObjectBindingMap m_item_gossipBinding;
     LuaObjectBindingMap m_go_gossipBinding;
 
+    // calls and time of every Lua function called by this engine, reset on restart
+    struct HookProfile
+    {
+        uint64_t calls = 0;
+        uint64_t totalMicroseconds = 0;
+        uint64_t maxMicroseconds = 0;
+        // set for timed events, the other functions are looked up in the registry when the profile is logged
+        std::string name;
+    };
+
+    std::unordered_map<int, HookProfile> m_hookProfiles;
+    int m_currentReference;
+    uint32_t m_engineId;
+
+    void addProfile(int reference, std::chrono::steady_clock::time_point startTime);
+
 public:
 
     LuaEngine();
     ~LuaEngine(){}
     void Startup();
     void LoadScripts();
-    void Restart();
+    void Restart(bool registerScripts);
+
+    // only called for the master engine, the ScriptMgr needs every script and hook once
+    void registerScripts();
+
+    void logProfile();
 
     void RegisterEvent(uint8_t, uint32_t, uint32_t, uint16_t);
     void ResumeLuaThread(int);
@@ -433,6 +455,10 @@ public:
 
     std::unordered_map<int, EventInfoHolder*> m_registeredTimedEvents;
 
+    std::vector<uint16_t> EventAsToFuncName[NUM_SERVER_HOOKS];
+    std::map<uint32_t, uint16_t> m_luaDummySpells;
+    GossipMenu* m_menu;
+
     struct _ENGINEHOOKINFO
     {
         bool hooks[NUM_SERVER_HOOKS];
@@ -6,9 +6,29 @@ This file is released under the MIT license. See README-MIT for more information
 #include "LuaGlobal.h"
 #include "LUAEngine.h"
 
+namespace
+{
+    // set by LuaEngineScope, wins over the engine of the thread
+    thread_local LuaEngine* t_scopedEngine = nullptr;
+
+    // engine owned by this thread, handed back when the thread ends
+    struct ThreadEngine
+    {
+        LuaEngine* engine = nullptr;
+
+        ~ThreadEngine()
+        {
+            if (engine != nullptr)
+                LuaGlobal::instance()->releaseEngine(engine);
+        }
+    };
+
+    thread_local ThreadEngine t_threadEngine;
+}
+
 std::unique_ptr<LuaGlobal> LuaGlobal::s_instance;
 
-LuaGlobal::LuaGlobal(): m_menu(nullptr)
+LuaGlobal::LuaGlobal(): m_masterEngine(nullptr)
 {
 }
 
@@ -22,12 +42,154 @@ std::unique_ptr<LuaGlobal>& LuaGlobal::instance()
     return s_instance;
 }
 
-std::unique_ptr<LuaEngine>& LuaGlobal::luaEngine()
+LuaEngine* LuaGlobal::luaEngine()
+{
+    if (t_scopedEngine != nullptr)
+        return t_scopedEngine;
+
+    if (t_threadEngine.engine == nullptr)
+        t_threadEngine.engine = acquireEngine();
+
+    return t_threadEngine.engine;
+}
+
+void LuaGlobal::startup()
+{
+    auto engine = std::make_unique<LuaEngine>();
+    m_masterEngine = engine.get();
+
+    m_masterEngine->Startup();
+    m_masterEngine->registerScripts();
+
+    {
+        std::lock_guard<std::mutex> guard(m_enginesMutex);
+        m_engines.push_back(std::move(engine));
+    }
+
+    if (t_threadEngine.engine == nullptr)
+        t_threadEngine.engine = m_masterEngine;
+    else
+        releaseEngine(m_masterEngine);
+}
+
+void LuaGlobal::restart()
+{
+    std::vector<LuaEngine*> engines;
+    {
+        std::lock_guard<std::mutex> guard(m_enginesMutex);
+        for (const auto& engine : m_engines)
+            engines.push_back(engine.get());
+    }
+
+    // every engine is locked while it reloads, the others keep running
+    for (auto engine : engines)
+        engine->Restart(engine == m_masterEngine);
+
+    DLLLogDetail("LuaEngineMgr : Restarted %u Lua engines.", static_cast<uint32_t>(engines.size()));
+}
+
+LuaEngine* LuaGlobal::acquireEngine()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_enginesMutex);
+        if (!m_freeEngines.empty())
+        {
+            LuaEngine* engine = m_freeEngines.back();
+            m_freeEngines.pop_back();
+            return engine;
+        }
+    }
+
+    // loading the scripts takes a while, the other threads must not wait for it
+    auto engine = std::make_unique<LuaEngine>();
+    engine->Startup();
+
+    std::lock_guard<std::mutex> guard(m_enginesMutex);
+    m_engines.push_back(std::move(engine));
+    DLLLogDetail("LuaEngineMgr : Started Lua engine %u for a new thread.", static_cast<uint32_t>(m_engines.size()));
+
+    return m_engines.back().get();
+}
+
+void LuaGlobal::releaseEngine(LuaEngine* engine)
+{
+    // timed events of the engine are still executed by the world thread, so the engine stays alive
+    std::lock_guard<std::mutex> guard(m_enginesMutex);
+    m_freeEngines.push_back(engine);
+}
+
+void LuaGlobal::addOnLoadInfo(uint32_t mapId, uint32_t instanceId, uint32_t lowGuid)
+{
+    std::lock_guard<std::mutex> guard(m_onLoadInfoMutex);
+    m_onLoadInfo.push_back(mapId);
+    m_onLoadInfo.push_back(instanceId);
+    m_onLoadInfo.push_back(lowGuid);
+}
+
+std::vector<uint32_t> LuaGlobal::takeOnLoadInfo()
+{
+    std::lock_guard<std::mutex> guard(m_onLoadInfoMutex);
+    std::vector<uint32_t> onLoadInfo;
+    onLoadInfo.swap(m_onLoadInfo);
+    return onLoadInfo;
+}
+
+void LuaGlobal::setSharedValue(std::string const& key, LuaSharedValue const& value)
+{
+    std::lock_guard<std::mutex> guard(m_sharedValuesMutex);
+    m_sharedValues[key] = value;
+}
+
+void LuaGlobal::removeSharedValue(std::string const& key)
+{
+    std::lock_guard<std::mutex> guard(m_sharedValuesMutex);
+    m_sharedValues.erase(key);
+}
+
+bool LuaGlobal::getSharedValue(std::string const& key, LuaSharedValue& value)
 {
-    if (!s_luaEngine)
+    std::lock_guard<std::mutex> guard(m_sharedValuesMutex);
+    const auto itr = m_sharedValues.find(key);
+    if (itr == m_sharedValues.end())
+        return false;
+
+    value = itr->second;
+    return true;
+}
+
+double LuaGlobal::addSharedNumber(std::string const& key, double amount)
+{
+    std::lock_guard<std::mutex> guard(m_sharedValuesMutex);
+    LuaSharedValue& value = m_sharedValues[key];
+    if (value.type != LuaSharedValue::TYPE_NUMBER)
+    {
+        value = LuaSharedValue();
+        value.type = LuaSharedValue::TYPE_NUMBER;
+    }
+
+    value.number += amount;
+    return value.number;
+}
+
+void LuaGlobal::logProfiles()
+{
+    std::vector<LuaEngine*> engines;
     {
-        s_luaEngine = std::make_unique<LuaEngine>();
+        std::lock_guard<std::mutex> guard(m_enginesMutex);
+        for (const auto& engine : m_engines)
+            engines.push_back(engine.get());
     }
 
-    return s_luaEngine;
+    for (auto engine : engines)
+        engine->logProfile();
+}
+
+LuaEngineScope::LuaEngineScope(LuaEngine* engine) : m_previousEngine(t_scopedEngine)
+{
+    t_scopedEngine = engine;
+}
+
+LuaEngineScope::~LuaEngineScope()
+{
+    t_scopedEngine = m_previousEngine;
 }
@@ -6,6 +6,10 @@ This file is released under the MIT license. See README-MIT for more information
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <Management/Gossip/GossipScript.h>
 #include <Server/Script/ScriptMgr.h>
 #include "WoWGuid.h"
@@ -13,19 +17,82 @@ This file is released under the MIT license. See README-MIT for more information
 
 class LuaEngine;
 
+// value stored with SetSharedValue, the only data Lua scripts can share between the engines
+struct LuaSharedValue
+{
+    enum Type
+    {
+        TYPE_BOOL,
+        TYPE_NUMBER,
+        TYPE_STRING
+    };
+
+    Type type = TYPE_NUMBER;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+};
+
+// Every thread calling into Lua (map threads, the world thread...) runs its own engine with all scripts loaded,
+// so hooks of different maps never wait for each other. The first engine is the master engine, it registers
+// the script factories and server hooks with the ScriptMgr once. Engines of finished threads are reused.
 class LuaGlobal
 {
     static std::unique_ptr<LuaGlobal> s_instance;
     LuaGlobal();
 
-    std::unique_ptr<LuaEngine> s_luaEngine;
+    std::mutex m_enginesMutex;
+    std::vector<std::unique_ptr<LuaEngine>> m_engines;
+    std::vector<LuaEngine*> m_freeEngines;
+    LuaEngine* m_masterEngine;
+
+    std::mutex m_onLoadInfoMutex;
+    std::vector<uint32_t> m_onLoadInfo;
+
+    std::mutex m_sharedValuesMutex;
+    std::unordered_map<std::string, LuaSharedValue> m_sharedValues;
+
 public:
     static std::unique_ptr<LuaGlobal>& instance();
 
-    GossipMenu* m_menu;
-    std::vector<uint32_t> m_onLoadInfo;
-    std::vector<uint16_t> EventAsToFuncName[NUM_SERVER_HOOKS];
-    std::map<uint32_t, uint16_t> m_luaDummySpells;
+    // engine of the calling thread, created on the first call
+    LuaEngine* luaEngine();
+
+    // creates the master engine for the calling thread and registers the scripts
+    void startup();
+    // reloads the scripts of every engine
+    void restart();
+
+    // hands the engine of a finished thread back for the next new thread
+    void releaseEngine(LuaEngine* engine);
+
+    // creatures with an OnLoad hook, OnLoad is called again after a restart
+    void addOnLoadInfo(uint32_t mapId, uint32_t instanceId, uint32_t lowGuid);
+    std::vector<uint32_t> takeOnLoadInfo();
+
+    void setSharedValue(std::string const& key, LuaSharedValue const& value);
+    void removeSharedValue(std::string const& key);
+    bool getSharedValue(std::string const& key, LuaSharedValue& value);
+    double addSharedNumber(std::string const& key, double amount);
+
+    // logs the hook profile of all engines
+    void logProfiles();
+
+private:
+    LuaEngine* acquireEngine();
+};
+
+// Makes luaEngine() return the given engine on this thread until the scope ends.
+// Used when a thread runs code of an engine it does not own, e.g. timed events on the world thread or a restart.
+class LuaEngineScope
+{
+public:
+    explicit LuaEngineScope(LuaEngine* engine);
+    ~LuaEngineScope();
+
+    LuaEngineScope(LuaEngineScope const&) = delete;
+    LuaEngineScope& operator=(LuaEngineScope const&) = delete;
 
-    std::unique_ptr<LuaEngine>& luaEngine();
+private:
+    LuaEngine* m_previousEngine;
 };
@@ -67,5 +67,6 @@ This file is released under the MIT license. See README-MIT for more information
 
 #define GET_LOCK LuaGlobal::instance()->luaEngine()->getLock().Acquire();
 #define RELEASE_LOCK LuaGlobal::instance()->luaEngine()->getLock().Release();
-#define CHECK_BINDING_ACQUIRELOCK GET_LOCK if(m_binding == NULL) { RELEASE_LOCK return; }
+// the binding is looked up in the engine of the calling thread
+#define CHECK_BINDING_ACQUIRELOCK GET_LOCK LuaObjectBinding* binding = getBinding(); if(binding == NULL) { RELEASE_LOCK return; }
 #define sLuaEventMgr LuaGlobal::instance()->luaEngine()->LuaEventMgr
\ No newline at end of file
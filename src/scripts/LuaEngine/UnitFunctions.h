@@ -77,13 +77,13 @@ public:
         if (plr == NULL)
             return 0;
 
-        if (LuaGlobal::instance()->m_menu != NULL)
-            delete LuaGlobal::instance()->m_menu;
+        if (LuaGlobal::instance()->luaEngine()->m_menu != NULL)
+            delete LuaGlobal::instance()->luaEngine()->m_menu;
 
-        LuaGlobal::instance()->m_menu = new GossipMenu(ptr->getGuid(), text_id);
+        LuaGlobal::instance()->luaEngine()->m_menu = new GossipMenu(ptr->getGuid(), text_id);
 
         if (autosend != 0)
-            LuaGlobal::instance()->m_menu->sendGossipPacket(plr);
+            LuaGlobal::instance()->luaEngine()->m_menu->sendGossipPacket(plr);
 
         return 0;
     }
@@ -97,12 +97,12 @@ public:
         const char * boxmessage = luaL_optstring(L, 5, "");
         uint32 boxmoney = static_cast<uint32>(luaL_optinteger(L, 6, 0));
 
-        if (LuaGlobal::instance()->m_menu == NULL){
+        if (LuaGlobal::instance()->luaEngine()->m_menu == NULL){
             DLLLogDetail("There is no menu to add items to!");
             return 0;
         }
 
-        LuaGlobal::instance()->m_menu->addItem(icon, 0, IntId, menu_text, boxmoney, boxmessage, coded);
+        LuaGlobal::instance()->luaEngine()->m_menu->addItem(icon, 0, IntId, menu_text, boxmoney, boxmessage, coded);
 
         return 0;
     }
@@ -111,13 +111,13 @@ public:
     {
         Player* plr = CHECK_PLAYER(L, 1);
 
-        if (LuaGlobal::instance()->m_menu == NULL){
+        if (LuaGlobal::instance()->luaEngine()->m_menu == NULL){
             DLLLogDetail("There is no menu to send!");
             return 0;
         }
 
         if (plr != NULL)
-            LuaGlobal::instance()->m_menu->sendGossipPacket(plr);
+            LuaGlobal::instance()->luaEngine()->m_menu->sendGossipPacket(plr);
 
         return 0;
     }
@@ -161,14 +161,14 @@ public:
     static int GossipAddQuests(lua_State *L, Unit *ptr){
         TEST_UNIT()
 
-            if (LuaGlobal::instance()->m_menu == NULL){
+            if (LuaGlobal::instance()->luaEngine()->m_menu == NULL){
                 DLLLogDetail("There's no menu to fill quests into.");
                 return 0;
             }
 
         Player *player = CHECK_PLAYER(L, 1);
 
-        sQuestMgr.FillQuestMenu(static_cast< Creature* >(ptr), player, *LuaGlobal::instance()->m_menu);
+        sQuestMgr.FillQuestMenu(static_cast< Creature* >(ptr), player, *LuaGlobal::instance()->luaEngine()->m_menu);
 
         return 0;
     }
@@ -179,13 +179,13 @@ public:
         TEST_PLAYER()
             Player * plr = static_cast<Player*>(ptr);
 
-        if (LuaGlobal::instance()->m_menu == nullptr)
+        if (LuaGlobal::instance()->luaEngine()->m_menu == nullptr)
         {
             DLLLogDetail("There is no menu to complete!");
             return 0;
         }
 
-        LuaGlobal::instance()->m_menu->senGossipComplete(plr);
+        LuaGlobal::instance()->luaEngine()->m_menu->senGossipComplete(plr);
 
         return 0;
     }
@@ -689,7 +689,7 @@ public:
             functionRef = LuaHelpers::ExtractfRefFromCString(L, luaL_checkstring(L, 1));
         if (functionRef)
         {
-            TimedEvent* ev = TimedEvent::Allocate(ptr, new CallbackP1<LuaEngine, int>(LuaGlobal::instance()->luaEngine().get(), &LuaEngine::CallFunctionByReference, functionRef), EVENT_LUA_CREATURE_EVENTS, delay, repeats);
+            TimedEvent* ev = TimedEvent::Allocate(ptr, new CallbackP1<LuaEngine, int>(LuaGlobal::instance()->luaEngine(), &LuaEngine::CallFunctionByReference, functionRef), EVENT_LUA_CREATURE_EVENTS, delay, repeats);
             ptr->event_AddEvent(ev);
             std::map< uint64, std::set<int> > & objRefs = LuaGlobal::instance()->luaEngine()->getObjectFunctionRefs();
             std::map< uint64, std::set<int> >::iterator itr = objRefs.find(ptr->getGuid());
@@ -21,6 +21,23 @@
 #include "BigNumber.h"
 #include <openssl/bn.h>
 #include <algorithm>
+#include <memory>
+
+namespace
+{
+    struct BnCtxDeleter
+    {
+        void operator()(BN_CTX* ctx) const { BN_CTX_free(ctx); }
+    };
+
+    // BN_CTX is only scratch space, so every thread keeps one for its whole lifetime
+    // instead of allocating a new one for each multiplication/exponentiation
+    BN_CTX* getThreadBnCtx()
+    {
+        thread_local std::unique_ptr<BN_CTX, BnCtxDeleter> bnctx(BN_CTX_new());
+        return bnctx.get();
+    }
+}
 
 BigNumber::BigNumber()
 {
@@ -97,58 +114,33 @@ BigNumber BigNumber::operator-=(const BigNumber & bn)
 
 BigNumber BigNumber::operator*=(const BigNumber & bn)
 {
-    BN_CTX* bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_mul(_bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
-
+    BN_mul(_bn, _bn, bn._bn, getThreadBnCtx());
     return *this;
 }
 
 BigNumber BigNumber::operator/=(const BigNumber & bn)
 {
-    BN_CTX* bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_div(_bn, NULL, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
-
+    BN_div(_bn, NULL, _bn, bn._bn, getThreadBnCtx());
     return *this;
 }
 
 BigNumber BigNumber::operator%=(const BigNumber & bn)
 {
-    BN_CTX* bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_mod(_bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
-
+    BN_mod(_bn, _bn, bn._bn, getThreadBnCtx());
     return *this;
 }
 
 BigNumber BigNumber::Exp(const BigNumber & bn)
 {
     BigNumber ret;
-    BN_CTX* bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_exp(ret._bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
-
+    BN_exp(ret._bn, _bn, bn._bn, getThreadBnCtx());
     return ret;
 }
 
 BigNumber BigNumber::ModExp(const BigNumber & bn1, const BigNumber & bn2)
 {
     BigNumber ret;
-    BN_CTX* bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_mod_exp(ret._bn, _bn, bn1._bn, bn2._bn, bnctx);
-    BN_CTX_free(bnctx);
-
+    BN_mod_exp(ret._bn, _bn, bn1._bn, bn2._bn, getThreadBnCtx());
     return ret;
 }
 
@@ -415,6 +415,17 @@ void Database::AddQueryBuffer(QueryBuffer* b)
     }
 }
 
+void Database::QueueQueryBuffer(QueryBuffer* b)
+{
+    if (m_queryBufferThread != nullptr && !m_queryBufferThread->isKilled())
+        query_buffer.push(b);
+    else
+    {
+        PerformQueryBuffer(b, NULL);
+        delete b;
+    }
+}
+
 void Database::FreeQueryResult(QueryResult* p)
 {
     delete p;
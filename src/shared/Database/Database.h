@@ -144,6 +144,9 @@ class SERVER_DECL Database
         void PerformQueryBuffer(QueryBuffer* b, DatabaseConnection* ccon);
         void AddQueryBuffer(QueryBuffer* b);
 
+        // runs the buffer as one transaction on the query buffer thread, waits only when the thread is gone
+        void QueueQueryBuffer(QueryBuffer* b);
+
         static Database* CreateDatabaseInterface();
         static void CleanupLibs();
 
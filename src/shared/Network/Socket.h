@@ -53,6 +53,9 @@ class SERVER_DECL Socket
         // Called when the socket is disconnected from the client (either forcibly or by the connection dropping)
         virtual void OnDisconnect() {}
 
+        // Work queued outside of the socket threads still references this socket, the garbage collector keeps it until it is done.
+        virtual bool HasPendingJobs() { return false; }
+
         /* Sending Operations */
 
         // Locks sending mutex, adds bytes, unlocks mutex.
@@ -273,7 +276,7 @@ class SocketGarbageCollector
             for(i = deletionQueue.begin(); i != deletionQueue.end();)
             {
                 i2 = i++;
-                if(i2->second <= t)
+                if(i2->second <= t && !i2->first->HasPendingJobs())
                 {
                     delete i2->first;
                     deletionQueue.erase(i2);
@@ -80,9 +80,8 @@ void HandleReadComplete(Socket* s, uint32 len)
         s->m_readEvent.Unmark();
         if(len)
         {
-            s->readBuffer.IncrementWritten(len);
-            s->OnRead();
-            s->SetupReadEvent();
+            // ReadCallback holds m_readMutex around OnRead, input can also be handled from outside the socket threads
+            s->ReadCallback(len);
         }
         else
             s->Delete();      // Queue deletion.
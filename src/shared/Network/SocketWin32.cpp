@@ -103,8 +103,11 @@ void Socket::SetupReadEvent()
 
 void Socket::ReadCallback(uint32 len)
 {
+    // same lock as the epoll/kqueue read path, OnRead can also be driven from outside the socket threads
+    m_readMutex.Acquire();
     readBuffer.IncrementWritten(len);
     OnRead();
+    m_readMutex.Release();
     SetupReadEvent();
 }
 
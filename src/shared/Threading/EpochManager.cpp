@@ -0,0 +1,168 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "EpochManager.h"
+
+using std::lock_guard;
+using std::mutex;
+
+namespace AscEmu::Threading
+{
+    namespace
+    {
+        // hands the record back when the owning thread ends
+        struct ThreadRecordReleaser
+        {
+            ~ThreadRecordReleaser()
+            {
+                EpochManager::getInstance().releaseThreadRecord();
+            }
+        };
+    }
+
+    EpochManager::EpochManager() : m_globalEpoch(1)
+    {
+    }
+
+    EpochManager::~EpochManager()
+    {
+        // no reader is left at static destruction
+        for (auto& retired : m_retired)
+            retired.deleter();
+
+        for (auto record : m_records)
+            delete record;
+    }
+
+    EpochManager& EpochManager::getInstance()
+    {
+        static EpochManager mInstance;
+        return mInstance;
+    }
+
+    EpochManager::ThreadRecord*& EpochManager::getThreadRecord()
+    {
+        thread_local ThreadRecord* record = nullptr;
+        return record;
+    }
+
+    EpochManager::ThreadRecord* EpochManager::acquireRecord()
+    {
+        thread_local ThreadRecordReleaser releaser;
+        (void)releaser;
+
+        lock_guard<mutex> guard(m_recordMutex);
+        for (auto record : m_records)
+        {
+            bool expected = false;
+            if (record->inUse.compare_exchange_strong(expected, true))
+                return record;
+        }
+
+        auto record = new ThreadRecord;
+        record->inUse = true;
+        m_records.push_back(record);
+        return record;
+    }
+
+    void EpochManager::releaseThreadRecord()
+    {
+        auto& record = getThreadRecord();
+        if (record == nullptr)
+            return;
+
+        record->epoch.store(0, std::memory_order_release);
+        record->depth = 0;
+        record->inUse.store(false, std::memory_order_release);
+        record = nullptr;
+    }
+
+    EpochManager::Guard::Guard()
+    {
+        auto& record = getThreadRecord();
+        if (record == nullptr)
+            record = getInstance().acquireRecord();
+
+        m_record = record;
+        if (m_record->depth++ == 0)
+        {
+            // sequentially consistent, the announcement has to be visible before the guarded pointer is read.
+            // Guarded pointers have to be loaded sequentially consistent as well.
+            m_record->epoch.store(getInstance().m_globalEpoch.load(std::memory_order_acquire), std::memory_order_seq_cst);
+        }
+    }
+
+    EpochManager::Guard::~Guard()
+    {
+        if (--m_record->depth == 0)
+            m_record->epoch.store(0, std::memory_order_release);
+    }
+
+    void EpochManager::retire(std::function<void()> deleter)
+    {
+        {
+            lock_guard<mutex> guard(m_retiredMutex);
+
+            // readers entering after the increment can not see the unpublished object anymore
+            const uint64_t epoch = m_globalEpoch.fetch_add(1, std::memory_order_seq_cst);
+            m_retired.push_back({ epoch, std::move(deleter) });
+        }
+
+        reclaim();
+    }
+
+    uint64_t EpochManager::getOldestActiveEpoch()
+    {
+        uint64_t oldest = m_globalEpoch.load(std::memory_order_seq_cst);
+
+        lock_guard<mutex> guard(m_recordMutex);
+        for (auto record : m_records)
+        {
+            const uint64_t epoch = record->epoch.load(std::memory_order_seq_cst);
+            if (epoch != 0 && epoch < oldest)
+                oldest = epoch;
+        }
+
+        return oldest;
+    }
+
+    size_t EpochManager::reclaim()
+    {
+        std::vector<RetiredObject> reclaimable;
+        {
+            lock_guard<mutex> guard(m_retiredMutex);
+            if (m_retired.empty())
+                return 0;
+
+            const uint64_t oldest = getOldestActiveEpoch();
+
+            // an object retired in epoch e is safe once every active reader entered after e
+            for (auto itr = m_retired.begin(); itr != m_retired.end();)
+            {
+                if (itr->epoch < oldest)
+                {
+                    reclaimable.push_back(std::move(*itr));
+                    itr = m_retired.erase(itr);
+                }
+                else
+                {
+                    ++itr;
+                }
+            }
+        }
+
+        // deleters run without the lock, they may retire further objects
+        for (auto& retired : reclaimable)
+            retired.deleter();
+
+        return reclaimable.size();
+    }
+
+    size_t EpochManager::getRetiredCount()
+    {
+        lock_guard<mutex> guard(m_retiredMutex);
+        return m_retired.size();
+    }
+}
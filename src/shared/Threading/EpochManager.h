@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Epoch based reclamation for data read without locks.
+// Readers wrap their accesses in an EpochManager::Guard. Writers unpublish a pointer first and then hand the
+// object to retire(), it is destroyed once every thread that was inside a guard at that time has left it.
+// Entering a guard only writes the calling thread's own slot, readers share no counters or locks.
+namespace AscEmu::Threading
+{
+    class EpochManager
+    {
+        struct alignas(64) ThreadRecord
+        {
+            // 0 = the thread is not inside a guard
+            std::atomic<uint64_t> epoch{ 0 };
+            std::atomic<bool> inUse{ false };
+            uint32_t depth = 0;
+        };
+
+        struct RetiredObject
+        {
+            uint64_t epoch;
+            std::function<void()> deleter;
+        };
+
+        std::atomic<uint64_t> m_globalEpoch;
+
+        // records are never freed, a finished thread leaves its record to the next new thread
+        std::mutex m_recordMutex;
+        std::vector<ThreadRecord*> m_records;
+
+        std::mutex m_retiredMutex;
+        std::vector<RetiredObject> m_retired;
+
+        EpochManager();
+        ~EpochManager();
+
+        ThreadRecord* acquireRecord();
+        static ThreadRecord*& getThreadRecord();
+        uint64_t getOldestActiveEpoch();
+
+    public:
+        static EpochManager& getInstance();
+
+        EpochManager(EpochManager&&) = delete;
+        EpochManager(EpochManager const&) = delete;
+        EpochManager& operator=(EpochManager&&) = delete;
+        EpochManager& operator=(EpochManager const&) = delete;
+
+        class Guard
+        {
+            ThreadRecord* m_record;
+        public:
+            Guard();
+            ~Guard();
+
+            Guard(Guard const&) = delete;
+            Guard& operator=(Guard const&) = delete;
+        };
+
+        // the object must not be reachable for new readers anymore
+        void retire(std::function<void()> deleter);
+
+        template <class T>
+        void retire(T* object) { retire([object]() { delete object; }); }
+
+        // destroys retired objects no reader can hold anymore, returns the destroyed count
+        size_t reclaim();
+
+        size_t getRetiredCount();
+
+        // called when a thread ends
+        void releaseThreadRecord();
+    };
+}
+
+#define sEpochManager AscEmu::Threading::EpochManager::getInstance()
@@ -0,0 +1,149 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "WorkerPool.h"
+#include <algorithm>
+#include <memory>
+
+using std::lock_guard;
+using std::mutex;
+using std::string;
+using std::unique_lock;
+
+namespace AscEmu::Threading
+{
+    WorkerPool::WorkerPool(string poolName, uint32_t threadCount) :
+        m_poolName(poolName),
+        m_running(true),
+        m_activeJobs(0),
+        m_processedJobs(0)
+    {
+        if (threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+        m_threads.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; ++i)
+            m_threads.emplace_back(&WorkerPool::workerLoop, this);
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        shutdown();
+    }
+
+    void WorkerPool::workerLoop()
+    {
+        for (;;)
+        {
+            Job job;
+            {
+                unique_lock<mutex> lock(m_mtx);
+                m_jobCondition.wait(lock, [this] { return !m_running || !m_jobs.empty(); });
+
+                // queue is drained before the threads exit
+                if (m_jobs.empty())
+                    return;
+
+                job = std::move(m_jobs.front());
+                m_jobs.pop();
+                ++m_activeJobs;
+            }
+
+            job();
+            ++m_processedJobs;
+
+            {
+                lock_guard<mutex> guard(m_mtx);
+                --m_activeJobs;
+                if (m_activeJobs == 0 && m_jobs.empty())
+                    m_idleCondition.notify_all();
+            }
+        }
+    }
+
+    void WorkerPool::queueJob(Job job)
+    {
+        {
+            lock_guard<mutex> guard(m_mtx);
+            if (m_running)
+            {
+                m_jobs.push(std::move(job));
+                m_jobCondition.notify_one();
+                return;
+            }
+        }
+
+        job();
+        ++m_processedJobs;
+    }
+
+    void WorkerPool::waitForIdle()
+    {
+        unique_lock<mutex> lock(m_mtx);
+        m_idleCondition.wait(lock, [this] { return m_activeJobs == 0 && m_jobs.empty(); });
+    }
+
+    void WorkerPool::parallelFor(size_t count, std::function<void(size_t)> const& job)
+    {
+        if (count == 0)
+            return;
+
+        struct Batch
+        {
+            std::atomic<size_t> nextIndex{ 0 };
+            std::atomic<size_t> doneCount{ 0 };
+            mutex mtx;
+            std::condition_variable doneCondition;
+        };
+
+        // helpers picked up after the batch is finished find no index left and never touch job
+        const auto batch = std::make_shared<Batch>();
+        const auto runBatch = [batch, count, &job]()
+        {
+            for (size_t index = batch->nextIndex++; index < count; index = batch->nextIndex++)
+            {
+                job(index);
+
+                if (++batch->doneCount == count)
+                {
+                    lock_guard<mutex> guard(batch->mtx);
+                    batch->doneCondition.notify_all();
+                }
+            }
+        };
+
+        const size_t helperCount = std::min(m_threads.size(), count - 1);
+        for (size_t i = 0; i < helperCount; ++i)
+            queueJob(runBatch);
+
+        runBatch();
+
+        unique_lock<mutex> lock(batch->mtx);
+        batch->doneCondition.wait(lock, [batch, count] { return batch->doneCount == count; });
+    }
+
+    void WorkerPool::shutdown()
+    {
+        {
+            lock_guard<mutex> guard(m_mtx);
+            if (!m_running)
+                return;
+
+            m_running = false;
+        }
+        m_jobCondition.notify_all();
+
+        for (auto& thread : m_threads)
+            thread.join();
+
+        m_threads.clear();
+    }
+
+    size_t WorkerPool::getQueueSize()
+    {
+        lock_guard<mutex> guard(m_mtx);
+        return m_jobs.size();
+    }
+}
@@ -0,0 +1,63 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Fixed size pool of threads working on a shared fifo of short jobs.
+// Unlike AEThreadPool there is no scheduling/pulse thread, a queued job is picked up immediately.
+namespace AscEmu::Threading
+{
+    class WorkerPool
+    {
+        typedef std::function<void()> Job;
+
+        std::string m_poolName;
+        std::vector<std::thread> m_threads;
+
+        std::mutex m_mtx;
+        std::condition_variable m_jobCondition;
+        std::condition_variable m_idleCondition;
+        std::queue<Job> m_jobs;
+
+        bool m_running;
+        uint32_t m_activeJobs;
+        std::atomic<uint64_t> m_processedJobs;
+
+        void workerLoop();
+    public:
+        // threadCount 0 = one thread per hardware thread
+        WorkerPool(std::string poolName, uint32_t threadCount);
+        ~WorkerPool();
+
+        WorkerPool(WorkerPool const&) = delete;
+        WorkerPool& operator=(WorkerPool const&) = delete;
+
+        // runs the job inline when the pool was already shut down
+        void queueJob(Job job);
+
+        // blocks until every queued job is finished
+        void waitForIdle();
+
+        // calls job(0) ... job(count - 1) on the pool and the calling thread, returns when all calls are done.
+        // Only waits for its own calls, so it can be used by several threads sharing the pool.
+        void parallelFor(size_t count, std::function<void(size_t)> const& job);
+
+        // finishes all queued jobs and joins the threads
+        void shutdown();
+
+        size_t getQueueSize();
+        size_t getThreadCount() const { return m_threads.size(); }
+        uint64_t getProcessedJobCount() const { return m_processedJobs; }
+        const std::string& getName() const { return m_poolName; }
+    };
+}
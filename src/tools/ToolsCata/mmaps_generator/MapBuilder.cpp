@@ -42,11 +42,49 @@ struct MmapTileHeader
         mmapVersion(MMAP_VERSION), size(0), usesLiquids(true) {}
 };
 
+// cached detour data of a tile (before it was added to a navmesh) and the hash of its build input
+// bump the version when the recast build itself changes
+#define MMAP_CACHE_MAGIC 0x4d4d4343   // 'MMCC'
+#define MMAP_CACHE_VERSION 1
+
+struct MmapCacheHeader
+{
+    uint32 cacheMagic;
+    uint32 cacheVersion;
+    uint64 key;
+    uint32 size;
+
+    MmapCacheHeader() : cacheMagic(MMAP_CACHE_MAGIC), cacheVersion(MMAP_CACHE_VERSION), key(0), size(0) {}
+};
+
 namespace MMAP
 {
+    namespace
+    {
+        // FNV-1a
+        void hashBytes(uint64& hash, const void* data, size_t size)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 0x100000001b3ULL;
+            }
+        }
+
+        template <typename T>
+        void hashArray(uint64& hash, const G3D::Array<T>& values)
+        {
+            const uint32 count = static_cast<uint32>(values.size());
+            hashBytes(hash, &count, sizeof(count));
+            if (count)
+                hashBytes(hash, values.getCArray(), count * sizeof(T));
+        }
+    }
+
     MapBuilder::MapBuilder(float maxWalkableAngle, bool skipLiquid,
         bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
-        bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath) :
+        bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath, bool buildCache) :
         m_terrainBuilder     (NULL),
         m_debugOutput        (debugOutput),
         m_offMeshFilePath    (offMeshFilePath),
@@ -55,13 +93,19 @@ namespace MMAP
         m_skipBattlegrounds  (skipBattlegrounds),
         m_maxWalkableAngle   (maxWalkableAngle),
         m_bigBaseUnit        (bigBaseUnit),
-        m_rcContext          (NULL),
-        _cancelationToken    (false)
+        m_buildCache         (buildCache),
+        m_rcContext          (NULL)
     {
         m_terrainBuilder = new TerrainBuilder(skipLiquid);
 
         m_rcContext = new rcContext(false);
 
+        if (m_buildCache)
+        {
+            std::error_code error;
+            fs::create_directories("mmaps/cache", error);
+        }
+
         discoverTiles();
     }
 
@@ -164,14 +208,20 @@ namespace MMAP
     {
         while (1)
         {
-            uint32 mapId = 0;
+            TileTask task;
 
-            _queue.WaitAndPop(mapId);
+            _queue.WaitAndPop(task);
 
-            if (_cancelationToken)
+            // the queue was canceled
+            if (!task.m_map)
                 return;
 
-            buildMap(mapId);
+            MapBuildState* state = task.m_map;
+
+            uint32 tileX, tileY;
+            StaticMapTree::unpackTileID(state->m_tileIds[task.m_index], tileX, tileY);
+
+            finishTile(state, task.m_index, buildTileData(state->m_mapId, tileX, tileY, state->m_navMesh));
         }
     }
 
@@ -187,13 +237,22 @@ namespace MMAP
             return a.m_tiles->size() > b.m_tiles->size();
         });
 
+        std::vector<MapBuildState*> mapStates;
         for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
         {
             uint32 mapId = it->m_mapId;
             if (!shouldSkipMap(mapId))
             {
                 if (threads > 0)
-                    _queue.Push(mapId);
+                {
+                    // big maps come first, their tiles keep the threads busy while the next maps are prepared
+                    if (MapBuildState* state = prepareMap(mapId))
+                    {
+                        mapStates.push_back(state);
+                        for (uint32 i = 0; i < state->m_tileIds.size(); ++i)
+                            _queue.Push(TileTask(state, i));
+                    }
+                }
                 else
                     buildMap(mapId);
             }
@@ -204,14 +263,16 @@ namespace MMAP
             std::this_thread::sleep_for(std::chrono::milliseconds(1000));
         }
 
-        _cancelationToken = true;
-
+        // workers finish their current tile before they leave
         _queue.Cancel();
 
         for (auto& thread : _workerThreads)
         {
             thread.join();
         }
+
+        for (MapBuildState* state : mapStates)
+            delete state;
     }
 
     /**************************************************************************/
@@ -338,7 +399,9 @@ namespace MMAP
         getTileBounds(tileX, tileY, data.solidVerts.getCArray(), data.solidVerts.size() / 3, bmin, bmax);
 
         // build navmesh tile
-        buildMoveMapTile(mapId, tileX, tileY, data, bmin, bmax, navMesh);
+        TileNavData tileData;
+        buildMoveMapTile(mapId, tileX, tileY, data, bmin, bmax, navMesh, tileData);
+        writeMoveMapTile(mapId, tileX, tileY, navMesh, tileData);
         fclose(file);
     }
 
@@ -364,6 +427,24 @@ namespace MMAP
         //printf("[Thread %u] Building map %04u:\n", uint32(ACE_Thread::self()), mapID);
 #endif
 
+        MapBuildState* state = prepareMap(mapID);
+        if (!state)
+            return;
+
+        for (uint32 i = 0; i < state->m_tileIds.size(); ++i)
+        {
+            uint32 tileX, tileY;
+            StaticMapTree::unpackTileID(state->m_tileIds[i], tileX, tileY);
+
+            finishTile(state, i, buildTileData(mapID, tileX, tileY, state->m_navMesh));
+        }
+
+        delete state;
+    }
+
+    /**************************************************************************/
+    MapBuildState* MapBuilder::prepareMap(uint32 mapID)
+    {
         std::set<uint32>* tiles = getTileList(mapID);
 
         // make sure we process maps which don't have tiles
@@ -379,43 +460,92 @@ namespace MMAP
                     tiles->insert(StaticMapTree::packTileID(i, j));
         }
 
-        if (!tiles->empty())
+        if (tiles->empty())
         {
-            // build navMesh
-            dtNavMesh* navMesh = NULL;
-            buildNavMesh(mapID, navMesh);
-            if (!navMesh)
-            {
-                printf("[Map %04i] Failed creating navmesh!\n", mapID);
-                return;
-            }
+            printf("[Map %04i] Complete!\n", mapID);
+            return NULL;
+        }
 
-            // now start building mmtiles for each tile
-            printf("[Map %04i] We have %u tiles.\n", mapID, (unsigned int)tiles->size());
-            for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
-            {
-                uint32 tileX, tileY;
+        // build navMesh
+        dtNavMesh* navMesh = NULL;
+        buildNavMesh(mapID, navMesh);
+        if (!navMesh)
+        {
+            printf("[Map %04i] Failed creating navmesh!\n", mapID);
+            return NULL;
+        }
 
-                // unpack tile coords
-                StaticMapTree::unpackTileID((*it), tileX, tileY);
+        // now collect the mmtiles to build
+        printf("[Map %04i] We have %u tiles.\n", mapID, (unsigned int)tiles->size());
 
-                if (shouldSkipTile(mapID, tileX, tileY))
-                    continue;
+        MapBuildState* state = new MapBuildState(mapID, navMesh);
+        for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
+        {
+            uint32 tileX, tileY;
 
-                buildTile(mapID, tileX, tileY, navMesh);
-            }
+            // unpack tile coords
+            StaticMapTree::unpackTileID((*it), tileX, tileY);
+
+            if (shouldSkipTile(mapID, tileX, tileY))
+                continue;
+
+            state->m_tileIds.push_back(*it);
+        }
 
+        if (state->m_tileIds.empty())
+        {
             dtFreeNavMesh(navMesh);
+            delete state;
+
+            printf("[Map %04i] Complete!\n", mapID);
+            return NULL;
         }
 
-        printf("[Map %04i] Complete!\n", mapID);
+        state->m_tileData.resize(state->m_tileIds.size());
+        state->m_tileBuilt.resize(state->m_tileIds.size(), false);
+        return state;
+    }
+
+    /**************************************************************************/
+    void MapBuilder::finishTile(MapBuildState* state, uint32 index, TileNavData const& tileData)
+    {
+        std::lock_guard<std::mutex> lock(state->m_lock);
+
+        state->m_tileData[index] = tileData;
+        state->m_tileBuilt[index] = true;
+
+        // the navmesh salts its tile refs by add order, a tile waits for all tiles before it
+        while (state->m_nextWrite < state->m_tileIds.size() && state->m_tileBuilt[state->m_nextWrite])
+        {
+            uint32 tileX, tileY;
+            StaticMapTree::unpackTileID(state->m_tileIds[state->m_nextWrite], tileX, tileY);
+
+            writeMoveMapTile(state->m_mapId, tileX, tileY, state->m_navMesh, state->m_tileData[state->m_nextWrite]);
+            state->m_tileData[state->m_nextWrite] = TileNavData();
+            ++state->m_nextWrite;
+        }
+
+        if (state->m_nextWrite == state->m_tileIds.size() && state->m_navMesh)
+        {
+            dtFreeNavMesh(state->m_navMesh);
+            state->m_navMesh = NULL;
+
+            printf("[Map %04i] Complete!\n", state->m_mapId);
+        }
     }
 
     /**************************************************************************/
     void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    {
+        writeMoveMapTile(mapID, tileX, tileY, navMesh, buildTileData(mapID, tileX, tileY, navMesh));
+    }
+
+    /**************************************************************************/
+    TileNavData MapBuilder::buildTileData(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
     {
         printf("[Map %04i] Building tile [%02u,%02u]\n", mapID, tileX, tileY);
 
+        TileNavData tileData;
         MeshData meshData;
 
         // get heightmap data
@@ -426,7 +556,7 @@ namespace MMAP
 
         // if there is no data, give up now
         if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
-            return;
+            return tileData;
 
         // remove unused vertices
         TerrainBuilder::cleanVertices(meshData.solidVerts, meshData.solidTris);
@@ -438,7 +568,7 @@ namespace MMAP
         allVerts.append(meshData.solidVerts);
 
         if (!allVerts.size())
-            return;
+            return tileData;
 
         // get bounds of current tile
         float bmin[3], bmax[3];
@@ -446,8 +576,22 @@ namespace MMAP
 
         m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
 
+        // debug output needs the intermediate values, those tiles are always built
+        const bool useCache = m_buildCache && !m_debugOutput;
+        const uint64 cacheKey = useCache ? getTileCacheKey(meshData, bmin, bmax, navMesh) : 0;
+        if (useCache && loadCachedTile(mapID, tileX, tileY, cacheKey, tileData))
+        {
+            printf("[Map %04i] [%02i,%02i]: Input unchanged, using cached tile\n", mapID, tileX, tileY);
+            return tileData;
+        }
+
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh, tileData);
+
+        if (useCache)
+            storeCachedTile(mapID, tileX, tileY, cacheKey, tileData);
+
+        return tileData;
     }
 
     /**************************************************************************/
@@ -528,7 +672,7 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
         MeshData &meshData, float bmin[3], float bmax[3],
-        dtNavMesh* navMesh)
+        dtNavMesh* navMesh, TileNavData& tileData)
     {
         // console output
         char tileString[255];
@@ -813,44 +957,8 @@ namespace MMAP
                 break;
             }
 
-            dtTileRef tileRef = 0;
-            printf("%s Adding tile to navmesh...\n", tileString);
-            // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
-            // is removed via removeTile()
-            dtStatus dtResult = navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, &tileRef);
-            if (!tileRef || dtResult != DT_SUCCESS)
-            {
-                printf("%s Failed adding tile to navmesh!\n", tileString);
-                break;
-            }
-
-            // file output
-            char fileName[255];
-            sprintf(fileName, "mmaps/%04u%02i%02i.mmtile", mapID, tileY, tileX);
-            FILE* file = fopen(fileName, "wb");
-            if (!file)
-            {
-                char message[1024];
-                sprintf(message, "[Map %04i] Failed to open %s for writing!\n", mapID, fileName);
-                perror(message);
-                navMesh->removeTile(tileRef, NULL, NULL);
-                break;
-            }
-
-            printf("%s Writing to file...\n", tileString);
-
-            // write header
-            MmapTileHeader header;
-            header.usesLiquids = m_terrainBuilder->usesLiquids() ? 1 : 0;
-            header.size = uint32(navDataSize);
-            fwrite(&header, sizeof(MmapTileHeader), 1, file);
-
-            // write data
-            fwrite(navData, sizeof(unsigned char), navDataSize, file);
-            fclose(file);
-
-            // now that tile is written to disk, we can unload it
-            navMesh->removeTile(tileRef, NULL, NULL);
+            tileData.data = navData;
+            tileData.size = navDataSize;
         }
         while (0);
 
@@ -869,6 +977,160 @@ namespace MMAP
         }
     }
 
+    /**************************************************************************/
+    void MapBuilder::writeMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, TileNavData const& tileData)
+    {
+        if (!tileData.data)
+            return;
+
+        char tileString[255];
+        sprintf(tileString, "[Map %04i] [%02i,%02i]: ", mapID, tileX, tileY);
+
+        dtTileRef tileRef = 0;
+        printf("%s Adding tile to navmesh...\n", tileString);
+        // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
+        // is removed via removeTile()
+        dtStatus dtResult = navMesh->addTile(tileData.data, tileData.size, DT_TILE_FREE_DATA, 0, &tileRef);
+        if (!tileRef || dtResult != DT_SUCCESS)
+        {
+            printf("%s Failed adding tile to navmesh!\n", tileString);
+            dtFree(tileData.data);
+            return;
+        }
+
+        // file output
+        char fileName[255];
+        sprintf(fileName, "mmaps/%04u%02i%02i.mmtile", mapID, tileY, tileX);
+        FILE* file = fopen(fileName, "wb");
+        if (!file)
+        {
+            char message[1024];
+            sprintf(message, "[Map %04i] Failed to open %s for writing!\n", mapID, fileName);
+            perror(message);
+            navMesh->removeTile(tileRef, NULL, NULL);
+            return;
+        }
+
+        printf("%s Writing to file...\n", tileString);
+
+        // write header
+        MmapTileHeader header;
+        header.usesLiquids = m_terrainBuilder->usesLiquids() ? 1 : 0;
+        header.size = uint32(tileData.size);
+        fwrite(&header, sizeof(MmapTileHeader), 1, file);
+
+        // write data
+        fwrite(tileData.data, sizeof(unsigned char), tileData.size, file);
+        fclose(file);
+
+        // now that tile is written to disk, we can unload it
+        navMesh->removeTile(tileRef, NULL, NULL);
+    }
+
+    /**************************************************************************/
+    uint64 MapBuilder::getTileCacheKey(MeshData const& meshData, float const* bmin, float const* bmax, dtNavMesh const* navMesh) const
+    {
+        uint64 hash = 0xcbf29ce484222325ULL;
+
+        // build settings
+        const uint32 versions[3] = { MMAP_CACHE_VERSION, MMAP_VERSION, DT_NAVMESH_VERSION };
+        hashBytes(hash, versions, sizeof(versions));
+        hashBytes(hash, &m_maxWalkableAngle, sizeof(m_maxWalkableAngle));
+        hashBytes(hash, &m_bigBaseUnit, sizeof(m_bigBaseUnit));
+        hashBytes(hash, navMesh->getParams()->orig, sizeof(float) * 3);
+        hashBytes(hash, bmin, sizeof(float) * 3);
+        hashBytes(hash, bmax, sizeof(float) * 3);
+
+        // input geometry, terrain and models of the tile with its borders
+        hashArray(hash, meshData.solidVerts);
+        hashArray(hash, meshData.solidTris);
+        hashArray(hash, meshData.liquidVerts);
+        hashArray(hash, meshData.liquidTris);
+        hashArray(hash, meshData.liquidType);
+        hashArray(hash, meshData.offMeshConnections);
+        hashArray(hash, meshData.offMeshConnectionRads);
+        hashArray(hash, meshData.offMeshConnectionDirs);
+        hashArray(hash, meshData.offMeshConnectionsAreas);
+        hashArray(hash, meshData.offMeshConnectionsFlags);
+
+        return hash;
+    }
+
+    /**************************************************************************/
+    bool MapBuilder::loadCachedTile(uint32 mapID, uint32 tileX, uint32 tileY, uint64 key, TileNavData& tileData)
+    {
+        char fileName[255];
+        sprintf(fileName, "mmaps/cache/%04u%02i%02i.navcache", mapID, tileY, tileX);
+        FILE* file = fopen(fileName, "rb");
+        if (!file)
+            return false;
+
+        MmapCacheHeader header;
+        if (fread(&header, sizeof(MmapCacheHeader), 1, file) != 1 || header.cacheMagic != MMAP_CACHE_MAGIC ||
+            header.cacheVersion != MMAP_CACHE_VERSION || header.key != key)
+        {
+            fclose(file);
+            return false;
+        }
+
+        // tiles without navmesh data are cached as well
+        if (header.size)
+        {
+            // allocated like dtCreateNavMeshData does, the navmesh frees it
+            unsigned char* data = static_cast<unsigned char*>(dtAlloc(header.size, DT_ALLOC_PERM));
+            if (!data || header.size < sizeof(dtMeshHeader) || fread(data, sizeof(unsigned char), header.size, file) != header.size)
+            {
+                dtFree(data);
+                fclose(file);
+                return false;
+            }
+
+            // a truncated or foreign file must not reach the navmesh
+            dtMeshHeader const* meshHeader = reinterpret_cast<dtMeshHeader const*>(data);
+            if (meshHeader->magic != DT_NAVMESH_MAGIC || meshHeader->version != DT_NAVMESH_VERSION || fgetc(file) != EOF)
+            {
+                dtFree(data);
+                fclose(file);
+                return false;
+            }
+
+            tileData.data = data;
+            tileData.size = int(header.size);
+        }
+
+        fclose(file);
+        return true;
+    }
+
+    /**************************************************************************/
+    void MapBuilder::storeCachedTile(uint32 mapID, uint32 tileX, uint32 tileY, uint64 key, TileNavData const& tileData)
+    {
+        char fileName[255];
+        sprintf(fileName, "mmaps/cache/%04u%02i%02i.navcache", mapID, tileY, tileX);
+
+        // written under a temporary name first, an interrupted run must not leave a truncated entry behind
+        char tempFileName[260];
+        sprintf(tempFileName, "%s.tmp", fileName);
+        FILE* file = fopen(tempFileName, "wb");
+        if (!file)
+            return;
+
+        MmapCacheHeader header;
+        header.key = key;
+        header.size = uint32(tileData.size);
+        bool success = fwrite(&header, sizeof(MmapCacheHeader), 1, file) == 1;
+
+        // stored before the navmesh writes its links into the data
+        if (success && tileData.data)
+            success = fwrite(tileData.data, sizeof(unsigned char), tileData.size, file) == size_t(tileData.size);
+
+        success = fclose(file) == 0 && success;
+
+        remove(fileName);
+        if (!success || rename(tempFileName, fileName) != 0)
+            remove(tempFileName);
+    }
+
     /**************************************************************************/
     void MapBuilder::getTileBounds(uint32 tileX, uint32 tileY, float* verts, int vertCount, float* bmin, float* bmax)
     {
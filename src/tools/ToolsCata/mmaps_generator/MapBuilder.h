@@ -161,6 +161,40 @@ namespace MMAP
         rcPolyMeshDetail* dmesh;
     };
 
+    // detour data of one mmtile, not added to a navmesh yet
+    struct TileNavData
+    {
+        TileNavData() : data(NULL), size(0) {}
+
+        unsigned char* data;
+        int size;
+    };
+
+    // The tiles of a map are built by all worker threads. Built tiles are written in tile order, the navmesh
+    // hands out the same tile salts as in a serial build and the mmtiles stay byte identical.
+    struct MapBuildState
+    {
+        MapBuildState(uint32 mapId, dtNavMesh* navMesh) : m_mapId(mapId), m_navMesh(navMesh), m_nextWrite(0) {}
+
+        uint32 m_mapId;
+        dtNavMesh* m_navMesh;
+
+        std::vector<uint32> m_tileIds;
+        std::vector<TileNavData> m_tileData;
+        std::vector<bool> m_tileBuilt;
+        size_t m_nextWrite;
+        std::mutex m_lock;
+    };
+
+    struct TileTask
+    {
+        TileTask() : m_map(NULL), m_index(0) {}
+        TileTask(MapBuildState* map, uint32 index) : m_map(map), m_index(index) {}
+
+        MapBuildState* m_map;
+        uint32 m_index;
+    };
+
     class MapBuilder
     {
         public:
@@ -171,7 +205,8 @@ namespace MMAP
                 bool skipBattlegrounds   = false,
                 bool debugOutput         = false,
                 bool bigBaseUnit         = false,
-                const char* offMeshFilePath = NULL);
+                const char* offMeshFilePath = NULL,
+                bool buildCache          = true);
 
             ~MapBuilder();
 
@@ -183,6 +218,7 @@ namespace MMAP
             void buildSingleTile(uint32 mapID, uint32 tileX, uint32 tileY);
 
             // builds list of maps, then builds all of mmap tiles (based on the skip settings)
+            // the tiles of all maps are shared between the threads
             void buildAllMaps(int threads);
 
             void WorkerThread();
@@ -194,7 +230,14 @@ namespace MMAP
 
             void buildNavMesh(uint32 mapID, dtNavMesh* &navMesh);
 
+            // creates the navmesh and the list of tiles to build, NULL if there is nothing to build
+            MapBuildState* prepareMap(uint32 mapID);
+
+            // stores a built tile and writes all tiles of the map that are next in order
+            void finishTile(MapBuildState* state, uint32 index, TileNavData const& tileData);
+
             void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
+            TileNavData buildTileData(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
 
             // move map building
             void buildMoveMapTile(uint32 mapID,
@@ -203,7 +246,16 @@ namespace MMAP
                 MeshData &meshData,
                 float bmin[3],
                 float bmax[3],
-                dtNavMesh* navMesh);
+                dtNavMesh* navMesh,
+                TileNavData& tileData);
+
+            // adds the tile to the navmesh and writes the mmtile, frees the tile data
+            void writeMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, TileNavData const& tileData);
+
+            // build cache, tiles are looked up by a hash of their input geometry and build settings
+            uint64 getTileCacheKey(MeshData const& meshData, float const* bmin, float const* bmax, dtNavMesh const* navMesh) const;
+            bool loadCachedTile(uint32 mapID, uint32 tileX, uint32 tileY, uint64 key, TileNavData& tileData);
+            void storeCachedTile(uint32 mapID, uint32 tileX, uint32 tileY, uint64 key, TileNavData const& tileData);
 
             void getTileBounds(uint32 tileX, uint32 tileY,
                 float* verts, int vertCount,
@@ -226,13 +278,13 @@ namespace MMAP
 
             float m_maxWalkableAngle;
             bool m_bigBaseUnit;
+            bool m_buildCache;
 
             // build performance - not really used for now
             rcContext* m_rcContext;
 
             std::vector<std::thread> _workerThreads;
-            ProducerConsumerQueue<uint32> _queue;
-            std::atomic<bool> _cancelationToken;
+            ProducerConsumerQueue<TileTask> _queue;
     };
 }
 
@@ -0,0 +1,253 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Common.hpp"
+#include "VMapManager2.h"
+#include "FloorMapDefines.h"
+#include "Util.hpp"
+
+// Bakes the vmap surfaces of every extracted map tile into floors/MMMM_XX_YY.flr, the world server
+// reads heights from these instead of casting a ray per lookup.
+
+namespace
+{
+    const float tileSize = 533.3333333f;
+    const int32_t tilesPerMap = 64;
+    const float rayStartHeight = 20000.0f;
+    const float raySearchDistance = 40000.0f;
+
+    struct TileId
+    {
+        uint32_t mapId;
+        uint32_t tileX;
+        uint32_t tileY;
+    };
+
+    // world position of a grid point, cell centers use point + 0.5
+    float gridToWorld(uint32_t tile, float point)
+    {
+        return (32.0f - (tile + point / FLOOR_GRID_SIZE)) * tileSize;
+    }
+
+    // all surfaces of a column from top to bottom
+    void castColumn(VMAP::VMapManager2& vmapManager, TileId const& tile, float x, float y, std::vector<float>& layers)
+    {
+        layers.clear();
+
+        float z = rayStartHeight;
+        while (layers.size() <= FLOOR_MAX_LAYERS)
+        {
+            const float height = vmapManager.getHeight(tile.mapId, x, y, z, raySearchDistance);
+            if (height < VMAP_INVALID_HEIGHT)
+                break;
+
+            layers.push_back(height);
+            z = height - FLOOR_LAYER_MERGE_DISTANCE;
+        }
+    }
+
+    bool hasLayerNear(std::vector<float> const& layers, float height)
+    {
+        for (float layer : layers)
+        {
+            if (std::fabs(layer - height) <= FLOOR_CELL_TOLERANCE)
+                return true;
+        }
+
+        return false;
+    }
+
+    // a cell is baked if every corner sees the same surfaces as its center
+    bool isUniformCell(std::vector<float> const& center, std::vector<float> const* corners[4])
+    {
+        if (center.size() > FLOOR_MAX_LAYERS)
+            return false;
+
+        for (uint8_t i = 0; i < 4; ++i)
+        {
+            if (corners[i]->size() != center.size())
+                return false;
+
+            for (float layer : center)
+            {
+                if (!hasLayerNear(*corners[i], layer))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    // models of the 8 neighbour tiles can reach over the border cells of the baked tile
+    std::vector<std::pair<int32_t, int32_t>> loadNeighbourTiles(VMAP::VMapManager2& vmapManager, TileId const& tile)
+    {
+        std::vector<std::pair<int32_t, int32_t>> loadedTiles;
+        for (int32_t x = static_cast<int32_t>(tile.tileX) - 1; x <= static_cast<int32_t>(tile.tileX) + 1; ++x)
+        {
+            for (int32_t y = static_cast<int32_t>(tile.tileY) - 1; y <= static_cast<int32_t>(tile.tileY) + 1; ++y)
+            {
+                if (x < 0 || y < 0 || x >= tilesPerMap || y >= tilesPerMap)
+                    continue;
+
+                if (x == static_cast<int32_t>(tile.tileX) && y == static_cast<int32_t>(tile.tileY))
+                    continue;
+
+                if (vmapManager.loadMap("vmaps", tile.mapId, x, y) == VMAP::VMAP_LOAD_RESULT_OK)
+                    loadedTiles.emplace_back(x, y);
+            }
+        }
+
+        return loadedTiles;
+    }
+
+    bool bakeTile(TileId const& tile, std::string const& outputPath)
+    {
+        VMAP::VMapManager2 vmapManager;
+        if (vmapManager.loadMap("vmaps", tile.mapId, tile.tileX, tile.tileY) != VMAP::VMAP_LOAD_RESULT_OK)
+            return false;
+
+        const auto neighbourTiles = loadNeighbourTiles(vmapManager, tile);
+
+        const uint32_t pointCount = FLOOR_GRID_SIZE + 1;
+
+        // one row of corners is kept for the next row of cells
+        std::vector<std::vector<float>> cornerRow(pointCount);
+        std::vector<std::vector<float>> nextCornerRow(pointCount);
+        for (uint32_t j = 0; j < pointCount; ++j)
+            castColumn(vmapManager, tile, gridToWorld(tile.tileX, 0.0f), gridToWorld(tile.tileY, static_cast<float>(j)), cornerRow[j]);
+
+        std::vector<uint8_t> layerCounts(FLOOR_GRID_SIZE * FLOOR_GRID_SIZE);
+        std::vector<float> layers;
+        std::vector<float> center;
+        bool hasSurface = false;
+
+        for (uint32_t i = 0; i < FLOOR_GRID_SIZE; ++i)
+        {
+            for (uint32_t j = 0; j < pointCount; ++j)
+                castColumn(vmapManager, tile, gridToWorld(tile.tileX, i + 1.0f), gridToWorld(tile.tileY, static_cast<float>(j)), nextCornerRow[j]);
+
+            for (uint32_t j = 0; j < FLOOR_GRID_SIZE; ++j)
+            {
+                castColumn(vmapManager, tile, gridToWorld(tile.tileX, i + 0.5f), gridToWorld(tile.tileY, j + 0.5f), center);
+
+                const std::vector<float>* corners[4] = { &cornerRow[j], &cornerRow[j + 1], &nextCornerRow[j], &nextCornerRow[j + 1] };
+
+                uint8_t& layerCount = layerCounts[i * FLOOR_GRID_SIZE + j];
+                if (isUniformCell(center, corners))
+                {
+                    layerCount = static_cast<uint8_t>(center.size());
+                    layers.insert(layers.end(), center.begin(), center.end());
+                }
+                else
+                {
+                    layerCount = FLOOR_CELL_RAY_CAST;
+                }
+
+                hasSurface |= !center.empty();
+            }
+
+            cornerRow.swap(nextCornerRow);
+        }
+
+        for (auto const& neighbourTile : neighbourTiles)
+            vmapManager.unloadMap(tile.mapId, neighbourTile.first, neighbourTile.second);
+
+        vmapManager.unloadMap(tile.mapId, tile.tileX, tile.tileY);
+
+        // tiles without any model are ray cast free anyway
+        if (!hasSurface)
+            return true;
+
+        char fileName[1024];
+        sprintf(fileName, "%s/%04u_%02u_%02u.flr", outputPath.c_str(), tile.mapId, tile.tileX, tile.tileY);
+
+        FILE* file = fopen(fileName, "wb");
+        if (file == nullptr)
+        {
+            std::cout << "Can't create " << fileName << std::endl;
+            return false;
+        }
+
+        FloorTileHeader header;
+        header.layerCount = static_cast<uint32_t>(layers.size());
+
+        fwrite(&header, sizeof(header), 1, file);
+        fwrite(layerCounts.data(), sizeof(uint8_t), layerCounts.size(), file);
+        fwrite(layers.data(), sizeof(float), layers.size(), file);
+        fclose(file);
+
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 3)
+    {
+        std::cout << "usage: " << argv[0] << " [floor dest dir] [threads]" << std::endl;
+        return 1;
+    }
+
+    // run from the directory that holds the extracted maps and vmaps
+    const std::string outputPath = argc > 1 ? argv[1] : "floors";
+    uint32_t threadCount = argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : std::thread::hardware_concurrency();
+    if (threadCount == 0)
+        threadCount = 1;
+
+    fs::create_directories(outputPath);
+
+    std::vector<TileId> tiles;
+    for (auto const& mapFile : Util::getDirectoryContent("maps", ".map"))
+    {
+        const size_t nameStart = mapFile.second.find_last_of("/\\");
+        const std::string fileName = nameStart == std::string::npos ? mapFile.second : mapFile.second.substr(nameStart + 1);
+
+        TileId tile;
+        if (sscanf(fileName.c_str(), "%04u_%02u_%02u.map", &tile.mapId, &tile.tileX, &tile.tileY) == 3)
+            tiles.push_back(tile);
+    }
+
+    std::cout << "Baking floors of " << tiles.size() << " tiles with " << threadCount << " threads to " << outputPath << std::endl;
+
+    std::atomic<size_t> nextTile(0);
+    std::atomic<size_t> bakedTiles(0);
+    std::mutex outputMutex;
+
+    std::vector<std::thread> workers;
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        workers.emplace_back([&]()
+        {
+            for (size_t index = nextTile++; index < tiles.size(); index = nextTile++)
+            {
+                TileId const& tile = tiles[index];
+                if (!bakeTile(tile, outputPath))
+                    continue;
+
+                const size_t done = ++bakedTiles;
+
+                std::lock_guard<std::mutex> guard(outputMutex);
+                std::cout << "[" << done << "/" << tiles.size() << "] map " << tile.mapId << " tile " << tile.tileX << " " << tile.tileY << std::endl;
+            }
+        });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    std::cout << "Ok, all done" << std::endl;
+    return 0;
+}
@@ -0,0 +1,53 @@
+#!/bin/sh
+# Builds the mmaps once serially and once on worker threads and compares the results byte by byte.
+# Run it where mmaps_generator runs (next to maps and vmaps). The first argument is the thread
+# count of the parallel build, further arguments are passed to both builds, e.g.
+#   ./mmaps_compare.sh 8 --skipContinents true --skipJunkMaps true
+# The build cache is turned off for both builds, an existing mmaps directory is moved aside and restored.
+
+THREADS=${1:-4}
+[ $# -gt 0 ] && shift
+
+if [ -e mmaps_serial ] || [ -e mmaps_parallel ] || [ -e mmaps_compare_backup ]; then
+    echo "remove mmaps_serial, mmaps_parallel and mmaps_compare_backup first"
+    exit 2
+fi
+
+if [ -d mmaps ]; then
+    mv mmaps mmaps_compare_backup || exit 2
+fi
+
+# build <output dir> <threads> [options]
+build()
+{
+    OUTPUT=$1
+    shift
+    mkdir -p mmaps
+    ./mmaps_generator --silent --buildCache false --threads "$@" || return 1
+    rm -rf mmaps/cache
+    mv mmaps "$OUTPUT"
+}
+
+build mmaps_serial 0 "$@"
+SERIAL_RESULT=$?
+build mmaps_parallel "$THREADS" "$@"
+PARALLEL_RESULT=$?
+
+if [ -d mmaps_compare_backup ]; then
+    rm -rf mmaps
+    mv mmaps_compare_backup mmaps
+fi
+
+if [ $SERIAL_RESULT -ne 0 ] || [ $PARALLEL_RESULT -ne 0 ]; then
+    echo "mmaps_generator failed"
+    exit 2
+fi
+
+if diff -rq mmaps_serial mmaps_parallel; then
+    echo "serial and parallel ($THREADS threads) mmaps are identical"
+    rm -rf mmaps_serial mmaps_parallel
+    exit 0
+fi
+
+echo "serial and parallel ($THREADS threads) mmaps differ, kept in mmaps_serial and mmaps_parallel"
+exit 1
@@ -19,23 +19,27 @@
 
 #include <string>
 #include <iostream>
+#include <cstdlib>
+#include <thread>
 
 #include "TileAssembler.h"
 
 int main(int argc, char* argv[])
 {
-    if (argc != 3)
+    if (argc != 3 && argc != 4)
     {
-        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir>" << std::endl;
+        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir> [threads]" << std::endl;
         return 1;
     }
 
     std::string src = argv[1];
     std::string dest = argv[2];
+    unsigned int threads = argc == 4 ? static_cast<unsigned int>(atoi(argv[3])) : std::thread::hardware_concurrency();
 
     std::cout << "using " << src << " as source directory and writing output to " << dest << std::endl;
 
     VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest);
+    ta->setThreadCount(threads);
 
     if (!ta->convertWorld2())
     {
@@ -2,4 +2,5 @@
 mkdir -p vmaps
 ./vmap_extractor
 ./vmap_assembler Buildings vmaps
+./floor_baker floors
 
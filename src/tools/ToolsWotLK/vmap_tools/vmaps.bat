@@ -2,4 +2,5 @@
 mkdir vmaps
 vmap4_extractor.exe
 vmap4_assembler Buildings vmaps
+floor_baker.exe floors
 pause
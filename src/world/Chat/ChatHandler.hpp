@@ -203,6 +203,7 @@ class SERVER_DECL ChatHandler
         bool HandleDebugSetPlayerFlagsCommand(const char* args, WorldSession* m_session);
         bool HandleDebugGetPlayerFlagsCommand(const char* /*args*/, WorldSession* m_session);
         bool HandleDebugSetWeatherCommand(const char* args, WorldSession* m_session);
+        bool HandleDebugLfgSimulateCommand(const char* args, WorldSession* m_session);
 
         // old debugcmds.cpp
         //\todo Rewrite these commands
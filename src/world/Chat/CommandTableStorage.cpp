@@ -418,6 +418,7 @@ void CommandTableStorage::Init()
         { "setplayerflags",     'd', &ChatHandler::HandleDebugSetPlayerFlagsCommand,"Add player flags x to selected player",                    nullptr },
         { "getplayerflags",     'd', &ChatHandler::HandleDebugGetPlayerFlagsCommand,"Display current player flags of selected player x",        nullptr },
         { "setweather",         'd', &ChatHandler::HandleDebugSetWeatherCommand,    "Change zone weather <type> <densitiy>",        nullptr },
+        { "lfgsimulate",        'd', &ChatHandler::HandleDebugLfgSimulateCommand,   "Simulates <players> joining the lfg matchmaker",           nullptr },
         { nullptr,              '0', nullptr,                                       "",                                                         nullptr }
     };
     dupe_command_table(debugCommandTable, _debugCommandTable);
@@ -1553,7 +1553,7 @@ bool ChatHandler::HandleCharSetNameCommand(const char* args, WorldSession* m_ses
     Player* plr = sObjectMgr.GetPlayer(pi->guid);
     if (plr != nullptr)
     {
-        plr->setName(new_name);
+        sObjectMgr.RenameOnlinePlayer(plr, new_name);
         BlueSystemMessage(plr->GetSession(), "%s changed your name to '%s'.", m_session->GetPlayer()->getName().c_str(), new_name.c_str());
         plr->SaveToDB(false);
     }
@@ -10,6 +10,7 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Server/ServerState.h"
 #include "Objects/ObjectMgr.h"
 #include "Management/WeatherMgr.h"
+#include "Management/LFG/LFGMatchmaker.h"
 
 bool ChatHandler::HandleDoPercentDamageCommand(const char* args, WorldSession* session)
 {
@@ -538,3 +539,29 @@ bool ChatHandler::HandleDebugSetWeatherCommand(const char* args, WorldSession* m
 
     return true;
 }
+
+//.debug lfgsimulate
+bool ChatHandler::HandleDebugLfgSimulateCommand(const char* args, WorldSession* m_session)
+{
+    uint32_t players = 10000;
+    uint32_t dungeons = 30;
+    sscanf(args, "%u %u", &players, &dungeons);
+
+    if (players == 0 || players > 1000000)
+    {
+        RedSystemMessage(m_session, "Command must be in format <players 1-1000000> <dungeons>.");
+        return true;
+    }
+
+    // synthetic players, the real queue is not touched
+    const LfgMatchmakerSimulation result = LfgMatchmaker::simulate(players, dungeons);
+
+    SystemMessage(m_session, "Lfg matchmaker: %u players for %u dungeons, %u proposals, %u still queued.", result.players, dungeons, result.proposals, result.leftInQueue);
+    SystemMessage(m_session, "Matching time: %u ms total, %u us max per join, %u us average per proposal.",
+        static_cast<uint32_t>(result.totalMicroseconds / 1000), static_cast<uint32_t>(result.maxMicroseconds),
+        result.proposals ? static_cast<uint32_t>(result.proposalMicroseconds / result.proposals) : 0);
+    SystemMessage(m_session, "Grouped players waited %u joins on average for their proposal.",
+        result.proposals ? static_cast<uint32_t>(result.waitedJoins / (result.proposals * 4)) : 0);
+
+    return true;
+}
@@ -8,6 +8,9 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Storage/MySQLDataStore.hpp"
 #include "Server/MainServerDefines.h"
 #include "Server/Master.h"
+#include "Server/QueryResponseCache.h"
+#include "Management/GuildSaveQueue.h"
+#include "Management/ObjectUpdates/UpdateCompressor.h"
 
 //.server info
 bool ChatHandler::HandleServerInfoCommand(const char* /*args*/, WorldSession* m_session)
@@ -53,6 +56,11 @@ bool ChatHandler::HandleServerInfoCommand(const char* /*args*/, WorldSession* m_
     GreenSystemMessage(m_session, "RAM Usage: %6.2f MB", sWorld.getRAMUsage());
     GreenSystemMessage(m_session, "SQL Query Cache Size (World): |r%u queries delayed", WorldDatabase.GetQueueSize());
     GreenSystemMessage(m_session, "SQL Query Cache Size (Character): |r%u queries delayed", CharacterDatabase.GetQueueSize());
+    GreenSystemMessage(m_session, "Guild Write Queue: |r%u writes pending (%llu coalesced)", static_cast<uint32_t>(sGuildSaveQueue.getQueueDepth()), sGuildSaveQueue.getCoalescedCount());
+    const auto compression = UpdateCompressor::getStats();
+    GreenSystemMessage(m_session, "Update Compression: |r%llu packets, ratio %.2f, %.1f us per packet (large packet level %d)", compression.packetCount,
+        compression.inputBytes > 0 ? static_cast<double>(compression.outputBytes) / compression.inputBytes : 0.0,
+        compression.packetCount > 0 ? static_cast<double>(compression.microseconds) / compression.packetCount : 0.0, compression.largeBufferLevel);
     GreenSystemMessage(m_session, "Socket Count: |r%u", sSocketMgr.GetSocketCount());
 
     return true;
@@ -264,6 +272,7 @@ bool ChatHandler::HandleReloadGameobjectsCommand(const char* /*args*/, WorldSess
 {
     auto startTime = Util::TimeNow();
     sMySQLStore.loadGameObjectPropertiesTable();
+    sQueryResponseCache.invalidate(CMSG_GAMEOBJECT_QUERY);
     GreenSystemMessage(m_session, "WorldDB gameobjects tables reloaded in %u ms", static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
     return true;
 }
@@ -273,6 +282,7 @@ bool ChatHandler::HandleReloadCreaturesCommand(const char* /*args*/, WorldSessio
 {
     auto startTime = Util::TimeNow();
     sMySQLStore.loadCreaturePropertiesTable();
+    sQueryResponseCache.invalidate(CMSG_CREATURE_QUERY);
     GreenSystemMessage(m_session, "WorldDB creature tables reloaded in %u ms", static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
     return true;
 }
@@ -329,6 +339,7 @@ bool ChatHandler::HandleReloadItemsCommand(const char* /*args*/, WorldSession* m
 {
     auto startTime = Util::TimeNow();
     sMySQLStore.loadItemPropertiesTable();
+    sQueryResponseCache.invalidate(CMSG_ITEM_QUERY_SINGLE);
     GreenSystemMessage(m_session, "WorldDB table 'items' reloaded in %u ms", static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
     return true;
 }
@@ -338,6 +349,7 @@ bool ChatHandler::HandleReloadItempagesCommand(const char* /*args*/, WorldSessio
 {
     auto startTime = Util::TimeNow();
     sMySQLStore.loadItemPagesTable();
+    sQueryResponseCache.invalidate(CMSG_PAGE_TEXT_QUERY);
     GreenSystemMessage(m_session, "WorldDB 'itempages' table reloaded in %u ms", static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
     return true;
 }
@@ -356,6 +368,7 @@ bool ChatHandler::HandleReloadNpcTextCommand(const char* /*args*/, WorldSession*
 {
     auto startTime = Util::TimeNow();
     sMySQLStore.loadNpcTextTable();
+    sQueryResponseCache.invalidate(CMSG_NPC_TEXT_QUERY);
     GreenSystemMessage(m_session, "WorldDB 'npc_text' table reloaded in %u ms", static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
     return true;
 }
@@ -392,6 +405,7 @@ bool ChatHandler::HandleReloadQuestsCommand(const char* /*args*/, WorldSession*
 {
     auto startTime = Util::TimeNow();
     sMySQLStore.loadQuestPropertiesTable();
+    sQueryResponseCache.invalidate(CMSG_QUEST_QUERY);
     GreenSystemMessage(m_session, "WorldDB 'quest_properties' table reloaded in %u ms", static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
     return true;
 }
@@ -428,6 +442,7 @@ bool ChatHandler::HandleReloadWorldstringTablesCommand(const char* /*args*/, Wor
 {
     auto startTime = Util::TimeNow();
     sMySQLStore.loadWorldStringsTable();
+    sQueryResponseCache.invalidate(CMSG_NPC_TEXT_QUERY);
     GreenSystemMessage(m_session, "WorldDB 'worldstring_tables' table reloaded in %u ms", static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
     return true;
 }
@@ -683,6 +683,9 @@ void CBattleground::RemovePlayer(Player* plr, bool logout)
         sBattlegroundManager.SendBattlefieldStatus(plr, BGSTATUS_NOFLAGS, 0, 0, 0, 0, 0);
     }
 
+    if (!m_ended)
+        sBattlegroundManager.OnBattlegroundSlotFreed(this);
+
     if (/*!m_ended && */m_players[0].size() == 0 && m_players[1].size() == 0)
     {
         /* create an inactive event */
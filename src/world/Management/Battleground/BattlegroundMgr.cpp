@@ -50,8 +50,15 @@ void CBattlegroundManager::initialize()
     {
         m_instances[i].clear();
         m_maxBattlegroundId[i] = 0;
+
+        for (uint8 j = 0; j < MAX_LEVEL_GROUP; ++j)
+            m_pendingQueueUpdate[i][j] = false;
+
+        m_pendingGroupQueueUpdate[i] = false;
     }
 
+    m_queueMatchScheduled = false;
+
     // These battlegrounds will be available in Random Battleground queue
     avalibleInRandom.push_back(BATTLEGROUND_ALTERAC_VALLEY);
     avalibleInRandom.push_back(BATTLEGROUND_WARSONG_GULCH);
@@ -282,7 +289,7 @@ void CBattlegroundManager::HandleBattlegroundJoin(WorldSession* m_session, World
 
     // Queue him!
     m_queueLock.Acquire();
-    m_queuedPlayers[srlPacket.bgType][lgroup].push_back(pguid);
+    m_queuedPlayers[srlPacket.bgType][lgroup].addPlayer(pguid, plr->getTeam());
     LogNotice("BattlegroundManager : Player %u is now in battleground queue for instance %u", m_session->GetPlayer()->getGuidLow(), (srlPacket.instanceId + 1));
 
     plr->m_bgIsQueued = true;
@@ -298,19 +305,11 @@ void CBattlegroundManager::HandleBattlegroundJoin(WorldSession* m_session, World
 
     SendBattlefieldStatus(plr, BGSTATUS_INQUEUE, srlPacket.bgType, srlPacket.instanceId, 0, bgMaps[srlPacket.bgType], 0);
 
+    const bool startable = IsQueueStartable(srlPacket.bgType, lgroup);
     m_queueLock.Release();
-}
 
-void ErasePlayerFromList(uint32 guid, std::list<uint32>* l)
-{
-    for (std::list<uint32>::iterator itr = l->begin(); itr != l->end(); ++itr)
-    {
-        if ((*itr) == guid)
-        {
-            l->erase(itr);
-            return;
-        }
-    }
+    if (srlPacket.instanceId || startable || HasJoinableInstance(srlPacket.bgType, lgroup))
+        ScheduleQueueUpdate(srlPacket.bgType, lgroup);
 }
 
 uint8 GetBattlegroundCaption(BattleGroundTypes bgType)
@@ -343,7 +342,6 @@ void CBattlegroundManager::HandleGetBattlegroundQueueCommand(WorldSession* m_ses
     std::stringstream ss;
 
     Player* plr;
-    std::list<uint32>::iterator it3, it4;
 
     m_queueLock.Acquire();
 
@@ -353,7 +351,7 @@ void CBattlegroundManager::HandleGetBattlegroundQueueCommand(WorldSession* m_ses
     {
         for (uint8 j = 0; j < MAX_LEVEL_GROUP; ++j)
         {
-            if (!m_queuedPlayers[i][j].size())
+            if (m_queuedPlayers[i][j].getPlayerCount() == 0)
                 continue;
 
             foundSomething = true;
@@ -390,16 +388,15 @@ void CBattlegroundManager::HandleGetBattlegroundQueueCommand(WorldSession* m_ses
 
             ss << ": ";
 
-            ss << (uint32)m_queuedPlayers[i][j].size() << " players queued";
+            ss << (uint32)m_queuedPlayers[i][j].getPlayerCount() << " players queued";
 
             if (!isArena(i))
             {
                 int ally = 0, horde = 0;
 
-                for (it3 = m_queuedPlayers[i][j].begin(); it3 != m_queuedPlayers[i][j].end();)
+                for (uint32 queuedGuid : m_queuedPlayers[i][j].getPlayers())
                 {
-                    it4 = it3++;
-                    plr = sObjectMgr.GetPlayer(*it4);
+                    plr = sObjectMgr.GetPlayer(queuedGuid);
 
                     if (!plr || GetLevelGrouping(plr->getLevel()) != j)
                     {
@@ -413,8 +410,8 @@ void CBattlegroundManager::HandleGetBattlegroundQueueCommand(WorldSession* m_ses
                 }
 
                 ss << " (Alliance: " << ally << " Horde: " << horde;
-                if ((int)m_queuedPlayers[i][j].size() > (ally + horde))
-                    ss << " Unknown: " << ((int)m_queuedPlayers[i][j].size() - ally - horde);
+                if ((int)m_queuedPlayers[i][j].getPlayerCount() > (ally + horde))
+                    ss << " Unknown: " << ((int)m_queuedPlayers[i][j].getPlayerCount() - ally - horde);
                 ss << ")";
             }
 
@@ -527,8 +524,6 @@ int CBattlegroundManager::CreateArenaType(int type, Group* group1, Group* group2
     if (ar == NULL)
     {
         LOG_ERROR("%s (%u): Couldn't create Arena Instance", __FILE__, __LINE__);
-        m_queueLock.Release();
-        m_instanceLock.Release();
         return -1;
     }
     ar->rated_match = true;
@@ -550,7 +545,7 @@ void CBattlegroundManager::AddPlayerToBg(CBattleground* bg, std::deque<uint32> *
         if (bg->CanPlayerJoin(plr, bg->GetType()))
         {
             bg->AddPlayer(plr, plr->getTeam());
-            ErasePlayerFromList(plr->getGuidLow(), &m_queuedPlayers[i][j]);
+            m_queuedPlayers[i][j].removePlayer(plr->getGuidLow());
         }
         else
         {
@@ -560,7 +555,7 @@ void CBattlegroundManager::AddPlayerToBg(CBattleground* bg, std::deque<uint32> *
     }
     else
     {
-        ErasePlayerFromList(plrguid, &m_queuedPlayers[i][j]);
+        m_queuedPlayers[i][j].removePlayer(plrguid);
     }
 }
 
@@ -577,18 +572,156 @@ void CBattlegroundManager::AddPlayerToBgTeam(CBattleground* bg, std::deque<uint3
             plr->setBgTeam(Team);
             bg->AddPlayer(plr, Team);
         }
-        ErasePlayerFromList(plrguid, &m_queuedPlayers[i][j]);
+        m_queuedPlayers[i][j].removePlayer(plrguid);
     }
 }
 
 void CBattlegroundManager::EventQueueUpdate(bool forceStart)
+{
+    m_queueLock.Acquire();
+    m_instanceLock.Acquire();
+
+    bool updated = true;
+    for (uint8 i = 0; i < BATTLEGROUND_NUM_TYPES && updated; ++i)
+    {
+        for (uint8 j = 0; j < MAX_LEVEL_GROUP && updated; ++j)
+            updated = UpdateQueue(i, j, forceStart);
+    }
+
+    // Handle paired arena team joining
+    for (uint8 i = BATTLEGROUND_ARENA_2V2; i <= BATTLEGROUND_ARENA_5V5 && updated; ++i)
+        updated = UpdateArenaGroupQueue(i, forceStart);
+
+    m_queueLock.Release();
+    m_instanceLock.Release();
+}
+
+void CBattlegroundManager::EventQueueMatch()
+{
+    // joins from now on schedule a new match
+    m_queueMatchScheduled = false;
+
+    m_queueLock.Acquire();
+    m_instanceLock.Acquire();
+
+    bool updated = true;
+    for (uint8 i = 0; i < BATTLEGROUND_NUM_TYPES && updated; ++i)
+    {
+        for (uint8 j = 0; j < MAX_LEVEL_GROUP && updated; ++j)
+        {
+            if (m_pendingQueueUpdate[i][j].exchange(false))
+                updated = UpdateQueue(i, j, false);
+        }
+    }
+
+    for (uint8 i = BATTLEGROUND_ARENA_2V2; i <= BATTLEGROUND_ARENA_5V5 && updated; ++i)
+    {
+        if (m_pendingGroupQueueUpdate[i].exchange(false))
+            updated = UpdateArenaGroupQueue(i, false);
+    }
+
+    m_queueLock.Release();
+    m_instanceLock.Release();
+}
+
+void CBattlegroundManager::ScheduleQueueUpdate(uint32 Type, uint32 LevelGroup)
+{
+    if (Type >= BATTLEGROUND_NUM_TYPES || LevelGroup >= MAX_LEVEL_GROUP)
+        return;
+
+    m_pendingQueueUpdate[Type][LevelGroup] = true;
+
+    if (!m_queueMatchScheduled.exchange(true))
+        sEventMgr.AddEvent(this, &CBattlegroundManager::EventQueueMatch, EVENT_BATTLEGROUND_QUEUE_UPDATE, 1, 1, 0);
+}
+
+void CBattlegroundManager::ScheduleGroupQueueUpdate(uint32 Type)
+{
+    if (!isArena(Type))
+        return;
+
+    m_pendingGroupQueueUpdate[Type] = true;
+
+    if (!m_queueMatchScheduled.exchange(true))
+        sEventMgr.AddEvent(this, &CBattlegroundManager::EventQueueMatch, EVENT_BATTLEGROUND_QUEUE_UPDATE, 1, 1, 0);
+}
+
+void CBattlegroundManager::OnBattlegroundSlotFreed(CBattleground* bg)
+{
+    const uint32 type = bg->GetType();
+    const uint32 levelGroup = bg->GetLevelGroup();
+
+    ScheduleQueueUpdate(type, levelGroup);
+
+    // random queue players fill every battleground type that is available in random
+    if (std::find(avalibleInRandom.begin(), avalibleInRandom.end(), type) != avalibleInRandom.end())
+        ScheduleQueueUpdate(BATTLEGROUND_RANDOM, levelGroup);
+}
+
+bool CBattlegroundManager::IsQueueStartable(uint32 Type, uint32 LevelGroup)
+{
+    const BattlegroundQueue& queue = m_queuedPlayers[Type][LevelGroup];
+
+    if (isArena(Type))
+        return queue.getPlayerCount() >= GetMinimumPlayers(Type) * 2;
+
+    std::vector<uint32> startTypes;
+    if (Type == BATTLEGROUND_RANDOM)
+        startTypes = avalibleInRandom;
+    else
+        startTypes.push_back(Type);
+
+    for (uint32 startType : startTypes)
+    {
+        const uint32 minPlayers = GetMinimumPlayers(startType);
+        if (queue.getTeamPlayerCount(TEAM_ALLIANCE) >= minPlayers && queue.getTeamPlayerCount(TEAM_HORDE) >= minPlayers)
+            return true;
+    }
+
+    return false;
+}
+
+bool CBattlegroundManager::HasJoinableInstance(uint32 Type, uint32 LevelGroup)
+{
+    std::vector<uint32> joinTypes;
+    if (Type == BATTLEGROUND_RANDOM)
+        joinTypes = avalibleInRandom;
+    else
+        joinTypes.push_back(Type);
+
+    bool joinable = false;
+
+    m_instanceLock.Acquire();
+    for (uint32 joinType : joinTypes)
+    {
+        for (const auto& instance : m_instances[joinType])
+        {
+            CBattleground* bg = instance.second;
+            if (bg->HasEnded() || bg->GetLevelGroup() != LevelGroup || bg->IsFull())
+                continue;
+
+            if (isArena(joinType) && static_cast<Arena*>(bg)->Rated())
+                continue;
+
+            joinable = true;
+            break;
+        }
+
+        if (joinable)
+            break;
+    }
+    m_instanceLock.Release();
+
+    return joinable;
+}
+
+bool CBattlegroundManager::UpdateQueue(uint32 i, uint32 j, bool forceStart)
 {
     std::deque<uint32> tempPlayerVec[2];
 
     Player* plr;
     CBattleground* bg;
 
-    std::list<uint32>::iterator it3, it4;
     std::map<uint32, CBattleground*>::iterator iitr;
 
     Arena* arena;
@@ -600,375 +733,353 @@ void CBattlegroundManager::EventQueueUpdate(bool forceStart)
 
     std::queue<uint32> teams[MAX_PLAYER_TEAMS];
 
-    m_queueLock.Acquire();
-    m_instanceLock.Acquire();
+    if (m_queuedPlayers[i][j].getPlayerCount() == 0)
+        return true;
 
-    for (uint8 i = 0; i < BATTLEGROUND_NUM_TYPES; ++i)
+    // We try to add the players who queued for a specific Bg/Arena instance to
+    // the Bg/Arena where they queued to, and add the rest to another list
+    for (uint32 queuedGuid : m_queuedPlayers[i][j].getPlayers())
     {
-        for (uint8 j = 0; j < MAX_LEVEL_GROUP; ++j)
+        plrguid = queuedGuid;
+        plr = sObjectMgr.GetPlayer(plrguid);
+
+        // Player has left the game or switched level group since queuing (by leveling for example)
+        if (!plr || GetLevelGrouping(plr->getLevel()) != j)
         {
-            if (!m_queuedPlayers[i][j].size())
-                continue;
+            m_queuedPlayers[i][j].removePlayer(plrguid);
+            continue;
+        }
 
-            tempPlayerVec[0].clear();
-            tempPlayerVec[1].clear();
+        // queued to a specific instance id?
+        if (plr->m_bgQueueInstanceId != 0)
+        {
+            iitr = m_instances[i].find(plr->m_bgQueueInstanceId);
+            if (iitr == m_instances[i].end())
+            {
+                // queue no longer valid, since instance has closed since queuing
+                plr->GetSession()->SystemMessage(plr->GetSession()->LocalizedWorldSrv(52), plr->m_bgQueueInstanceId);
+                plr->m_bgIsQueued = false;
+                plr->m_bgQueueType = 0;
+                plr->m_bgQueueInstanceId = 0;
+                m_queuedPlayers[i][j].removePlayer(plrguid);
+                continue;
+            }
 
-            // We try to add the players who queued for a specific Bg/Arena instance to
-            // the Bg/Arena where they queued to, and add the rest to another list
-            for (it3 = m_queuedPlayers[i][j].begin(); it3 != m_queuedPlayers[i][j].end();)
+            // can we join the specified Bg instance?
+            bg = iitr->second;
+            if (bg->CanPlayerJoin(plr, bg->GetType()))
             {
-                it4 = it3++;
-                plrguid = *it4;
-                plr = sObjectMgr.GetPlayer(plrguid);
+                bg->AddPlayer(plr, plr->getTeam());
+                m_queuedPlayers[i][j].removePlayer(plrguid);
+            }
+        }
+        else
+        {
+            if (isArena(i))
+                tempPlayerVec[plr->getTeam()].push_back(plrguid);
+            else if (!plr->HasAura(BG_DESERTER))
+                tempPlayerVec[plr->getTeam()].push_back(plrguid);
+        }
+    }
 
-                // Player has left the game or switched level group since queuing (by leveling for example)
-                if (!plr || GetLevelGrouping(plr->getLevel()) != j)
-                {
-                    m_queuedPlayers[i][j].erase(it4);
+
+    /// Now that we have a list of players who didn't queue for a specific instance
+    /// try to add them to a Bg/Arena that is already under way
+    std::vector<uint32> tryJoinVec;
+    if (i == BATTLEGROUND_RANDOM)
+    {
+        tryJoinVec = avalibleInRandom;
+    }
+    else
+    {
+        tryJoinVec.push_back(i);
+    }
+
+    for (uint32 bgIndex = 0; bgIndex < tryJoinVec.size(); bgIndex++)
+    {
+        uint32 tmpJoinBgType = tryJoinVec[bgIndex];
+
+        for (iitr = m_instances[tmpJoinBgType].begin(); iitr != m_instances[tmpJoinBgType].end(); ++iitr)
+        {
+            if (iitr->second->HasEnded() || iitr->second->GetLevelGroup() != j)
+                continue;
+
+            if (isArena(i))
+            {
+                arena = static_cast<Arena*>(iitr->second);
+                if (arena->Rated())
                     continue;
-                }
 
-                // queued to a specific instance id?
-                if (plr->m_bgQueueInstanceId != 0)
+                factionMap[0] = arena->GetTeamFaction(0);
+                factionMap[1] = arena->GetTeamFaction(1);
+
+                team = arena->GetFreeTeam();
+                while ((team >= 0) && (tempPlayerVec[factionMap[team]].size() > 0))
                 {
-                    iitr = m_instances[i].find(plr->m_bgQueueInstanceId);
-                    if (iitr == m_instances[i].end())
+                    plrguid = *tempPlayerVec[factionMap[team]].begin();
+                    tempPlayerVec[factionMap[team]].pop_front();
+                    plr = sObjectMgr.GetPlayer(plrguid);
+                    if (plr)
                     {
-                        // queue no longer valid, since instance has closed since queuing
-                        plr->GetSession()->SystemMessage(plr->GetSession()->LocalizedWorldSrv(52), plr->m_bgQueueInstanceId);
-                        plr->m_bgIsQueued = false;
-                        plr->m_bgQueueType = 0;
-                        plr->m_bgQueueInstanceId = 0;
-                        m_queuedPlayers[i][j].erase(it4);
-                        continue;
+                        plr->setBgTeam(team);
+                        arena->AddPlayer(plr, team);
+                        team = arena->GetFreeTeam();
                     }
+                    m_queuedPlayers[i][j].removePlayer(plrguid);
+                }
+            }
+            else
+            {
+                bg = iitr->second;
+                int size = (int)std::min(tempPlayerVec[0].size(), tempPlayerVec[1].size());
+                for (int counter = 0; (counter < size) && (bg->IsFull() == false); counter++)
+                {
+                    AddPlayerToBgTeam(bg, &tempPlayerVec[0], i, j, 0);
+                    AddPlayerToBgTeam(bg, &tempPlayerVec[1], i, j, 1);
+                }
 
-                    // can we join the specified Bg instance?
-                    bg = iitr->second;
-                    if (bg->CanPlayerJoin(plr, bg->GetType()))
-                    {
-                        bg->AddPlayer(plr, plr->getTeam());
-                        m_queuedPlayers[i][j].erase(it4);
-                    }
+                while (tempPlayerVec[0].size() > 0 && bg->HasFreeSlots(0, bg->GetType()))
+                {
+                    AddPlayerToBgTeam(bg, &tempPlayerVec[0], i, j, 0);
                 }
-                else
+                while (tempPlayerVec[1].size() > 0 && bg->HasFreeSlots(1, bg->GetType()))
                 {
-                    if (isArena(i))
-                        tempPlayerVec[plr->getTeam()].push_back(plrguid);
-                    else if (!plr->HasAura(BG_DESERTER))
-                        tempPlayerVec[plr->getTeam()].push_back(plrguid);
+                    AddPlayerToBgTeam(bg, &tempPlayerVec[1], i, j, 1);
                 }
             }
+        }
+    }
 
+    // Now that that we added everyone we could to a running Bg/Arena
+    // We shall see if we can start a new one!
+    if (isArena(i))
+    {
+        // enough players to start a round?
+        uint32 minPlayers = sBattlegroundManager.GetMinimumPlayers(i);
+        if (!forceStart && ((tempPlayerVec[0].size() + tempPlayerVec[1].size()) < (minPlayers * 2)))
+            return true;
 
-            /// Now that we have a list of players who didn't queue for a specific instance
-            /// try to add them to a Bg/Arena that is already under way
-            std::vector<uint32> tryJoinVec;
-            if (i == BATTLEGROUND_RANDOM)
+        if (CanCreateInstance(i, j))
+        {
+            arena = static_cast<Arena*>(CreateInstance(i, j));
+            if (arena == NULL)
             {
-                tryJoinVec = avalibleInRandom;
-            }
-            else
+                LOG_ERROR("%s (%u): Couldn't create Arena Instance", __FILE__, __LINE__);
+                return false;
+            } // No alliance in the queue
+            if (tempPlayerVec[0].size() == 0)
             {
-                tryJoinVec.push_back(i);
+                count = GetMaximumPlayers(i) * 2;
+                while ((count > 0) && (tempPlayerVec[1].size() > 0))
+                {
+                    if (teams[0].size() > teams[1].size())
+                        teams[1].push(tempPlayerVec[1].front());
+                    else
+                        teams[0].push(tempPlayerVec[1].front());
+                    tempPlayerVec[1].pop_front();
+                    count--;
+                }
             }
-
-            for (uint32 bgIndex = 0; bgIndex < tryJoinVec.size(); bgIndex++)
-            {
-                uint32 tmpJoinBgType = tryJoinVec[bgIndex];
-
-                for (iitr = m_instances[tmpJoinBgType].begin(); iitr != m_instances[tmpJoinBgType].end(); ++iitr)
+            else // No horde in the queue
+                if (tempPlayerVec[1].size() == 0)
                 {
-                    if (iitr->second->HasEnded() || iitr->second->GetLevelGroup() != j)
-                        continue;
-
-                    if (isArena(i))
+                    count = GetMaximumPlayers(i) * 2;
+                    while ((count > 0) && (tempPlayerVec[0].size() > 0))
                     {
-                        arena = static_cast<Arena*>(iitr->second);
-                        if (arena->Rated())
-                            continue;
-
-                        factionMap[0] = arena->GetTeamFaction(0);
-                        factionMap[1] = arena->GetTeamFaction(1);
-
-                        team = arena->GetFreeTeam();
-                        while ((team >= 0) && (tempPlayerVec[factionMap[team]].size() > 0))
-                        {
-                            plrguid = *tempPlayerVec[factionMap[team]].begin();
-                            tempPlayerVec[factionMap[team]].pop_front();
-                            plr = sObjectMgr.GetPlayer(plrguid);
-                            if (plr)
-                            {
-                                plr->setBgTeam(team);
-                                arena->AddPlayer(plr, team);
-                                team = arena->GetFreeTeam();
-                            }
-                            ErasePlayerFromList(plrguid, &m_queuedPlayers[i][j]);
-                        }
+                        if (teams[0].size() > teams[1].size())
+                            teams[1].push(tempPlayerVec[0].front());
+                        else
+                            teams[0].push(tempPlayerVec[0].front());
+                        tempPlayerVec[0].pop_front();
+                        count--;
                     }
-                    else
+                }
+                else // There are both alliance and horde players in the queue
+                {
+                    count = GetMaximumPlayers(i);
+                    while ((count > 0) && (tempPlayerVec[0].size() > 0) && (tempPlayerVec[1].size() > 0))
                     {
-                        bg = iitr->second;
-                        int size = (int)std::min(tempPlayerVec[0].size(), tempPlayerVec[1].size());
-                        for (int counter = 0; (counter < size) && (bg->IsFull() == false); counter++)
-                        {
-                            AddPlayerToBgTeam(bg, &tempPlayerVec[0], i, j, 0);
-                            AddPlayerToBgTeam(bg, &tempPlayerVec[1], i, j, 1);
-                        }
-
-                        while (tempPlayerVec[0].size() > 0 && bg->HasFreeSlots(0, bg->GetType()))
-                        {
-                            AddPlayerToBgTeam(bg, &tempPlayerVec[0], i, j, 0);
-                        }
-                        while (tempPlayerVec[1].size() > 0 && bg->HasFreeSlots(1, bg->GetType()))
-                        {
-                            AddPlayerToBgTeam(bg, &tempPlayerVec[1], i, j, 1);
-                        }
+                        teams[0].push(tempPlayerVec[0].front());
+                        teams[1].push(tempPlayerVec[1].front());
+                        tempPlayerVec[0].pop_front();
+                        tempPlayerVec[1].pop_front();
+                        count--;
                     }
                 }
-            }
 
-            // Now that that we added everyone we could to a running Bg/Arena
-            // We shall see if we can start a new one!
-            if (isArena(i))
+            // Now we just need to add the players to the Arena instance
+            while (teams[0].size() > 0)
             {
-                // enough players to start a round?
-                uint32 minPlayers = sBattlegroundManager.GetMinimumPlayers(i);
-                if (!forceStart && ((tempPlayerVec[0].size() + tempPlayerVec[1].size()) < (minPlayers * 2)))
-                    continue;
+                for (uint32 localeTeam = 0; localeTeam < 2; localeTeam++)
+                {
+                    plrguid = teams[localeTeam].front();
+                    teams[localeTeam].pop();
+                    plr = sObjectMgr.GetPlayer(plrguid);
+                    if (plr == NULL)
+                        continue;
 
-                if (CanCreateInstance(i, j))
+                    plr->setBgTeam(localeTeam);
+                    arena->AddPlayer(plr, plr->getBgTeam());
+                    // remove from the main queue (painful!)
+                    m_queuedPlayers[i][j].removePlayer(plr->getGuidLow());
+                }
+            }
+        }
+    }
+    else
+    {
+        uint32 bgToStart = i;
+        if (i == BATTLEGROUND_RANDOM)
+        {
+            if (!forceStart)
+            {
+                std::vector<uint32> bgPossible;
+                for (uint32 bgIndex = 0; bgIndex < avalibleInRandom.size(); bgIndex++)
                 {
-                    arena = static_cast<Arena*>(CreateInstance(i, j));
-                    if (arena == NULL)
-                    {
-                        LOG_ERROR("%s (%u): Couldn't create Arena Instance", __FILE__, __LINE__);
-                        m_queueLock.Release();
-                        m_instanceLock.Release();
-                        return;
-                    } // No alliance in the queue
-                    if (tempPlayerVec[0].size() == 0)
-                    {
-                        count = GetMaximumPlayers(i) * 2;
-                        while ((count > 0) && (tempPlayerVec[1].size() > 0))
-                        {
-                            if (teams[0].size() > teams[1].size())
-                                teams[1].push(tempPlayerVec[1].front());
-                            else
-                                teams[0].push(tempPlayerVec[1].front());
-                            tempPlayerVec[1].pop_front();
-                            count--;
-                        }
-                    }
-                    else // No horde in the queue
-                        if (tempPlayerVec[1].size() == 0)
-                        {
-                            count = GetMaximumPlayers(i) * 2;
-                            while ((count > 0) && (tempPlayerVec[0].size() > 0))
-                            {
-                                if (teams[0].size() > teams[1].size())
-                                    teams[1].push(tempPlayerVec[0].front());
-                                else
-                                    teams[0].push(tempPlayerVec[0].front());
-                                tempPlayerVec[0].pop_front();
-                                count--;
-                            }
-                        }
-                        else // There are both alliance and horde players in the queue
-                        {
-                            count = GetMaximumPlayers(i);
-                            while ((count > 0) && (tempPlayerVec[0].size() > 0) && (tempPlayerVec[1].size() > 0))
-                            {
-                                teams[0].push(tempPlayerVec[0].front());
-                                teams[1].push(tempPlayerVec[1].front());
-                                tempPlayerVec[0].pop_front();
-                                tempPlayerVec[1].pop_front();
-                                count--;
-                            }
-                        }
+                    uint32 tmpJoinBgType = avalibleInRandom[bgIndex];
 
-                    // Now we just need to add the players to the Arena instance
-                    while (teams[0].size() > 0)
+                    uint32 minPlayers = sBattlegroundManager.GetMinimumPlayers(tmpJoinBgType);
+                    if ((tempPlayerVec[0].size() >= minPlayers && tempPlayerVec[1].size() >= minPlayers))
                     {
-                        for (uint32 localeTeam = 0; localeTeam < 2; localeTeam++)
-                        {
-                            plrguid = teams[localeTeam].front();
-                            teams[localeTeam].pop();
-                            plr = sObjectMgr.GetPlayer(plrguid);
-                            if (plr == NULL)
-                                continue;
-
-                            plr->setBgTeam(localeTeam);
-                            arena->AddPlayer(plr, plr->getBgTeam());
-                            // remove from the main queue (painful!)
-                            ErasePlayerFromList(plr->getGuidLow(), &m_queuedPlayers[i][j]);
-                        }
+                        bgPossible.push_back(tmpJoinBgType);
                     }
                 }
+
+                if (bgPossible.size() > 0)
+                {
+                    uint32 num = Util::getRandomUInt(0, static_cast<uint32>(bgPossible.size() - 1));
+                    bgToStart = bgPossible[num];
+                }
             }
             else
             {
-                uint32 bgToStart = i;
-                if (i == BATTLEGROUND_RANDOM)
-                {
-                    if (!forceStart)
-                    {
-                        std::vector<uint32> bgPossible;
-                        for (uint32 bgIndex = 0; bgIndex < avalibleInRandom.size(); bgIndex++)
-                        {
-                            uint32 tmpJoinBgType = avalibleInRandom[bgIndex];
+                uint32 num = Util::getRandomUInt(0, static_cast<uint32>(avalibleInRandom.size() - 1));
+                bgToStart = avalibleInRandom[num];
+            }
+        }
 
-                            uint32 minPlayers = sBattlegroundManager.GetMinimumPlayers(tmpJoinBgType);
-                            if ((tempPlayerVec[0].size() >= minPlayers && tempPlayerVec[1].size() >= minPlayers))
-                            {
-                                bgPossible.push_back(tmpJoinBgType);
-                            }
-                        }
 
-                        if (bgPossible.size() > 0)
+        uint32 minPlayers = sBattlegroundManager.GetMinimumPlayers(bgToStart);
+        if (forceStart || ((tempPlayerVec[0].size() >= minPlayers && tempPlayerVec[1].size() >= minPlayers) && bgToStart != BATTLEGROUND_RANDOM))
+        {
+            if (CanCreateInstance(bgToStart, j))
+            {
+                bg = CreateInstance(bgToStart, j);
+                if (bg == NULL)
+                    return false;
+
+                // push as many as possible in
+                if (forceStart)
+                {
+                    for (uint8 k = 0; k < 2; ++k)
+                    {
+                        while (tempPlayerVec[k].size() && bg->HasFreeSlots(k, bg->GetType()))
                         {
-                            uint32 num = Util::getRandomUInt(0, static_cast<uint32>(bgPossible.size() - 1));
-                            bgToStart = bgPossible[num];
+                            AddPlayerToBgTeam(bg, &tempPlayerVec[k], i, j, k);
                         }
                     }
-                    else
-                    {
-                        uint32 num = Util::getRandomUInt(0, static_cast<uint32>(avalibleInRandom.size() - 1));
-                        bgToStart = avalibleInRandom[num];
-                    }
                 }
-
-
-                uint32 minPlayers = sBattlegroundManager.GetMinimumPlayers(bgToStart);
-                if (forceStart || ((tempPlayerVec[0].size() >= minPlayers && tempPlayerVec[1].size() >= minPlayers) && bgToStart != BATTLEGROUND_RANDOM))
+                else
                 {
-                    if (CanCreateInstance(bgToStart, j))
+                    int size = (int)std::min(tempPlayerVec[0].size(), tempPlayerVec[1].size());
+                    for (int counter = 0; (counter < size) && (bg->IsFull() == false); counter++)
                     {
-                        bg = CreateInstance(bgToStart, j);
-                        if (bg == NULL)
-                        {
-                            m_queueLock.Release();
-                            m_instanceLock.Release();
-                            return;
-                        }
-
-                        // push as many as possible in
-                        if (forceStart)
-                        {
-                            for (uint8 k = 0; k < 2; ++k)
-                            {
-                                while (tempPlayerVec[k].size() && bg->HasFreeSlots(k, bg->GetType()))
-                                {
-                                    AddPlayerToBgTeam(bg, &tempPlayerVec[k], i, j, k);
-                                }
-                            }
-                        }
-                        else
-                        {
-                            int size = (int)std::min(tempPlayerVec[0].size(), tempPlayerVec[1].size());
-                            for (int counter = 0; (counter < size) && (bg->IsFull() == false); counter++)
-                            {
-                                AddPlayerToBgTeam(bg, &tempPlayerVec[0], i, j, 0);
-                                AddPlayerToBgTeam(bg, &tempPlayerVec[1], i, j, 1);
-                            }
-                        }
+                        AddPlayerToBgTeam(bg, &tempPlayerVec[0], i, j, 0);
+                        AddPlayerToBgTeam(bg, &tempPlayerVec[1], i, j, 1);
                     }
                 }
             }
         }
     }
 
-    // Handle paired arena team joining
+    return true;
+}
+
+bool CBattlegroundManager::UpdateArenaGroupQueue(uint32 i, bool forceStart)
+{
     Group* group1, *group2;
     uint32 teamids[2] = { 0, 0 };
     uint32 avgRating[2] = { 0, 0 };
     uint32 n;
     std::list<uint32>::iterator itz;
-    for (uint8 i = BATTLEGROUND_ARENA_2V2; i <= BATTLEGROUND_ARENA_5V5; ++i)
+
+    if (!forceStart && m_queuedGroups[i].size() < 2)      // got enough to have an arena battle ;P
+    {
+        return true;
+    }
+
+    for (uint32 j = 0; j < (uint32)m_queuedGroups[i].size(); j++)
     {
-        if (!forceStart && m_queuedGroups[i].size() < 2)      // got enough to have an arena battle ;P
+        group1 = group2 = NULL;
+        n = Util::getRandomUInt((uint32)m_queuedGroups[i].size()) - 1;
+        for (itz = m_queuedGroups[i].begin(); itz != m_queuedGroups[i].end() && n > 0; ++itz)
+            --n;
+
+        if (itz == m_queuedGroups[i].end())
+            itz = m_queuedGroups[i].begin();
+
+        if (itz == m_queuedGroups[i].end())
         {
-            continue;
+            LOG_ERROR("Internal error at %s:%u", __FILE__, __LINE__);
+            return false;
         }
 
-        for (uint32 j = 0; j < (uint32)m_queuedGroups[i].size(); j++)
+        group1 = sObjectMgr.GetGroupById(*itz);
+        if (group1 == NULL)
         {
-            group1 = group2 = NULL;
-            n = Util::getRandomUInt((uint32)m_queuedGroups[i].size()) - 1;
-            for (itz = m_queuedGroups[i].begin(); itz != m_queuedGroups[i].end() && n > 0; ++itz)
-                --n;
+            continue;
+        }
 
-            if (itz == m_queuedGroups[i].end())
-                itz = m_queuedGroups[i].begin();
+        if (forceStart && m_queuedGroups[i].size() == 1)
+        {
+            if (CreateArenaType(i, group1, NULL) == -1) return false;
+            m_queuedGroups[i].remove(group1->GetID());
+            continue;
+        }
 
-            if (itz == m_queuedGroups[i].end())
-            {
-                LOG_ERROR("Internal error at %s:%u", __FILE__, __LINE__);
-                m_queueLock.Release();
-                m_instanceLock.Release();
-                return;
-            }
+        teamids[0] = GetArenaGroupQInfo(group1, i, &avgRating[0]);
 
-            group1 = sObjectMgr.GetGroupById(*itz);
-            if (group1 == NULL)
+        std::list<uint32> possibleGroups;
+        for (itz = m_queuedGroups[i].begin(); itz != m_queuedGroups[i].end(); ++itz)
+        {
+            group2 = sObjectMgr.GetGroupById(*itz);
+            if (group2)
             {
-                continue;
+                teamids[1] = GetArenaGroupQInfo(group2, i, &avgRating[1]);
+                uint32 delta = abs((int32)avgRating[0] - (int32)avgRating[1]);
+                if (teamids[0] != teamids[1] && delta <= worldConfig.rate.arenaQueueDiff)
+                {
+                    possibleGroups.push_back(group2->GetID());
+                }
             }
+        }
 
-            if (forceStart && m_queuedGroups[i].size() == 1)
-            {
-                if (CreateArenaType(i, group1, NULL) == -1) return;
-                m_queuedGroups[i].remove(group1->GetID());
-                continue;
-            }
+        if (possibleGroups.size() > 0)
+        {
+            n = Util::getRandomUInt((uint32)possibleGroups.size()) - 1;
+            for (itz = possibleGroups.begin(); itz != possibleGroups.end() && n > 0; ++itz)
+                --n;
 
-            teamids[0] = GetArenaGroupQInfo(group1, i, &avgRating[0]);
+            if (itz == possibleGroups.end())
+                itz = possibleGroups.begin();
 
-            std::list<uint32> possibleGroups;
-            for (itz = m_queuedGroups[i].begin(); itz != m_queuedGroups[i].end(); ++itz)
+            if (itz == possibleGroups.end())
             {
-                group2 = sObjectMgr.GetGroupById(*itz);
-                if (group2)
-                {
-                    teamids[1] = GetArenaGroupQInfo(group2, i, &avgRating[1]);
-                    uint32 delta = abs((int32)avgRating[0] - (int32)avgRating[1]);
-                    if (teamids[0] != teamids[1] && delta <= worldConfig.rate.arenaQueueDiff)
-                    {
-                        possibleGroups.push_back(group2->GetID());
-                    }
-                }
+                LOG_ERROR("Internal error at %s:%u", __FILE__, __LINE__);
+                return false;
             }
 
-            if (possibleGroups.size() > 0)
+            group2 = sObjectMgr.GetGroupById(*itz);
+            if (group2)
             {
-                n = Util::getRandomUInt((uint32)possibleGroups.size()) - 1;
-                for (itz = possibleGroups.begin(); itz != possibleGroups.end() && n > 0; ++itz)
-                    --n;
-
-                if (itz == possibleGroups.end())
-                    itz = possibleGroups.begin();
-
-                if (itz == possibleGroups.end())
-                {
-                    LOG_ERROR("Internal error at %s:%u", __FILE__, __LINE__);
-                    m_queueLock.Release();
-                    m_instanceLock.Release();
-                    return;
-                }
-
-                group2 = sObjectMgr.GetGroupById(*itz);
-                if (group2)
-                {
-                    if (CreateArenaType(i, group1, group2) == -1) return;
-                    m_queuedGroups[i].remove(group1->GetID());
-                    m_queuedGroups[i].remove(group2->GetID());
-                }
+                if (CreateArenaType(i, group1, group2) == -1) return false;
+                m_queuedGroups[i].remove(group1->GetID());
+                m_queuedGroups[i].remove(group2->GetID());
             }
         }
     }
 
-    m_queueLock.Release();
-    m_instanceLock.Release();
+    return true;
 }
 
 void CBattlegroundManager::RemovePlayerFromQueues(Player* plr)
@@ -979,20 +1090,22 @@ void CBattlegroundManager::RemovePlayerFromQueues(Player* plr)
 
     sEventMgr.RemoveEvents(plr, EVENT_BATTLEGROUND_QUEUE_UPDATE);
 
+    // the player is queued in the level group they joined with and may have leveled since
     uint32 lgroup = GetLevelGrouping(plr->getLevel());
-    std::list<uint32>::iterator itr;
-
-    itr = m_queuedPlayers[plr->m_bgQueueType][lgroup].begin();
-    while (itr != m_queuedPlayers[plr->m_bgQueueType][lgroup].end())
+    if (m_queuedPlayers[plr->m_bgQueueType][lgroup].removePlayer(plr->getGuidLow()))
     {
-        if ((*itr) == plr->getGuidLow())
+        LOG_DEBUG("Removing player %u from queue instance %u type %u", plr->getGuidLow(), plr->m_bgQueueInstanceId, plr->m_bgQueueType);
+    }
+    else
+    {
+        for (uint32 j = 0; j < MAX_LEVEL_GROUP; ++j)
         {
-            LOG_DEBUG("Removing player %u from queue instance %u type %u", plr->getGuidLow(), plr->m_bgQueueInstanceId, plr->m_bgQueueType);
-            m_queuedPlayers[plr->m_bgQueueType][lgroup].erase(itr);
-            break;
+            if (m_queuedPlayers[plr->m_bgQueueType][j].removePlayer(plr->getGuidLow()))
+            {
+                LOG_DEBUG("Removing player %u from queue instance %u type %u", plr->getGuidLow(), plr->m_bgQueueInstanceId, plr->m_bgQueueType);
+                break;
+            }
         }
-
-        ++itr;
     }
 
     plr->m_bgIsQueued = false;
@@ -1243,15 +1356,12 @@ void CBattlegroundManager::DeleteBattleground(CBattleground* bg)
         m_instances[i].erase(bg->GetId());
 
         // erase any queued players
-        std::list<uint32>::iterator itr = m_queuedPlayers[i][j].begin();
-        std::list<uint32>::iterator it2;
-        for (; itr != m_queuedPlayers[i][j].end();)
+        for (uint32 queuedGuid : m_queuedPlayers[i][j].getPlayers())
         {
-            it2 = itr++;
-            plr = sObjectMgr.GetPlayer(*it2);
+            plr = sObjectMgr.GetPlayer(queuedGuid);
             if (!plr)
             {
-                m_queuedPlayers[i][j].erase(it2);
+                m_queuedPlayers[i][j].removePlayer(queuedGuid);
                 continue;
             }
 
@@ -1260,7 +1370,7 @@ void CBattlegroundManager::DeleteBattleground(CBattleground* bg)
                 sChatHandler.SystemMessage(plr->GetSession(), plr->GetSession()->LocalizedWorldSrv(54), bg->GetId());
                 SendBattlefieldStatus(plr, BGSTATUS_NOFLAGS, 0, 0, 0, 0, 0);
                 plr->m_bgIsQueued = false;
-                m_queuedPlayers[i][j].erase(it2);
+                m_queuedPlayers[i][j].removePlayer(queuedGuid);
             }
         }
 
@@ -1475,7 +1585,11 @@ void CBattlegroundManager::HandleArenaJoin(WorldSession* m_session, uint32 Battl
 
             m_queueLock.Acquire();
             m_queuedGroups[BattlegroundType].push_back(pGroup->GetID());
+            const bool startable = m_queuedGroups[BattlegroundType].size() >= 2;
             m_queueLock.Release();
+
+            if (startable)
+                ScheduleGroupQueueUpdate(BattlegroundType);
             LogNotice("BattlegroundMgr : Group %u is now in battleground queue for arena type %u", pGroup->GetID(), BattlegroundType);
 
             // send the battleground status packet
@@ -1487,7 +1601,7 @@ void CBattlegroundManager::HandleArenaJoin(WorldSession* m_session, uint32 Battl
 
     // Queue him!
     m_queueLock.Acquire();
-    m_queuedPlayers[BattlegroundType][lgroup].push_back(pguid);
+    m_queuedPlayers[BattlegroundType][lgroup].addPlayer(pguid, m_session->GetPlayer()->getTeam());
     LogNotice("BattlegroundMgr : Player %u is now in battleground queue for {Arena %u}", m_session->GetPlayer()->getGuidLow(), BattlegroundType);
 
     // send the battleground status packet
@@ -1503,5 +1617,9 @@ void CBattlegroundManager::HandleArenaJoin(WorldSession* m_session, uint32 Battl
     m_session->GetPlayer()->m_bgEntryPointMap = m_session->GetPlayer()->GetMapId();
     m_session->GetPlayer()->m_bgEntryPointInstance = m_session->GetPlayer()->GetInstanceID();
 
+    const bool startable = IsQueueStartable(BattlegroundType, lgroup);
     m_queueLock.Release();
+
+    if (startable || HasJoinableInstance(BattlegroundType, lgroup))
+        ScheduleQueueUpdate(BattlegroundType, lgroup);
 }
@@ -24,6 +24,9 @@
 
 #include "WorldPacket.h"
 #include "Server/EventableObject.h"
+#include "Management/Battleground/BattlegroundQueue.h"
+
+#include <atomic>
 
 #define ANTI_CHEAT
 
@@ -202,14 +205,19 @@ class SERVER_DECL CBattlegroundManager : public EventableObject
     uint32 m_maxBattlegroundId[BATTLEGROUND_NUM_TYPES];
 
     // Queue System
-    // Instance Id -> list<Player guid> [ BattlegroundType ] (instance 0 - first available)
-    std::list<uint32> m_queuedPlayers[BATTLEGROUND_NUM_TYPES][MAX_LEVEL_GROUP];
+    // Player guids by team [ BattlegroundType ][ LevelGroup ]
+    BattlegroundQueue m_queuedPlayers[BATTLEGROUND_NUM_TYPES][MAX_LEVEL_GROUP];
 
     // Instance Id -> list<Group id> [BattlegroundType][LevelGroup]
     std::list<uint32> m_queuedGroups[BATTLEGROUND_NUM_TYPES];
 
     Mutex m_queueLock;
 
+    // Queues that may be able to start or fill a battleground, matched by EventQueueMatch
+    std::atomic<bool> m_pendingQueueUpdate[BATTLEGROUND_NUM_TYPES][MAX_LEVEL_GROUP];
+    std::atomic<bool> m_pendingGroupQueueUpdate[BATTLEGROUND_NUM_TYPES];
+    std::atomic<bool> m_queueMatchScheduled;
+
     // Bg factory methods by Bg map Id
     std::map<uint32, BattlegroundFactoryMethod> bgFactories;
 
@@ -292,6 +300,25 @@ class SERVER_DECL CBattlegroundManager : public EventableObject
         void EventQueueUpdate();
         void EventQueueUpdate(bool forceStart);
 
+        // Matches only the queues marked by ScheduleQueueUpdate / ScheduleGroupQueueUpdate
+        void EventQueueMatch();
+
+        void ScheduleQueueUpdate(uint32 Type, uint32 LevelGroup);
+        void ScheduleGroupQueueUpdate(uint32 Type);
+
+        // A player left a running battleground, queued players may take the free slot
+        void OnBattlegroundSlotFreed(CBattleground* bg);
+
+        // Both locks have to be held, returns false if an instance could not be created
+        bool UpdateQueue(uint32 Type, uint32 LevelGroup, bool forceStart);
+        bool UpdateArenaGroupQueue(uint32 Type, bool forceStart);
+
+        // Enough queued players on each side to start, m_queueLock has to be held
+        bool IsQueueStartable(uint32 Type, uint32 LevelGroup);
+
+        // A running instance with free slots for this queue, takes m_instanceLock
+        bool HasJoinableInstance(uint32 Type, uint32 LevelGroup);
+
         void HandleGetBattlegroundQueueCommand(WorldSession* m_session);
 
         void HandleBattlegroundJoin(WorldSession* m_session, WorldPacket& pck);
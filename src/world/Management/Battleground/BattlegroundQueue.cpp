@@ -0,0 +1,69 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "BattlegroundQueue.h"
+
+#include <iterator>
+
+BattlegroundQueue::BattlegroundQueue() : mNextJoinSequence(0)
+{
+}
+
+bool BattlegroundQueue::addPlayer(uint32_t guid, uint32_t team)
+{
+    if (team > 1 || mPositions.find(guid) != mPositions.end())
+        return false;
+
+    TeamQueue& teamQueue = mTeamQueues[team];
+    teamQueue.push_back({ guid, mNextJoinSequence++ });
+
+    mPositions[guid] = { team, std::prev(teamQueue.end()) };
+    return true;
+}
+
+bool BattlegroundQueue::removePlayer(uint32_t guid)
+{
+    const auto position = mPositions.find(guid);
+    if (position == mPositions.end())
+        return false;
+
+    mTeamQueues[position->second.team].erase(position->second.entry);
+    mPositions.erase(position);
+    return true;
+}
+
+bool BattlegroundQueue::hasPlayer(uint32_t guid) const
+{
+    return mPositions.find(guid) != mPositions.end();
+}
+
+size_t BattlegroundQueue::getPlayerCount() const
+{
+    return mPositions.size();
+}
+
+size_t BattlegroundQueue::getTeamPlayerCount(uint32_t team) const
+{
+    return team > 1 ? 0 : mTeamQueues[team].size();
+}
+
+std::vector<uint32_t> BattlegroundQueue::getPlayers() const
+{
+    std::vector<uint32_t> players;
+    players.reserve(mPositions.size());
+
+    // merge both teams by join order, the players who waited longest come first
+    auto alliance = mTeamQueues[0].begin();
+    auto horde = mTeamQueues[1].begin();
+    while (alliance != mTeamQueues[0].end() || horde != mTeamQueues[1].end())
+    {
+        if (horde == mTeamQueues[1].end() || (alliance != mTeamQueues[0].end() && alliance->joinSequence < horde->joinSequence))
+            players.push_back((alliance++)->guid);
+        else
+            players.push_back((horde++)->guid);
+    }
+
+    return players;
+}
@@ -0,0 +1,52 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// Players queued for one battleground type and level group. Every team has its own queue in join order,
+// players are indexed by guid so joining and leaving never walk the queue.
+class BattlegroundQueue
+{
+    public:
+
+        BattlegroundQueue();
+
+        // returns false if the player is already queued
+        bool addPlayer(uint32_t guid, uint32_t team);
+        bool removePlayer(uint32_t guid);
+        bool hasPlayer(uint32_t guid) const;
+
+        size_t getPlayerCount() const;
+        size_t getTeamPlayerCount(uint32_t team) const;
+
+        // all queued players in join order
+        std::vector<uint32_t> getPlayers() const;
+
+    private:
+
+        struct QueueEntry
+        {
+            uint32_t guid;
+            uint64_t joinSequence;
+        };
+
+        typedef std::list<QueueEntry> TeamQueue;
+
+        struct QueuePosition
+        {
+            uint32_t team;
+            TeamQueue::iterator entry;
+        };
+
+        TeamQueue mTeamQueues[2];
+        std::unordered_map<uint32_t, QueuePosition> mPositions;
+        uint64_t mNextJoinSequence;
+};
@@ -29,13 +29,14 @@
 #include "WorldPacket.h"
 #include "Units/Players/Player.h"
 #include "Server/Packets/SmsgChannelNotify.h"
+#include "Objects/ObjectMgr.h"
 
 using namespace AscEmu::Packets;
 
 bool Channel::HasMember(Player* pPlayer)
 {
     m_lock.Acquire();
-    if (m_members.find(pPlayer) == m_members.end())
+    if (findMember(pPlayer) == nullptr)
     {
         m_lock.Release();
         return false;
@@ -111,7 +112,7 @@ void Channel::AttemptJoin(Player* plr, const char* password)
         return;
     }
 
-    if (m_members.find(plr) != m_members.end())
+    if (findMember(plr) != nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_ALREADY_ON, m_name).serialise().get());
         return;
@@ -121,7 +122,7 @@ void Channel::AttemptJoin(Player* plr, const char* password)
         flags |= CHANNEL_MEMBER_FLAG_OWNER;
 
     plr->JoinedChannel(this);
-    m_members.insert(std::make_pair(plr, flags));
+    addMember(plr, flags);
 
     if (m_announce)
     {
@@ -143,8 +144,8 @@ void Channel::Part(Player* plr, bool send_packet)
 {
     m_lock.Acquire();
 
-    MemberMap::iterator itr = m_members.find(plr);
-    if (itr == m_members.end())
+    ChannelMember* itr = findMember(plr);
+    if (itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
 
@@ -152,8 +153,8 @@ void Channel::Part(Player* plr, bool send_packet)
         return;
     }
 
-    uint32 flags = itr->second;
-    m_members.erase(itr);
+    uint32 flags = itr->flags;
+    removeMember(plr);
 
     plr->LeftChannel(this);
 
@@ -195,14 +196,14 @@ void Channel::SetOwner(Player* oldpl, Player* plr)
     uint32 oldflags = 0, oldflags2 = 0;
     if (oldpl != NULL)
     {
-        MemberMap::iterator itr = m_members.find(oldpl);
-        if (m_members.end() == itr)
+        ChannelMember* itr = findMember(oldpl);
+        if (itr == nullptr)
         {
             plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
             return;
         }
 
-        if (!(itr->second & CHANNEL_MEMBER_FLAG_OWNER))
+        if (!(itr->flags & CHANNEL_MEMBER_FLAG_OWNER))
         {
             plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOT_OWNER, m_name).serialise().get());
             return;
@@ -211,44 +212,44 @@ void Channel::SetOwner(Player* oldpl, Player* plr)
 
     if (plr == NULL)
     {
-        for (MemberMap::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
+        for (MemberList::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
         {
-            if (itr->second & CHANNEL_MEMBER_FLAG_OWNER)
+            if (itr->flags & CHANNEL_MEMBER_FLAG_OWNER)
             {
                 // remove the old owner
-                oldflags2 = itr->second;
-                itr->second &= ~CHANNEL_MEMBER_FLAG_OWNER;
-                SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, itr->first->getGuid(), oldflags2, 0, itr->second).serialise().get());
+                oldflags2 = itr->flags;
+                itr->flags &= ~CHANNEL_MEMBER_FLAG_OWNER;
+                SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, itr->player->getGuid(), oldflags2, 0, itr->flags).serialise().get());
             }
             else
             {
                 if (pOwner == NULL)
                 {
-                    pOwner = itr->first;
-                    oldflags = itr->second;
-                    itr->second |= CHANNEL_MEMBER_FLAG_OWNER;
+                    pOwner = itr->player;
+                    oldflags = itr->flags;
+                    itr->flags |= CHANNEL_MEMBER_FLAG_OWNER;
                 }
             }
         }
     }
     else
     {
-        for (MemberMap::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
+        for (MemberList::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
         {
-            if (itr->second & CHANNEL_MEMBER_FLAG_OWNER)
+            if (itr->flags & CHANNEL_MEMBER_FLAG_OWNER)
             {
                 // remove the old owner
-                oldflags2 = itr->second;
-                itr->second &= ~CHANNEL_MEMBER_FLAG_OWNER;
-                SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, itr->first->getGuid(), oldflags2, 0, itr->second).serialise().get());
+                oldflags2 = itr->flags;
+                itr->flags &= ~CHANNEL_MEMBER_FLAG_OWNER;
+                SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, itr->player->getGuid(), oldflags2, 0, itr->flags).serialise().get());
             }
             else
             {
-                if (plr == itr->first)
+                if (plr == itr->player)
                 {
-                    pOwner = itr->first;
-                    oldflags = itr->second;
-                    itr->second |= CHANNEL_MEMBER_FLAG_OWNER;
+                    pOwner = itr->player;
+                    oldflags = itr->flags;
+                    itr->flags |= CHANNEL_MEMBER_FLAG_OWNER;
                 }
             }
         }
@@ -268,13 +269,13 @@ void Channel::Invite(Player* plr, Player* new_player)
 {
     Guard mGuard(m_lock);
 
-    if (m_members.find(plr) == m_members.end())
+    if (findMember(plr) == nullptr)
     {
         SendNotOn(plr);
         return;
     }
 
-    if (m_members.find(new_player) != m_members.end())
+    if (findMember(new_player) != nullptr)
     {
         SendAlreadyOn(plr, new_player);
         return;
@@ -289,14 +290,14 @@ void Channel::Moderate(Player* plr)
 {
     Guard mGuard(m_lock);
 
-    MemberMap::iterator itr = m_members.find(plr);
-    if (m_members.end() == itr)
+    ChannelMember* itr = findMember(plr);
+    if (itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
         return;
     }
 
-    if (!(itr->second & CHANNEL_MEMBER_FLAG_OWNER || itr->second & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('c'))
+    if (!(itr->flags & CHANNEL_MEMBER_FLAG_OWNER || itr->flags & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('c'))
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTMOD, m_name).serialise().get());
         return;
@@ -308,24 +309,24 @@ void Channel::Moderate(Player* plr)
 
 void Channel::Say(Player* plr, const char* message, Player* for_gm_client, bool forced)
 {
-    Guard mGuard(m_lock);
-
     if (!forced)
     {
-        MemberMap::iterator itr = m_members.find(plr);
-        if (m_members.end() == itr)
+        Guard mGuard(m_lock);
+
+        ChannelMember* itr = findMember(plr);
+        if (itr == nullptr)
         {
             plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
             return;
         }
 
-        if (itr->second & CHANNEL_MEMBER_FLAG_MUTED)
+        if (itr->flags & CHANNEL_MEMBER_FLAG_MUTED)
         {
             plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_YOUCANTSPEAK, m_name).serialise().get());
             return;
         }
 
-        if (m_muted && !(itr->second & CHANNEL_MEMBER_FLAG_VOICED) && !(itr->second & CHANNEL_MEMBER_FLAG_MODERATOR) && !(itr->second & CHANNEL_MEMBER_FLAG_OWNER))
+        if (m_muted && !(itr->flags & CHANNEL_MEMBER_FLAG_VOICED) && !(itr->flags & CHANNEL_MEMBER_FLAG_MODERATOR) && !(itr->flags & CHANNEL_MEMBER_FLAG_OWNER))
         {
             plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_YOUCANTSPEAK, m_name).serialise().get());
             return;
@@ -339,20 +340,21 @@ void Channel::Say(Player* plr, const char* message, Player* for_gm_client, bool
         return;
     }
 
-    WorldPacket data(SMSG_MESSAGECHAT, strlen(message) + 100);
-    data << uint8(CHAT_MSG_CHANNEL);
-    data << uint32(0);        // language
-    data << plr->getGuid();    // guid
-    data << uint32(0);        // rank?
-    data << m_name;            // channel name
-    data << plr->getGuid();    // guid again?
-    data << uint32(strlen(message) + 1);
-    data << message;
-    data << (uint8)(plr->isGMFlagSet() ? 4 : 0);
+    // serialized once, every member gets the same payload
+    const auto data = std::make_shared<WorldPacket>(SMSG_MESSAGECHAT, strlen(message) + 100);
+    *data << uint8(CHAT_MSG_CHANNEL);
+    *data << uint32(0);        // language
+    *data << plr->getGuid();    // guid
+    *data << uint32(0);        // rank?
+    *data << m_name;            // channel name
+    *data << plr->getGuid();    // guid again?
+    *data << uint32(strlen(message) + 1);
+    *data << message;
+    *data << (uint8)(plr->isGMFlagSet() ? 4 : 0);
     if (for_gm_client != nullptr)
-        for_gm_client->SendPacket(&data);
+        for_gm_client->SendPacket(data.get());
     else
-        SendToAll(&data);
+        SendToAll(data);
 }
 
 void Channel::SendNotOn(Player* plr)
@@ -369,27 +371,27 @@ void Channel::Kick(Player* plr, Player* die_player, bool ban)
 {
     Guard mGuard(m_lock);
 
-    MemberMap::iterator me_itr = m_members.find(plr);
-    if (me_itr == m_members.end())
+    ChannelMember* me_itr = findMember(plr);
+    if (me_itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
         return;
     }
 
-    MemberMap::iterator itr = m_members.find(die_player);
-    if (itr == m_members.end())
+    ChannelMember* itr = findMember(die_player);
+    if (itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOT_ON_2, m_name, die_player->getGuid()).serialise().get());
         return;
     }
 
-    if (!(me_itr->second & CHANNEL_MEMBER_FLAG_OWNER || me_itr->second & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
+    if (!(me_itr->flags & CHANNEL_MEMBER_FLAG_OWNER || me_itr->flags & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTMOD, m_name).serialise().get());
         return;
     }
 
-    uint32 flags = itr->second;
+    uint32 flags = itr->flags;
 
     SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_KICKED, m_name, die_player->getGuid()).serialise().get());
 
@@ -398,7 +400,7 @@ void Channel::Kick(Player* plr, Player* die_player, bool ban)
         SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_BANNED, m_name, die_player->getGuid()).serialise().get());
     }
 
-    m_members.erase(itr);
+    removeMember(die_player);
 
     if (flags & CHANNEL_MEMBER_FLAG_OWNER)
         SetOwner(NULL, NULL);
@@ -413,14 +415,14 @@ void Channel::Unban(Player* plr, PlayerInfo* bplr)
 {
     Guard mGuard(m_lock);
 
-    MemberMap::iterator itr = m_members.find(plr);
-    if (m_members.end() == itr)
+    ChannelMember* itr = findMember(plr);
+    if (itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
         return;
     }
 
-    if (!(itr->second & CHANNEL_MEMBER_FLAG_OWNER || itr->second & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
+    if (!(itr->flags & CHANNEL_MEMBER_FLAG_OWNER || itr->flags & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTMOD, m_name).serialise().get());
         return;
@@ -441,58 +443,58 @@ void Channel::Voice(Player* plr, Player* v_player)
 {
     Guard mGuard(m_lock);
 
-    MemberMap::iterator itr = m_members.find(plr);
-    if (m_members.end() == itr)
+    ChannelMember* itr = findMember(plr);
+    if (itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
         return;
     }
 
-    MemberMap::iterator itr2 = m_members.find(v_player);
-    if (m_members.end() == itr2)
+    ChannelMember* itr2 = findMember(v_player);
+    if (itr2 == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOT_ON_2, m_name, v_player->getGuid()).serialise().get());
         return;
     }
 
-    if (!(itr->second & CHANNEL_MEMBER_FLAG_OWNER || itr->second & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
+    if (!(itr->flags & CHANNEL_MEMBER_FLAG_OWNER || itr->flags & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTMOD, m_name).serialise().get());
         return;
     }
 
-    uint32 oldflags = itr2->second;
-    itr2->second |= CHANNEL_MEMBER_FLAG_VOICED;
-    SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, v_player->getGuid(), oldflags, 0, itr2->second).serialise().get());
+    uint32 oldflags = itr2->flags;
+    itr2->flags |= CHANNEL_MEMBER_FLAG_VOICED;
+    SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, v_player->getGuid(), oldflags, 0, itr2->flags).serialise().get());
 }
 
 void Channel::Devoice(Player* plr, Player* v_player)
 {
     Guard mGuard(m_lock);
 
-    MemberMap::iterator itr = m_members.find(plr);
-    if (m_members.end() == itr)
+    ChannelMember* itr = findMember(plr);
+    if (itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
         return;
     }
 
-    MemberMap::iterator itr2 = m_members.find(v_player);
-    if (m_members.end() == itr2)
+    ChannelMember* itr2 = findMember(v_player);
+    if (itr2 == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOT_ON_2, m_name, v_player->getGuid()).serialise().get());
         return;
     }
 
-    if (!(itr->second & CHANNEL_MEMBER_FLAG_OWNER || itr->second & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
+    if (!(itr->flags & CHANNEL_MEMBER_FLAG_OWNER || itr->flags & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTMOD, m_name).serialise().get());
         return;
     }
 
-    uint32 oldflags = itr2->second;
-    itr2->second &= ~CHANNEL_MEMBER_FLAG_VOICED;
-    SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, v_player->getGuid(), oldflags, 0, itr2->second).serialise().get());
+    uint32 oldflags = itr2->flags;
+    itr2->flags &= ~CHANNEL_MEMBER_FLAG_VOICED;
+    SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, v_player->getGuid(), oldflags, 0, itr2->flags).serialise().get());
 
 }
 
@@ -500,29 +502,29 @@ void Channel::Mute(Player* plr, Player* die_player)
 {
     Guard mGuard(m_lock);
 
-    MemberMap::iterator itr = m_members.find(plr);
-    if (m_members.end() == itr)
+    ChannelMember* itr = findMember(plr);
+    if (itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
         return;
     }
 
-    MemberMap::iterator itr2 = m_members.find(die_player);
-    if (m_members.end() == itr2)
+    ChannelMember* itr2 = findMember(die_player);
+    if (itr2 == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOT_ON_2, m_name, die_player->getGuid()).serialise().get());
         return;
     }
 
-    if (!(itr->second & CHANNEL_MEMBER_FLAG_OWNER || itr->second & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
+    if (!(itr->flags & CHANNEL_MEMBER_FLAG_OWNER || itr->flags & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTMOD, m_name).serialise().get());
         return;
     }
 
-    uint32 oldflags = itr2->second;
-    itr2->second |= CHANNEL_MEMBER_FLAG_MUTED;
-    SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, die_player->getGuid(), oldflags, 0, itr2->second).serialise().get());
+    uint32 oldflags = itr2->flags;
+    itr2->flags |= CHANNEL_MEMBER_FLAG_MUTED;
+    SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, die_player->getGuid(), oldflags, 0, itr2->flags).serialise().get());
 
 }
 
@@ -530,87 +532,87 @@ void Channel::Unmute(Player* plr, Player* die_player)
 {
     Guard mGuard(m_lock);
 
-    MemberMap::iterator itr = m_members.find(plr);
-    if (m_members.end() == itr)
+    ChannelMember* itr = findMember(plr);
+    if (itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
         return;
     }
 
-    MemberMap::iterator itr2 = m_members.find(die_player);
-    if (m_members.end() == itr2)
+    ChannelMember* itr2 = findMember(die_player);
+    if (itr2 == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOT_ON_2, m_name, die_player->getGuid()).serialise().get());
         return;
     }
 
-    if (!(itr->second & CHANNEL_MEMBER_FLAG_OWNER || itr->second & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
+    if (!(itr->flags & CHANNEL_MEMBER_FLAG_OWNER || itr->flags & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTMOD, m_name).serialise().get());
         return;
     }
 
-    uint32 oldflags = itr2->second;
-    itr2->second &= ~CHANNEL_MEMBER_FLAG_MUTED;
-    SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, die_player->getGuid(), oldflags, 0, itr2->second).serialise().get());
+    uint32 oldflags = itr2->flags;
+    itr2->flags &= ~CHANNEL_MEMBER_FLAG_MUTED;
+    SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, die_player->getGuid(), oldflags, 0, itr2->flags).serialise().get());
 }
 
 void Channel::GiveModerator(Player* plr, Player* new_player)
 {
     Guard mGuard(m_lock);
 
-    MemberMap::iterator itr = m_members.find(plr);
-    if (m_members.end() == itr)
+    ChannelMember* itr = findMember(plr);
+    if (itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
         return;
     }
 
-    MemberMap::iterator itr2 = m_members.find(new_player);
-    if (m_members.end() == itr2)
+    ChannelMember* itr2 = findMember(new_player);
+    if (itr2 == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOT_ON_2, m_name, new_player->getGuid()).serialise().get());
         return;
     }
 
-    if (!(itr->second & CHANNEL_MEMBER_FLAG_OWNER || itr->second & CHANNEL_MEMBER_FLAG_MODERATOR))
+    if (!(itr->flags & CHANNEL_MEMBER_FLAG_OWNER || itr->flags & CHANNEL_MEMBER_FLAG_MODERATOR))
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTMOD, m_name).serialise().get());
         return;
     }
 
-    uint32 oldflags = itr2->second;
-    itr2->second |= CHANNEL_MEMBER_FLAG_MODERATOR;
-    SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, new_player->getGuid(), oldflags, 0, itr2->second).serialise().get());
+    uint32 oldflags = itr2->flags;
+    itr2->flags |= CHANNEL_MEMBER_FLAG_MODERATOR;
+    SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, new_player->getGuid(), oldflags, 0, itr2->flags).serialise().get());
 }
 
 void Channel::TakeModerator(Player* plr, Player* new_player)
 {
     Guard mGuard(m_lock);
 
-    MemberMap::iterator itr = m_members.find(plr);
-    if (m_members.end() == itr)
+    ChannelMember* itr = findMember(plr);
+    if (itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
         return;
     }
 
-    MemberMap::iterator itr2 = m_members.find(new_player);
-    if (m_members.end() == itr2)
+    ChannelMember* itr2 = findMember(new_player);
+    if (itr2 == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOT_ON_2, m_name, new_player->getGuid()).serialise().get());
         return;
     }
 
-    if (!(itr->second & CHANNEL_MEMBER_FLAG_OWNER || itr->second & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
+    if (!(itr->flags & CHANNEL_MEMBER_FLAG_OWNER || itr->flags & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTMOD, m_name).serialise().get());
         return;
     }
 
-    uint32 oldflags = itr2->second;
-    itr2->second &= ~CHANNEL_MEMBER_FLAG_MODERATOR;
-    SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, new_player->getGuid(), oldflags, 0, itr2->second).serialise().get());
+    uint32 oldflags = itr2->flags;
+    itr2->flags &= ~CHANNEL_MEMBER_FLAG_MODERATOR;
+    SendToAll(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_MODE_CHG, m_name, new_player->getGuid(), oldflags, 0, itr2->flags).serialise().get());
 
 }
 
@@ -618,14 +620,14 @@ void Channel::Announce(Player* plr)
 {
     Guard mGuard(m_lock);
 
-    MemberMap::iterator itr = m_members.find(plr);
-    if (m_members.end() == itr)
+    ChannelMember* itr = findMember(plr);
+    if (itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
         return;
     }
 
-    if (!(itr->second & CHANNEL_MEMBER_FLAG_OWNER || itr->second & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
+    if (!(itr->flags & CHANNEL_MEMBER_FLAG_OWNER || itr->flags & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTMOD, m_name).serialise().get());
         return;
@@ -639,14 +641,14 @@ void Channel::Password(Player* plr, const char* pass)
 {
     Guard mGuard(m_lock);
 
-    MemberMap::iterator itr = m_members.find(plr);
-    if (m_members.end() == itr)
+    ChannelMember* itr = findMember(plr);
+    if (itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
         return;
     }
 
-    if (!(itr->second & CHANNEL_MEMBER_FLAG_OWNER || itr->second & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
+    if (!(itr->flags & CHANNEL_MEMBER_FLAG_OWNER || itr->flags & CHANNEL_MEMBER_FLAG_MODERATOR) && !plr->GetSession()->CanUseCommand('a'))
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTMOD, m_name).serialise().get());
         return;
@@ -661,8 +663,8 @@ void Channel::List(Player* plr)
     Guard mGuard(m_lock);
     WorldPacket data(SMSG_CHANNEL_LIST, 50 + (m_members.size() * 9));
 
-    MemberMap::iterator itr = m_members.find(plr);
-    if (itr == m_members.end())
+    ChannelMember* itr = findMember(plr);
+    if (itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
         return;
@@ -673,17 +675,17 @@ void Channel::List(Player* plr)
     data << m_name;
     data << uint8(m_flags);
     data << uint32(m_members.size());
-    for (itr = m_members.begin(); itr != m_members.end(); ++itr)
+    for (const auto& member : m_members)
     {
-        data << itr->first->getGuid();
+        data << member.player->getGuid();
         flags = 0;
-        if (!(itr->second & CHANNEL_MEMBER_FLAG_MUTED))
+        if (!(member.flags & CHANNEL_MEMBER_FLAG_MUTED))
             flags |= CHANNEL_MEMBER_FLAG_VOICED;
 
-        if (itr->second & CHANNEL_MEMBER_FLAG_OWNER)
+        if (member.flags & CHANNEL_MEMBER_FLAG_OWNER)
             flags |= CHANNEL_MEMBER_FLAG_OWNER;
 
-        if (itr->second & CHANNEL_MEMBER_FLAG_MODERATOR)
+        if (member.flags & CHANNEL_MEMBER_FLAG_MODERATOR)
             flags |= CHANNEL_MEMBER_FLAG_MODERATOR;
 
         if (!m_general)
@@ -699,18 +701,18 @@ void Channel::GetOwner(Player* plr)
 {
     Guard mGuard(m_lock);
 
-    MemberMap::iterator itr = m_members.find(plr);
-    if (itr == m_members.end())
+    ChannelMember* itr = findMember(plr);
+    if (itr == nullptr)
     {
         plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_NOTON, m_name).serialise().get());
         return;
     }
 
-    for (itr = m_members.begin(); itr != m_members.end(); ++itr)
+    for (const auto& member : m_members)
     {
-        if (itr->second & CHANNEL_MEMBER_FLAG_OWNER)
+        if (member.flags & CHANNEL_MEMBER_FLAG_OWNER)
         {
-            plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_WHO_OWNER, m_name, itr->first->getGuid()).serialise().get());
+            plr->SendPacket(SmsgChannelNotify(CHANNEL_NOTIFY_FLAG_WHO_OWNER, m_name, member.player->getGuid()).serialise().get());
             return;
         }
     }
@@ -719,25 +721,88 @@ void Channel::GetOwner(Player* plr)
 Channel::~Channel()
 {
     m_lock.Acquire();
-    for (MemberMap::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-        itr->first->LeftChannel(this);
+    for (MemberList::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
+        itr->player->LeftChannel(this);
 
     m_lock.Release();
 }
 
 void Channel::SendToAll(WorldPacket* data)
 {
-    Guard guard(m_lock);
-    for (MemberMap::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-        itr->first->SendPacket(data);
+    SendToAll(std::make_shared<const WorldPacket>(*data), nullptr);
 }
 
 void Channel::SendToAll(WorldPacket* data, Player* plr)
+{
+    SendToAll(std::make_shared<const WorldPacket>(*data), plr);
+}
+
+void Channel::SendToAll(const std::shared_ptr<const WorldPacket>& data, Player* plr)
+{
+    const auto recipients = getRecipients();
+    const uint32 skipGuid = plr != nullptr ? plr->getGuidLow() : 0;
+
+    for (uint32 guid : *recipients)
+    {
+        if (guid == skipGuid)
+            continue;
+
+        // the player may have logged out since the snapshot was taken
+        Player* member = sObjectMgr.GetPlayer(guid);
+        if (member != nullptr && member->GetSession() != nullptr)
+            member->GetSession()->SendSharedPacket(data);
+    }
+}
+
+Channel::ChannelMember* Channel::findMember(Player* plr)
+{
+    const auto itr = m_memberIndex.find(plr);
+    if (itr == m_memberIndex.end())
+        return nullptr;
+
+    return &m_members[itr->second];
+}
+
+void Channel::addMember(Player* plr, uint32 flags)
+{
+    m_memberIndex[plr] = m_members.size();
+    m_members.push_back({ plr, plr->getGuidLow(), flags });
+    m_recipients.reset();
+}
+
+void Channel::removeMember(Player* plr)
+{
+    const auto itr = m_memberIndex.find(plr);
+    if (itr == m_memberIndex.end())
+        return;
+
+    // move the last member into the free slot
+    const size_t slot = itr->second;
+    m_memberIndex.erase(itr);
+
+    if (slot != m_members.size() - 1)
+    {
+        m_members[slot] = m_members.back();
+        m_memberIndex[m_members[slot].player] = slot;
+    }
+
+    m_members.pop_back();
+    m_recipients.reset();
+}
+
+std::shared_ptr<const std::vector<uint32>> Channel::getRecipients()
 {
     Guard guard(m_lock);
-    for (MemberMap::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
+
+    if (m_recipients == nullptr)
     {
-        if (itr->first != plr)
-            itr->first->SendPacket(data);
+        auto recipients = std::make_shared<std::vector<uint32>>();
+        recipients->reserve(m_members.size());
+        for (const auto& member : m_members)
+            recipients->push_back(member.guid);
+
+        m_recipients = recipients;
     }
+
+    return m_recipients;
 }
@@ -28,6 +28,9 @@
 #include "Threading/Mutex.h"
 #include <set>
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 #include "Units/Players/Player.h"
 
 
@@ -128,12 +131,30 @@ class SERVER_DECL Channel
 {
     Mutex m_lock;
 
-    typedef std::map<Player*, uint32> MemberMap;
+    struct ChannelMember
+    {
+        Player* player;
+        uint32 guid;
+        uint32 flags;
+    };
 
-    MemberMap m_members;
+    typedef std::vector<ChannelMember> MemberList;
+
+    // members are stored flat, m_memberIndex maps a player to the slot
+    MemberList m_members;
+    std::unordered_map<Player*, size_t> m_memberIndex;
+
+    // guids of all members for broadcasts, rebuilt after the membership changed
+    std::shared_ptr<const std::vector<uint32>> m_recipients;
 
     std::set<uint32> m_bannedMembers;
 
+    ChannelMember* findMember(Player* plr);
+    void addMember(Player* plr, uint32 flags);
+    void removeMember(Player* plr);
+
+    std::shared_ptr<const std::vector<uint32>> getRecipients();
+
     public:
 
         friend class ChannelIterator;
@@ -186,13 +207,16 @@ class SERVER_DECL Channel
         void SendToAll(WorldPacket* data);
         void SendToAll(WorldPacket* data, Player* plr);
 
+        // sends to the members at call time without holding the channel lock, all of them share the payload
+        void SendToAll(const std::shared_ptr<const WorldPacket>& data, Player* plr = nullptr);
+
         bool HasMember(Player* pPlayer);
 };
 
 class ChannelIterator
 {
-    Channel::MemberMap::iterator m_itr;
-    Channel::MemberMap::iterator m_endItr;
+    Channel::MemberList::iterator m_itr;
+    Channel::MemberList::iterator m_endItr;
 
     bool m_searchInProgress;
 
@@ -223,12 +247,12 @@ class ChannelIterator
 
         Player* operator*() const
         {
-            return m_itr->first;
+            return m_itr->player;
         }
 
         Player* operator->() const
         {
-            return m_itr->first;
+            return m_itr->player;
         }
 
         void Increment()
@@ -242,7 +266,7 @@ class ChannelIterator
             ++m_itr;
         }
 
-        inline Player* Grab() { return m_itr->first; }
+        inline Player* Grab() { return m_itr->player; }
         inline bool End() { return (m_itr == m_endItr) ? true : false; }
 };
 
@@ -163,6 +163,7 @@ bool Container::AddItem(int16 slot, Item* item)
 
     m_Slot[slot] = item;
     item->m_isDirty = true;
+    m_owner->getItemInterface()->addItemToCountIndex(item, this, slot);
 
     item->setContainer(this);
     item->setOwner(m_owner);
@@ -232,6 +233,7 @@ void Container::SwapItems(int8 SrcSlot, int8 DstSlot)
     temp = m_Slot[SrcSlot];
     m_Slot[SrcSlot] = m_Slot[DstSlot];
     m_Slot[DstSlot] = temp;
+    m_owner->getItemInterface()->invalidateItemCounts();
 
     if (m_Slot[DstSlot])
     {
@@ -265,6 +267,8 @@ Item* Container::SafeRemoveAndRetreiveItemFromSlot(int16 slot, bool destroy)
         return NULL;
 
     m_Slot[slot] = NULL;
+    if (m_owner != nullptr)
+        m_owner->getItemInterface()->removeItemFromCountIndex(pItem);
 
     if (pItem->getOwner() == m_owner)
     {
@@ -297,6 +301,8 @@ bool Container::SafeFullRemoveItemFromSlot(int16 slot)
 
     if (pItem == NULL || pItem == this) return false;
     m_Slot[slot] = NULL;
+    if (m_owner != nullptr)
+        m_owner->getItemInterface()->removeItemFromCountIndex(pItem);
 
     setSlot(slot, 0);
     pItem->setContainer(nullptr);
@@ -320,6 +326,7 @@ bool Container::AddItemToFreeSlot(Item* pItem, uint32* r_slot)
         {
             m_Slot[slot] = pItem;
             pItem->m_isDirty = true;
+            m_owner->getItemInterface()->addItemToCountIndex(pItem, this, static_cast<int16_t>(slot));
 
             pItem->setContainer(this);
             pItem->setOwner(m_owner);
@@ -142,6 +142,9 @@ void GameEvent::SetState(GameEventState pState)
         return;
 
     state = pState;
+
+    // event npcs and quests come and go with the state
+    sQuestMgr.invalidateQuestgiverStatus();
 }
 
 GameEventState GameEvent::OnStateChange(GameEventState pOldState, GameEventState pNewState)
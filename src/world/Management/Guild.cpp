@@ -7,6 +7,7 @@ This file is released under the MIT license. See README-MIT for more information
 
 #include "Guild.h"
 #include "Management/GuildMgr.h"
+#include "Management/GuildSaveQueue.h"
 #if VERSION_STRING == Cata
 #include "GameCata/Management/GuildFinderMgr.h"
 #elif VERSION_STRING == Mop
@@ -152,9 +153,9 @@ bool Guild::create(Player* pLeader, std::string const& name)
 
     LogDebug("GUILD: creating guild %s for leader %s (%u)", name.c_str(), pLeader->getName().c_str(), WoWGuid::getGuidLowPartFromUInt64(m_leaderGuid));
 
-    CharacterDatabase.Execute("DELETE FROM guild_members WHERE guildId = %u", m_id);
+    sGuildSaveQueue.queue(m_id, "", "DELETE FROM guild_members WHERE guildId = %u", m_id);
 
-    CharacterDatabase.Execute("INSERT INTO guilds (guildId, guildName, leaderGuid, emblemStyle, emblemColor, borderStyle, borderColor, backgroundColor,"
+    sGuildSaveQueue.queue(m_id, GuildSaveQueue::makeKey("guilds", m_id), "INSERT INTO guilds (guildId, guildName, leaderGuid, emblemStyle, emblemColor, borderStyle, borderColor, backgroundColor,"
         "guildInfo, motd, createdate, bankBalance, guildLevel, guildExperience, todayExperience) "
         "VALUES('%u', '%s', '%u', '%u', '%u', '%u', '%u', '%u', '%s', '%s', '%u', '%u', '%u', '0', '0')",
         m_id, name.c_str(), m_leaderGuid, m_emblemInfo.getStyle(), m_emblemInfo.getColor(), m_emblemInfo.getBorderStyle(),
@@ -186,21 +187,21 @@ void Guild::disband()
         deleteMember(itr->second->getGUID(), true);
     }
 
-    CharacterDatabase.Execute("DELETE FROM guilds WHERE guildId = %u", m_id);
+    sGuildSaveQueue.queue(m_id, GuildSaveQueue::makeKey("guilds", m_id), "DELETE FROM guilds WHERE guildId = %u", m_id);
 
-    CharacterDatabase.Execute("DELETE FROM guildranks WHERE guildId = %u", m_id);
+    sGuildSaveQueue.queue(m_id, "", "DELETE FROM guild_ranks WHERE guildId = %u", m_id);
 
-    CharacterDatabase.Execute("DELETE FROM guild_bank_tabs WHERE guildId = %u", m_id);
+    sGuildSaveQueue.queue(m_id, "", "DELETE FROM guild_bank_tabs WHERE guildId = %u", m_id);
 
     deleteBankItems(true);
 
-    CharacterDatabase.Execute("DELETE FROM guild_bank_items WHERE guildId = %u", m_id);
+    sGuildSaveQueue.queue(m_id, "", "DELETE FROM guild_bank_items WHERE guildId = %u", m_id);
 
-    CharacterDatabase.Execute("DELETE FROM guild_bank_rights WHERE guildId = %u", m_id);
+    sGuildSaveQueue.queue(m_id, "", "DELETE FROM guild_bank_rights WHERE guildId = %u", m_id);
 
-    CharacterDatabase.Execute("DELETE FROM guild_logs WHERE guildId = %u", m_id);
+    sGuildSaveQueue.queue(m_id, "", "DELETE FROM guild_logs WHERE guildId = %u", m_id);
 
-    CharacterDatabase.Execute("DELETE FROM guild_bank_logs WHERE guildId = %u", m_id);
+    sGuildSaveQueue.queue(m_id, "", "DELETE FROM guild_bank_logs WHERE guildId = %u", m_id);
 #if VERSION_STRING >= Cata
     sGuildFinderMgr.deleteGuild(m_id);
 #endif
@@ -210,7 +211,7 @@ void Guild::disband()
 
 void Guild::saveGuildToDB()
 {
-    CharacterDatabase.Execute("UPDATE guilds SET guildLevel = '%u', guildExperience = '%llu', todayExperience = '%llu' WHERE guildId = %u",
+    sGuildSaveQueue.queue(m_id, GuildSaveQueue::makeKey("guilds.experience", m_id), "UPDATE guilds SET guildLevel = '%u', guildExperience = '%llu', todayExperience = '%llu' WHERE guildId = %u",
         static_cast<uint32_t>(getLevel()), getExperience(), getTodayExperience(), getId());
 }
 
@@ -257,50 +258,31 @@ void Guild::onPlayerStatusChange(Player* player, uint32_t flag, bool state)
 void Guild::handleRoster(WorldSession* session)
 {
 #if VERSION_STRING < Cata
-    WorldPacket data(SMSG_GUILD_ROSTER, (4 + m_motd.length() + 1 + m_info.length() + 1 + 4 + _getRanksSize() * (4 + 4 + MAX_GUILD_BANK_TABS * (4 + 4)) + _guildMembersStore.size() * 50));
-    data << uint32_t(_guildMembersStore.size());
-    data << m_motd;
-    data << m_info;
-
-    data << uint32_t(_getRanksSize());
-    for (auto ritr = _guildRankInfoStore.begin(); ritr != _guildRankInfoStore.end(); ++ritr)
+    if (session != nullptr)
     {
-        data << uint32_t(ritr->getRights());
-        if (ritr->getBankMoneyPerDay() == sizeof(uint32_t))
-            data << uint32_t(sizeof(uint32_t));
-        else
-            data << uint32_t(ritr->getBankMoneyPerDay());
-
-        for (uint8_t i = 0; i < MAX_GUILD_BANK_TABS; ++i)
-        {
-            data << uint32_t(ritr->getBankTabRights(i));
-            data << uint32_t(ritr->getBankTabSlotsPerDay(i));
-        }
+        WorldPacket data;
+        buildRosterPacket(data, _hasRankRight(session->GetPlayer()->getGuid(), GR_RIGHT_VIEWOFFNOTE));
+        session->SendPacket(&data);
+        return;
     }
 
+    // broadcast, one packet for the members with and one for the members without officer note rights
+    WorldPacket rosterPackets[2];
+    bool rosterPacketBuilt[2] = { false, false };
     for (auto itr = _guildMembersStore.begin(); itr != _guildMembersStore.end(); ++itr)
     {
-        data << uint64_t(itr->second->getGUID())
-            << uint8_t(itr->second->getFlags())
-            << itr->second->getName()
-            << uint32_t(itr->second->getRankId())
-            << uint8_t(itr->second->getLevel())
-            << uint8_t(itr->second->getClass())
-            << uint8_t(0)
-            << uint32_t(itr->second->getZoneId());
-
-        if (!itr->second->getFlags())
-            data << float(float(::time(nullptr) - itr->second->getLogoutTime()) / DAY);
-
-        data << itr->second->getPublicNote();
+        if (Player* player = itr->second->getPlayerByGuid(itr->second->getGUID()))
+        {
+            const uint8_t withOfficerNotes = (getRankRights(itr->second->getRankId()) & GR_RIGHT_VIEWOFFNOTE) != GR_RIGHT_EMPTY ? 1 : 0;
+            if (!rosterPacketBuilt[withOfficerNotes])
+            {
+                buildRosterPacket(rosterPackets[withOfficerNotes], withOfficerNotes != 0);
+                rosterPacketBuilt[withOfficerNotes] = true;
+            }
 
-        if (_hasRankRight(session->GetPlayer()->getGuid(), GR_RIGHT_VIEWOFFNOTE))
-            data << itr->second->getOfficerNote();
-        else
-            data << "";
+            player->GetSession()->SendPacket(&rosterPackets[withOfficerNotes]);
+        }
     }
-
-    session->SendPacket(&data);
 #else
     ByteBuffer memberData(100);
     WorldPacket data(SMSG_GUILD_ROSTER, 100);
@@ -402,6 +384,50 @@ void Guild::handleRoster(WorldSession* session)
 #endif
 }
 
+#if VERSION_STRING < Cata
+void Guild::buildRosterPacket(WorldPacket& data, bool withOfficerNotes) const
+{
+    data.Initialize(SMSG_GUILD_ROSTER, (4 + m_motd.length() + 1 + m_info.length() + 1 + 4 + _getRanksSize() * (4 + 4 + MAX_GUILD_BANK_TABS * (4 + 4)) + _guildMembersStore.size() * 50));
+    data << uint32_t(_guildMembersStore.size());
+    data << m_motd;
+    data << m_info;
+
+    data << uint32_t(_getRanksSize());
+    for (auto ritr = _guildRankInfoStore.begin(); ritr != _guildRankInfoStore.end(); ++ritr)
+    {
+        data << uint32_t(ritr->getRights());
+        if (ritr->getBankMoneyPerDay() == sizeof(uint32_t))
+            data << uint32_t(sizeof(uint32_t));
+        else
+            data << uint32_t(ritr->getBankMoneyPerDay());
+
+        for (uint8_t i = 0; i < MAX_GUILD_BANK_TABS; ++i)
+        {
+            data << uint32_t(ritr->getBankTabRights(i));
+            data << uint32_t(ritr->getBankTabSlotsPerDay(i));
+        }
+    }
+
+    const time_t now = ::time(nullptr);
+
+    for (auto itr = _guildMembersStore.begin(); itr != _guildMembersStore.end(); ++itr)
+    {
+        itr->second->appendRosterData(data);
+
+        // the offline time changes every second and is never cached
+        if (!itr->second->getFlags())
+            data << float(float(now - itr->second->getLogoutTime()) / DAY);
+
+        data << itr->second->getPublicNote();
+
+        if (withOfficerNotes)
+            data << itr->second->getOfficerNote();
+        else
+            data << "";
+    }
+}
+#endif
+
 void Guild::handleQuery(WorldSession* session)
 {
     WorldPacket data(SMSG_GUILD_QUERY_RESPONSE, 8 * 32 + 200);
@@ -503,7 +529,7 @@ void Guild::handleSetMOTD(WorldSession* session, std::string const& motd)
     else
     {
         m_motd = motd;
-        CharacterDatabase.Execute("UPDATE guilds SET motd = '%s' WHERE guildId = %u", CharacterDatabase.EscapeString(motd).c_str(), m_id);
+        sGuildSaveQueue.queue(m_id, GuildSaveQueue::makeKey("guilds.motd", m_id), "UPDATE guilds SET motd = '%s' WHERE guildId = %u", CharacterDatabase.EscapeString(motd).c_str(), m_id);
         broadcastEvent(GE_MOTD, 0, { motd });
     }
 }
@@ -516,7 +542,7 @@ void Guild::handleSetInfo(WorldSession* session, std::string const& info)
     if (_hasRankRight(session->GetPlayer()->getGuid(), GR_RIGHT_MODIFY_GUILD_INFO))
     {
         m_info = info;
-        CharacterDatabase.Execute("UPDATE guilds SET guildInfo = '%s' WHERE guildId = %u", info.c_str(), m_id);
+        sGuildSaveQueue.queue(m_id, GuildSaveQueue::makeKey("guilds.guildInfo", m_id), "UPDATE guilds SET guildInfo = '%s' WHERE guildId = %u", info.c_str(), m_id);
     }
 }
 
@@ -842,9 +868,9 @@ void Guild::handleRemoveRank(WorldSession* session, uint8_t rankId)
     if (_getRanksSize() <= MIN_GUILD_RANKS || rankId >= _getRanksSize() || !isLeader(session->GetPlayer()))
         return;
 
-    CharacterDatabase.Execute("DELETE FROM guild_bank_rights WHERE rankId = %u AND guildId = %u", rankId, m_id);
+    sGuildSaveQueue.queue(m_id, "", "DELETE FROM guild_bank_rights WHERE rankId = %u AND guildId = %u", rankId, m_id);
 
-    CharacterDatabase.Execute("DELETE FROM guild_ranks WHERE rankId = %u AND guildId = %u", rankId, m_id);
+    sGuildSaveQueue.queue(m_id, GuildSaveQueue::makeKey("guild_ranks", m_id, rankId), "DELETE FROM guild_ranks WHERE rankId = %u AND guildId = %u", rankId, m_id);
 
     _guildRankInfoStore.erase(_guildRankInfoStore.begin() + rankId);
 
@@ -1178,7 +1204,7 @@ bool Guild::loadMemberFromDB(Field* fields, Field* fields2)
     auto member = new GuildMember(m_id, MAKE_NEW_GUID(lowguid, 0, HIGHGUID_TYPE_PLAYER), fields[2].GetUInt8());
     if (!member->loadGuildMembersFromDB(fields, fields2))
     {
-        CharacterDatabase.Execute("DELETE FROM guild_members WHERE guildId = %u", lowguid);
+        sGuildSaveQueue.queue(m_id, GuildSaveQueue::makeKey("guild_members", lowguid), "DELETE FROM guild_members WHERE playerid = %u", lowguid);
         delete member;
         return false;
     }
@@ -1492,7 +1518,7 @@ bool Guild::addMember(uint64_t guid, uint8_t rankId)
 
     member->saveGuildMembersToDB(false);
 
-    CharacterDatabase.Execute("INSERT INTO guild_members_withdraw VALUES(%u, 0, 0, 0, 0, 0, 0, 0, 0, 0)", m_id);
+    sGuildSaveQueue.queue(m_id, GuildSaveQueue::makeKey("guild_members_withdraw", lowguid), "REPLACE INTO guild_members_withdraw VALUES(%u, 0, 0, 0, 0, 0, 0, 0, 0, 0)", lowguid);
 
     updateAccountsNumber();
 
@@ -1566,7 +1592,7 @@ void Guild::deleteMember(uint64_t guid, bool isDisbanding, bool /*isKicked*/)
 #endif
     }
 
-    CharacterDatabase.Execute("DELETE FROM guild_members WHERE guildId = %u", lowguid);
+    sGuildSaveQueue.queue(m_id, GuildSaveQueue::makeKey("guild_members", lowguid), "DELETE FROM guild_members WHERE playerid = %u", lowguid);
 
     if (!isDisbanding)
         updateAccountsNumber();
@@ -1615,9 +1641,9 @@ void Guild::createNewBankTab()
     uint8_t tabId = _getPurchasedTabsSize();
     _guildBankTabsStore.push_back(new GuildBankTab(m_id, tabId));
 
-    CharacterDatabase.Execute("DELETE FROM guild_bank_tabs WHERE guildId = %u AND tabId = %u", m_id, static_cast<uint32_t>(tabId));
-
-    CharacterDatabase.Execute("INSERT INTO guild_bank_tabs VALUES(%u, %u, '', '', '')", m_id, static_cast<uint32_t>(tabId));
+    sGuildSaveQueue.queueGroup(m_id, GuildSaveQueue::makeKey("guild_bank_tabs", m_id, tabId), {
+        GuildSaveQueue::format("DELETE FROM guild_bank_tabs WHERE guildId = %u AND tabId = %u", m_id, static_cast<uint32_t>(tabId)),
+        GuildSaveQueue::format("INSERT INTO guild_bank_tabs VALUES(%u, %u, '', '', '')", m_id, static_cast<uint32_t>(tabId)) });
 
     ++tabId;
     for (auto itr = _guildRankInfoStore.begin(); itr != _guildRankInfoStore.end(); ++itr)
@@ -1626,8 +1652,8 @@ void Guild::createNewBankTab()
 
 void Guild::createDefaultGuildRanks()
 {
-    CharacterDatabase.Execute("DELETE FROM guild_ranks WHERE guildId = %u", m_id);
-    CharacterDatabase.Execute("DELETE FROM guild_bank_rights WHERE guildId = %u", m_id);
+    sGuildSaveQueue.queue(m_id, "", "DELETE FROM guild_ranks WHERE guildId = %u", m_id);
+    sGuildSaveQueue.queue(m_id, "", "DELETE FROM guild_bank_rights WHERE guildId = %u", m_id);
 
     createRank("GuildMaster", GR_RIGHT_ALL);
     createRank("Officer", GR_RIGHT_ALL);
@@ -1696,7 +1722,7 @@ bool Guild::modifyBankMoney(uint64_t amount, bool add)
         m_bankMoney -= amount;
     }
 
-    CharacterDatabase.Execute("UPDATE guild SET bankBalance = %llu WHERE guildId = %u", m_bankMoney, m_id);
+    sGuildSaveQueue.queue(m_id, GuildSaveQueue::makeKey("guilds.bankBalance", m_id), "UPDATE guilds SET bankBalance = %llu WHERE guildId = %u", m_bankMoney, m_id);
 
     return true;
 }
@@ -1709,7 +1735,7 @@ void Guild::setLeaderGuid(GuildMember* pLeader)
     m_leaderGuid = pLeader->getGUID();
     pLeader->changeRank(GR_GUILDMASTER);
 
-    CharacterDatabase.Execute("UPDATE guild SET leaderGuid = '%u' WHERE guildId = %u", WoWGuid::getGuidLowPartFromUInt64(m_leaderGuid), m_id);
+    sGuildSaveQueue.queue(m_id, GuildSaveQueue::makeKey("guilds.leaderGuid", m_id), "UPDATE guilds SET leaderGuid = '%u' WHERE guildId = %u", WoWGuid::getGuidLowPartFromUInt64(m_leaderGuid), m_id);
 }
 
 void Guild::setRankBankMoneyPerDay(uint8_t rankId, uint32_t moneyPerDay)
@@ -2589,22 +2615,34 @@ mTotalActivity(0), mWeekActivity(0), mTotalReputation(0), mBankWithdraw{ 0 }, mW
 
 void Guild::GuildMember::setStats(Player* player)
 {
+#if VERSION_STRING < Cata
+    std::lock_guard<std::mutex> guard(mRosterMutex);
+#endif
     mName = player->getName();
     mLevel = static_cast<uint8_t>(player->getLevel());
     mClass = player->getClass();
     mZoneId = player->GetZoneId();
     mAccountId = player->GetSession()->GetAccountId();
     mAchievementPoints = 0;
+#if VERSION_STRING < Cata
+    mRosterDataDirty = true;
+#endif
 }
 
 void Guild::GuildMember::setStats(std::string const& name, uint8_t level, uint8_t _class, uint32_t zoneId, uint32_t accountId, uint32_t reputation)
 {
+#if VERSION_STRING < Cata
+    std::lock_guard<std::mutex> guard(mRosterMutex);
+#endif
     mName = name;
     mLevel = level;
     mClass = _class;
     mZoneId = zoneId;
     mAccountId = accountId;
     mTotalReputation = reputation;
+#if VERSION_STRING < Cata
+    mRosterDataDirty = true;
+#endif
 }
 
 bool Guild::GuildMember::checkStats() const
@@ -2631,7 +2669,8 @@ void Guild::GuildMember::setPublicNote(std::string const& publicNote)
 
     mPublicNote = publicNote;
 
-    CharacterDatabase.Execute("UPDATE guild_members SET publicNote = '%s' WHERE playerid = %u", publicNote.c_str(), WoWGuid::getGuidLowPartFromUInt64(mGuid));
+    sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_members.publicNote", WoWGuid::getGuidLowPartFromUInt64(mGuid)),
+        "UPDATE guild_members SET publicNote = '%s' WHERE playerid = %u", publicNote.c_str(), WoWGuid::getGuidLowPartFromUInt64(mGuid));
 }
 
 void Guild::GuildMember::setOfficerNote(std::string const& officerNote)
@@ -2641,12 +2680,19 @@ void Guild::GuildMember::setOfficerNote(std::string const& officerNote)
 
     mOfficerNote = officerNote;
 
-    CharacterDatabase.Execute("UPDATE guild_members SET officerNote = '%s' WHERE playerid = %u", officerNote.c_str(), WoWGuid::getGuidLowPartFromUInt64(mGuid));
+    sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_members.officerNote", WoWGuid::getGuidLowPartFromUInt64(mGuid)),
+        "UPDATE guild_members SET officerNote = '%s' WHERE playerid = %u", officerNote.c_str(), WoWGuid::getGuidLowPartFromUInt64(mGuid));
 }
 
 void Guild::GuildMember::setZoneId(uint32_t id)
 {
+#if VERSION_STRING < Cata
+    std::lock_guard<std::mutex> guard(mRosterMutex);
+#endif
     mZoneId = id;
+#if VERSION_STRING < Cata
+    mRosterDataDirty = true;
+#endif
 }
 
 void Guild::GuildMember::setAchievementPoints(uint32_t val)
@@ -2656,22 +2702,46 @@ void Guild::GuildMember::setAchievementPoints(uint32_t val)
 
 void Guild::GuildMember::setLevel(uint8_t var)
 {
+#if VERSION_STRING < Cata
+    std::lock_guard<std::mutex> guard(mRosterMutex);
+#endif
     mLevel = var;
+#if VERSION_STRING < Cata
+    mRosterDataDirty = true;
+#endif
 }
 
 void Guild::GuildMember::addFlag(uint8_t var)
 {
+#if VERSION_STRING < Cata
+    std::lock_guard<std::mutex> guard(mRosterMutex);
+#endif
     mFlags |= var;
+#if VERSION_STRING < Cata
+    mRosterDataDirty = true;
+#endif
 }
 
 void Guild::GuildMember::removeFlag(uint8_t var)
 {
+#if VERSION_STRING < Cata
+    std::lock_guard<std::mutex> guard(mRosterMutex);
+#endif
     mFlags &= ~var;
+#if VERSION_STRING < Cata
+    mRosterDataDirty = true;
+#endif
 }
 
 void Guild::GuildMember::resetFlags()
 {
+#if VERSION_STRING < Cata
+    std::lock_guard<std::mutex> guard(mRosterMutex);
+#endif
     mFlags = GEM_STATUS_NONE;
+#if VERSION_STRING < Cata
+    mRosterDataDirty = true;
+#endif
 }
 
 bool Guild::GuildMember::loadGuildMembersFromDB(Field* fields, Field* fields2)
@@ -2700,7 +2770,7 @@ bool Guild::GuildMember::loadGuildMembersFromDB(Field* fields, Field* fields2)
     if (!mZoneId)
     {
         LogError("Player (GUID: %u) has broken zone-data", WoWGuid::getGuidLowPartFromUInt64(mGuid));
-        mZoneId = sObjectMgr.GetPlayer(WoWGuid::getGuidLowPartFromUInt64(mGuid))->GetZoneId();
+        setZoneId(sObjectMgr.GetPlayer(WoWGuid::getGuidLowPartFromUInt64(mGuid))->GetZoneId());
     }
 
     resetFlags();
@@ -2710,7 +2780,7 @@ bool Guild::GuildMember::loadGuildMembersFromDB(Field* fields, Field* fields2)
 
 void Guild::GuildMember::saveGuildMembersToDB(bool /*_delete*/) const
 {
-    CharacterDatabase.Execute("REPLACE INTO guild_members VALUES (%u, %u, %u, '%s', '%s')",
+    sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_members", WoWGuid::getGuidLowPartFromUInt64(mGuid)), "REPLACE INTO guild_members VALUES (%u, %u, %u, '%s', '%s')",
         mGuildId, WoWGuid::getGuidLowPartFromUInt64(mGuid), static_cast<uint32_t>(mRankId), mPublicNote.c_str(), mOfficerNote.c_str());
 }
 
@@ -2806,13 +2876,45 @@ bool Guild::GuildMember::isOnline()
 
 void Guild::GuildMember::changeRank(uint8_t newRank)
 {
-    mRankId = newRank;
+    {
+#if VERSION_STRING < Cata
+        std::lock_guard<std::mutex> guard(mRosterMutex);
+#endif
+        mRankId = newRank;
+#if VERSION_STRING < Cata
+        mRosterDataDirty = true;
+#endif
+    }
 
     if (Player* player = sObjectMgr.GetPlayer(WoWGuid::getGuidLowPartFromUInt64(mGuid)))
         player->setGuildRank(newRank);
 
-    CharacterDatabase.Execute("UPDATE guild_members SET guildRank = '%u' WHERE playerid = %u", static_cast<uint32_t>(newRank), WoWGuid::getGuidLowPartFromUInt64(mGuid));
+    sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_members.guildRank", WoWGuid::getGuidLowPartFromUInt64(mGuid)),
+        "UPDATE guild_members SET guildRank = '%u' WHERE playerid = %u", static_cast<uint32_t>(newRank), WoWGuid::getGuidLowPartFromUInt64(mGuid));
+}
+
+#if VERSION_STRING < Cata
+void Guild::GuildMember::appendRosterData(ByteBuffer& data) const
+{
+    std::lock_guard<std::mutex> guard(mRosterMutex);
+    if (mRosterDataDirty)
+    {
+        mRosterData.clear();
+        mRosterData << uint64_t(mGuid)
+            << uint8_t(mFlags)
+            << mName
+            << uint32_t(mRankId)
+            << uint8_t(mLevel)
+            << uint8_t(mClass)
+            << uint8_t(0)
+            << uint32_t(mZoneId);
+
+        mRosterDataDirty = false;
+    }
+
+    data.append(mRosterData);
 }
+#endif
 
 void Guild::GuildMember::updateLogoutTime()
 {
@@ -2838,7 +2940,8 @@ void Guild::GuildMember::updateBankWithdrawValue(uint8_t tabId, uint32_t amount)
 {
     mBankWithdraw[tabId] += amount;
 
-    CharacterDatabase.Execute("REPLACE INTO guild_members_withdraw VALUES('%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u')",
+    sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_members_withdraw", WoWGuid::getGuidLowPartFromUInt64(mGuid)),
+        "REPLACE INTO guild_members_withdraw VALUES('%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u')",
         WoWGuid::getGuidLowPartFromUInt64(mGuid),
         mBankWithdraw[0], mBankWithdraw[1], mBankWithdraw[2], mBankWithdraw[3], mBankWithdraw[4],
         mBankWithdraw[5], mBankWithdraw[6], 0, 0);
@@ -19,6 +19,7 @@ This file is released under the MIT license. See README-MIT for more information
 #include "GuildRankInfo.h"
 #include "GuildBankTab.h"
 
+#include <mutex>
 #include <string>
 
 
@@ -134,8 +135,21 @@ public:
 
         Player* getPlayerByGuid(uint64_t guid);
 
+#if VERSION_STRING < Cata
+        // appends guid, flags, name, rank, level, class and zone of the roster entry,
+        // the bytes are serialized again only after one of these fields has changed
+        void appendRosterData(ByteBuffer& data) const;
+#endif
+
     private:
 
+#if VERSION_STRING < Cata
+        // guards the cached roster entry against the setters of the cached fields
+        mutable std::mutex mRosterMutex;
+        mutable ByteBuffer mRosterData;
+        mutable bool mRosterDataDirty = true;
+#endif
+
         uint32_t mGuildId;
 
         uint64_t mGuid;
@@ -190,6 +204,9 @@ public:
     void saveGuildToDB();
 
     void handleRoster(WorldSession* session = nullptr);
+#if VERSION_STRING < Cata
+    void buildRosterPacket(WorldPacket& data, bool withOfficerNotes) const;
+#endif
     void handleQuery(WorldSession* session);
     void handleSetMOTD(WorldSession* session, std::string const& motd);
     void handleSetInfo(WorldSession* session, std::string const& info);
@@ -7,6 +7,7 @@ This file is released under the MIT license. See README-MIT for more information
 #include "GuildBankEventLog.h"
 #include "WoWGuid.h"
 #include "Server/MainServerDefines.h"
+#include "Management/GuildSaveQueue.h"
 
 
 GuildBankEventLogEntry::GuildBankEventLogEntry(uint32_t guildId, uint32_t guid, GuildBankEventLogTypes eventType, uint8_t tabId, uint32_t playerGuid,
@@ -34,12 +35,12 @@ bool GuildBankEventLogEntry::isMoneyEvent() const
 
 void GuildBankEventLogEntry::saveGuildLogToDB() const
 {
-    CharacterDatabase.Execute("DELETE FROM guild_bank_logs WHERE guildId = %u AND logGuid = %u AND tabId = %u",
-        mGuildId, mGuid, mBankTabId);
-
-    CharacterDatabase.Execute("INSERT INTO guild_bank_logs VALUES('%u', '%u', '%u', '%u', '%u', '%llu', '%u', '%u', '%llu')",
-        mGuildId, mGuid, mBankTabId, (uint32_t)mEventType, mPlayerGuid, mItemOrMoney, (uint32_t)mItemStackCount,
-        (uint32_t)mDestTabId, mTimestamp);
+    sGuildSaveQueue.queueGroup(mGuildId, GuildSaveQueue::makeKey("guild_bank_logs", mGuildId, mGuid, mBankTabId), {
+        GuildSaveQueue::format("DELETE FROM guild_bank_logs WHERE guildId = %u AND logGuid = %u AND tabId = %u",
+            mGuildId, mGuid, mBankTabId),
+        GuildSaveQueue::format("INSERT INTO guild_bank_logs VALUES('%u', '%u', '%u', '%u', '%u', '%llu', '%u', '%u', '%llu')",
+            mGuildId, mGuid, mBankTabId, (uint32_t)mEventType, mPlayerGuid, mItemOrMoney, (uint32_t)mItemStackCount,
+            (uint32_t)mDestTabId, mTimestamp) });
 }
 
 #if VERSION_STRING >= Cata
@@ -6,6 +6,7 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Guild.h"
 #include "GuildBankTab.h"
 #include "Server/MainServerDefines.h"
+#include "Management/GuildSaveQueue.h"
 #include "Management/Item.h"
 #include "Objects/ObjectMgr.h"
 #include "Server/Packets/MsgQueryGuildBankText.h"
@@ -32,7 +33,8 @@ bool GuildBankTab::loadGuildBankTabItemFromDB(Field* fields)
     Item* pItem = sObjectMgr.LoadItem(fields[3].GetUInt32());
     if (pItem == nullptr)
     {
-        CharacterDatabase.Execute("DELETE FROM guild_bank_items WHERE itemGuid = %u AND guildId = %u AND tabId = %u",
+        sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_bank_items", mGuildId, fields[1].GetUInt8(), slotId),
+            "DELETE FROM guild_bank_items WHERE itemGuid = %u AND guildId = %u AND tabId = %u",
             fields[3].GetUInt32(), mGuildId, static_cast<uint32_t>(fields[1].GetUInt8()));
     }
 
@@ -130,7 +132,8 @@ void GuildBankTab::setInfo(std::string const& name, std::string const& icon)
     mName = name;
     mIcon = icon;
 
-    CharacterDatabase.Execute("UPDATE guild_bank_tabs SET tabName = '%s' , tabIcon = '%s' WHERE guildId = '%u' AND tabId = '%u' ",
+    sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_bank_tabs.info", mGuildId, mTabId),
+        "UPDATE guild_bank_tabs SET tabName = '%s' , tabIcon = '%s' WHERE guildId = '%u' AND tabId = '%u' ",
         mName.c_str(), mIcon.c_str(), mGuildId, static_cast<uint32_t>(mTabId));
 }
 
@@ -141,7 +144,8 @@ void GuildBankTab::setText(std::string const& text)
 
     mText = text;
 
-    CharacterDatabase.Execute("UPDATE guild_bank_tabs SET tabText = '%s' , tabIcon = '%s' WHERE guildId = %u AND tabId = %u ",
+    sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_bank_tabs.text", mGuildId, mTabId),
+        "UPDATE guild_bank_tabs SET tabText = '%s' , tabIcon = '%s' WHERE guildId = %u AND tabId = %u ",
         mText.c_str(), mIcon.c_str(), mGuildId, static_cast<uint32_t>(mTabId));
 }
 
@@ -206,12 +210,14 @@ bool GuildBankTab::setItem(uint8_t slotId, Item* item)
             }
         }
 
-        CharacterDatabase.Execute("INSERT INTO guild_bank_items VALUES (%u, %u, %u, %u)", mGuildId, static_cast<uint32_t>(mTabId), slot_id, item->getGuidLow());
+        sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_bank_items", mGuildId, mTabId, slot_id),
+            "REPLACE INTO guild_bank_items VALUES (%u, %u, %u, %u)", mGuildId, static_cast<uint32_t>(mTabId), slot_id, item->getGuidLow());
     }
     else
     {
         mItems[slotId] = nullptr;
-        CharacterDatabase.Execute("DELETE FROM guild_bank_items WHERE guildId = %u AND tabId = %u AND slotId = %u", mGuildId, static_cast<uint32_t>(mTabId), static_cast<uint32_t>(slotId));
+        sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_bank_items", mGuildId, mTabId, slotId),
+            "DELETE FROM guild_bank_items WHERE guildId = %u AND tabId = %u AND slotId = %u", mGuildId, static_cast<uint32_t>(mTabId), static_cast<uint32_t>(slotId));
     }
 
     return true;
@@ -6,6 +6,7 @@ This file is released under the MIT license. See README-MIT for more information
 #include "GuildEmblemInfo.h"
 #include "Database/Database.h"
 #include "Server/MainServerDefines.h"
+#include "Management/GuildSaveQueue.h"
 
 EmblemInfo::EmblemInfo() : mStyle(0), mColor(0), mBorderStyle(0), mBorderColor(0), mBackgroundColor(0)
 {
@@ -22,7 +23,7 @@ void EmblemInfo::loadEmblemInfoFromDB(Field* fields)
 
 void EmblemInfo::saveEmblemInfoToDB(uint32_t guildId) const
 {
-    CharacterDatabase.Execute("UPDATE guilds SET emblemStyle = %u, emblemColor = %u, borderStyle = %u, borderColor = %u, backgroundColor = %u WHERE guildId = %u",
+    sGuildSaveQueue.queue(guildId, GuildSaveQueue::makeKey("guilds.emblem", guildId), "UPDATE guilds SET emblemStyle = %u, emblemColor = %u, borderStyle = %u, borderColor = %u, backgroundColor = %u WHERE guildId = %u",
         mStyle, mColor, mBorderStyle, mBorderColor, mBackgroundColor, guildId);
 }
 
@@ -7,6 +7,7 @@ This file is released under the MIT license. See README-MIT for more information
 #include "GuildEventLog.h"
 #include "WoWGuid.h"
 #include "Server/MainServerDefines.h"
+#include "Management/GuildSaveQueue.h"
 
 
 GuildEventLogEntry::GuildEventLogEntry(uint32_t guildId, uint32_t guid, GuildEventLogTypes eventType, uint32_t playerGuid1, uint32_t playerGuid2, uint8_t newRank) :
@@ -25,9 +26,10 @@ GuildEventLogEntry::~GuildEventLogEntry()
 
 void GuildEventLogEntry::saveGuildLogToDB() const
 {
-    CharacterDatabase.Execute("DELETE FROM guild_logs WHERE guildId = %u AND logGuid = %u", mGuildId, mGuid);
-    CharacterDatabase.Execute("INSERT INTO guild_logs VALUES(%u, %u, %u, %u, %u, %u, %llu)",
-        mGuildId, mGuid, uint8_t(mEventType), mPlayerGuid1, mPlayerGuid2, (uint32_t)mNewRank, mTimestamp);
+    sGuildSaveQueue.queueGroup(mGuildId, GuildSaveQueue::makeKey("guild_logs", mGuildId, mGuid), {
+        GuildSaveQueue::format("DELETE FROM guild_logs WHERE guildId = %u AND logGuid = %u", mGuildId, mGuid),
+        GuildSaveQueue::format("INSERT INTO guild_logs VALUES(%u, %u, %u, %u, %u, %u, %llu)",
+            mGuildId, mGuid, uint8_t(mEventType), mPlayerGuid1, mPlayerGuid2, (uint32_t)mNewRank, mTimestamp) });
 }
 
 #if VERSION_STRING >= Cata
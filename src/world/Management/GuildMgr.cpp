@@ -7,6 +7,7 @@ This file is released under the MIT license. See README-MIT for more information
 
 #include "GuildMgr.h"
 #include "Guild.h"
+#include "GuildSaveQueue.h"
 #include "Objects/ObjectMgr.h"
 #include "Server/MainServerDefines.h"
 
@@ -22,7 +23,7 @@ void GuildMgr::finalize()
         delete itr.second;
 }
 
-void GuildMgr::update(uint32_t /*diff*/)
+void GuildMgr::update(uint32_t diff)
 {
     if (!firstSave)
     {
@@ -35,6 +36,14 @@ void GuildMgr::update(uint32_t /*diff*/)
         lastSave = static_cast<uint32_t>(time(nullptr)) + worldConfig.guild.saveInterval;
         sGuildMgr.saveGuilds();
     }
+
+    // a full queue is written before the interval ends, a raid night in the guild bank must not pile up
+    flushTimer += diff;
+    if (flushTimer >= worldConfig.guild.flushInterval * 1000 || sGuildSaveQueue.getQueueDepth() >= maxPendingGuildWrites)
+    {
+        flushTimer = 0;
+        sGuildSaveQueue.flush();
+    }
 }
 
 void GuildMgr::saveGuilds()
@@ -53,6 +53,9 @@ class SERVER_DECL GuildMgr
         uint32_t lastSave = 0;
         bool firstSave = false;
 
+        uint32_t flushTimer = 0;
+        static const size_t maxPendingGuildWrites = 2000;
+
     protected:
 
         typedef std::unordered_map<uint32_t, Guild*> GuildContainer;
@@ -7,6 +7,7 @@ This file is released under the MIT license. See README-MIT for more information
 #include "GuildNewsLog.h"
 #include "WoWGuid.h"
 #include "Server/MainServerDefines.h"
+#include "Management/GuildSaveQueue.h"
 #include "Server/Definitions.h"
 #include "Objects/Object.h"
 
@@ -60,10 +61,10 @@ void GuildNewsLogEntry::setSticky(bool isSticky)
 
 void GuildNewsLogEntry::saveGuildLogToDB() const
 {
-    CharacterDatabase.Execute("DELETE FROM guild_news_log WHERE guildId = %u AND logGuid = %u", mGuildId, getGUID());
-
-    CharacterDatabase.Execute("INSERT INTO guild_news_log VALUES('%u', '%u', '%u', '%u', '%u', '%u', '%llu')",
-        mGuildId, getGUID(), static_cast<uint32_t>(getType()), static_cast<uint32_t>(getPlayerGuid()), getFlags(), getValue(), getTimestamp());
+    sGuildSaveQueue.queueGroup(mGuildId, GuildSaveQueue::makeKey("guild_news_log", mGuildId, getGUID()), {
+        GuildSaveQueue::format("DELETE FROM guild_news_log WHERE guildId = %u AND logGuid = %u", mGuildId, getGUID()),
+        GuildSaveQueue::format("INSERT INTO guild_news_log VALUES('%u', '%u', '%u', '%u', '%u', '%u', '%llu')",
+            mGuildId, getGUID(), static_cast<uint32_t>(getType()), static_cast<uint32_t>(getPlayerGuid()), getFlags(), getValue(), getTimestamp()) });
 }
 
 void GuildNewsLogEntry::writeGuildLogPacket(WorldPacket& data, ByteBuffer&) const
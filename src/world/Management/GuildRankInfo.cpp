@@ -8,6 +8,7 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Log.hpp"
 #include "Database/Database.h"
 #include "Server/MainServerDefines.h"
+#include "Management/GuildSaveQueue.h"
 
 
 GuildRankInfo::GuildRankInfo() : mGuildId(0), mRankId(GUILD_RANK_NONE), mRights(GR_RIGHT_EMPTY), mBankMoneyPerDay(0)
@@ -40,13 +41,15 @@ void GuildRankInfo::saveGuildRankToDB(bool _delete) const
 {
     if (_delete)
     {
-        CharacterDatabase.Execute("DELETE FROM guild_ranks WHERE guildId = %u AND rankId = %u", mGuildId, (uint32_t)mRankId);
+        sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_ranks", mGuildId, mRankId),
+            "DELETE FROM guild_ranks WHERE guildId = %u AND rankId = %u", mGuildId, (uint32_t)mRankId);
     }
     else
     {
-        CharacterDatabase.Execute("DELETE FROM guild_ranks WHERE guildId = %u AND rankId = %u", mGuildId, (uint32_t)mRankId);
-        CharacterDatabase.Execute("INSERT INTO guild_ranks (guildId, rankId, rankName, rankRights, goldLimitPerDay) VALUES ('%u', '%u', '%s', '%u', '0')",
-            mGuildId, (uint32_t)mRankId, mName.c_str(), mRights);
+        sGuildSaveQueue.queueGroup(mGuildId, GuildSaveQueue::makeKey("guild_ranks", mGuildId, mRankId), {
+            GuildSaveQueue::format("DELETE FROM guild_ranks WHERE guildId = %u AND rankId = %u", mGuildId, (uint32_t)mRankId),
+            GuildSaveQueue::format("INSERT INTO guild_ranks (guildId, rankId, rankName, rankRights, goldLimitPerDay) VALUES ('%u', '%u', '%s', '%u', '0')",
+                mGuildId, (uint32_t)mRankId, mName.c_str(), mRights) });
     }
 }
 
@@ -67,7 +70,8 @@ void GuildRankInfo::setName(std::string const& name)
 
     mName = name;
 
-    CharacterDatabase.Execute("UPDATE guild_ranks SET rankName = '%s', rankId = %u WHERE guildId = %u", mName.c_str(), static_cast<uint32_t>(mRankId), mGuildId);
+    sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_ranks.rankName", mGuildId, mRankId),
+        "UPDATE guild_ranks SET rankName = '%s' WHERE guildId = %u AND rankId = %u", CharacterDatabase.EscapeString(mName).c_str(), mGuildId, static_cast<uint32_t>(mRankId));
 }
 
 uint32_t GuildRankInfo::getRights() const
@@ -85,7 +89,8 @@ void GuildRankInfo::setRights(uint32_t rights)
 
     mRights = rights;
 
-    CharacterDatabase.Execute("UPDATE guild_ranks SET rankRights = %u WHERE guildId = %u AND rankId = %u", mRights, mGuildId, static_cast<uint32_t>(mRankId));
+    sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_ranks.rankRights", mGuildId, mRankId),
+        "UPDATE guild_ranks SET rankRights = %u WHERE guildId = %u AND rankId = %u", mRights, mGuildId, static_cast<uint32_t>(mRankId));
 }
 
 int32_t GuildRankInfo::getBankMoneyPerDay() const
@@ -103,7 +108,8 @@ void GuildRankInfo::setBankMoneyPerDay(uint32_t money)
 
     mBankMoneyPerDay = money;
 
-    CharacterDatabase.Execute("UPDATE guild_ranks SET goldLimitPerDay = '%u', rankId = '%u' WHERE guildId = %u", money, static_cast<uint32_t>(mRankId), mGuildId);
+    sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_ranks.goldLimitPerDay", mGuildId, mRankId),
+        "UPDATE guild_ranks SET goldLimitPerDay = %u WHERE guildId = %u AND rankId = %u", money, mGuildId, static_cast<uint32_t>(mRankId));
 }
 
 int8_t GuildRankInfo::getBankTabRights(uint8_t tabId) const
@@ -131,7 +137,7 @@ void GuildRankInfo::createMissingTabsIfNeeded(uint8_t tabs, bool /*_delete*/, bo
         if (logOnCreate)
             LogError("Guild %u has broken Tab %u for rank %u. Created default tab.", mGuildId, i, static_cast<uint32_t>(mRankId));
 
-        CharacterDatabase.Execute("REPLACE INTO guild_bank_rights VALUES(%u, %u, %u, %u, %u);",
+        sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_bank_rights", mGuildId, i, mRankId), "REPLACE INTO guild_bank_rights VALUES(%u, %u, %u, %u, %u);",
             mGuildId, i, static_cast<uint32_t>(mRankId), static_cast<uint32_t>(rightsAndSlots.getRights()), rightsAndSlots.getSlots());
     }
 }
@@ -146,7 +152,7 @@ void GuildRankInfo::setBankTabSlotsAndRights(GuildBankRightsAndSlots rightsAndSl
 
     if (saveToDB)
     {
-        CharacterDatabase.Execute("REPLACE INTO guild_bank_rights VALUES(%u, %u, %u, %u, %u)",
+        sGuildSaveQueue.queue(mGuildId, GuildSaveQueue::makeKey("guild_bank_rights", mGuildId, guildBR.getTabId(), mRankId), "REPLACE INTO guild_bank_rights VALUES(%u, %u, %u, %u, %u)",
             mGuildId, static_cast<uint32_t>(guildBR.getTabId()), static_cast<uint32_t>(mRankId), static_cast<uint32_t>(guildBR.getRights()), guildBR.getSlots());
     }
 }
@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "StdAfx.h"
+#include "Management/GuildSaveQueue.h"
+#include "Server/MainServerDefines.h"
+
+#include <cstdarg>
+
+GuildSaveQueue& GuildSaveQueue::getInstance()
+{
+    static GuildSaveQueue mInstance;
+    return mInstance;
+}
+
+std::string GuildSaveQueue::makeKey(char const* name, uint32_t id, uint32_t subId, uint32_t subId2)
+{
+    return std::string(name) + ":" + std::to_string(id) + ":" + std::to_string(subId) + ":" + std::to_string(subId2);
+}
+
+std::string GuildSaveQueue::format(const char* format, ...)
+{
+    char statement[16384];
+
+    va_list vlist;
+    va_start(vlist, format);
+    vsnprintf(statement, 16384, format, vlist);
+    va_end(vlist);
+
+    return statement;
+}
+
+void GuildSaveQueue::queue(uint32_t guildId, std::string const& key, const char* format, ...)
+{
+    char statement[16384];
+
+    va_list vlist;
+    va_start(vlist, format);
+    vsnprintf(statement, 16384, format, vlist);
+    va_end(vlist);
+
+    queueGroup(guildId, key, { statement });
+}
+
+void GuildSaveQueue::queueGroup(uint32_t guildId, std::string const& key, std::vector<std::string> statements)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    if (!key.empty())
+    {
+        const auto itr = m_pendingWritesByKey.find(key);
+        if (itr != m_pendingWritesByKey.end())
+        {
+            const auto guildItr = m_pendingWritesPerGuild.find(itr->second->guildId);
+            if (guildItr != m_pendingWritesPerGuild.end() && --guildItr->second == 0)
+                m_pendingWritesPerGuild.erase(guildItr);
+
+            m_pendingWrites.erase(itr->second);
+            m_pendingWritesByKey.erase(itr);
+            ++m_coalescedCount;
+        }
+    }
+
+    m_pendingWrites.push_back({ guildId, key, std::move(statements) });
+    ++m_pendingWritesPerGuild[guildId];
+
+    if (!key.empty())
+        m_pendingWritesByKey[key] = std::prev(m_pendingWrites.end());
+}
+
+size_t GuildSaveQueue::flush()
+{
+    // buffers have to reach the database in the order they were taken from the queue
+    std::lock_guard<std::mutex> flushGuard(m_flushMutex);
+
+    PendingWriteList pendingWrites;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        pendingWrites.swap(m_pendingWrites);
+        m_pendingWritesByKey.clear();
+        m_pendingWritesPerGuild.clear();
+    }
+
+    if (pendingWrites.empty())
+        return 0;
+
+    auto buffer = new QueryBuffer;
+    size_t statementCount = 0;
+    for (const auto& pendingWrite : pendingWrites)
+    {
+        for (const auto& statement : pendingWrite.statements)
+        {
+            buffer->AddQueryStr(statement);
+            ++statementCount;
+        }
+    }
+
+    CharacterDatabase.QueueQueryBuffer(buffer);
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_flushedCount += statementCount;
+
+    return statementCount;
+}
+
+size_t GuildSaveQueue::getQueueDepth() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_pendingWrites.size();
+}
+
+size_t GuildSaveQueue::getQueueDepth(uint32_t guildId) const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    const auto itr = m_pendingWritesPerGuild.find(guildId);
+    return itr != m_pendingWritesPerGuild.end() ? itr->second : 0;
+}
+
+uint64_t GuildSaveQueue::getCoalescedCount() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_coalescedCount;
+}
+
+uint64_t GuildSaveQueue::getFlushedCount() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_flushedCount;
+}
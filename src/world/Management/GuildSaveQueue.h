@@ -0,0 +1,76 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include "CommonTypes.hpp"
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Write-behind queue for the guild tables. Guilds keep their state in memory, their statements are
+// collected here and written by flush() in one transaction on the query buffer thread.
+//
+// A pending write with a key is replaced by the next write with the same key and moves to the end of
+// the queue. A key names one complete row (DELETE, REPLACE or DELETE + INSERT of that row) or one
+// column of one row, so the last write of a key always carries the in-memory state. Writes without
+// a key are never coalesced and keep their position.
+class SERVER_DECL GuildSaveQueue
+{
+    private:
+
+        GuildSaveQueue() = default;
+        ~GuildSaveQueue() = default;
+
+    public:
+
+        static GuildSaveQueue& getInstance();
+
+        GuildSaveQueue(GuildSaveQueue&&) = delete;
+        GuildSaveQueue(GuildSaveQueue const&) = delete;
+        GuildSaveQueue& operator=(GuildSaveQueue&&) = delete;
+        GuildSaveQueue& operator=(GuildSaveQueue const&) = delete;
+
+        static std::string makeKey(char const* name, uint32_t id, uint32_t subId = 0, uint32_t subId2 = 0);
+        static std::string format(const char* format, ...);
+
+        void queue(uint32_t guildId, std::string const& key, const char* format, ...);
+        void queueGroup(uint32_t guildId, std::string const& key, std::vector<std::string> statements);
+
+        // hands all pending statements to the character database, returns the statement count
+        size_t flush();
+
+        size_t getQueueDepth() const;
+        size_t getQueueDepth(uint32_t guildId) const;
+        uint64_t getCoalescedCount() const;
+        uint64_t getFlushedCount() const;
+
+    private:
+
+        struct PendingWrite
+        {
+            uint32_t guildId;
+            std::string key;
+            std::vector<std::string> statements;
+        };
+
+        typedef std::list<PendingWrite> PendingWriteList;
+
+        PendingWriteList m_pendingWrites;
+        std::unordered_map<std::string, PendingWriteList::iterator> m_pendingWritesByKey;
+        std::unordered_map<uint32_t, size_t> m_pendingWritesPerGuild;
+
+        uint64_t m_coalescedCount = 0;
+        uint64_t m_flushedCount = 0;
+
+        mutable std::mutex m_mutex;
+        std::mutex m_flushMutex;
+};
+
+#define sGuildSaveQueue GuildSaveQueue::getInstance()
@@ -83,7 +83,12 @@ uint64_t Item::getGiftCreatorGuid() const { return itemData()->gift_creator_guid
 void Item::setGiftCreatorGuid(uint64_t guid) { write(itemData()->gift_creator_guid.guid, guid); }
 
 uint32_t Item::getStackCount() const { return itemData()->stack_count; }
-void Item::setStackCount(uint32_t count) { write(itemData()->stack_count, count); }
+void Item::setStackCount(uint32_t count)
+{
+    write(itemData()->stack_count, count);
+    updateOwnerItemCountIndex();
+}
+
 void Item::modStackCount(int32_t mod)
 {
     int32_t newStackCount = getStackCount();
@@ -183,6 +188,12 @@ void Item::setContainer(Container* container) { setContainerGuid(container ? con
 ItemProperties const* Item::getItemProperties() const { return m_itemProperties; }
 void Item::setItemProperties(ItemProperties const* itemProperties) { m_itemProperties = itemProperties; }
 
+void Item::updateOwnerItemCountIndex()
+{
+    if (m_owner != nullptr && m_owner->getItemInterface() != nullptr)
+        m_owner->getItemInterface()->updateItemCountIndexStack(this);
+}
+
 bool Item::fitsToSpellRequirements(SpellInfo const* spellInfo) const
 {
     const auto itemProperties = getItemProperties();
@@ -456,6 +456,9 @@ public:
         uint32 random_suffix;
         time_t ItemExpiresOn;       /// this is for existingduration
 
+        /// the item count index of the owner has to follow stack counts
+        void updateOwnerItemCountIndex();
+
     private:
         /// Enchant type 3 spellids, like engineering gadgets appliable to items.
         uint32 OnUseSpellIDs[3];
@@ -115,6 +115,291 @@ bool ItemInterface::isItemInTradeWindow(Item const* item) const
     return item->getOwner()->getTradeData()->hasTradeItem(item->getGuid());
 }
 
+// Resolves where a slot goes in the item count index. order follows the search order FindItemLessMax
+// has always used: backpack, bags, currency, then bank slots and bank bags. False for slots outside the index.
+static bool getItemCountIndexSlot(int8_t containerSlot, int16_t slot, bool& isBank, bool& isStackCandidate, uint32_t& order)
+{
+    if (containerSlot == INVENTORY_SLOT_NOT_SET)
+    {
+        if (slot >= EQUIPMENT_SLOT_START && slot < INVENTORY_SLOT_ITEM_END)
+        {
+            isBank = false;
+            isStackCandidate = slot >= INVENTORY_SLOT_ITEM_START;
+        }
+        else if (slot >= INVENTORY_KEYRING_START && slot < INVENTORY_KEYRING_END)
+        {
+            isBank = false;
+            isStackCandidate = false;
+        }
+        else if (slot >= CURRENCYTOKEN_SLOT_START && slot < CURRENCYTOKEN_SLOT_END)
+        {
+            isBank = false;
+            isStackCandidate = true;
+            order = 0x10000 + slot;
+            return true;
+        }
+        else if (slot >= BANK_SLOT_ITEM_START && slot < BANK_SLOT_BAG_END)
+        {
+            isBank = true;
+            isStackCandidate = slot < BANK_SLOT_ITEM_END;
+        }
+        else
+        {
+            return false;
+        }
+
+        order = slot;
+        return true;
+    }
+
+    if (containerSlot >= INVENTORY_SLOT_BAG_START && containerSlot < INVENTORY_SLOT_BAG_END)
+        isBank = false;
+    else if (containerSlot >= BANK_SLOT_BAG_START && containerSlot < BANK_SLOT_BAG_END)
+        isBank = true;
+    else
+        return false;
+
+    isStackCandidate = true;
+    order = 0x100 * (containerSlot + 1) + slot;
+    return true;
+}
+
+static uint32_t getItemCountIndexStackCount(Item const* item)
+{
+    return item->getStackCount() ? item->getStackCount() : 1;
+}
+
+void ItemInterface::addToItemCountIndex(Item* item, int8_t containerSlot, int16_t slot)
+{
+    if (item->wrapped_item_id != 0)
+        return;
+
+    ItemCountIndexItem indexItem;
+    if (!getItemCountIndexSlot(containerSlot, slot, indexItem.isBank, indexItem.isStackCandidate, indexItem.order))
+        return;
+
+    indexItem.stackCount = 0;
+
+    const auto result = m_itemCountIndexItems.emplace(item, indexItem);
+    if (!result.second)
+        return;
+
+    if (indexItem.isStackCandidate)
+    {
+        ItemCountIndexEntry& entry = m_itemCountIndex[item->getEntry()];
+        std::vector<ItemCountIndexStack>& stacks = indexItem.isBank ? entry.bankStackItems : entry.stackItems;
+        const auto position = std::upper_bound(stacks.begin(), stacks.end(), indexItem.order, [](uint32_t order, ItemCountIndexStack const& stack)
+        {
+            return order < stack.order;
+        });
+        stacks.insert(position, { indexItem.order, item });
+    }
+
+    modItemCountIndexCount(item, result.first->second, static_cast<int32_t>(getItemCountIndexStackCount(item)));
+}
+
+void ItemInterface::modItemCountIndexCount(Item* item, ItemCountIndexItem& indexItem, int32_t mod)
+{
+    indexItem.stackCount += mod;
+
+    ItemCountIndexEntry& entry = m_itemCountIndex[item->getEntry()];
+    (indexItem.isBank ? entry.bankCount : entry.count) += mod;
+
+    const uint32_t limitCategory = item->getItemProperties()->ItemLimitCategory;
+    if (limitCategory != 0)
+    {
+        ItemCountIndexEntry& limitEntry = m_itemLimitCountIndex[limitCategory];
+        (indexItem.isBank ? limitEntry.bankCount : limitEntry.count) += mod;
+    }
+}
+
+void ItemInterface::addItemToCountIndex(Item* item, int8_t containerSlot, int16_t slot)
+{
+    if (!m_itemCountIndexValid)
+        return;
+
+    // a bag brings its contents along
+    if (item->isContainer())
+    {
+        invalidateItemCounts();
+        return;
+    }
+
+    addToItemCountIndex(item, containerSlot, slot);
+}
+
+void ItemInterface::addItemToCountIndex(Item* item, Container const* container, int16_t slot)
+{
+    if (!m_itemCountIndexValid)
+        return;
+
+    // contents of bags outside of the bag slots are not counted
+    for (int8_t i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
+    {
+        if (m_pItems[i] == container)
+        {
+            addItemToCountIndex(item, i, slot);
+            return;
+        }
+    }
+
+    for (int8_t i = BANK_SLOT_BAG_START; i < BANK_SLOT_BAG_END; ++i)
+    {
+        if (m_pItems[i] == container)
+        {
+            addItemToCountIndex(item, i, slot);
+            return;
+        }
+    }
+}
+
+void ItemInterface::removeItemFromCountIndex(Item* item)
+{
+    if (!m_itemCountIndexValid)
+        return;
+
+    if (item->isContainer())
+    {
+        invalidateItemCounts();
+        return;
+    }
+
+    const auto itr = m_itemCountIndexItems.find(item);
+    if (itr == m_itemCountIndexItems.end())
+        return;
+
+    modItemCountIndexCount(item, itr->second, -static_cast<int32_t>(itr->second.stackCount));
+
+    if (itr->second.isStackCandidate)
+    {
+        ItemCountIndexEntry& entry = m_itemCountIndex[item->getEntry()];
+        std::vector<ItemCountIndexStack>& stacks = itr->second.isBank ? entry.bankStackItems : entry.stackItems;
+        stacks.erase(std::remove_if(stacks.begin(), stacks.end(), [item](ItemCountIndexStack const& stack) { return stack.item == item; }), stacks.end());
+    }
+
+    m_itemCountIndexItems.erase(itr);
+}
+
+void ItemInterface::updateItemCountIndexStack(Item* item)
+{
+    if (!m_itemCountIndexValid)
+        return;
+
+    const auto itr = m_itemCountIndexItems.find(item);
+    if (itr == m_itemCountIndexItems.end())
+        return;
+
+    const int32_t mod = static_cast<int32_t>(getItemCountIndexStackCount(item)) - static_cast<int32_t>(itr->second.stackCount);
+    if (mod != 0)
+        modItemCountIndexCount(item, itr->second, mod);
+}
+
+void ItemInterface::rebuildItemCountIndex()
+{
+    m_itemCountIndex.clear();
+    m_itemLimitCountIndex.clear();
+    m_itemCountIndexItems.clear();
+
+    const auto addBagContents = [this](int8_t bagSlot)
+    {
+        Item* bag = GetInventoryItem(bagSlot);
+        if (bag == nullptr || !bag->isContainer())
+            return;
+
+        for (uint32_t i = 0; i < bag->getItemProperties()->ContainerSlots; ++i)
+        {
+            if (Item* item = static_cast<Container*>(bag)->GetItem(static_cast<int16_t>(i)))
+                addToItemCountIndex(item, bagSlot, static_cast<int16_t>(i));
+        }
+    };
+
+    for (int16_t i = EQUIPMENT_SLOT_START; i < INVENTORY_SLOT_ITEM_END; ++i)
+    {
+        if (Item* item = GetInventoryItem(i))
+            addToItemCountIndex(item, INVENTORY_SLOT_NOT_SET, i);
+    }
+
+    for (int8_t i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
+        addBagContents(i);
+
+    for (int16_t i = INVENTORY_KEYRING_START; i < INVENTORY_KEYRING_END; ++i)
+    {
+        if (Item* item = GetInventoryItem(i))
+            addToItemCountIndex(item, INVENTORY_SLOT_NOT_SET, i);
+    }
+
+    for (int16_t i = CURRENCYTOKEN_SLOT_START; i < CURRENCYTOKEN_SLOT_END; ++i)
+    {
+        if (Item* item = GetInventoryItem(i))
+            addToItemCountIndex(item, INVENTORY_SLOT_NOT_SET, i);
+    }
+
+    for (int16_t i = BANK_SLOT_ITEM_START; i < BANK_SLOT_BAG_END; ++i)
+    {
+        if (Item* item = GetInventoryItem(i))
+            addToItemCountIndex(item, INVENTORY_SLOT_NOT_SET, i);
+    }
+
+    for (int8_t i = BANK_SLOT_BAG_START; i < BANK_SLOT_BAG_END; ++i)
+        addBagContents(i);
+
+    m_itemCountIndexValid = true;
+}
+
+ItemInterface::ItemCountIndexEntry const* ItemInterface::getItemCountIndexEntry(uint32_t itemId)
+{
+    if (!m_itemCountIndexValid)
+        rebuildItemCountIndex();
+
+    const auto itr = m_itemCountIndex.find(itemId);
+    return itr != m_itemCountIndex.end() ? &itr->second : nullptr;
+}
+
+#ifdef _DEBUG
+uint32_t ItemInterface::scanItemCount(uint32_t itemId, bool includeBank)
+{
+    uint32_t count = 0;
+    const auto countItem = [&count, itemId](Item* item)
+    {
+        if (item != nullptr && item->getEntry() == itemId && item->wrapped_item_id == 0)
+            count += item->getStackCount() ? item->getStackCount() : 1;
+    };
+
+    const auto countBagContents = [this, &countItem](int16_t bagSlot)
+    {
+        Item* bag = GetInventoryItem(bagSlot);
+        if (bag == nullptr || !bag->isContainer())
+            return;
+
+        for (uint32_t i = 0; i < bag->getItemProperties()->ContainerSlots; ++i)
+            countItem(static_cast<Container*>(bag)->GetItem(static_cast<int16_t>(i)));
+    };
+
+    for (int16_t i = EQUIPMENT_SLOT_START; i < INVENTORY_SLOT_ITEM_END; ++i)
+        countItem(GetInventoryItem(i));
+
+    for (int16_t i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
+        countBagContents(i);
+
+    for (int16_t i = INVENTORY_KEYRING_START; i < INVENTORY_KEYRING_END; ++i)
+        countItem(GetInventoryItem(i));
+
+    for (int16_t i = CURRENCYTOKEN_SLOT_START; i < CURRENCYTOKEN_SLOT_END; ++i)
+        countItem(GetInventoryItem(i));
+
+    if (includeBank)
+    {
+        for (int16_t i = BANK_SLOT_ITEM_START; i < BANK_SLOT_BAG_END; ++i)
+            countItem(GetInventoryItem(i));
+
+        for (int16_t i = BANK_SLOT_BAG_START; i < BANK_SLOT_BAG_END; ++i)
+            countBagContents(i);
+    }
+
+    return count;
+}
+#endif
+
 // MIT End
 // APGL Start
 
@@ -255,6 +540,7 @@ AddItemResult ItemInterface::m_AddItem(Item* item, int8 ContainerSlot, int16 slo
 {
     ARCEMU_ASSERT(slot < MAX_INVENTORY_SLOT);
     ARCEMU_ASSERT(ContainerSlot < MAX_INVENTORY_SLOT);
+
     if (item == nullptr || !item->getItemProperties() || slot < 0)
         return ADD_ITEM_RESULT_ERROR;
 
@@ -316,6 +602,7 @@ AddItemResult ItemInterface::m_AddItem(Item* item, int8 ContainerSlot, int16 slo
             item->setOwner(m_pOwner);
             item->setContainerGuid(m_pOwner->getGuid());
             m_pItems[(int)slot] = item;
+            addItemToCountIndex(item, INVENTORY_SLOT_NOT_SET, slot);
 
             if (item->getItemProperties()->Bonding == ITEM_BIND_ON_PICKUP)
             {
@@ -459,6 +746,7 @@ Item* ItemInterface::SafeRemoveAndRetreiveItemFromSlot(int8 ContainerSlot, int16
 {
     ARCEMU_ASSERT(slot < MAX_INVENTORY_SLOT);
     ARCEMU_ASSERT(ContainerSlot < MAX_INVENTORY_SLOT);
+
     Item* pItem = nullptr;
 
     if (ContainerSlot == INVENTORY_SLOT_NOT_SET)
@@ -478,6 +766,7 @@ Item* ItemInterface::SafeRemoveAndRetreiveItemFromSlot(int8 ContainerSlot, int16
         }
 
         m_pItems[(int)slot] = nullptr;
+        removeItemFromCountIndex(pItem);
         if (pItem->getOwner() == m_pOwner)
         {
             pItem->m_isDirty = true;
@@ -641,6 +930,7 @@ bool ItemInterface::SafeFullRemoveItemFromSlot(int8 ContainerSlot, int16 slot)
         }
 
         m_pItems[(int)slot] = nullptr;
+        removeItemFromCountIndex(pItem);
         // hacky crashfix
         if (pItem->getOwner() == m_pOwner)
         {
@@ -829,91 +1119,27 @@ Container* ItemInterface::GetContainer(int8 containerSlot)
 /// Checks for stacks that didn't reached max capacity
 Item* ItemInterface::FindItemLessMax(uint32 itemid, uint32 cnt, bool IncBank)
 {
-    uint32 i;
-    for (i = INVENTORY_SLOT_ITEM_START; i < INVENTORY_SLOT_ITEM_END; ++i)
-    {
-        Item* item = GetInventoryItem(static_cast<int16>(i));
-        if (item)
-        {
-            uint32 itemMaxStack = (item->getOwner()->m_cheats.ItemStackCheat) ? 0x7fffffff : item->getItemProperties()->MaxCount;
-            if ((item->getEntry() == itemid && item->wrapped_item_id == 0) && (itemMaxStack >= (item->getStackCount() + cnt)))
-            {
-                return item;
-            }
-        }
-    }
-
-    for (i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
-    {
-        Item* item = GetInventoryItem(static_cast<int16>(i));
-        if (item && item->isContainer())
-        {
-            for (uint32 j = 0; j < item->getItemProperties()->ContainerSlots; ++j)
-            {
-                Item* item2 = static_cast<Container*>(item)->GetItem(static_cast<int16>(j));
-                if (item2)
-                {
-                    uint32 itemMaxStack = (item2->getOwner()->m_cheats.ItemStackCheat) ? 0x7fffffff : item2->getItemProperties()->MaxCount;
-                    if ((item2->getItemProperties()->ItemId == itemid && item2->wrapped_item_id == 0) && (itemMaxStack >= (item2->getStackCount() + cnt)))
-                    {
-                        return item2;
-                    }
-                }
-            }
-
-        }
-    }
-
-    for (i = CURRENCYTOKEN_SLOT_START; i < CURRENCYTOKEN_SLOT_END; ++i)
-    {
-        Item* item = GetInventoryItem(static_cast<int16>(i));
-        if (item)
-        {
-            uint32 itemMaxStack = (item->getOwner()->m_cheats.ItemStackCheat) ? 0x7fffffff : item->getItemProperties()->MaxCount;
-            if ((item->getEntry() == itemid && item->wrapped_item_id == 0) && (itemMaxStack >= (item->getStackCount() + cnt)))
-            {
-                return item;
-            }
-        }
-    }
+    ItemCountIndexEntry const* entry = getItemCountIndexEntry(itemid);
+    if (entry == nullptr)
+        return nullptr;
 
-    if (IncBank)
+    const auto findStack = [this, cnt](std::vector<ItemCountIndexStack> const& stacks) -> Item*
     {
-        for (i = BANK_SLOT_ITEM_START; i < BANK_SLOT_ITEM_END; ++i)
+        for (const auto& stack : stacks)
         {
-            Item* item = GetInventoryItem(static_cast<int16>(i));
-            if (item)
-            {
-                uint32 itemMaxStack = (item->getOwner()->m_cheats.ItemStackCheat) ? 0x7fffffff : item->getItemProperties()->MaxCount;
-                if ((item->getEntry() == itemid && item->wrapped_item_id == 0) && (itemMaxStack >= (item->getStackCount() + cnt)))
-                {
-                    return item;
-                }
-            }
+            uint32 itemMaxStack = (m_pOwner->m_cheats.ItemStackCheat) ? 0x7fffffff : stack.item->getItemProperties()->MaxCount;
+            if (itemMaxStack >= (stack.item->getStackCount() + cnt))
+                return stack.item;
         }
 
-        for (i = BANK_SLOT_BAG_START; i < BANK_SLOT_BAG_END; ++i)
-        {
-            Item* item = GetInventoryItem(static_cast<int16>(i));
-            if (item && item->isContainer())
-            {
+        return nullptr;
+    };
 
-                for (uint32 j = 0; j < item->getItemProperties()->ContainerSlots; ++j)
-                {
-                    Item* item2 = static_cast<Container*>(item)->GetItem(static_cast<int16>(j));
-                    if (item2)
-                    {
-                        uint32 itemMaxStack = (item2->getOwner()->m_cheats.ItemStackCheat) ? 0x7fffffff : item2->getItemProperties()->MaxCount;
-                        if ((item2->getItemProperties()->ItemId == itemid && item2->wrapped_item_id == 0) && (itemMaxStack >= (item2->getStackCount() + cnt)))
-                        {
-                            return item2;
-                        }
-                    }
-                }
+    if (Item* item = findStack(entry->stackItems))
+        return item;
 
-            }
-        }
-    }
+    if (IncBank)
+        return findStack(entry->bankStackItems);
 
     return nullptr;
 }
@@ -922,102 +1148,19 @@ Item* ItemInterface::FindItemLessMax(uint32 itemid, uint32 cnt, bool IncBank)
 uint32 ItemInterface::GetItemCount(uint32 itemid, bool IncBank)
 {
     uint32 cnt = 0;
-    uint32 i;
-    for (i = EQUIPMENT_SLOT_START; i < INVENTORY_SLOT_ITEM_END; ++i)
-    {
-        Item* item = GetInventoryItem(static_cast<int16>(i));
+    if (ItemCountIndexEntry const* entry = getItemCountIndexEntry(itemid))
+        cnt = entry->count + (IncBank ? entry->bankCount : 0);
 
-        if (item)
-        {
-            if (item->getEntry() == itemid && item->wrapped_item_id == 0)
-            {
-                cnt += item->getStackCount() ? item->getStackCount() : 1;
-            }
-        }
-    }
-
-    for (i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
+#ifdef _DEBUG
+    const uint32 scannedCount = scanItemCount(itemid, IncBank);
+    if (cnt != scannedCount)
     {
-        Item* item = GetInventoryItem(static_cast<int16>(i));
-        if (item && item->isContainer())
-        {
-            for (uint32 j = 0; j < item->getItemProperties()->ContainerSlots; ++j)
-            {
-                Item* item2 = static_cast<Container*>(item)->GetItem(static_cast<int16>(j));
-                if (item2)
-                {
-                    if (item2->getEntry() == itemid && item->wrapped_item_id == 0)
-                    {
-                        cnt += item2->getStackCount() ? item2->getStackCount() : 1;
-                    }
-                }
-            }
-
-        }
+        LogError("ItemInterface::GetItemCount : stale item count index for item %u (index %u, scan %u)", itemid, cnt, scannedCount);
+        invalidateItemCounts();
+        return scannedCount;
     }
+#endif
 
-    for (i = INVENTORY_KEYRING_START; i < INVENTORY_KEYRING_END; ++i)
-    {
-        Item* item = GetInventoryItem(static_cast<int16>(i));
-
-        if (item)
-        {
-            if (item->getItemProperties()->ItemId == itemid && item->wrapped_item_id == 0)
-            {
-                cnt += item->getStackCount() ? item->getStackCount() : 1;
-            }
-        }
-    }
-
-    for (i = CURRENCYTOKEN_SLOT_START; i < CURRENCYTOKEN_SLOT_END; ++i)
-    {
-        Item* item = GetInventoryItem(static_cast<int16>(i));
-
-        if (item)
-        {
-            if (item->getItemProperties()->ItemId == itemid && item->wrapped_item_id == 0)
-            {
-                cnt += item->getStackCount() ? item->getStackCount() : 1;
-            }
-        }
-    }
-
-    if (IncBank)
-    {
-        for (i = BANK_SLOT_ITEM_START; i < BANK_SLOT_BAG_END; ++i)
-        {
-            Item* item = GetInventoryItem(static_cast<int16>(i));
-            if (item)
-            {
-                if (item->getItemProperties()->ItemId == itemid && item->wrapped_item_id == 0)
-                {
-                    cnt += item->getStackCount() ? item->getStackCount() : 1;
-                }
-            }
-        }
-
-        for (i = BANK_SLOT_BAG_START; i < BANK_SLOT_BAG_END; ++i)
-        {
-            Item* item = GetInventoryItem(static_cast<int16>(i));
-            if (item)
-            {
-                if (item->isContainer())
-                {
-                    for (uint32 j = 0; j < item->getItemProperties()->ContainerSlots; ++j)
-                    {
-                        Item* item2 = static_cast<Container*>(item)->GetItem(static_cast<int16>(j));
-                        if (item2)
-                        {
-                            if (item2->getItemProperties()->ItemId == itemid && item->wrapped_item_id == 0)
-                            {
-                                cnt += item2->getStackCount() ? item2->getStackCount() : 1;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
     return cnt;
 }
 
@@ -2989,6 +3132,9 @@ void ItemInterface::SwapItemSlots(int8 srcslot, int8 dstslot)
     Item* DstItem = GetInventoryItem(dstslot);
 
     LOG_DEBUG("ItemInterface::SwapItemSlots(%u, %u);", srcslot, dstslot);
+
+    invalidateItemCounts();
+
     //Item * temp = GetInventoryItem(srcslot);
     //if (temp)
     //    LOG_DEBUG("Source item: %s (inventoryType=%u, realslot=%u);" , temp->GetProto()->Name1 , temp->GetProto()->InventoryType , GetItemSlotByType(temp->GetProto()->InventoryType));
@@ -3104,6 +3250,9 @@ void ItemInterface::SwapItemSlots(int8 srcslot, int8 dstslot)
 
     m_pItems[(int)srcslot] = DstItem;
 
+    // ApplyItemMods above may have rebuilt the count index from the old slots
+    invalidateItemCounts();
+
     // swapping 2 bags filled with items
     if (DstItem != nullptr && SrcItem != nullptr && SrcItem->isContainer() && DstItem->isContainer())
     {
@@ -3805,103 +3954,13 @@ uint32 ItemInterface::GetItemCountByLimitId(uint32 LimitId, bool IncBank)
 {
     uint32 cnt = 0;
 
-    for (uint8_t i = EQUIPMENT_SLOT_START; i < INVENTORY_SLOT_ITEM_END; ++i)
-    {
-        Item* item = GetInventoryItem(static_cast<int16>(i));
-        if (item != nullptr)
-        {
-            if (item->getItemProperties()->ItemLimitCategory == LimitId
-                && item->wrapped_item_id == 0)
-            {
-                cnt += item->getStackCount() ? item->getStackCount() : 1;
-            }
-        }
-    }
-
-    for (uint8_t i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
-    {
-        Item* item = GetInventoryItem(static_cast<int16>(i));
-        if (item && item->isContainer())
-        {
-            for (uint32 j = 0; j < item->getItemProperties()->ContainerSlots; ++j)
-            {
-                Item* item2 = (static_cast<Container*>(item))->GetItem(static_cast<int16>(j));
-                if (item2 != nullptr)
-                {
-                    if (item2->getItemProperties()->ItemLimitCategory == LimitId
-                        && item2->wrapped_item_id == 0)
-                    {
-                        cnt += item2->getStackCount() ? item2->getStackCount() : 1;
-                    }
-                }
-            }
-        }
-    }
-
-    for (uint8_t i = INVENTORY_KEYRING_START; i < INVENTORY_KEYRING_END; ++i)
-    {
-        Item* item = GetInventoryItem(static_cast<int16>(i));
-        if (item != nullptr)
-        {
-            if (item->getItemProperties()->ItemLimitCategory == LimitId
-                && item->wrapped_item_id == 0)
-            {
-                cnt += item->getStackCount() ? item->getStackCount() : 1;
-            }
-        }
-    }
+    if (!m_itemCountIndexValid)
+        rebuildItemCountIndex();
 
-    for (uint8_t i = CURRENCYTOKEN_SLOT_START; i < CURRENCYTOKEN_SLOT_END; ++i)
-    {
-        Item* item = GetInventoryItem(static_cast<int16>(i));
-        if (item != nullptr)
-        {
-            if (item->getItemProperties()->ItemLimitCategory == LimitId
-                && item->wrapped_item_id == 0)
-            {
-                cnt += item->getStackCount() ? item->getStackCount() : 1;
-            }
-        }
-    }
+    const auto itr = m_itemLimitCountIndex.find(LimitId);
+    if (itr != m_itemLimitCountIndex.end())
+        cnt = itr->second.count + (IncBank ? itr->second.bankCount : 0);
 
-    if (IncBank)
-    {
-        for (uint8_t i = BANK_SLOT_ITEM_START; i < BANK_SLOT_BAG_END; ++i)
-        {
-            Item* item = GetInventoryItem(static_cast<int16>(i));
-            if (item != nullptr)
-            {
-                if (item->getItemProperties()->ItemLimitCategory == LimitId
-                    && item->wrapped_item_id == 0)
-                {
-                    cnt += item->getStackCount() ? item->getStackCount() : 1;
-                }
-            }
-        }
-
-        for (uint8_t i = BANK_SLOT_BAG_START; i < BANK_SLOT_BAG_END; ++i)
-        {
-            Item* item = GetInventoryItem(static_cast<int16>(i));
-            if (item != nullptr)
-            {
-                if (item->isContainer())
-                {
-                    for (uint32 j = 0; j < item->getItemProperties()->ContainerSlots; ++j)
-                    {
-                        Item* item2 = (static_cast<Container*>(item))->GetItem(static_cast<int16>(j));
-                        if (item2 != nullptr)
-                        {
-                            if (item2->getItemProperties()->ItemLimitCategory == LimitId
-                                && item2->wrapped_item_id == 0)
-                            {
-                                cnt += item2->getStackCount() ? item2->getStackCount() : 1;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
     cnt += GetEquippedCountByItemLimit(LimitId);
 
     return cnt;
@@ -23,6 +23,9 @@
 #include "ItemPrototype.h"
 #include "Common.hpp"
 
+#include <unordered_map>
+#include <vector>
+
 class Creature;
 
 const uint8 INVALID_BACKPACK_SLOT = 0xFF;
@@ -75,13 +78,62 @@ class SERVER_DECL ItemInterface
 
         AddItemResult m_AddItem(Item* item, int8 ContainerSlot, int16 slot);
 
-    public:
         // APGL End
         // MIT Start
 
+        struct ItemCountIndexStack
+        {
+            uint32_t order;                            // position in the FindItemLessMax search order
+            Item* item;
+        };
+
+        struct ItemCountIndexEntry
+        {
+            uint32_t count = 0;                        // equipment, backpack, bags, keyring and currency
+            uint32_t bankCount = 0;                    // bank slots and bank bags
+            std::vector<ItemCountIndexStack> stackItems;     // FindItemLessMax candidates outside the bank, sorted by order
+            std::vector<ItemCountIndexStack> bankStackItems; // FindItemLessMax candidates in the bank, sorted by order
+        };
+
+        struct ItemCountIndexItem
+        {
+            uint32_t order;
+            uint32_t stackCount;                       // the count added to the entry
+            bool isBank;
+            bool isStackCandidate;
+        };
+
+        // Item counts by entry and by limit category. Adding and removing items and stack count changes
+        // update the index in place, layout changes (swaps, bags, gift wrapping) invalidate it and the
+        // next lookup rebuilds it with one scan.
+        std::unordered_map<uint32_t, ItemCountIndexEntry> m_itemCountIndex;
+        std::unordered_map<uint32_t, ItemCountIndexEntry> m_itemLimitCountIndex;
+        std::unordered_map<Item*, ItemCountIndexItem> m_itemCountIndexItems;
+        bool m_itemCountIndexValid = false;
+
+        void rebuildItemCountIndex();
+        void addToItemCountIndex(Item* item, int8_t containerSlot, int16_t slot);
+        void modItemCountIndexCount(Item* item, ItemCountIndexItem& indexItem, int32_t mod);
+        ItemCountIndexEntry const* getItemCountIndexEntry(uint32_t itemId);
+
+#ifdef _DEBUG
+        // full scan to validate the index
+        uint32_t scanItemCount(uint32_t itemId, bool includeBank);
+#endif
+
+    public:
+
         bool hasItemForTotemCategory(uint32_t totemCategory);
         bool isItemInTradeWindow(Item const* item) const;
 
+        void invalidateItemCounts() { m_itemCountIndexValid = false; }
+
+        // keep the item count index in sync, no-ops while the index is invalid
+        void addItemToCountIndex(Item* item, int8_t containerSlot, int16_t slot);
+        void addItemToCountIndex(Item* item, Container const* container, int16_t slot);
+        void removeItemFromCountIndex(Item* item);
+        void updateItemCountIndexStack(Item* item);
+
         // MIT End
         // APGL Start
 
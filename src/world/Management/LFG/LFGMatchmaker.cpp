@@ -0,0 +1,248 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "StdAfx.h"
+#include "Management/LFG/LFGMatchmaker.h"
+#include "Management/LFG/LFGMgr.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+bool LfgMatchmaker::buildDungeonMask(const LfgDungeonSet& dungeons, LfgDungeonMask& mask)
+{
+    mask.reset();
+    for (const auto dungeonId : dungeons)
+    {
+        if (dungeonId >= LFG_DUNGEON_MASK_BITS)
+            return false;
+
+        mask.set(dungeonId);
+    }
+
+    return mask.any();
+}
+
+void LfgMatchmaker::add(const LfgMatchmakerEntry& entry)
+{
+    remove(entry.guid);
+
+    const uint32_t serial = ++m_serial;
+    m_entries[entry.guid] = { entry, serial };
+
+    const uint8_t roleFlags[MATCHMAKER_ROLE_COUNT] = { ROLE_TANK, ROLE_HEALER, ROLE_DAMAGE };
+    for (uint8_t role = 0; role < MATCHMAKER_ROLE_COUNT; ++role)
+    {
+        if (!(entry.roles & roleFlags[role]))
+            continue;
+
+        auto& buckets = m_buckets[role];
+        auto& bucketIndex = m_bucketIndex[role];
+
+        const auto itr = bucketIndex.find(entry.dungeons);
+        if (itr == bucketIndex.end())
+        {
+            bucketIndex[entry.dungeons] = buckets.size();
+            buckets.emplace_back();
+            buckets.back().dungeons = entry.dungeons;
+            buckets.back().entries.push_back({ entry.guid, serial });
+        }
+        else
+        {
+            buckets[itr->second].entries.push_back({ entry.guid, serial });
+        }
+    }
+}
+
+void LfgMatchmaker::remove(uint64_t guid)
+{
+    const auto itr = m_entries.find(guid);
+    if (itr == m_entries.end())
+        return;
+
+    // bucket entries are dropped lazily, the serial tells them apart from a new entry of the same guid
+    const uint8_t roles = itr->second.entry.roles;
+    m_staleEntries += ((roles & ROLE_TANK) ? 1 : 0) + ((roles & ROLE_HEALER) ? 1 : 0) + ((roles & ROLE_DAMAGE) ? 1 : 0);
+    m_entries.erase(itr);
+
+    if (m_staleEntries > 64 && m_staleEntries > m_entries.size())
+        compact();
+}
+
+bool LfgMatchmaker::contains(uint64_t guid) const
+{
+    return m_entries.find(guid) != m_entries.end();
+}
+
+bool LfgMatchmaker::isLive(const BucketEntry& bucketEntry) const
+{
+    const auto itr = m_entries.find(bucketEntry.guid);
+    return itr != m_entries.end() && itr->second.serial == bucketEntry.serial;
+}
+
+bool LfgMatchmaker::pickOldest(MatchmakerRole role, LfgDungeonMask& dungeons, std::vector<uint64_t>& group) const
+{
+    const Bucket* bestBucket = nullptr;
+    const BucketEntry* bestEntry = nullptr;
+
+    for (const auto& bucket : m_buckets[role])
+    {
+        if ((bucket.dungeons & dungeons).none())
+            continue;
+
+        for (const auto& bucketEntry : bucket.entries)
+        {
+            if (!isLive(bucketEntry) || std::find(group.begin(), group.end(), bucketEntry.guid) != group.end())
+                continue;
+
+            if (bestEntry == nullptr || bucketEntry.serial < bestEntry->serial)
+            {
+                bestBucket = &bucket;
+                bestEntry = &bucketEntry;
+            }
+
+            // entries of a bucket are ordered by join time
+            break;
+        }
+    }
+
+    if (bestEntry == nullptr)
+        return false;
+
+    group.push_back(bestEntry->guid);
+    dungeons &= bestBucket->dungeons;
+    return true;
+}
+
+bool LfgMatchmaker::findGroup(const LfgMatchmakerEntry& entry, std::vector<uint64_t>& group) const
+{
+    const uint8_t roleFlags[MATCHMAKER_ROLE_COUNT] = { ROLE_TANK, ROLE_HEALER, ROLE_DAMAGE };
+    const uint8_t rolesNeeded[MATCHMAKER_ROLE_COUNT] = { LFG_TANKS_NEEDED, LFG_HEALERS_NEEDED, LFG_DPS_NEEDED };
+
+    // try every role the player has chosen, the scarce roles are filled first
+    for (uint8_t entryRole = 0; entryRole < MATCHMAKER_ROLE_COUNT; ++entryRole)
+    {
+        if (!(entry.roles & roleFlags[entryRole]))
+            continue;
+
+        group.clear();
+        group.push_back(entry.guid);
+        LfgDungeonMask dungeons = entry.dungeons;
+
+        bool complete = true;
+        for (uint8_t role = 0; role < MATCHMAKER_ROLE_COUNT && complete; ++role)
+        {
+            const uint8_t needed = rolesNeeded[role] - (role == entryRole ? 1 : 0);
+            for (uint8_t i = 0; i < needed && complete; ++i)
+                complete = pickOldest(MatchmakerRole(role), dungeons, group);
+        }
+
+        if (complete)
+            return true;
+    }
+
+    group.clear();
+    return false;
+}
+
+void LfgMatchmaker::compact()
+{
+    for (uint8_t role = 0; role < MATCHMAKER_ROLE_COUNT; ++role)
+    {
+        auto& buckets = m_buckets[role];
+        for (auto& bucket : buckets)
+        {
+            bucket.entries.erase(std::remove_if(bucket.entries.begin(), bucket.entries.end(), [this](const BucketEntry& bucketEntry)
+            {
+                return !isLive(bucketEntry);
+            }), bucket.entries.end());
+        }
+
+        buckets.erase(std::remove_if(buckets.begin(), buckets.end(), [](const Bucket& bucket)
+        {
+            return bucket.entries.empty();
+        }), buckets.end());
+
+        m_bucketIndex[role].clear();
+        for (size_t i = 0; i < buckets.size(); ++i)
+            m_bucketIndex[role][buckets[i].dungeons] = i;
+    }
+
+    m_staleEntries = 0;
+}
+
+LfgMatchmakerSimulation LfgMatchmaker::simulate(uint32_t players, uint32_t dungeons)
+{
+    LfgMatchmakerSimulation result;
+    result.players = players;
+
+    dungeons = std::max(1u, std::min(dungeons, LFG_DUNGEON_MASK_BITS - 1));
+
+    // fixed seed, runs are comparable
+    std::mt19937 random(players);
+    LfgMatchmaker matchmaker;
+    std::vector<uint32_t> joinIndex(players + 1, 0);
+    std::vector<uint64_t> group;
+
+    for (uint32_t i = 0; i < players; ++i)
+    {
+        LfgMatchmakerEntry entry;
+        entry.guid = i + 1;
+
+        const uint32_t roleRoll = random() % 100;
+        if (roleRoll < 10)
+            entry.roles = ROLE_TANK;
+        else if (roleRoll < 25)
+            entry.roles = ROLE_HEALER;
+        else if (roleRoll < 85)
+            entry.roles = ROLE_DAMAGE;
+        else if (roleRoll < 93)
+            entry.roles = ROLE_TANK | ROLE_DAMAGE;
+        else
+            entry.roles = ROLE_HEALER | ROLE_DAMAGE;
+
+        // a third queues for the random dungeon (all dungeons), the others pick up to three
+        if (random() % 3 == 0)
+        {
+            for (uint32_t dungeon = 1; dungeon <= dungeons; ++dungeon)
+                entry.dungeons.set(dungeon);
+        }
+        else
+        {
+            const uint32_t picks = 1 + random() % 3;
+            for (uint32_t pick = 0; pick < picks; ++pick)
+                entry.dungeons.set(1 + random() % dungeons);
+        }
+
+        const auto startTime = std::chrono::high_resolution_clock::now();
+        const bool found = matchmaker.findGroup(entry, group);
+        const auto microseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - startTime).count());
+
+        result.totalMicroseconds += microseconds;
+        result.maxMicroseconds = std::max(result.maxMicroseconds, microseconds);
+
+        if (found)
+        {
+            ++result.proposals;
+            result.proposalMicroseconds += microseconds;
+            for (const auto guid : group)
+            {
+                if (guid == entry.guid)
+                    continue;
+
+                result.waitedJoins += i - joinIndex[guid];
+                matchmaker.remove(guid);
+            }
+        }
+        else
+        {
+            joinIndex[entry.guid] = i;
+            matchmaker.add(entry);
+        }
+    }
+
+    result.leftInQueue = static_cast<uint32_t>(matchmaker.size());
+    return result;
+}
@@ -0,0 +1,98 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include "LFG.h"
+
+#include <bitset>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+// one bit per dungeon id, big enough for MAX_DUNGEONS of every version
+static const uint32_t LFG_DUNGEON_MASK_BITS = 512;
+typedef std::bitset<LFG_DUNGEON_MASK_BITS> LfgDungeonMask;
+
+struct LfgMatchmakerEntry
+{
+    uint64_t guid = 0;
+    uint8_t roles = 0;
+    LfgDungeonMask dungeons;
+};
+
+struct LfgMatchmakerSimulation
+{
+    uint32_t players = 0;
+    uint32_t proposals = 0;
+    uint32_t leftInQueue = 0;
+    uint64_t totalMicroseconds = 0;                        ///< Time spent in findGroup for all joins
+    uint64_t maxMicroseconds = 0;                          ///< Slowest single join
+    uint64_t proposalMicroseconds = 0;                     ///< Time spent in findGroup for joins which formed a proposal
+    uint64_t waitedJoins = 0;                              ///< Sum of joins every grouped player waited for its proposal
+};
+
+// Matches single queued players without trying combinations of the whole queue.
+// Entries are kept in buckets per role and selected dungeons, a group is formed greedily
+// (tank, healer, then three dps) by taking the oldest entry of all buckets whose dungeons still
+// intersect with the dungeons of the players picked so far.
+// Groups from here still have to pass LfgMgr::CheckCompatibility (locks, online state...).
+class LfgMatchmaker
+{
+    public:
+
+        // false if one of the dungeons does not fit into the mask
+        static bool buildDungeonMask(const LfgDungeonSet& dungeons, LfgDungeonMask& mask);
+
+        void add(const LfgMatchmakerEntry& entry);
+        void remove(uint64_t guid);
+        bool contains(uint64_t guid) const;
+        size_t size() const { return m_entries.size(); }
+
+        // fills group with the guid of entry and the 4 guids found in the buckets, entry does not need to be added
+        bool findGroup(const LfgMatchmakerEntry& entry, std::vector<uint64_t>& group) const;
+
+        // joins the given amount of random players into an empty matchmaker, used by .debug lfgsimulate
+        static LfgMatchmakerSimulation simulate(uint32_t players, uint32_t dungeons);
+
+    private:
+
+        enum MatchmakerRole
+        {
+            MATCHMAKER_TANK,
+            MATCHMAKER_HEALER,
+            MATCHMAKER_DPS,
+            MATCHMAKER_ROLE_COUNT
+        };
+
+        struct BucketEntry
+        {
+            uint64_t guid;
+            uint32_t serial;
+        };
+
+        struct Bucket
+        {
+            LfgDungeonMask dungeons;
+            std::deque<BucketEntry> entries;
+        };
+
+        struct StoredEntry
+        {
+            LfgMatchmakerEntry entry;
+            uint32_t serial;
+        };
+
+        bool isLive(const BucketEntry& bucketEntry) const;
+        bool pickOldest(MatchmakerRole role, LfgDungeonMask& dungeons, std::vector<uint64_t>& group) const;
+        void compact();
+
+        std::unordered_map<uint64_t, StoredEntry> m_entries;
+        std::vector<Bucket> m_buckets[MATCHMAKER_ROLE_COUNT];
+        std::unordered_map<LfgDungeonMask, size_t> m_bucketIndex[MATCHMAKER_ROLE_COUNT];
+        uint32_t m_serial = 0;
+        size_t m_staleEntries = 0;
+};
@@ -28,6 +28,8 @@
 
 uint32 LfgDungeonTypes[MAX_DUNGEONS];
 
+static_assert(MAX_DUNGEONS <= LFG_DUNGEON_MASK_BITS, "LfgDungeonMask has to hold every dungeon id");
+
 LfgMgr& LfgMgr::getInstance()
 {
     static LfgMgr mInstance;
@@ -251,6 +253,7 @@ void LfgMgr::Update(uint32 diff)
         uint8 queueId = it->first;
         LfgGuidList& newToQueue = it->second;
         LfgGuidList& currentQueue = m_currentQueue[queueId];
+        LfgMatchmaker& matchmaker = m_matchmakers[queueId];
         LfgGuidList firstNew;
         while (!newToQueue.empty())
         {
@@ -259,14 +262,32 @@ void LfgMgr::Update(uint32 diff)
             firstNew.push_back(frontguid);
             newToQueue.pop_front();
 
-            LfgGuidList temporalList = currentQueue;
-            if (LfgProposal* pProposal = FindNewGroups(firstNew, temporalList)) // Group found!
+            LfgProposal* pProposal = nullptr;
+            bool matchmakerRejected = false;
+            LfgMatchmakerEntry matchmakerEntry;
+            bool isMatchmakerEntry = GetMatchmakerEntry(frontguid, matchmakerEntry);
+            if (isMatchmakerEntry)
+            {
+                pProposal = FindMatchmakerGroup(queueId, matchmakerEntry, matchmakerRejected);
+            }
+
+            // Groups are only matched by trying the combinations of the queue, single players
+            // only need it when groups are queued, the matchmaker already tried all other single players.
+            // A matchmaker group rejected by CheckCompatibility falls back to the full search as well.
+            if (!pProposal && (!isMatchmakerEntry || matchmakerRejected || currentQueue.size() > matchmaker.size()))
+            {
+                LfgGuidList temporalList = currentQueue;
+                pProposal = FindNewGroups(firstNew, temporalList);
+            }
+
+            if (pProposal) // Group found!
             {
                 // Remove groups in the proposal from new and current queues (not from queue map)
                 for (LfgGuidList::const_iterator itQueue = pProposal->queues.begin(); itQueue != pProposal->queues.end(); ++itQueue)
                 {
                     currentQueue.remove(*itQueue);
                     newToQueue.remove(*itQueue);
+                    matchmaker.remove(*itQueue);
                 }
 
                 m_Proposals[++m_lfgProposalId] = pProposal;
@@ -309,6 +330,11 @@ void LfgMgr::Update(uint32 diff)
                 {
                     currentQueue.push_back(frontguid);         // Lfg group not found, add this group to the queue.
                 }
+
+                if (isMatchmakerEntry && m_QueueInfoMap.find(frontguid) != m_QueueInfoMap.end())
+                {
+                    matchmaker.add(matchmakerEntry);
+                }
             }
 
             firstNew.clear();
@@ -406,6 +432,11 @@ bool LfgMgr::RemoveFromQueue(uint64 guid)
         it->second.remove(guid);
     }
 
+    for (LfgMatchmakerMap::iterator it = m_matchmakers.begin(); it != m_matchmakers.end(); ++it)
+    {
+        it->second.remove(guid);
+    }
+
     RemoveFromCompatibles(guid);
 
     LfgQueueInfoMap::iterator it = m_QueueInfoMap.find(guid);
@@ -844,7 +875,7 @@ void LfgMgr::OfferContinue(Group* grp)
 
 LfgProposal* LfgMgr::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
 {
-    LOG_DEBUG("(%s) - all(%s)", ConcatenateGuids(check).c_str(), ConcatenateGuids(all).c_str());
+    LOG_DEBUG("(%u queues) - all(%u)", uint32(check.size()), uint32(all.size()));
 
     LfgProposal* pProposal = nullptr;
     if (check.empty() || check.size() > 5 || !CheckCompatibility(check, pProposal))
@@ -863,6 +894,52 @@ LfgProposal* LfgMgr::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
     return pProposal;
 }
 
+bool LfgMgr::GetMatchmakerEntry(uint64 guid, LfgMatchmakerEntry& entry)
+{
+    LfgQueueInfoMap::const_iterator itQueue = m_QueueInfoMap.find(guid);
+    if (itQueue == m_QueueInfoMap.end() || !itQueue->second || itQueue->second->roles.size() != 1)
+    {
+        return false;
+    }
+
+    uint64 playerGuid = itQueue->second->roles.begin()->first;
+
+    // Locked dungeons would fail CheckCompatibility for every group found with them
+    LfgDungeonSet dungeons = itQueue->second->dungeons;
+    const LfgLockMap& lockMap = GetLockedDungeons(playerGuid);
+    for (LfgLockMap::const_iterator it = lockMap.begin(); it != lockMap.end(); ++it)
+    {
+        dungeons.erase(it->first & 0x00FFFFFF);
+    }
+
+    entry.guid = guid;
+    entry.roles = itQueue->second->roles.begin()->second;
+    return LfgMatchmaker::buildDungeonMask(dungeons, entry.dungeons);
+}
+
+LfgProposal* LfgMgr::FindMatchmakerGroup(uint8 queueId, const LfgMatchmakerEntry& entry, bool& rejected)
+{
+    rejected = false;
+
+    std::vector<uint64> group;
+    if (!m_matchmakers[queueId].findGroup(entry, group))
+    {
+        return nullptr;
+    }
+
+    LOG_DEBUG("QueueId %u: matchmaker found a group for " I64FMTD, queueId, entry.guid);
+
+    LfgGuidList check(group.begin(), group.end());
+    LfgProposal* pProposal = nullptr;
+    if (!CheckCompatibility(check, pProposal) || !pProposal)
+    {
+        LOG_DEBUG("QueueId %u: matchmaker group for " I64FMTD " rejected", queueId, entry.guid);
+        rejected = true;
+    }
+
+    return pProposal;
+}
+
 bool LfgMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
 {
     if (pProposal)                                         // Do not check anything if we already have a proposal
@@ -870,14 +947,14 @@ bool LfgMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         return false;
     }
 
-    std::string strGuids = ConcatenateGuids(check);
-
     if (check.size() > 5 || check.empty())
     {
-        LOG_DEBUG("(%s): Size wrong - Not compatibles", strGuids.c_str());
+        LOG_DEBUG("(%u queues): Size wrong - Not compatibles", uint32(check.size()));
         return false;
     }
 
+    const LfgCompatibleKey key(check);
+
     if (check.size() == 1)
     {
         WoWGuid wowGuid;
@@ -890,10 +967,10 @@ bool LfgMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     }
 
     // Previously cached?
-    LfgAnswer answer = GetCompatibles(strGuids);
+    LfgAnswer answer = GetCompatibles(key);
     if (answer != LFG_ANSWER_PENDING)
     {
-        LOG_DEBUG("(%s) compatibles (cached): %d", strGuids.c_str(), answer);
+        LOG_DEBUG("(" I64FMTD " +%u) compatibles (cached): %d", key.guids[0], uint32(key.count - 1), answer);
         return bool(answer ? true : false);
     }
 
@@ -906,8 +983,8 @@ bool LfgMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         // Check all-but-new compatibilities (New, A, B, C, D) --> check(A, B, C, D)
         if (!CheckCompatibility(check, pProposal))          // Group not compatible
         {
-            LOG_DEBUG("(%s) not compatibles (%s not compatibles)", strGuids.c_str(), ConcatenateGuids(check).c_str());
-            SetCompatibles(strGuids, false);
+            LOG_DEBUG("(" I64FMTD " +%u) not compatibles (" I64FMTD " +%u not compatibles)", frontGuid, uint32(check.size()), check.front(), uint32(check.size() - 1));
+            SetCompatibles(key, false);
             return false;
         }
         check.push_front(frontGuid);
@@ -960,14 +1037,14 @@ bool LfgMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     // Do not match - groups already in a lfgDungeon or too much players
     if (numLfgGroups > 1 || numPlayers > 5)
     {
-        SetCompatibles(strGuids, false);
+        SetCompatibles(key, false);
         if (numLfgGroups > 1)
         {
-            LOG_DEBUG("(%s) More than one Lfggroup (%u)", strGuids.c_str(), numLfgGroups);
+            LOG_DEBUG("(" I64FMTD " +%u) More than one Lfggroup (%u)", key.guids[0], uint32(key.count - 1), numLfgGroups);
         }
         else
         {
-            LOG_DEBUG("(%s) Too much players (%u)", strGuids.c_str(), numPlayers);
+            LOG_DEBUG("(" I64FMTD " +%u) Too much players (%u)", key.guids[0], uint32(key.count - 1), numPlayers);
         }
 
         return false;
@@ -1002,7 +1079,7 @@ bool LfgMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         Player* player = sObjectMgr.GetPlayer(wowGuid.getGuidLowPart());
         if (!player)
         {
-            LOG_DEBUG("(%s) Warning! %u offline! Marking as not compatibles!", strGuids.c_str(), it->first);
+            LOG_DEBUG("(" I64FMTD " +%u) Warning! " I64FMTD " offline! Marking as not compatibles!", key.guids[0], uint32(key.count - 1), it->first);
         }
         else
         {
@@ -1023,10 +1100,10 @@ bool LfgMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     {
         if (players.size() == numPlayers)
         {
-            LOG_DEBUG("(%s) Roles not compatible", strGuids.c_str());
+            LOG_DEBUG("(" I64FMTD " +%u) Roles not compatible", key.guids[0], uint32(key.count - 1));
         }
 
-        SetCompatibles(strGuids, false);
+        SetCompatibles(key, false);
         return false;
     }
 
@@ -1054,15 +1131,15 @@ bool LfgMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
 
     if (compatibleDungeons.empty())
     {
-        SetCompatibles(strGuids, false);
+        SetCompatibles(key, false);
         return false;
     }
-    SetCompatibles(strGuids, true);
+    SetCompatibles(key, true);
 
     // ----- Group is compatible, if we have MAXGROUPSIZE members then match is found
     if (numPlayers != 5)
     {
-        LOG_DEBUG("(%s) Compatibles but not match. Players(%u)", strGuids.c_str(), numPlayers);
+        LOG_DEBUG("(" I64FMTD " +%u) Compatibles but not match. Players(%u)", key.guids[0], uint32(key.count - 1), numPlayers);
         uint8 Tanks_Needed = LFG_TANKS_NEEDED;
         uint8 Healers_Needed = LFG_HEALERS_NEEDED;
         uint8 Dps_Needed = LFG_DPS_NEEDED;
@@ -1104,7 +1181,7 @@ bool LfgMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         }
         return true;
     }
-    LOG_DEBUG("(%s) MATCH! Group formed", strGuids.c_str());
+    LOG_DEBUG("(" I64FMTD " +%u) MATCH! Group formed", key.guids[0], uint32(key.count - 1));
 
     // GROUP FORMED!
 
@@ -1273,25 +1350,57 @@ void LfgMgr::UpdateRoleCheck(uint64 gguid, uint64 guid /* = 0 */, uint8 roles /*
 
 void LfgMgr::RemoveFromCompatibles(uint64 guid)
 {
-    std::stringstream out;
-    out << guid;
-    std::string strGuid = out.str();
-
     LOG_DEBUG("Removing %u", guid);
-    for (LfgCompatibleMap::iterator itNext = m_CompatibleMap.begin(); itNext != m_CompatibleMap.end();)
+    LfgCompatibleIndex::iterator itIndex = m_CompatibleIndex.find(guid);
+    if (itIndex == m_CompatibleIndex.end())
+        return;
+
+    std::vector<LfgCompatibleKey> keys;
+    keys.swap(itIndex->second);
+    m_CompatibleIndex.erase(itIndex);
+
+    for (std::vector<LfgCompatibleKey>::const_iterator it = keys.begin(); it != keys.end(); ++it)
     {
-        LfgCompatibleMap::iterator it = itNext++;
-        if (it->first.find(strGuid) != std::string::npos)  // Found, remove it
-            m_CompatibleMap.erase(it);
+        m_CompatibleMap.erase(*it);
+
+        // drop the key from the index of the other guids too, it would be stale and pushed again by SetCompatibles
+        for (uint8 i = 0; i < it->count; ++i)
+        {
+            if (it->guids[i] == guid)
+                continue;
+
+            LfgCompatibleIndex::iterator itPartner = m_CompatibleIndex.find(it->guids[i]);
+            if (itPartner == m_CompatibleIndex.end())
+                continue;
+
+            std::vector<LfgCompatibleKey>& partnerKeys = itPartner->second;
+            std::vector<LfgCompatibleKey>::iterator itKey = std::find(partnerKeys.begin(), partnerKeys.end(), *it);
+            if (itKey != partnerKeys.end())
+            {
+                *itKey = partnerKeys.back();
+                partnerKeys.pop_back();
+            }
+
+            if (partnerKeys.empty())
+                m_CompatibleIndex.erase(itPartner);
+        }
     }
 }
 
-void LfgMgr::SetCompatibles(std::string key, bool compatibles)
+void LfgMgr::SetCompatibles(const LfgCompatibleKey& key, bool compatibles)
 {
-    m_CompatibleMap[key] = LfgAnswer(compatibles);
+    std::pair<LfgCompatibleMap::iterator, bool> result = m_CompatibleMap.insert(std::make_pair(key, LfgAnswer(compatibles)));
+    if (!result.second)
+    {
+        result.first->second = LfgAnswer(compatibles);
+        return;
+    }
+
+    for (uint8 i = 0; i < key.count; ++i)
+        m_CompatibleIndex[key.guids[i]].push_back(key);
 }
 
-LfgAnswer LfgMgr::GetCompatibles(std::string key)
+LfgAnswer LfgMgr::GetCompatibles(const LfgCompatibleKey& key)
 {
     LfgAnswer answer = LFG_ANSWER_PENDING;
     LfgCompatibleMap::iterator it = m_CompatibleMap.find(key);
@@ -2189,19 +2298,6 @@ LfgType LfgMgr::GetDungeonType(uint32 dungeonId)
 #endif
 }
 
-std::string LfgMgr::ConcatenateGuids(LfgGuidList check)
-{
-    if (check.empty())
-        return "";
-
-    std::ostringstream o;
-    LfgGuidList::const_iterator it = check.begin();
-    o << (*it);
-    for (++it; it != check.end(); ++it)
-        o << '|' << (*it);
-    return o.str();
-}
-
 LfgState LfgMgr::GetState(uint64 guid)
 {
     LOG_DEBUG("%u", guid);
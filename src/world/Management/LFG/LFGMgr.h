@@ -6,8 +6,12 @@ This file is released under the MIT license. See README-MIT for more information
 #pragma once
 
 #include "LFG.h"
+#include "LFGMatchmaker.h"
 #include "Server/Definitions.h"
+#include <algorithm>
+#include <array>
 #include <list>
+#include <unordered_map>
 #include "Server/EventableObject.h"
 
 #define MAX_LFG_QUEUE_ID 3
@@ -152,7 +156,6 @@ typedef std::set<Player*> PlayerSet;
 typedef std::list<Player*> LfgPlayerList;
 typedef std::multimap<uint32, LfgReward const*> LfgRewardMap;
 typedef std::pair<LfgRewardMap::const_iterator, LfgRewardMap::const_iterator> LfgRewardMapBounds;
-typedef std::map<std::string, LfgAnswer> LfgCompatibleMap;
 typedef std::map<uint64, LfgDungeonSet> LfgDungeonMap;
 typedef std::map<uint64, uint8> LfgRolesMap;
 typedef std::map<uint64, LfgAnswer> LfgAnswerMap;
@@ -164,6 +167,43 @@ typedef std::map<uint32, LfgPlayerBoot*> LfgPlayerBootMap;
 typedef std::map<uint64, LfgGroupData> LfgGroupDataMap;
 typedef std::map<uint64, LfgPlayerData> LfgPlayerDataMap;
 
+/// Key of the compatibility cache, the sorted guids of up to 5 queues
+struct LfgCompatibleKey
+{
+    explicit LfgCompatibleKey(const LfgGuidList& check): count(0)
+    {
+        guids.fill(0);
+        for (LfgGuidList::const_iterator it = check.begin(); it != check.end() && count < guids.size(); ++it)
+            guids[count++] = *it;
+
+        std::sort(guids.begin(), guids.begin() + count);
+    }
+
+    bool operator==(const LfgCompatibleKey& other) const
+    {
+        return count == other.count && guids == other.guids;
+    }
+
+    std::array<uint64, 5> guids;
+    uint8 count;
+};
+
+struct LfgCompatibleKeyHash
+{
+    size_t operator()(const LfgCompatibleKey& key) const
+    {
+        uint64 hash = 0xcbf29ce484222325ULL ^ key.count;
+        for (uint8 i = 0; i < key.count; ++i)
+            hash = (hash ^ key.guids[i]) * 0x100000001b3ULL;
+
+        return size_t(hash ^ (hash >> 32));
+    }
+};
+
+typedef std::unordered_map<LfgCompatibleKey, LfgAnswer, LfgCompatibleKeyHash> LfgCompatibleMap;
+typedef std::unordered_map<uint64, std::vector<LfgCompatibleKey>> LfgCompatibleIndex;
+typedef std::map<uint8, LfgMatchmaker> LfgMatchmakerMap;
+
 // Data needed by SMSG_LFG_JOIN_RESULT
 struct LfgJoinResultData
 {
@@ -357,14 +397,15 @@ class LfgMgr : EventableObject
         bool CheckGroupRoles(LfgRolesMap &groles, bool removeLeaderFlag = true);
         bool CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal);
         void GetCompatibleDungeons(LfgDungeonSet& dungeons, const PlayerSet& players, LfgLockPartyMap& lockMap);
-        void SetCompatibles(std::string concatenatedGuids, bool compatibles);
-        LfgAnswer GetCompatibles(std::string concatenatedGuids);
+        void SetCompatibles(const LfgCompatibleKey& key, bool compatibles);
+        LfgAnswer GetCompatibles(const LfgCompatibleKey& key);
         void RemoveFromCompatibles(uint64 guid);
+        bool GetMatchmakerEntry(uint64 guid, LfgMatchmakerEntry& entry);
+        LfgProposal* FindMatchmakerGroup(uint8 queueId, const LfgMatchmakerEntry& entry, bool& rejected);
 
         // Generic
         const LfgDungeonSet& GetDungeonsByRandom(uint32 randomdungeon);
         LfgType GetDungeonType(uint32 dungeon);
-        std::string ConcatenateGuids(LfgGuidList check);
 
         // General variables
         bool m_update;                                     ///< Doing an update?
@@ -386,6 +427,8 @@ class LfgMgr : EventableObject
         LfgGuidListMap m_currentQueue;                     ///< Ordered list. Used to find groups
         LfgGuidListMap m_newToQueue;                       ///< New groups to add to queue
         LfgCompatibleMap m_CompatibleMap;                  ///< Compatible dungeons
+        LfgCompatibleIndex m_CompatibleIndex;              ///< Cached compatibility keys of each guid
+        LfgMatchmakerMap m_matchmakers;                    ///< Single players of m_currentQueue by role and dungeons
         LfgGuidList m_teleport;                            ///< Players being teleported
         // Rolecheck - Proposal - Vote Kicks
         LfgRoleCheckMap m_RoleChecks;                      ///< Current Role checks
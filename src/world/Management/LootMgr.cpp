@@ -72,24 +72,44 @@ const T & RandomChoice(const T* variant, int count)
     return variant[count - 1];
 }
 
-template <class T> // works for anything that has the field 'chance' and is stored in plain array
-T* RandomChoiceVector(std::vector<std::pair<T*, float> > & variant)
+namespace
 {
-    float totalChance = 0;
-    float val;
-    typename std::vector<std::pair<T*, float> >::iterator itr;
-    if (variant.size() == 0)
-        return NULL;
-    for (itr = variant.begin(); itr != variant.end(); ++itr)
-        totalChance += itr->second;
-    val = Util::getRandomFloat(totalChance);
-    for (itr = variant.begin(); itr != variant.end(); ++itr)
-    {
-        val -= itr->second;
-        if (val <= 0) return itr->first;
+    std::mt19937& getLootRandomEngine()
+    {
+        thread_local std::mt19937 engine(std::random_device{}());
+        return engine;
+    }
+
+    // probability of Rand(chance)
+    double getDropProbability(float chance)
+    {
+        const float scaledChance = chance * 100.0f;
+        if (scaledChance >= 10000.0f)
+            return 1.0;
+
+        const int32 p = int32(scaledChance);
+        if (p < 0)
+            return 0.0;
+
+        return (p + 1) / 10001.0;
+    }
+
+    float getLootTypeChance(StoreLootItem const& item, uint8 type)
+    {
+        switch (type)
+        {
+            case LOOT_NORMAL10:
+                return item.chance;
+            case LOOT_NORMAL25:
+                return item.chance2;
+            case LOOT_HEROIC10:
+                return item.chance3;
+            case LOOT_HEROIC25:
+                return item.chance4;
+            default:
+                return 0.0f;
+        }
     }
-    // should not come here, buf if it does, we should return something reasonable
-    return variant.begin()->first;
 }
 
 bool Loot::any() const
@@ -97,6 +117,130 @@ bool Loot::any() const
     return gold > 0 || items.size() > 0;
 }
 
+void LootStore::addTemplate(uint32 entry, std::vector<StoreLootItem> const& items)
+{
+    if (contains(entry))
+        return;
+
+    StoreLootList list;
+    list.firstItem = static_cast<uint32>(m_items.size());
+    list.count = static_cast<uint32>(items.size());
+    m_items.insert(m_items.end(), items.begin(), items.end());
+
+    // items with the same chance and quality share one roll group, the drop rate depends on the quality only
+    for (uint8 type = 0; type < NUM_LOOT_TYPES; ++type)
+    {
+        std::vector<LootRollGroup> groups;
+        std::vector<std::vector<uint32>> groupItems;
+        for (uint32 i = 0; i < list.count; ++i)
+        {
+            const float chance = getLootTypeChance(items[i], type);
+
+            // drop chance cannot be larger than 100% or smaller than 0%
+            if (chance <= 0.0f || chance > 100.0f)
+                continue;
+
+            const uint32 quality = items[i].item.itemproto->Quality;
+
+            uint32 group = 0;
+            while (group < groups.size() && (groups[group].chance != chance || groups[group].quality != quality))
+                ++group;
+
+            if (group == groups.size())
+            {
+                groups.push_back({ chance, quality, 0, 0 });
+                groupItems.emplace_back();
+            }
+
+            groupItems[group].push_back(i);
+        }
+
+        list.firstGroup[type] = static_cast<uint32>(m_groups.size());
+        list.groupCount[type] = static_cast<uint32>(groups.size());
+        for (uint32 group = 0; group < groups.size(); ++group)
+        {
+            groups[group].firstItem = static_cast<uint32>(m_groupItems.size());
+            groups[group].itemCount = static_cast<uint32>(groupItems[group].size());
+            m_groupItems.insert(m_groupItems.end(), groupItems[group].begin(), groupItems[group].end());
+            m_groups.push_back(groups[group]);
+        }
+    }
+
+    m_templates.push_back(list);
+    const uint32 index = static_cast<uint32>(m_templates.size());
+    if (entry < LOOT_DENSE_ENTRY_LIMIT)
+    {
+        if (entry >= m_index.size())
+            m_index.resize(entry + 1, 0);
+
+        m_index[entry] = index;
+    }
+    else
+    {
+        m_sparseIndex[entry] = index;
+    }
+}
+
+void LootStore::clear()
+{
+    m_index.clear();
+    m_sparseIndex.clear();
+    m_templates.clear();
+    m_items.clear();
+    m_groups.clear();
+    m_groupItems.clear();
+}
+
+StoreLootList const* LootStore::find(uint32 entry) const
+{
+    uint32 index = 0;
+    if (entry < LOOT_DENSE_ENTRY_LIMIT)
+    {
+        if (entry < m_index.size())
+            index = m_index[entry];
+    }
+    else
+    {
+        const auto itr = m_sparseIndex.find(entry);
+        if (itr != m_sparseIndex.end())
+            index = itr->second;
+    }
+
+    return index != 0 ? &m_templates[index - 1] : nullptr;
+}
+
+void LootStore::rollItems(StoreLootList const& list, uint8 type, std::mt19937& engine, std::vector<uint32>& dropped) const
+{
+    if (type >= NUM_LOOT_TYPES)
+        return;
+
+    const size_t firstDropped = dropped.size();
+    for (uint32 group = list.firstGroup[type]; group < list.firstGroup[type] + list.groupCount[type]; ++group)
+    {
+        LootRollGroup const& rollGroup = m_groups[group];
+        uint32 const* groupItems = &m_groupItems[rollGroup.firstItem];
+
+        const double probability = getDropProbability(rollGroup.chance * worldConfig.getFloatRate((WorldConfigRates)(RATE_DROP0 + rollGroup.quality)));
+        if (probability <= 0.0)
+            continue;
+
+        if (probability >= 1.0)
+        {
+            dropped.insert(dropped.end(), groupItems, groupItems + rollGroup.itemCount);
+            continue;
+        }
+
+        // every item drops independently with the same probability, so the distance to the next
+        // dropped item is geometric and the items in between need no roll
+        std::geometric_distribution<uint64> skip(probability);
+        for (uint64 i = skip(engine); i < rollGroup.itemCount; i += skip(engine) + 1)
+            dropped.push_back(groupItems[i]);
+    }
+
+    if (list.groupCount[type] > 1)
+        std::sort(dropped.begin() + firstDropped, dropped.end());
+}
+
 LootMgr& LootMgr::getInstance()
 {
     static LootMgr mInstance;
@@ -128,28 +272,18 @@ void LootMgr::LoadLoot()
 
 DBC::Structures::ItemRandomPropertiesEntry const* LootMgr::GetRandomProperties(ItemProperties const* proto)
 {
-    std::map<uint32, RandomPropertyVector>::iterator itr;
-    if (proto->RandomPropId == 0)
-        return nullptr;
-
-    itr = _randomprops.find(proto->RandomPropId);
-    if (itr == _randomprops.end())
+    if (proto->RandomPropId == 0 || proto->RandomPropId >= _randomprops.size())
         return nullptr;
 
-    return RandomChoiceVector<DBC::Structures::ItemRandomPropertiesEntry const>(itr->second);
+    return _randomprops[proto->RandomPropId].pick(getLootRandomEngine());
 }
 
 DBC::Structures::ItemRandomSuffixEntry const* LootMgr::GetRandomSuffix(ItemProperties const* proto)
 {
-    std::map<uint32, RandomSuffixVector>::iterator itr;
-    if (proto->RandomSuffixId == 0)
-        return nullptr;
-
-    itr = _randomsuffix.find(proto->RandomSuffixId);
-    if (itr == _randomsuffix.end())
+    if (proto->RandomSuffixId == 0 || proto->RandomSuffixId >= _randomsuffix.size())
         return nullptr;
 
-    return RandomChoiceVector<DBC::Structures::ItemRandomSuffixEntry const>(itr->second);
+    return _randomsuffix[proto->RandomSuffixId].pick(getLootRandomEngine());
 }
 
 void LootMgr::LoadLootProp()
@@ -160,7 +294,6 @@ void LootMgr::LoadLootProp()
     float ch;
     if (result)
     {
-        std::map<uint32, RandomPropertyVector>::iterator itr;
         do
         {
             id = result->Fetch()[0].GetUInt32();
@@ -172,17 +305,15 @@ void LootMgr::LoadLootProp()
                 LOG_ERROR("RandomProp group %u references non-existent randomprop %u.", id, eid);
                 continue;
             }
-            itr = _randomprops.find(id);
-            if (itr == _randomprops.end())
+            if (id >= LOOT_DENSE_ENTRY_LIMIT)
             {
-                RandomPropertyVector v;
-                v.push_back(std::make_pair(item_random_properties, ch));
-                _randomprops.insert(make_pair(id, v));
-            }
-            else
-            {
-                itr->second.push_back(std::make_pair(item_random_properties, ch));
+                LOG_ERROR("RandomProp group %u is out of range.", id);
+                continue;
             }
+            if (id >= _randomprops.size())
+                _randomprops.resize(id + 1);
+
+            _randomprops[id].add(item_random_properties, ch);
         }
         while (result->NextRow());
         delete result;
@@ -190,7 +321,6 @@ void LootMgr::LoadLootProp()
     result = WorldDatabase.Query("SELECT * FROM item_randomsuffix_groups");
     if (result)
     {
-        std::map<uint32, RandomSuffixVector>::iterator itr;
         do
         {
             id = result->Fetch()[0].GetUInt32();
@@ -202,38 +332,35 @@ void LootMgr::LoadLootProp()
                 LOG_ERROR("RandomSuffix group %u references non-existent randomsuffix %u.", id, eid);
                 continue;
             }
-            itr = _randomsuffix.find(id);
-            if (itr == _randomsuffix.end())
-            {
-                RandomSuffixVector v;
-                v.push_back(std::make_pair(item_random_suffix, ch));
-                _randomsuffix.insert(make_pair(id, v));
-            }
-            else
+            if (id >= LOOT_DENSE_ENTRY_LIMIT)
             {
-                itr->second.push_back(std::make_pair(item_random_suffix, ch));
+                LOG_ERROR("RandomSuffix group %u is out of range.", id);
+                continue;
             }
+            if (id >= _randomsuffix.size())
+                _randomsuffix.resize(id + 1);
+
+            _randomsuffix[id].add(item_random_suffix, ch);
         }
         while (result->NextRow());
         delete result;
     }
+
+    for (auto& randomProperties : _randomprops)
+        randomProperties.build();
+    for (auto& randomSuffix : _randomsuffix)
+        randomSuffix.build();
 }
 
 void LootMgr::finalize()
 {
     LOG_DETAIL(" Deleting Loot Tables...");
-    for (LootStore::iterator iter = CreatureLoot.begin(); iter != CreatureLoot.end(); ++iter)
-        delete[] iter->second.items;
-    for (LootStore::iterator iter = FishingLoot.begin(); iter != FishingLoot.end(); ++iter)
-        delete[] iter->second.items;
-    for (LootStore::iterator iter = SkinningLoot.begin(); iter != SkinningLoot.end(); ++iter)
-        delete[] iter->second.items;
-    for (LootStore::iterator iter = GOLoot.begin(); iter != GOLoot.end(); ++iter)
-        delete[] iter->second.items;
-    for (LootStore::iterator iter = ItemLoot.begin(); iter != ItemLoot.end(); ++iter)
-        delete[] iter->second.items;
-    for (LootStore::iterator iter = PickpocketingLoot.begin(); iter != PickpocketingLoot.end(); ++iter)
-        delete[] iter->second.items;
+    CreatureLoot.clear();
+    FishingLoot.clear();
+    SkinningLoot.clear();
+    GOLoot.clear();
+    ItemLoot.clear();
+    PickpocketingLoot.clear();
 }
 
 void LootMgr::LoadLootTables(const char* szTableName, LootStore* LootTable)
@@ -241,7 +368,6 @@ void LootMgr::LoadLootTables(const char* szTableName, LootStore* LootTable)
     std::vector< std::pair< uint32, std::vector< tempy > > > db_cache;
     std::vector< std::pair< uint32, std::vector< tempy > > >::iterator itr;
     db_cache.reserve(10000);
-    LootStore::iterator tab;
     QueryResult* result = WorldDatabase.Query("SELECT * FROM %s ORDER BY entryid ASC", szTableName);
     if (!result)
     {
@@ -287,15 +413,13 @@ void LootMgr::LoadLootTables(const char* szTableName, LootStore* LootTable)
     total = (uint32)db_cache.size();
 
     uint32 itemid;
+    std::vector<StoreLootItem> items;
     for (itr = db_cache.begin(); itr != db_cache.end(); ++itr)
     {
         entry_id = (*itr).first;
-        if (LootTable->end() == LootTable->find(entry_id))
+        if (!LootTable->contains(entry_id))
         {
-            StoreLootList list;
-            list.count = static_cast<uint32>(itr->second.size());
-            list.items = new StoreLootItem[list.count];
-            uint32 ind = 0;
+            items.clear();
             for (std::vector< tempy >::iterator itr2 = itr->second.begin(); itr2 != itr->second.end(); ++itr2)
             {
                 //Omit items that are not in db to prevent future bugs
@@ -303,117 +427,99 @@ void LootMgr::LoadLootTables(const char* szTableName, LootStore* LootTable)
                 ItemProperties const* proto = sMySQLStore.getItemProperties(itemid);
                 if (!proto)
                 {
-                    list.items[ind].item.itemproto = NULL;
                     LogDebugFlag(LF_DB_TABLES, "Loot for %u contains non-existant item %u . (%s)", entry_id, itemid, szTableName);
+                    continue;
                 }
+
+                StoreLootItem item;
+                item.item.itemproto = proto;
+                item.item.displayid = proto->DisplayInfoID;
+                item.chance = itr2->chance;
+                item.chance2 = itr2->chance_2;
+                item.chance3 = itr2->chance3;
+                item.chance4 = itr2->chance4;
+                item.mincount = itr2->mincount;
+                item.maxcount = itr2->maxcount;
+                if (proto->HasFlag(ITEM_FLAG_FREE_FOR_ALL))
+                    item.ffa_loot = 1;
                 else
+                    item.ffa_loot = 0;
+                if (LootTable == &GOLoot)
                 {
-                    list.items[ind].item.itemproto = proto;
-                    list.items[ind].item.displayid = proto->DisplayInfoID;
-                    list.items[ind].chance = itr2->chance;
-                    list.items[ind].chance2 = itr2->chance_2;
-                    list.items[ind].chance3 = itr2->chance3;
-                    list.items[ind].chance4 = itr2->chance4;
-                    list.items[ind].mincount = itr2->mincount;
-                    list.items[ind].maxcount = itr2->maxcount;
-                    if (proto->HasFlag(ITEM_FLAG_FREE_FOR_ALL))
-                        list.items[ind].ffa_loot = 1;
-                    else
-                        list.items[ind].ffa_loot = 0;
-                    if (LootTable == &GOLoot)
+                    if (proto->Class == ITEM_CLASS_QUEST)
                     {
-                        if (proto->Class == ITEM_CLASS_QUEST)
-                        {
-                            sQuestMgr.SetGameObjectLootQuest(itr->first, itemid);
-                            quest_loot_go[entry_id].insert(proto->ItemId);
-                        }
+                        sQuestMgr.SetGameObjectLootQuest(itr->first, itemid);
+                        quest_loot_go[entry_id].insert(proto->ItemId);
                     }
                 }
-                ind++;
+                items.push_back(item);
             }
-            (*LootTable)[entry_id] = list;
+            LootTable->addTemplate(entry_id, items);
         }
     }
     LogDetail("%u loot templates loaded from %s", static_cast<uint32_t>(db_cache.size()), szTableName);
     delete result;
 }
 
-void LootMgr::PushLoot(StoreLootList* list, Loot* loot, uint8 type)
+void LootMgr::PushLoot(LootStore const& store, StoreLootList const& list, Loot* loot, uint8 type)
 {
     uint32 i;
     uint32 count;
     if (type >= NUM_LOOT_TYPES)
         return;
-    for (uint32 x = 0; x < list->count; x++)
+
+    // only the dropped items are visited, the rolls of the other items are skipped
+    thread_local std::vector<uint32> dropped;
+    dropped.clear();
+    store.rollItems(list, type, getLootRandomEngine(), dropped);
+
+    for (uint32 x : dropped)
     {
-        if (list->items[x].item.itemproto) // this check is needed until loot DB is fixed
+        StoreLootItem const& lootItem = store.getItem(list, x);
+        ItemProperties const* itemproto = lootItem.item.itemproto;
+
+        if (lootItem.mincount == lootItem.maxcount)
+            count = lootItem.maxcount;
+        else
+            count = Util::getRandomUInt(lootItem.maxcount - lootItem.mincount) + lootItem.mincount;
+        for (i = 0; i < loot->items.size(); ++i)
         {
-            float chance = 0.0f;
-            switch (type)
-            {
-                case LOOT_NORMAL10:
-                    chance = list->items[x].chance;
-                    break;
-                case LOOT_NORMAL25:
-                    chance = list->items[x].chance2;
-                    break;
-                case LOOT_HEROIC10:
-                    chance = list->items[x].chance3;
-                    break;
-                case LOOT_HEROIC25:
-                    chance = list->items[x].chance4;
-                    break;
-            }
-            // drop chance cannot be larger than 100% or smaller than 0%
-            if (chance <= 0.0f || chance > 100.0f)
-                continue;
-            ItemProperties const* itemproto = list->items[x].item.itemproto;
-            if (Rand(chance * worldConfig.getFloatRate((WorldConfigRates)(RATE_DROP0 + itemproto->Quality)))) //|| itemproto->Class == ITEM_CLASS_QUEST)
+            //itemid rand match a already placed item, if item is stackable and unique(stack), increment it, otherwise skips
+            if ((loot->items[i].item.itemproto == itemproto) && itemproto->MaxCount && ((loot->items[i].iItemsCount + count) < itemproto->MaxCount))
             {
-                if (list->items[x].mincount == list->items[x].maxcount)
-                    count = list->items[x].maxcount;
-                else
-                    count = Util::getRandomUInt(list->items[x].maxcount - list->items[x].mincount) + list->items[x].mincount;
-                for (i = 0; i < loot->items.size(); ++i)
-                {
-                    //itemid rand match a already placed item, if item is stackable and unique(stack), increment it, otherwise skips
-                    if ((loot->items[i].item.itemproto == list->items[x].item.itemproto) && itemproto->MaxCount && ((loot->items[i].iItemsCount + count) < itemproto->MaxCount))
-                    {
-                        if (itemproto->Unique && ((loot->items[i].iItemsCount + count) < itemproto->Unique))
-                        {
-                            loot->items[i].iItemsCount += count;
-                            break;
-                        }
-                        else if (!itemproto->Unique)
-                        {
-                            loot->items[i].iItemsCount += count;
-                            break;
-                        }
-                    }
-                }
-                if (i != loot->items.size())
-                    continue;
-                __LootItem itm;
-                itm.item = list->items[x].item;
-                itm.iItemsCount = count;
-                itm.roll = NULL;
-                itm.passed = false;
-                itm.ffa_loot = list->items[x].ffa_loot;
-                itm.has_looted.clear();
-                if (itemproto->Quality > 1 && itemproto->ContainerSlots == 0)
+                if (itemproto->Unique && ((loot->items[i].iItemsCount + count) < itemproto->Unique))
                 {
-                    itm.iRandomProperty = GetRandomProperties(itemproto);
-                    itm.iRandomSuffix = GetRandomSuffix(itemproto);
+                    loot->items[i].iItemsCount += count;
+                    break;
                 }
-                else
+                else if (!itemproto->Unique)
                 {
-                    // save some calls :P
-                    itm.iRandomProperty = NULL;
-                    itm.iRandomSuffix = NULL;
+                    loot->items[i].iItemsCount += count;
+                    break;
                 }
-                loot->items.push_back(itm);
             }
         }
+        if (i != loot->items.size())
+            continue;
+        __LootItem itm;
+        itm.item = lootItem.item;
+        itm.iItemsCount = count;
+        itm.roll = NULL;
+        itm.passed = false;
+        itm.ffa_loot = lootItem.ffa_loot;
+        itm.has_looted.clear();
+        if (itemproto->Quality > 1 && itemproto->ContainerSlots == 0)
+        {
+            itm.iRandomProperty = GetRandomProperties(itemproto);
+            itm.iRandomSuffix = GetRandomSuffix(itemproto);
+        }
+        else
+        {
+            // save some calls :P
+            itm.iRandomProperty = NULL;
+            itm.iRandomSuffix = NULL;
+        }
+        loot->items.push_back(itm);
     }
     if (loot->items.size() > 16)
     {
@@ -524,101 +630,88 @@ void LootMgr::AddLoot(Loot* loot, uint32 itemid, uint32 mincount, uint32 maxcoun
 
 bool LootMgr::HasLootForCreature(uint32 loot_id)
 {
-    LootStore::iterator itr = CreatureLoot.find(loot_id);
-    if (itr != CreatureLoot.end())
-        return true;
-    else
-        return false;
+    return CreatureLoot.contains(loot_id);
 }
 
 void LootMgr::FillCreatureLoot(Loot* loot, uint32 loot_id, uint8 type)
 {
     loot->items.clear();
     loot->gold = 0;
-    LootStore::iterator tab = CreatureLoot.find(loot_id);
-    if (CreatureLoot.end() == tab)
+    StoreLootList const* list = CreatureLoot.find(loot_id);
+    if (list == nullptr)
         return;
     else
-        PushLoot(&tab->second, loot, type);
+        PushLoot(CreatureLoot, *list, loot, type);
 }
 
 void LootMgr::FillGOLoot(Loot* loot, uint32 loot_id, uint8 type)
 {
     loot->items.clear();
     loot->gold = 0;
-    LootStore::iterator tab = GOLoot.find(loot_id);
-    if (GOLoot.end() == tab)
+    StoreLootList const* list = GOLoot.find(loot_id);
+    if (list == nullptr)
         return;
     else
-        PushLoot(&tab->second, loot, type);
+        PushLoot(GOLoot, *list, loot, type);
 }
 
 void LootMgr::FillFishingLoot(Loot* loot, uint32 loot_id)
 {
     loot->items.clear();
     loot->gold = 0;
-    LootStore::iterator tab = FishingLoot.find(loot_id);
-    if (FishingLoot.end() == tab)
+    StoreLootList const* list = FishingLoot.find(loot_id);
+    if (list == nullptr)
         return;
     else
-        PushLoot(&tab->second, loot, 0);
+        PushLoot(FishingLoot, *list, loot, 0);
 }
 
 void LootMgr::FillSkinningLoot(Loot* loot, uint32 loot_id)
 {
     loot->items.clear();
     loot->gold = 0;
-    LootStore::iterator tab = SkinningLoot.find(loot_id);
-    if (SkinningLoot.end() == tab)
+    StoreLootList const* list = SkinningLoot.find(loot_id);
+    if (list == nullptr)
         return;
     else
-        PushLoot(&tab->second, loot, 0);
+        PushLoot(SkinningLoot, *list, loot, 0);
 }
 
 void LootMgr::FillPickpocketingLoot(Loot* loot, uint32 loot_id)
 {
     loot->items.clear();
     loot->gold = 0;
-    LootStore::iterator tab = PickpocketingLoot.find(loot_id);
-    if (PickpocketingLoot.end() == tab)
+    StoreLootList const* list = PickpocketingLoot.find(loot_id);
+    if (list == nullptr)
         return;
     else
-        PushLoot(&tab->second, loot, 0);
+        PushLoot(PickpocketingLoot, *list, loot, 0);
 }
 
 bool LootMgr::CanGODrop(uint32 LootId, uint32 itemid)
 {
-    LootStore::iterator tab = GOLoot.find(LootId);
-    if (GOLoot.end() == tab)
+    StoreLootList const* list = GOLoot.find(LootId);
+    if (list == nullptr)
         return false;
-    StoreLootList* list = &(tab->second);
     for (uint32 x = 0; x < list->count; x++)
-        if (list->items[x].item.itemproto->ItemId == itemid)
+        if (GOLoot.getItem(*list, x).item.itemproto->ItemId == itemid)
             return true;
     return false;
 }
 
-//THIS should be cached
 bool LootMgr::IsPickpocketable(uint32 creatureId)
 {
-    LootStore::iterator tab = PickpocketingLoot.find(creatureId);
-    if (PickpocketingLoot.end() == tab)return false;
-    else return true;
+    return PickpocketingLoot.contains(creatureId);
 }
 
-//THIS should be cached
 bool LootMgr::IsSkinnable(uint32 creatureId)
 {
-    LootStore::iterator tab = SkinningLoot.find(creatureId);
-    if (SkinningLoot.end() == tab)return false;
-    else return true;
+    return SkinningLoot.contains(creatureId);
 }
 
-//THIS should be cached
 bool LootMgr::IsFishable(uint32 zoneid)
 {
-    LootStore::iterator tab = FishingLoot.find(zoneid);
-    return tab != FishingLoot.end();
+    return FishingLoot.contains(zoneid);
 }
 
 #define NEED 1
@@ -903,11 +996,11 @@ void LootMgr::FillItemLoot(Loot* loot, uint32 loot_id)
 {
     loot->items.clear();
     loot->gold = 0;
-    LootStore::iterator tab = ItemLoot.find(loot_id);
-    if (ItemLoot.end() == tab)
+    StoreLootList const* list = ItemLoot.find(loot_id);
+    if (list == nullptr)
         return;
     else
-        PushLoot(&tab->second, loot, false);
+        PushLoot(ItemLoot, *list, loot, false);
 }
 
 int32 LootRoll::event_GetInstanceID()
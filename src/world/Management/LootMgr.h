@@ -30,6 +30,8 @@
 #include <map>
 #include <vector>
 #include <set>
+#include <unordered_map>
+#include <random>
 
 enum LOOTTYPE
 {
@@ -70,8 +72,90 @@ class LootRoll : public EventableObject
         MapMgr* _mgr;
 };
 
-typedef std::vector<std::pair<DBC::Structures::ItemRandomPropertiesEntry const*, float>> RandomPropertyVector;
-typedef std::vector<std::pair<DBC::Structures::ItemRandomSuffixEntry const*, float>> RandomSuffixVector;
+// Weighted choice in constant time (Vose's alias method). An entry is picked with the probability
+// weight / total weight, without any weight the first entry is picked.
+template <class T>
+class LootAliasTable
+{
+    public:
+
+        void add(T const* entry, float weight)
+        {
+            m_entries.push_back(entry);
+            m_probability.push_back(weight > 0.0f ? weight : 0.0f);
+        }
+
+        void build()
+        {
+            const size_t count = m_entries.size();
+            m_alias.assign(count, 0);
+
+            double totalWeight = 0.0;
+            for (double weight : m_probability)
+                totalWeight += weight;
+
+            if (count == 0 || totalWeight <= 0.0)
+            {
+                m_probability.assign(count, 0.0);
+                return;
+            }
+
+            std::vector<uint32> small;
+            std::vector<uint32> large;
+            for (uint32 i = 0; i < count; ++i)
+            {
+                m_probability[i] = m_probability[i] * count / totalWeight;
+                if (m_probability[i] < 1.0)
+                    small.push_back(i);
+                else
+                    large.push_back(i);
+            }
+
+            while (!small.empty() && !large.empty())
+            {
+                const uint32 less = small.back();
+                small.pop_back();
+                const uint32 more = large.back();
+
+                m_alias[less] = more;
+                m_probability[more] -= 1.0 - m_probability[less];
+                if (m_probability[more] < 1.0)
+                {
+                    large.pop_back();
+                    small.push_back(more);
+                }
+            }
+
+            // left overs are rounding errors of full columns
+            for (uint32 i : large)
+                m_probability[i] = 1.0;
+            for (uint32 i : small)
+                m_probability[i] = 1.0;
+        }
+
+        T const* pick(std::mt19937& engine) const
+        {
+            if (m_entries.empty())
+                return nullptr;
+
+            const uint32 column = std::uniform_int_distribution<uint32>(0, static_cast<uint32>(m_entries.size() - 1))(engine);
+            if (m_probability[column] <= 0.0)
+                return m_entries[m_alias[column]];
+
+            return std::uniform_real_distribution<double>(0.0, 1.0)(engine) < m_probability[column] ? m_entries[column] : m_entries[m_alias[column]];
+        }
+
+        bool empty() const { return m_entries.empty(); }
+
+    private:
+
+        std::vector<T const*> m_entries;
+        std::vector<double> m_probability;
+        std::vector<uint32> m_alias;
+};
+
+typedef LootAliasTable<DBC::Structures::ItemRandomPropertiesEntry> RandomPropertyTable;
+typedef LootAliasTable<DBC::Structures::ItemRandomSuffixEntry> RandomSuffixTable;
 
 struct _LootItem
 {
@@ -147,10 +231,21 @@ struct StoreLootItem
     uint32 ffa_loot;    /// can everyone from the group loot the item?
 };
 
+// items of one loot type with the same drop chance and quality, they are rolled together
+struct LootRollGroup
+{
+    float chance;
+    uint32 quality;
+    uint32 firstItem;   /// first template item index in LootStore group items
+    uint32 itemCount;
+};
+
 struct StoreLootList
 {
+    uint32 firstItem;
     uint32 count;
-    StoreLootItem* items;
+    uint32 firstGroup[NUM_LOOT_TYPES];
+    uint32 groupCount[NUM_LOOT_TYPES];
 };
 
 struct Loot
@@ -188,7 +283,36 @@ struct tempy
     uint32 maxcount;
 };
 
-typedef std::map<uint32, StoreLootList> LootStore;
+// entries below this are looked up in a plain array
+#define LOOT_DENSE_ENTRY_LIMIT 0x100000
+
+// Loot templates of one table, compiled into contiguous arrays at load time.
+// Items without item properties are not stored.
+class SERVER_DECL LootStore
+{
+    public:
+
+        void addTemplate(uint32 entry, std::vector<StoreLootItem> const& items);
+        void clear();
+
+        StoreLootList const* find(uint32 entry) const;
+        bool contains(uint32 entry) const { return find(entry) != nullptr; }
+        size_t size() const { return m_templates.size(); }
+
+        StoreLootItem const& getItem(StoreLootList const& list, uint32 index) const { return m_items[list.firstItem + index]; }
+
+        // appends the template item indices dropped by one roll of list, in template order
+        void rollItems(StoreLootList const& list, uint8 type, std::mt19937& engine, std::vector<uint32>& dropped) const;
+
+    private:
+
+        std::vector<uint32> m_index;                        // entry -> template index + 1, 0 without loot
+        std::unordered_map<uint32, uint32> m_sparseIndex;   // entries from LOOT_DENSE_ENTRY_LIMIT
+        std::vector<StoreLootList> m_templates;
+        std::vector<StoreLootItem> m_items;
+        std::vector<LootRollGroup> m_groups;
+        std::vector<uint32> m_groupItems;
+};
 
 #define PARTY_LOOT_FFA 0
 #define PARTY_LOOT_MASTER 2
@@ -260,9 +384,11 @@ class SERVER_DECL LootMgr
     private:
 
         void LoadLootTables(const char* szTableName, LootStore* LootTable);
-        void PushLoot(StoreLootList* list, Loot* loot, uint8 type);
-        std::map<uint32, RandomPropertyVector> _randomprops;
-        std::map<uint32, RandomSuffixVector> _randomsuffix;
+        void PushLoot(LootStore const& store, StoreLootList const& list, Loot* loot, uint8 type);
+
+        // indexed by random property / suffix group id
+        std::vector<RandomPropertyTable> _randomprops;
+        std::vector<RandomSuffixTable> _randomsuffix;
 };
 
 #define sLootMgr LootMgr::getInstance()
@@ -0,0 +1,189 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "UpdateCompressor.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+
+#include "Log.hpp"
+#include "Server/WorldConfig.h"
+#include "Server/World.h"
+
+namespace
+{
+    std::atomic<uint64_t> compressedPacketCount(0);
+    std::atomic<uint64_t> compressedInputBytes(0);
+    std::atomic<uint64_t> compressedOutputBytes(0);
+    std::atomic<uint64_t> compressionMicroseconds(0);
+    std::atomic<int32_t> lastLargeBufferLevel(0);
+
+    int32_t clampLevel(int32_t level)
+    {
+        if (level < Z_BEST_SPEED)
+            return Z_BEST_SPEED;
+
+        if (level > Z_BEST_COMPRESSION)
+            return Z_BEST_COMPRESSION;
+
+        return level;
+    }
+}
+
+UpdateCompressor::UpdateCompressor() :
+    m_streamInitialized(false),
+    m_streamLevel(0),
+    m_largeBufferLevel(largeBufferMaxLevel),
+    m_largeBufferCost(0.0),
+    m_largeBufferSamples(0)
+{
+    memset(&m_stream, 0, sizeof(m_stream));
+}
+
+UpdateCompressor::~UpdateCompressor()
+{
+    if (m_streamInitialized)
+        deflateEnd(&m_stream);
+}
+
+UpdateCompressor& UpdateCompressor::getThreadInstance()
+{
+    thread_local UpdateCompressor mInstance;
+    return mInstance;
+}
+
+bool UpdateCompressor::prepareStream(int32_t level)
+{
+    if (m_streamInitialized)
+    {
+        if (deflateReset(&m_stream) != Z_OK)
+        {
+            deflateEnd(&m_stream);
+            m_streamInitialized = false;
+        }
+        else if (m_streamLevel != level)
+        {
+            // nothing was compressed since the reset, the new level applies to the whole next stream
+            if (deflateParams(&m_stream, level, Z_DEFAULT_STRATEGY) != Z_OK)
+            {
+                deflateEnd(&m_stream);
+                m_streamInitialized = false;
+            }
+            else
+            {
+                m_streamLevel = level;
+            }
+        }
+    }
+
+    if (!m_streamInitialized)
+    {
+        memset(&m_stream, 0, sizeof(m_stream));
+        if (deflateInit(&m_stream, level) != Z_OK)
+        {
+            LOG_ERROR("deflateInit failed.");
+            return false;
+        }
+
+        m_streamInitialized = true;
+        m_streamLevel = level;
+    }
+
+    return true;
+}
+
+void UpdateCompressor::adaptLargeBufferLevel(int32_t configuredLevel, uint32_t size, uint64_t microseconds)
+{
+    const double budget = static_cast<double>(worldConfig.server.compressionBudget);
+    if (budget <= 0.0)
+    {
+        m_largeBufferLevel = largeBufferMaxLevel;
+        return;
+    }
+
+    // moving average of the cost per KB, a single slow packet (preempted thread) does not change the level.
+    // It is kept across level changes, the new level has to collect enough samples to move it before the next step.
+    const double cost = static_cast<double>(microseconds) * 1024.0 / static_cast<double>(size);
+    m_largeBufferCost = m_largeBufferCost == 0.0 ? cost : m_largeBufferCost * 0.875 + cost * 0.125;
+
+    const bool levelSettled = ++m_largeBufferSamples >= largeBufferMinSamples;
+
+    const int32_t minLevel = configuredLevel < largeBufferMaxLevel ? configuredLevel : largeBufferMaxLevel;
+    if (levelSettled && m_largeBufferCost > budget && m_largeBufferLevel > minLevel)
+    {
+        --m_largeBufferLevel;
+        m_largeBufferSamples = 0;
+    }
+    else if (levelSettled && m_largeBufferCost < budget / 2 && m_largeBufferLevel < largeBufferMaxLevel)
+    {
+        ++m_largeBufferLevel;
+        m_largeBufferSamples = 0;
+    }
+
+    lastLargeBufferLevel = m_largeBufferLevel;
+}
+
+const uint8_t* UpdateCompressor::compress(const uint8_t* data, uint32_t size, uint32_t& compressedSize)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    const int32_t configuredLevel = clampLevel(worldConfig.getIntRate(INTRATE_COMPRESSION));
+    const bool largeBuffer = size >= largeBufferSize;
+
+    int32_t level = configuredLevel;
+    if (largeBuffer && m_largeBufferLevel > level)
+        level = m_largeBufferLevel;
+
+    if (!prepareStream(level))
+        return nullptr;
+
+    const size_t bound = 4 + deflateBound(&m_stream, size);
+    if (m_buffer.size() < bound)
+        m_buffer.resize(bound);
+
+    // set up stream pointers
+    m_stream.next_in = const_cast<Bytef*>(data);
+    m_stream.avail_in = size;
+    m_stream.next_out = m_buffer.data() + 4;
+    m_stream.avail_out = static_cast<uInt>(m_buffer.size() - 4);
+
+    // the buffer holds deflateBound bytes, the stream ends in one call
+    if (deflate(&m_stream, Z_FINISH) != Z_STREAM_END)
+    {
+        LOG_ERROR("deflate failed: did not end stream");
+        deflateEnd(&m_stream);
+        m_streamInitialized = false;
+        return nullptr;
+    }
+
+    // fill in the full size of the compressed stream
+    memcpy(m_buffer.data(), &size, sizeof(uint32_t));
+    compressedSize = static_cast<uint32_t>(m_stream.total_out) + 4;
+
+    const auto microseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count());
+
+    if (largeBuffer)
+        adaptLargeBufferLevel(configuredLevel, size, microseconds);
+
+    ++compressedPacketCount;
+    compressedInputBytes += size;
+    compressedOutputBytes += compressedSize;
+    compressionMicroseconds += microseconds;
+
+    return m_buffer.data();
+}
+
+UpdateCompressionStats UpdateCompressor::getStats()
+{
+    UpdateCompressionStats stats;
+    stats.packetCount = compressedPacketCount;
+    stats.inputBytes = compressedInputBytes;
+    stats.outputBytes = compressedOutputBytes;
+    stats.microseconds = compressionMicroseconds;
+    stats.largeBufferLevel = lastLargeBufferLevel;
+
+    return stats;
+}
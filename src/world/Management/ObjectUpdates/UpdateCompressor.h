@@ -0,0 +1,62 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <zlib.h>
+
+struct UpdateCompressionStats
+{
+    uint64_t packetCount;
+    uint64_t inputBytes;
+    uint64_t outputBytes;
+    uint64_t microseconds;
+    int32_t largeBufferLevel;
+};
+
+// Deflates SMSG_(COMPRESSED_)UPDATE_OBJECT payloads. Every thread sending update packets owns one
+// compressor, its zlib stream and output buffer are reset and reused instead of allocated per packet.
+//
+// Small buffers use the configured Rates.Compression level. Large buffers start at level 6 and fall back
+// towards the configured level while compressing them costs more than Server.CompressionBudget
+// microseconds per KB, they climb back once the cost stays below half of the budget. The cost is a moving
+// average over the large buffers, each level is kept for at least largeBufferMinSamples of them.
+class UpdateCompressor
+{
+    static const uint32_t largeBufferSize = 40000;
+    static const int32_t largeBufferMaxLevel = 6;
+    static const uint32_t largeBufferMinSamples = 16;   // large buffers compressed at a level before it changes again
+
+    z_stream m_stream;
+    bool m_streamInitialized;
+    int32_t m_streamLevel;
+
+    std::vector<uint8_t> m_buffer;
+
+    int32_t m_largeBufferLevel;
+    double m_largeBufferCost;
+    uint32_t m_largeBufferSamples;
+
+    UpdateCompressor();
+
+    bool prepareStream(int32_t level);
+    void adaptLargeBufferLevel(int32_t configuredLevel, uint32_t size, uint64_t microseconds);
+public:
+    ~UpdateCompressor();
+
+    UpdateCompressor(UpdateCompressor const&) = delete;
+    UpdateCompressor& operator=(UpdateCompressor const&) = delete;
+
+    static UpdateCompressor& getThreadInstance();
+
+    // returns the uncompressed size as uint32 followed by the deflate stream, nullptr when zlib failed.
+    // The data stays valid until the next call on this thread.
+    const uint8_t* compress(const uint8_t* data, uint32_t size, uint32_t& compressedSize);
+
+    static UpdateCompressionStats getStats();
+};
@@ -12,76 +12,147 @@ This file is released under the MIT license. See README-MIT for more information
 
 using namespace std;
 
+UpdateManager::UpdateBuffers::UpdateBuffers(size_t creationBufferInitialSize, size_t updateBufferInitialSize, size_t outOfRangeIdsInitialSize)
+    :
+    creationBuffer(creationBufferInitialSize),
+    creationCount(0),
+    updateBuffer(updateBufferInitialSize),
+    updateCount(0),
+    outOfRangeIds(outOfRangeIdsInitialSize),
+    outOfRangeIdCount(0)
+{
+}
+
+size_t UpdateManager::UpdateBuffers::calculateBufferSize() const
+{
+    const size_t base_size = 10 + (outOfRangeIds.size() * 9);
+
+    if (creationBuffer.size() > updateBuffer.size())
+    {
+        return creationBuffer.size() + base_size;
+    }
+
+    return updateBuffer.size() + base_size;
+}
+
+bool UpdateManager::UpdateBuffers::readyForUpdate() const
+{
+    return creationBuffer.size() != 0
+        || updateBuffer.size() != 0
+        || outOfRangeIds.size() != 0;
+}
+
+void UpdateManager::UpdateBuffers::clear()
+{
+    // ByteBuffer::clear keeps the capacity
+    creationBuffer.clear();
+    creationCount = 0;
+    updateBuffer.clear();
+    updateCount = 0;
+    outOfRangeIds.clear();
+    outOfRangeIdCount = 0;
+}
+
 UpdateManager::UpdateManager(Player* owner, size_t compressionThreshold, size_t creationBufferInitialSize, size_t updateBufferInitialSize, size_t outOfRangeIdsInitialSize)
-    : 
-    m_owner(owner),
+    :
     m_compressionThreshold(compressionThreshold),
-    mUpdateCount(0),
-    mCreationCount(0),
-    mOutOfRangeIdCount(0),
+    m_buffers{ { creationBufferInitialSize, updateBufferInitialSize, outOfRangeIdsInitialSize }, { creationBufferInitialSize, updateBufferInitialSize, outOfRangeIdsInitialSize } },
+    m_pendingBuffers(&m_buffers[0]),
+    m_flushBuffers(&m_buffers[1]),
     bProcessPending(false),
-    bCreationBuffer(creationBufferInitialSize),
-    bUpdateBuffer(updateBufferInitialSize),
-    mOutOfRangeIds(outOfRangeIdsInitialSize)
+    m_packetBuffer(creationBufferInitialSize > updateBufferInitialSize ? creationBufferInitialSize : updateBufferInitialSize),
+    m_owner(owner)
 {
 }
 
 void UpdateManager::clearPendingUpdates()
 {
     lock_guard<mutex> update_guard(mtx_updateBuffer);
-    lock_guard<mutex> packet_guard(mtx_delayedPacketsLock);
 
     bProcessPending = false;
-    mUpdateCount = 0;
-    bUpdateBuffer.clear();
+    m_pendingBuffers->updateCount = 0;
+    m_pendingBuffers->updateBuffer.clear();
 }
 
 void UpdateManager::pushCreationData(ByteBuffer* data, uint32_t updateCount)
 {
-    lock_guard<mutex> update_guard(mtx_updateBuffer);
-    lock_guard<mutex> packet_guard(mtx_delayedPacketsLock);
+    {
+        lock_guard<mutex> update_guard(mtx_updateBuffer);
+        if (internalHasRoomFor(data->size()))
+        {
+            m_pendingBuffers->creationCount += updateCount;
+            m_pendingBuffers->creationBuffer.append(*data);
 
-    internalPushUpdatesIfBufferIsFull(data->size());
+            internalUpdateMapMgr();
+            return;
+        }
+    }
 
-    mCreationCount += updateCount;
-    bCreationBuffer.append(*data);
+    // the pending data is sent before this block, as it was pushed before
+    lock_guard<mutex> flush_guard(mtx_flush);
+    internalFlushPendingUpdates();
+
+    lock_guard<mutex> update_guard(mtx_updateBuffer);
+    m_pendingBuffers->creationCount += updateCount;
+    m_pendingBuffers->creationBuffer.append(*data);
 
     internalUpdateMapMgr();
 }
 
 void UpdateManager::pushOutOfRangeGuid(const WoWGuid & guid)
 {
-    lock_guard<mutex> update_guard(mtx_updateBuffer);
-    lock_guard<mutex> packet_guard(mtx_delayedPacketsLock);
+    {
+        lock_guard<mutex> update_guard(mtx_updateBuffer);
+        if (internalHasRoomFor(size_t(8)))
+        {
+            m_pendingBuffers->outOfRangeIds << guid;
+            ++m_pendingBuffers->outOfRangeIdCount;
 
-    internalPushUpdatesIfBufferIsFull(size_t(8));
+            internalUpdateMapMgr();
+            return;
+        }
+    }
 
-    mOutOfRangeIds << guid;
-    ++mOutOfRangeIdCount;
+    lock_guard<mutex> flush_guard(mtx_flush);
+    internalFlushPendingUpdates();
+
+    lock_guard<mutex> update_guard(mtx_updateBuffer);
+    m_pendingBuffers->outOfRangeIds << guid;
+    ++m_pendingBuffers->outOfRangeIdCount;
 
     internalUpdateMapMgr();
 }
 
 void UpdateManager::pushUpdateData(ByteBuffer * data, uint32_t updateCount)
 {
-    lock_guard<mutex> update_guard(mtx_updateBuffer);
-    lock_guard<mutex> packet_guard(mtx_delayedPacketsLock);
-    
-    internalPushUpdatesIfBufferIsFull(data->size());
+    {
+        lock_guard<mutex> update_guard(mtx_updateBuffer);
+        if (internalHasRoomFor(data->size()))
+        {
+            m_pendingBuffers->updateCount += updateCount;
+            m_pendingBuffers->updateBuffer.append(*data);
 
-    mUpdateCount += updateCount;
-    bUpdateBuffer.append(*data);
+            internalUpdateMapMgr();
+            return;
+        }
+    }
+
+    lock_guard<mutex> flush_guard(mtx_flush);
+    internalFlushPendingUpdates();
+
+    lock_guard<mutex> update_guard(mtx_updateBuffer);
+    m_pendingBuffers->updateCount += updateCount;
+    m_pendingBuffers->updateBuffer.append(*data);
 
     internalUpdateMapMgr();
 }
 
 void UpdateManager::processPendingUpdates()
 {
-    lock_guard<mutex> update_guard(mtx_updateBuffer);
-    lock_guard<mutex> packet_guard(mtx_delayedPacketsLock);
+    lock_guard<mutex> flush_guard(mtx_flush);
 
-    internalProcessPendingUpdates();
-    m_owner->resendSpeed();
+    internalFlushPendingUpdates();
+    internalSendDelayedPackets();
 }
 
 void UpdateManager::queueDelayedPacket(WorldPacket * packet)
@@ -91,144 +162,103 @@ void UpdateManager::queueDelayedPacket(WorldPacket * packet)
     m_delayedPackets.push_back(unique_ptr<WorldPacket>(packet));
 }
 
-size_t UpdateManager::calculateBufferSize() const
-{
-    const size_t base_size = 10 + (mOutOfRangeIds.size() * 9);
-
-    if (bCreationBuffer.size() > bUpdateBuffer.size())
-    {
-        return bCreationBuffer.size() + base_size;
-    }
-
-    return bUpdateBuffer.size() + base_size;
-}
-
-bool UpdateManager::readyForUpdate() const
+bool UpdateManager::internalHasRoomFor(size_t additionalDataSize) const
 {
-    return bCreationBuffer.size() != 0
-        || bUpdateBuffer.size() != 0
-        || mOutOfRangeIds.size() != 0;
+    return additionalDataSize + m_pendingBuffers->calculateBufferSize() < MAX_UPDATE_SIZE;
 }
 
-void UpdateManager::internalProcessPendingUpdates()
+void UpdateManager::internalFlushPendingUpdates()
 {
-    if (!readyForUpdate())
-    {
-        return;
-    }
-
-    ByteBuffer buffer(calculateBufferSize());
-
-    if (bCreationBuffer.size() > 0 || mOutOfRangeIdCount > 0)
+    // mtx_flush is held, m_flushBuffers is only touched by this thread until it returns
     {
-#if VERSION_STRING >= Cata
-        buffer << uint16_t(m_owner->GetMapId());
-#endif
-
-        if (mOutOfRangeIds.size() > 0)
+        lock_guard<mutex> update_guard(mtx_updateBuffer);
+        if (!m_pendingBuffers->readyForUpdate())
         {
-            buffer << uint32_t(mCreationCount + 1);
+            bProcessPending = false;
+            return;
         }
-        else
-        {
-            buffer << uint32_t(mCreationCount);
-        }
-
 
-#if VERSION_STRING <= TBC
-        buffer << uint8_t(1);
-#endif
+        std::swap(m_pendingBuffers, m_flushBuffers);
+        bProcessPending = false;
+    }
 
-        if (mOutOfRangeIdCount > 0)
-        {
-            buffer << uint8_t(UPDATETYPE_OUT_OF_RANGE_OBJECTS);
-            buffer << uint32_t(mOutOfRangeIdCount);
-            buffer.append(mOutOfRangeIds);
-            mOutOfRangeIds.clear();
-            mOutOfRangeIdCount = 0;
-        }
+    UpdateBuffers& buffers = *m_flushBuffers;
 
-        if (bCreationBuffer.size() > 0)
-        {
-            buffer.append(bCreationBuffer);
-            bCreationBuffer.clear();
-            mCreationCount = 0;
-        }
+    if (buffers.creationBuffer.size() > 0 || buffers.outOfRangeIdCount > 0)
+    {
+        internalSendUpdatePacket(buffers.creationCount, buffers.creationBuffer, &buffers.outOfRangeIds, buffers.outOfRangeIdCount);
+    }
 
-        auto sent_packet = false;
-#if VERSION_STRING < Cata
-        if (buffer.wpos() > m_compressionThreshold)
-        {
-            sent_packet = m_owner->CompressAndSendUpdateBuffer(uint32_t(buffer.wpos()), buffer.contents());
-        }
-#endif
+    if (buffers.updateBuffer.size() > 0)
+    {
+        internalSendUpdatePacket(buffers.updateCount, buffers.updateBuffer, nullptr, 0);
+    }
 
-        if (!sent_packet)
-        {
-            m_owner->GetSession()->OutPacket(SMSG_UPDATE_OBJECT, uint16_t(buffer.wpos()), buffer.contents());
-        }
+    buffers.clear();
 }
 
-    if (bUpdateBuffer.size() > 0)
-    {
-        buffer.clear();
+void UpdateManager::internalSendUpdatePacket(uint32_t blockCount, ByteBuffer const& blocks, ByteBuffer const* outOfRangeIds, uint32_t outOfRangeIdCount)
+{
+    ByteBuffer& buffer = m_packetBuffer;
+    buffer.clear();
 
 #if VERSION_STRING >= Cata
-        buffer << uint16_t(m_owner->GetMapId());
+    buffer << uint16_t(m_owner->GetMapId());
 #endif
 
-        if (mOutOfRangeIds.size() > 0)
-        {
-            buffer << uint32_t(mUpdateCount + 1);
-        }
-        else
-        {
-            buffer << uint32_t(mUpdateCount);
-        }
+    if (outOfRangeIds != nullptr && outOfRangeIds->size() > 0)
+    {
+        buffer << uint32_t(blockCount + 1);
+    }
+    else
+    {
+        buffer << uint32_t(blockCount);
+    }
 
 #if VERSION_STRING <= TBC
-        buffer << uint8_t(1);
+    buffer << uint8_t(1);
 #endif
 
-        buffer.append(bUpdateBuffer);
-        bUpdateBuffer.clear();
-        mUpdateCount = 0;
+    if (outOfRangeIdCount > 0)
+    {
+        buffer << uint8_t(UPDATETYPE_OUT_OF_RANGE_OBJECTS);
+        buffer << uint32_t(outOfRangeIdCount);
+        buffer.append(*outOfRangeIds);
+    }
+
+    buffer.append(blocks);
 
-        auto sent_packet = false;
+    auto sent_packet = false;
 #if VERSION_STRING < Cata
-        if (buffer.wpos() > m_compressionThreshold)
-        {
-            sent_packet = m_owner->CompressAndSendUpdateBuffer(uint32_t(buffer.wpos()), buffer.contents());
-        }
+    if (buffer.wpos() > m_compressionThreshold)
+    {
+        sent_packet = m_owner->CompressAndSendUpdateBuffer(uint32_t(buffer.wpos()), buffer.contents());
+    }
 #endif
 
-        if (!sent_packet)
-        {
-            m_owner->GetSession()->OutPacket(SMSG_UPDATE_OBJECT, uint16_t(buffer.wpos()), buffer.contents());
-        }
+    if (!sent_packet)
+    {
+        m_owner->GetSession()->OutPacket(SMSG_UPDATE_OBJECT, uint16_t(buffer.wpos()), buffer.contents());
     }
-
-    bProcessPending = false;
-    internalSendDelayedPackets();
 }
 
 void UpdateManager::internalSendDelayedPackets()
 {
-    const auto session = m_owner->GetSession();
-    for (const auto& packet : m_delayedPackets)
     {
-        session->SendPacket(packet.get());
-    }
+        lock_guard<mutex> packet_guard(mtx_delayedPacketsLock);
+        if (m_delayedPackets.empty())
+            return;
 
-    m_delayedPackets.clear();
-}
+        m_sendingDelayedPackets.swap(m_delayedPackets);
+    }
 
-void UpdateManager::internalPushUpdatesIfBufferIsFull(size_t additionalDataSize)
-{
-    if (additionalDataSize + calculateBufferSize() >= MAX_UPDATE_SIZE)
+    const auto session = m_owner->GetSession();
+    for (const auto& packet : m_sendingDelayedPackets)
     {
-        internalProcessPendingUpdates();
+        session->SendPacket(packet.get());
     }
+
+    m_sendingDelayedPackets.clear();
 }
 
 void UpdateManager::internalUpdateMapMgr()
@@ -21,27 +21,47 @@ class UpdateManager
 {
     const size_t MAX_UPDATE_SIZE = 63000;
 
+    // One half collects the pushed data while the other one is sent. A flush swaps the halves under
+    // mtx_updateBuffer and sends without holding it, the buffers keep their capacity across ticks.
+    struct UpdateBuffers
+    {
+        UpdateBuffers(size_t creationBufferInitialSize, size_t updateBufferInitialSize, size_t outOfRangeIdsInitialSize);
+
+        ByteBuffer creationBuffer;
+        uint32_t creationCount;
+        ByteBuffer updateBuffer;
+        uint32_t updateCount;
+        ByteBuffer outOfRangeIds;
+        uint32_t outOfRangeIdCount;
+
+        size_t calculateBufferSize() const;
+        bool readyForUpdate() const;
+        void clear();
+    };
+
+    // guards m_pendingBuffers and bProcessPending
     std::mutex mtx_updateBuffer;
+    // held while the flushed half is sent, keeps the packet order when a full buffer is flushed by a push
+    std::mutex mtx_flush;
     std::mutex mtx_delayedPacketsLock;
 
     size_t m_compressionThreshold;
 
-    ByteBuffer bCreationBuffer;
-    uint32_t mCreationCount;
-    ByteBuffer bUpdateBuffer;
+    UpdateBuffers m_buffers[2];
+    UpdateBuffers* m_pendingBuffers;
+    UpdateBuffers* m_flushBuffers;
     bool bProcessPending;
-    ByteBuffer mOutOfRangeIds;
-    uint32_t mUpdateCount;
-    uint32_t mOutOfRangeIdCount;
+
+    // reused for every SMSG_UPDATE_OBJECT of this player
+    ByteBuffer m_packetBuffer;
 
     std::vector<std::unique_ptr<WorldPacket>> m_delayedPackets;
+    std::vector<std::unique_ptr<WorldPacket>> m_sendingDelayedPackets;
     Player* m_owner;
 
-    size_t calculateBufferSize() const;
-    bool readyForUpdate() const;
-
-    void internalProcessPendingUpdates();
-    void internalPushUpdatesIfBufferIsFull(size_t additionalDataSize);
+    void internalFlushPendingUpdates();
+    void internalSendUpdatePacket(uint32_t blockCount, ByteBuffer const& blocks, ByteBuffer const* outOfRangeIds, uint32_t outOfRangeIdCount);
+    bool internalHasRoomFor(size_t additionalDataSize) const;
     void internalSendDelayedPackets();
     void internalUpdateMapMgr();
 public:
@@ -52,6 +72,7 @@ public:
     void pushCreationData(ByteBuffer* data, uint32_t updateCount);
     void pushOutOfRangeGuid(const WoWGuid& guid);
     void pushUpdateData(ByteBuffer* data, uint32_t updateCount);
+    // only sends, the players of one map are flushed in parallel
     void processPendingUpdates();
 
     void queueDelayedPacket(WorldPacket* packet);
@@ -258,6 +258,7 @@ void QuestLogEntry::SetMobCount(uint32 i, uint32 count)
     ARCEMU_ASSERT(i < 4);
     m_mobcount[i] = count;
     mDirty = true;
+    m_plr->invalidateQuestgiverStatus();
 }
 
 void QuestLogEntry::IncrementMobCount(uint32 i)
@@ -265,6 +266,7 @@ void QuestLogEntry::IncrementMobCount(uint32 i)
     ARCEMU_ASSERT(i < 4);
     ++m_mobcount[i];
     mDirty = true;
+    m_plr->invalidateQuestgiverStatus();
 }
 
 void QuestLogEntry::SetTrigger(uint32 i)
@@ -272,6 +274,7 @@ void QuestLogEntry::SetTrigger(uint32 i)
     ARCEMU_ASSERT(i < 4);
     m_explored_areas[i] = 1;
     mDirty = true;
+    m_plr->invalidateQuestgiverStatus();
 }
 
 void QuestLogEntry::SetSlot(uint16 i)
@@ -305,6 +308,7 @@ void QuestLogEntry::Fail(bool timerexpired)
     completed = QUEST_FAILED;
     expirytime = 0;
     mDirty = true;
+    m_plr->invalidateQuestgiverStatus();
 
     uint16 base = GetBaseField(m_slot);
     m_plr->setUInt32Value(base + 1, 2);
@@ -399,7 +403,10 @@ void QuestLogEntry::UpdatePlayerFields()
     }
 
     if ((m_quest->time != 0) && (expirytime < UNIXTIME))
+    {
         completed = QUEST_FAILED;
+        m_plr->invalidateQuestgiverStatus();
+    }
 
     if (completed == QUEST_FAILED)
         field0 |= 2;
@@ -436,4 +443,5 @@ void QuestLogEntry::SendUpdateAddKill(uint32 i)
 void QuestLogEntry::Complete()
 {
     completed = QUEST_COMPLETE;
+    m_plr->invalidateQuestgiverStatus();
 }
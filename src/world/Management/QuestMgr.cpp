@@ -275,6 +275,32 @@ uint32 QuestMgr::CalcStatus(Object* quest_giver, Player* plr)
     return status;
 }
 
+bool QuestMgr::isQuestgiverStatusVolatile(Object* quest_giver, Player* plr)
+{
+    if (!quest_giver->isCreature() || !static_cast<Creature*>(quest_giver)->HasQuests())
+        return true;
+
+    const auto creature = static_cast<Creature*>(quest_giver);
+    for (auto itr = creature->QuestsBegin(); itr != creature->QuestsEnd(); ++itr)
+    {
+        if (!((*itr)->type & QUESTGIVER_QUEST_END))
+            continue;
+
+        const auto qst = (*itr)->qst;
+        if (plr->GetQuestLogForEntry(qst->id) == nullptr)
+            continue;
+
+        if (qst->reward_money < 0)
+            return true;
+
+        for (uint8 i = 0; i < MAX_REQUIRED_QUEST_ITEM; ++i)
+            if (qst->required_item[i])
+                return true;
+    }
+
+    return false;
+}
+
 uint32 QuestMgr::ActiveQuestsCount(Object* quest_giver, Player* plr)
 {
     std::list<QuestRelation*>::const_iterator itr;
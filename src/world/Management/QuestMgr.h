@@ -29,6 +29,7 @@
 #include <vector>
 #include <unordered_map>
 #include <list>
+#include <atomic>
 
 struct QuestProperties;
 
@@ -113,6 +114,13 @@ class SERVER_DECL QuestMgr
         uint32 CalcQuestStatus(Player* plr, uint32 qst);
         uint32 ActiveQuestsCount(Object* quest_giver, Player* plr);
 
+        // true if the status also depends on items or money of plr, such a status can not be cached
+        bool isQuestgiverStatusVolatile(Object* quest_giver, Player* plr);
+
+        // bumped on changes which affect the quest giver status of every player (daily reset, game events)
+        uint32 getQuestgiverStatusGeneration() const { return m_questgiverStatusGeneration.load(std::memory_order_acquire); }
+        void invalidateQuestgiverStatus() { m_questgiverStatusGeneration.fetch_add(1, std::memory_order_acq_rel); }
+
         //Packet Forging...
         void BuildOfferReward(WorldPacket* data, QuestProperties const* qst, Object* qst_giver, uint32 menutype, uint32 language, Player* plr);
         void BuildQuestDetails(WorldPacket* data, QuestProperties const* qst, Object* qst_giver, uint32 menutype, uint32 language, Player* plr);
@@ -217,6 +225,8 @@ class SERVER_DECL QuestMgr
 
         std::unordered_map<uint32, uint32> m_ObjectLootQuestList;
 
+        std::atomic<uint32> m_questgiverStatusGeneration = 0;
+
         template <class T> void _AddQuest(uint32 entryid, QuestProperties const* qst, uint8 type);
 
         template <class T> std::unordered_map<uint32, std::list<QuestRelation*>* >& _GetList();
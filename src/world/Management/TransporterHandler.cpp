@@ -202,6 +202,7 @@ Transporter::Transporter(uint64 guid) : GameObject(guid), currenttguid(0)
 
     m_pathTime = 0;
     m_timer = 0;
+    m_currentFrame = 0;
     m_period = 0;
 }
 
@@ -500,22 +501,52 @@ bool Transporter::GenerateWaypoints(uint32 pathid)
 
     uint32 timer = t;
 
-
-    mNextWaypoint = m_WayPoints.begin();
-    GetNextWaypoint();
-    GetNextWaypoint();
+    CompileTimeline();
     m_pathTime = timer;
 
     return true;
 }
 
-void Transporter::GetNextWaypoint()
+void Transporter::CompileTimeline()
 {
-    mCurrentWaypoint = mNextWaypoint;
+    m_timeline.clear();
+    m_timeline.reserve(m_WayPoints.size());
+    for (const auto& waypoint : m_WayPoints)
+        m_timeline.push_back({ waypoint.first, waypoint.second, 0.0f, 0 });
+
+    const uint32 frameCount = static_cast<uint32>(m_timeline.size());
+    for (uint32 i = 0; i < frameCount; ++i)
+    {
+        const TWayPoint& next = m_timeline[(i + 1) % frameCount].point;
+        m_timeline[i].orientation = std::atan2(next.x, next.y) + float(M_PI);
+    }
+
+    // walk the path backwards twice, the second pass carries teleports over the end of the path
+    uint32 nextTeleportFrame = frameCount;
+    for (uint32 i = 2 * frameCount; i > 0; --i)
+    {
+        const uint32 frame = (i - 1) % frameCount;
+        if (m_timeline[frame].point.teleport)
+            nextTeleportFrame = frame;
 
-    ++mNextWaypoint;
-    if (mNextWaypoint == m_WayPoints.end())
-        mNextWaypoint = m_WayPoints.begin();
+        m_timeline[frame].nextTeleportFrame = nextTeleportFrame;
+    }
+
+    m_currentFrame = 0;
+}
+
+uint32 Transporter::GetTimelineFrame(uint32 pathTimer) const
+{
+    const auto itr = std::upper_bound(m_timeline.begin(), m_timeline.end(), pathTimer, [](uint32 time, const TransportTimelineFrame& frame)
+    {
+        return time < frame.time;
+    });
+
+    // the path starts at time 0, before the first frame is only reachable on a broken path
+    if (itr == m_timeline.begin())
+        return 0;
+
+    return static_cast<uint32>(itr - m_timeline.begin() - 1);
 }
 
 void Transporter::TeleportTransport(uint32 newMapid, uint32 oldmap, float x, float y, float z)
@@ -604,7 +635,8 @@ uint32 Transporter::buildCreateUpdateBlockForPlayer(ByteBuffer* data, Player* ta
 uint32 TimeStamp();
 void Transporter::Update()
 {
-    if (m_WayPoints.size() <= 1)
+    // a cleared path stops the transport
+    if (m_WayPoints.size() <= 1 || m_timeline.size() <= 1 || m_pathTime == 0)
         return;
 
     // hack Zyres _> todo
@@ -613,51 +645,64 @@ void Transporter::Update()
 
     m_timer = Util::getMSTime() % m_period;
 
-    while (((m_timer - mCurrentWaypoint->first) % m_pathTime) > ((mNextWaypoint->first - mCurrentWaypoint->first) % m_pathTime))
+    const uint32 frameCount = static_cast<uint32>(m_timeline.size());
+    const uint32 targetFrame = GetTimelineFrame(m_timer % m_pathTime);
+    if (targetFrame == m_currentFrame)
+        return;
+
+    // the frames passed on the way only matter if one of them teleports, the transport stops there
+    const uint32 nextFrame = (m_currentFrame + 1) % frameCount;
+    const uint32 teleportFrame = m_timeline[nextFrame].nextTeleportFrame;
+    if (teleportFrame != frameCount && (teleportFrame + frameCount - nextFrame) % frameCount <= (targetFrame + frameCount - nextFrame) % frameCount)
     {
-        GetNextWaypoint();
+        m_currentFrame = teleportFrame;
+        const TWayPoint& point = m_timeline[m_currentFrame].point;
+        TeleportTransport(point.mapid, GetMapId(), point.x, point.y, point.z);
+        return;
+    }
 
-        // first check help in case client-server transport coordinates de-synchronization
-        if (mCurrentWaypoint->second.mapid != GetMapId() || mCurrentWaypoint->second.teleport)
-        {
-            TeleportTransport(mCurrentWaypoint->second.mapid, GetMapId(), mCurrentWaypoint->second.x, mCurrentWaypoint->second.y, mCurrentWaypoint->second.z);
-            break;
-        }
-        else
-        {
-            SetPosition(mCurrentWaypoint->second.x, mCurrentWaypoint->second.y, mCurrentWaypoint->second.z, std::atan2(mNextWaypoint->second.x, mNextWaypoint->second.y) + float(M_PI), false);
-            UpdatePlayerPositions(mCurrentWaypoint->second.x, mCurrentWaypoint->second.y, mCurrentWaypoint->second.z, std::atan2(mNextWaypoint->second.x, mNextWaypoint->second.y) + float(M_PI));
-            // After a few tests (Durotar<->Northrend we need this, otherwise npc disappear on entering new map/zone/area DankoDJ
-            // Update Creature Position with Movement Info from Gameobject too prevent coord changes from Transporter Waypoint and Gameobject Position Aaron02
+    m_currentFrame = targetFrame;
+    const TransportTimelineFrame& frame = m_timeline[m_currentFrame];
+
+    // first check help in case client-server transport coordinates de-synchronization
+    if (frame.point.mapid != GetMapId())
+    {
+        TeleportTransport(frame.point.mapid, GetMapId(), frame.point.x, frame.point.y, frame.point.z);
+        return;
+    }
+
+    SetPosition(frame.point.x, frame.point.y, frame.point.z, frame.orientation, false);
+    UpdatePlayerPositions(frame.point.x, frame.point.y, frame.point.z, frame.orientation);
+    // After a few tests (Durotar<->Northrend we need this, otherwise npc disappear on entering new map/zone/area DankoDJ
+    // Update Creature Position with Movement Info from Gameobject too prevent coord changes from Transporter Waypoint and Gameobject Position Aaron02
 #if VERSION_STRING < Cata
-            UpdateNPCPositions(obj_movement_info.transport_data.relativePosition.x, obj_movement_info.transport_data.relativePosition.y, obj_movement_info.transport_data.relativePosition.z, std::atan2(obj_movement_info.transport_data.relativePosition.x, obj_movement_info.transport_data.relativePosition.y) + float(M_PI));
+    UpdateNPCPositions(obj_movement_info.transport_data.relativePosition.x, obj_movement_info.transport_data.relativePosition.y, obj_movement_info.transport_data.relativePosition.z, std::atan2(obj_movement_info.transport_data.relativePosition.x, obj_movement_info.transport_data.relativePosition.y) + float(M_PI));
 #else
-            UpdateNPCPositions(obj_movement_info.getTransportPosition()->x, obj_movement_info.getTransportPosition()->y, obj_movement_info.getTransportPosition()->z, std::atan2(obj_movement_info.getTransportPosition()->x, obj_movement_info.getTransportPosition()->y) + float(M_PI));
+    UpdateNPCPositions(obj_movement_info.getTransportPosition()->x, obj_movement_info.getTransportPosition()->y, obj_movement_info.getTransportPosition()->z, std::atan2(obj_movement_info.getTransportPosition()->x, obj_movement_info.getTransportPosition()->y) + float(M_PI));
 #endif
+
+    if (frame.point.delayed)
+    {
+        switch (GetGameObjectProperties()->display_id)
+        {
+        case 3015:
+        case 7087:
+        {
+            PlaySoundToSet(5154);        // ShipDocked LightHouseFogHorn.wav
         }
-        if (mCurrentWaypoint->second.delayed)
+        break;
+        case 3031:
         {
-            switch (GetGameObjectProperties()->display_id)
-            {
-            case 3015:
-            case 7087:
-            {
-                PlaySoundToSet(5154);        // ShipDocked LightHouseFogHorn.wav
-            }
-            break;
-            case 3031:
-            {
-                PlaySoundToSet(11804);        // ZeppelinDocked    ZeppelinHorn.wav
-            }
-            break;
-            default:
-            {
-                PlaySoundToSet(5495);        // BoatDockingWarning    BoatDockedWarning.wav
-            }
-            break;
-            }
-            TransportGossip(GetGameObjectProperties()->display_id);
+            PlaySoundToSet(11804);        // ZeppelinDocked    ZeppelinHorn.wav
         }
+        break;
+        default:
+        {
+            PlaySoundToSet(5495);        // BoatDockingWarning    BoatDockedWarning.wav
+        }
+        break;
+        }
+        TransportGossip(GetGameObjectProperties()->display_id);
     }
 }
 
@@ -665,7 +710,7 @@ void Transporter::TransportGossip(uint32 route)
 {
     if (route == 241)
     {
-        if (mCurrentWaypoint->second.mapid)
+        if (!m_timeline.empty() && m_timeline[m_currentFrame].point.mapid)
         {
             LOG_DEBUG("Arrived in Ratchet at %u", m_timer);
         }
@@ -819,9 +864,14 @@ void Transporter::UpdateNPCPositions(float x, float y, float z, float o)
 
 void Transporter::UpdatePlayerPositions(float x, float y, float z, float o)
 {
+    // passengers are in the map of the transporter, its own storage needs no global lock
+    MapMgr* mapMgr = GetMapMgr();
+    if (mapMgr == nullptr)
+        return;
+
     for (auto playerGuid : m_passengers)
     {
-        if (auto player = sObjectMgr.GetPlayer(playerGuid))
+        if (auto player = mapMgr->GetPlayer(playerGuid))
         {
 #if VERSION_STRING < Cata
             player->SetPosition(
@@ -91,6 +91,15 @@ struct TWayPoint
     bool delayed;
 };
 
+// waypoint of a compiled transport path
+struct TransportTimelineFrame
+{
+    uint32 time;                // path time the transport arrives at this frame
+    TWayPoint point;
+    float orientation;          // faces the following frame
+    uint32 nextTeleportFrame;   // first frame from this one on (cyclic) which teleports, frame count without any
+};
+
 bool FillTransporterPathVector(uint32 PathID, TransportPath & Path);
 
 class SERVER_DECL Transporter : public GameObject
@@ -145,7 +154,7 @@ public:
     // Update NPC Position
     void UpdateNPCPositions(float x, float y, float z, float o);
 
-    // Update Player POsition
+    // Update Player Position, passengers are resolved in the map of the transporter
     void UpdatePlayerPositions(float x, float y, float z, float o);
 
     // Builds Start Move Packet
@@ -171,17 +180,24 @@ private:
 
     typedef std::map<uint32, TWayPoint> WaypointMap;
 
-    WaypointMap::const_iterator mCurrentWaypoint;
-    WaypointMap::const_iterator mNextWaypoint;
-
 public:
 
+    // cleared to stop the transport
     WaypointMap m_WayPoints;
 
 private:
 
     void TeleportTransport(uint32 newMapid, uint32 oldmap, float x, float y, float z);
-    void GetNextWaypoint();
+
+    // Compiles m_WayPoints into m_timeline
+    void CompileTimeline();
+
+    // Frame the transport is at on pathTimer, the last one not after it
+    uint32 GetTimelineFrame(uint32 pathTimer) const;
+
+    std::vector<TransportTimelineFrame> m_timeline;
+    uint32 m_currentFrame;
+
     int32 m_period;
 
 protected:
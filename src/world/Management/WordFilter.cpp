@@ -9,33 +9,178 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Storage/MySQLDataStore.hpp"
 #include "Storage/MySQLStructures.h"
 
+#include <algorithm>
+#include <queue>
 
 WordFilter* g_chatFilter;
 
-WordFilter::WordFilter() {}
+namespace
+{
+    // ascii only, multibyte characters are compared as they are
+    inline uint8_t foldCase(char c)
+    {
+        const uint8_t byte = static_cast<uint8_t>(c);
+        return (byte >= 'A' && byte <= 'Z') ? static_cast<uint8_t>(byte + ('a' - 'A')) : byte;
+    }
+}
+
+WordFilter::WordFilter()
+{
+    compile();
+}
 
 WordFilter::~WordFilter() {}
 
+int32_t WordFilter::FilterAutomaton::getChild(uint32_t node, uint8_t c) const
+{
+    const auto& children = nodes[node].children;
+    const auto itr = std::lower_bound(children.begin(), children.end(), c, [](const std::pair<uint8_t, uint32_t>& child, uint8_t byte)
+    {
+        return child.first < byte;
+    });
+
+    if (itr == children.end() || itr->first != c)
+        return -1;
 
-//\brief case sensitive
-//\TODO replace it with boost::regex or c++14/17 std::regex
-bool WordFilter::isBlockedOrReplaceWord(std::string& chatMessage)
+    return static_cast<int32_t>(itr->second);
+}
+
+void WordFilter::compile()
 {
-    std::list<MySQLStructure::WordFilterChat>::const_iterator iterator;
-    for (iterator = sMySQLStore._wordFilterChatStore.begin(); iterator != sMySQLStore._wordFilterChatStore.end(); ++iterator)
+    auto startTime = Util::TimeNow();
+
+    auto automaton = std::make_shared<FilterAutomaton>();
+    automaton->nodes.emplace_back();
+
+    for (const auto& filterWord : sMySQLStore._wordFilterChatStore)
     {
-        size_t pos = 0;
-        while ((pos = chatMessage.find(iterator->word, pos)) != std::string::npos)
+        if (filterWord.word.empty())
+            continue;
+
+        uint32_t node = 0;
+        for (char c : filterWord.word)
         {
-            if (iterator->blockMessage)
+            const uint8_t byte = foldCase(c);
+            const int32_t child = automaton->getChild(node, byte);
+            if (child >= 0)
             {
-                return true;
+                node = static_cast<uint32_t>(child);
+                continue;
             }
 
-            chatMessage.replace(pos, iterator->word.length(), iterator->wordReplace);
-            pos += iterator->wordReplace.length();
+            const uint32_t newNode = static_cast<uint32_t>(automaton->nodes.size());
+            auto& children = automaton->nodes[node].children;
+            children.insert(std::upper_bound(children.begin(), children.end(), std::make_pair(byte, uint32_t(0))), std::make_pair(byte, newNode));
+
+            automaton->nodes.emplace_back();
+            node = newNode;
+        }
+
+        // the first entry of a word wins, like it did when the table was walked in order
+        if (automaton->nodes[node].word >= 0)
+            continue;
+
+        automaton->nodes[node].word = static_cast<int32_t>(automaton->words.size());
+        automaton->words.push_back({ static_cast<uint32_t>(filterWord.word.length()), filterWord.wordReplace, filterWord.blockMessage });
+    }
+
+    // breadth first, the fail target of a node is always closer to the root
+    std::queue<uint32_t> pending;
+    for (const auto& child : automaton->nodes[0].children)
+        pending.push(child.second);
+
+    while (!pending.empty())
+    {
+        const uint32_t node = pending.front();
+        pending.pop();
+
+        for (const auto& child : automaton->nodes[node].children)
+        {
+            uint32_t fail = automaton->nodes[node].fail;
+            int32_t failTarget = automaton->getChild(fail, child.first);
+            while (failTarget < 0 && fail != 0)
+            {
+                fail = automaton->nodes[fail].fail;
+                failTarget = automaton->getChild(fail, child.first);
+            }
+
+            auto& childNode = automaton->nodes[child.second];
+            childNode.fail = failTarget >= 0 ? static_cast<uint32_t>(failTarget) : 0;
+
+            const auto& failNode = automaton->nodes[childNode.fail];
+            childNode.outputLink = failNode.word >= 0 ? childNode.fail : failNode.outputLink;
+
+            pending.push(child.second);
+        }
+    }
+
+    const auto wordCount = static_cast<uint32_t>(automaton->words.size());
+    const auto nodeCount = static_cast<uint32_t>(automaton->nodes.size());
+
+    std::atomic_store(&m_automaton, std::shared_ptr<const FilterAutomaton>(std::move(automaton)));
+
+    LogDetail("WordFilter : Compiled %u chat filter words into %u states in %u ms!", wordCount, nodeCount, static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
+}
+
+bool WordFilter::isBlockedOrReplaceWord(std::string& chatMessage)
+{
+    const auto automaton = std::atomic_load(&m_automaton);
+    if (automaton == nullptr || automaton->words.empty())
+        return false;
+
+    // index of the longest word starting at each position, only filled once something matched
+    std::vector<int32_t> longestWordAt;
+
+    uint32_t state = 0;
+    for (size_t i = 0; i < chatMessage.length(); ++i)
+    {
+        const uint8_t byte = foldCase(chatMessage[i]);
+
+        int32_t next = automaton->getChild(state, byte);
+        while (next < 0 && state != 0)
+        {
+            state = automaton->nodes[state].fail;
+            next = automaton->getChild(state, byte);
+        }
+        state = next >= 0 ? static_cast<uint32_t>(next) : 0;
+
+        uint32_t output = automaton->nodes[state].word >= 0 ? state : automaton->nodes[state].outputLink;
+        for (; output != 0; output = automaton->nodes[output].outputLink)
+        {
+            const int32_t wordIndex = automaton->nodes[output].word;
+            const auto& word = automaton->words[wordIndex];
+            if (word.blockMessage)
+                return true;
+
+            if (longestWordAt.empty())
+                longestWordAt.assign(chatMessage.length(), -1);
+
+            const size_t start = i + 1 - word.length;
+            if (longestWordAt[start] < 0 || automaton->words[longestWordAt[start]].length < word.length)
+                longestWordAt[start] = wordIndex;
+        }
+    }
+
+    if (longestWordAt.empty())
+        return false;
+
+    std::string filteredMessage;
+    filteredMessage.reserve(chatMessage.length());
+
+    for (size_t i = 0; i < chatMessage.length();)
+    {
+        if (longestWordAt[i] >= 0)
+        {
+            const auto& word = automaton->words[longestWordAt[i]];
+            filteredMessage += word.replacement;
+            i += word.length;
+        }
+        else
+        {
+            filteredMessage += chatMessage[i++];
         }
     }
 
+    chatMessage.swap(filteredMessage);
     return false;
 }
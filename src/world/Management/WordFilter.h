@@ -5,7 +5,11 @@ This file is released under the MIT license. See README-MIT for more information
 
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 class WordFilter
 {
@@ -14,8 +18,40 @@ class WordFilter
         WordFilter();
         ~WordFilter();
 
+        // Builds the matcher from the wordfilter_chat table. Messages filtered meanwhile keep using the previous one.
+        void compile();
+
+        // case insensitive, returns true if the message contains a blocked word. Otherwise every word is replaced,
+        // overlapping words are replaced by the longest one starting first.
         bool isBlockedOrReplaceWord(std::string& chatMessage);
 
+    private:
+
+        // Aho-Corasick automaton over the case folded filter words
+        struct FilterAutomaton
+        {
+            struct Node
+            {
+                std::vector<std::pair<uint8_t, uint32_t>> children;     // sorted by byte
+                uint32_t fail = 0;
+                uint32_t outputLink = 0;                                // next node on the fail chain that ends a word, 0 for none
+                int32_t word = -1;                                      // index of the word ending here
+            };
+
+            struct Word
+            {
+                uint32_t length;
+                std::string replacement;
+                bool blockMessage;
+            };
+
+            std::vector<Node> nodes;
+            std::vector<Word> words;
+
+            int32_t getChild(uint32_t node, uint8_t c) const;
+        };
+
+        std::shared_ptr<const FilterAutomaton> m_automaton;
 };
 
 extern WordFilter* g_chatFilter;
@@ -901,94 +901,142 @@ void MapMgr::_UpdateObjects()
     if (!_updates.size() && !_processQueue.size())
         return;
 
-    ByteBuffer update(2500);
-    uint32 count = 0;
+    const auto workerPool = sWorld.getMapUpdateWorkerPool();
 
     m_updateMutex.Acquire();
 
+    // simulation side of the changed fields, runs before any block is built so all of them contain its result
+    for (auto pObj : _updates)
+    {
+        if (pObj != nullptr && pObj->isCreatureOrPlayer() && pObj->IsInWorld() && pObj->HasUpdateField(UNIT_FIELD_HEALTH))
+            static_cast<Unit*>(pObj)->EventHealthChangeSinceLastUpdate();
+    }
+
+    size_t blockCount = 0;
     for (auto pObj : _updates)
     {
         if (pObj == nullptr)
             continue;
 
+        if (m_updateBlocks.size() == blockCount)
+            m_updateBlocks.emplace_back();
+
+        auto& blocks = m_updateBlocks[blockCount++];
+        blocks.object = pObj;
+        blocks.ownerBlock.clear();
+        blocks.ownerCount = 0;
+        blocks.publicBlock.clear();
+        blocks.publicCount = 0;
+    }
+    _updates.clear();
+
+    // serialization only reads the objects, every block belongs to one object
+    if (workerPool != nullptr && blockCount >= minParallelUpdateObjects)
+    {
+        workerPool->parallelFor(blockCount, [this](size_t index)
+        {
+            buildObjectUpdateBlocks(m_updateBlocks[index]);
+        });
+    }
+    else
+    {
+        for (size_t i = 0; i < blockCount; ++i)
+            buildObjectUpdateBlocks(m_updateBlocks[i]);
+    }
+
+    ByteBuffer update(2500);
+    for (size_t i = 0; i < blockCount; ++i)
+    {
+        auto& blocks = m_updateBlocks[i];
+        Object* pObj = blocks.object;
+
         if (pObj->isItem() || pObj->isContainer())
         {
             // our update is only sent to the owner here.
-            Player* pOwner = static_cast<Item*>(pObj)->getOwner();
-            if (pOwner != nullptr)
+            if (blocks.ownerCount)
+                static_cast<Item*>(pObj)->getOwner()->getUpdateMgr().pushUpdateData(&blocks.ownerBlock, blocks.ownerCount);
+        }
+        else if (pObj->IsInWorld())
+        {
+            // players have to receive their own updates ;)
+            if (pObj->isPlayer())
+            {
+                if (blocks.ownerCount)
+                    static_cast<Player*>(pObj)->getUpdateMgr().pushUpdateData(&blocks.ownerBlock, blocks.ownerCount);
+            }
+            else if (pObj->isCreatureOrPlayer() && static_cast<Unit*>(pObj)->mPlayerControler != nullptr)
             {
-                count = static_cast<Item*>(pObj)->BuildValuesUpdateBlockForPlayer(&update, pOwner);
-                // send update to owner
+                // built here, a creature block for a target can change the dynamic flags of the creature
+                const auto count = pObj->BuildValuesUpdateBlockForPlayer(&update, static_cast<Unit*>(pObj)->mPlayerControler);
                 if (count)
                 {
-                    pOwner->getUpdateMgr().pushUpdateData(&update, count);
+                    static_cast<Unit*>(pObj)->mPlayerControler->getUpdateMgr().pushUpdateData(&update, count);
                     update.clear();
                 }
             }
-        }
-        else
-        {
-            if (pObj->IsInWorld())
-            {
-                // players have to receive their own updates ;)
-                if (pObj->isPlayer())
-                {
-                    // need to be different! ;)
-                    count = pObj->BuildValuesUpdateBlockForPlayer(&update, static_cast<Player*>(pObj));
-                    if (count)
-                    {
-                        static_cast<Player*>(pObj)->getUpdateMgr().pushUpdateData(&update, count);
-                        update.clear();
-                    }
-                }
-                else if (pObj->isCreatureOrPlayer() && static_cast<Unit*>(pObj)->mPlayerControler != nullptr)
-                {
-                    count = pObj->BuildValuesUpdateBlockForPlayer(&update, static_cast<Unit*>(pObj)->mPlayerControler);
-                    if (count)
-                    {
-                        static_cast<Unit*>(pObj)->mPlayerControler->getUpdateMgr().pushUpdateData(&update, count);
-                        update.clear();
-                    }
-                }
 
-                //what?
-                if (pObj->isCreatureOrPlayer() && pObj->HasUpdateField(UNIT_FIELD_HEALTH))
-                    static_cast<Unit*>(pObj)->EventHealthChangeSinceLastUpdate();
-
-                // build the update
-                count = pObj->BuildValuesUpdateBlockForPlayer(&update, static_cast<Player*>(NULL));
-
-                if (count)
+            if (blocks.publicCount)
+            {
+                for (const auto& itr : pObj->getInRangePlayersSet())
                 {
-                    for (const auto& itr : pObj->getInRangePlayersSet())
-                    {
-                        Player* lplr = static_cast<Player*>(itr);
+                    Player* lplr = static_cast<Player*>(itr);
 
-                        // Make sure that the target player can see us.
-                        if (lplr && lplr->IsVisible(pObj->getGuid()))
-                            lplr->getUpdateMgr().pushUpdateData(&update, count);
-                    }
-                    update.clear();
+                    // Make sure that the target player can see us.
+                    if (lplr && lplr->IsVisible(pObj->getGuid()))
+                        lplr->getUpdateMgr().pushUpdateData(&blocks.publicBlock, blocks.publicCount);
                 }
             }
         }
         pObj->ClearUpdateMask();
     }
-    _updates.clear();
     m_updateMutex.Release();
 
-    // generate pending a9packets and send to clients.
-    for (auto it = _processQueue.begin(); it != _processQueue.end();)
+    m_processPlayers.clear();
+    for (auto player : _processQueue)
+    {
+        if (player->GetMapMgr() == this)
+            m_processPlayers.push_back(player);
+    }
+    _processQueue.clear();
+
+    // generate pending a9packets and send to clients, each worker compresses and sends the packets of one player
+    if (workerPool != nullptr && m_processPlayers.size() >= minParallelUpdatePlayers)
+    {
+        workerPool->parallelFor(m_processPlayers.size(), [this](size_t index)
+        {
+            m_processPlayers[index]->getUpdateMgr().processPendingUpdates();
+        });
+    }
+    else
     {
-        Player* player = *it;
+        for (auto player : m_processPlayers)
+            player->getUpdateMgr().processPendingUpdates();
+    }
 
-        auto it2 = it;
-        ++it;
+    // changes player state, stays on the map thread
+    for (auto player : m_processPlayers)
+        player->resendSpeed();
+}
 
-        _processQueue.erase(it2);
-        if (player->GetMapMgr() == this)
-            player->ProcessPendingUpdates();
+void MapMgr::buildObjectUpdateBlocks(ObjectUpdateBlocks& blocks)
+{
+    Object* pObj = blocks.object;
+
+    if (pObj->isItem() || pObj->isContainer())
+    {
+        if (Player* pOwner = static_cast<Item*>(pObj)->getOwner())
+            blocks.ownerCount = pObj->BuildValuesUpdateBlockForPlayer(&blocks.ownerBlock, pOwner);
+
+        return;
     }
+
+    if (!pObj->IsInWorld())
+        return;
+
+    if (pObj->isPlayer())
+        blocks.ownerCount = pObj->BuildValuesUpdateBlockForPlayer(&blocks.ownerBlock, static_cast<Player*>(pObj));
+
+    blocks.publicCount = pObj->BuildValuesUpdateBlockForPlayer(&blocks.publicBlock, static_cast<Player*>(nullptr));
 }
 
 
@@ -1066,8 +1114,7 @@ float MapMgr::GetLandHeight(float x, float y, float z)
 {
     float adtheight = GetADTLandHeight(x, y);
 
-    VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
-    float vmapheight = vmgr->getHeight(_mapId, x, y, z + 0.5f, 10000.0f);
+    float vmapheight = GetVMapHeight(x, y, z + 0.5f);
 
     if (adtheight > z && vmapheight > -1000)
         return vmapheight; //underground
@@ -1077,14 +1124,20 @@ float MapMgr::GetLandHeight(float x, float y, float z)
 
 float MapMgr::GetADTLandHeight(float x, float y)
 {
-    TerrainTile* tile = _terrain->GetTile(x, y);
-    if (tile == nullptr)
-        return TERRAIN_INVALID_HEIGHT;
+    return _terrain->getADTHeight(x, y);
+}
 
-    float rv = tile->m_map.GetHeight(x, y);
-    tile->DecRef();
+float MapMgr::GetVMapHeight(float x, float y, float z)
+{
+    VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
+    if (!vmgr->isHeightCalcEnabled())
+        return VMAP_INVALID_HEIGHT_VALUE;
 
-    return rv;
+    float height;
+    if (_terrain->getFloorHeight(x, y, z, height))
+        return height;
+
+    return vmgr->getHeight(_mapId, x, y, z, 10000.0f);
 }
 
 bool MapMgr::IsUnderground(float x, float y, float z)
@@ -1111,26 +1164,12 @@ bool MapMgr::GetLiquidInfo(float x, float y, float z, float& liquidlevel, uint32
 
 float MapMgr::GetLiquidHeight(float x, float y)
 {
-    TerrainTile* tile = _terrain->GetTile(x, y);
-    if (tile == nullptr)
-        return TERRAIN_INVALID_HEIGHT;
-
-    float rv = tile->m_map.GetTileLiquidHeight(x, y);
-    tile->DecRef();
-
-    return rv;
+    return _terrain->getLiquidHeight(x, y);
 }
 
 uint8 MapMgr::GetLiquidType(float x, float y)
 {
-    TerrainTile* tile = _terrain->GetTile(x, y);
-    if (tile == nullptr)
-        return 0;
-
-    uint8 rv = tile->m_map.GetTileLiquidType(x, y);
-    tile->DecRef();
-
-    return rv;
+    return _terrain->getLiquidType(x, y);
 }
 
 const ::DBC::Structures::AreaTableEntry* MapMgr::GetArea(float x, float y, float z)
@@ -1581,6 +1620,10 @@ void MapMgr::_PerformObjectDuties()
         }
     }
 
+    // Terrain tiles unloaded by the maps are only deleted once no reader can hold them anymore (not on every loop)
+    if (mLoopCounter % 20 == 0)
+        sEpochManager.reclaim();
+
     // Finally, A9 Building/Distribution
     _UpdateObjects();
 }
@@ -1966,16 +2009,8 @@ float MapMgr::GetFirstZWithCPZ(float x, float y, float z)
     if (!worldConfig.terrainCollision.isCollisionEnabled)
         return NO_WMO_HEIGHT;
 
-    float posZ = NO_WMO_HEIGHT;
-    for (int i = 2; i >= -2; i--)   //z range = 2
-    {
-        VMAP::IVMapManager* mgr = VMAP::VMapFactory::createOrGetVMapManager();
-        //if (i== 0 && !IsUnderground(x,y,z)) return GetBaseMap()->GetLandHeight(x, y);
-        posZ = mgr->getHeight(GetMapId(), x, y, z + (float)i, 10000.0f);
-        if (posZ != NO_WMO_HEIGHT)
-            break;
-    }
-    return posZ;
+    // the ray from the top of the z range (2) already reaches every surface below it
+    return GetVMapHeight(x, y, z + 2.0f);
 }
 
 GameObject* MapMgr::FindNearestGoWithType(Object* o, uint32 type)
@@ -165,6 +165,9 @@ public:
 
     float GetADTLandHeight(float x, float y);
 
+    // first vmap surface below z, read from the baked floor map when the tile has one
+    float GetVMapHeight(float x, float y, float z);
+
     bool IsUnderground(float x, float y, float z);
 
     bool GetLiquidInfo(float x, float y, float z, float& liquidlevel, uint32& liquidtype);
@@ -264,6 +267,26 @@ private:
     UpdateQueue _updates;
     PUpdateQueue _processQueue;
 
+    // values update blocks of one changed object, the worker pool builds them and the map thread sends them in _updates order
+    struct ObjectUpdateBlocks
+    {
+        Object* object;
+        ByteBuffer ownerBlock;
+        uint32 ownerCount;
+        ByteBuffer publicBlock;
+        uint32 publicCount;
+    };
+
+    // below these sizes the work is done on the map thread, handing it to the pool costs more than it saves
+    static const size_t minParallelUpdateObjects = 32;
+    static const size_t minParallelUpdatePlayers = 4;
+
+    // kept between ticks to reuse the buffer capacity
+    std::vector<ObjectUpdateBlocks> m_updateBlocks;
+    std::vector<Player*> m_processPlayers;
+
+    void buildObjectUpdateBlocks(ObjectUpdateBlocks& blocks);
+
     // Sessions
     std::set<WorldSession*> Sessions;
 
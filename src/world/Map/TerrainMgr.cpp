@@ -28,20 +28,32 @@
 TerrainHolder::TerrainHolder(uint32 mapid)
 {
     for (uint8 i = 0; i < TERRAIN_NUM_TILES; ++i)
+    {
         for (uint8 j = 0; j < TERRAIN_NUM_TILES; ++j)
-            m_tiles[i][j] = NULL;
+        {
+            m_tiles[i][j] = nullptr;
+            m_tilerefs[i][j] = 0;
+        }
+    }
     m_mapid = mapid;
 }
 
 TerrainHolder::~TerrainHolder()
 {
     for (uint8 i = 0; i < TERRAIN_NUM_TILES; ++i)
+    {
         for (uint8 j = 0; j < TERRAIN_NUM_TILES; ++j)
-            UnloadTile(i, j);
+        {
+            if (TerrainTile* tile = m_tiles[i][j].exchange(nullptr))
+                sEpochManager.retire(tile);
+        }
+    }
 }
 
 uint32 TerrainHolder::GetAreaFlagWithoutAdtId(float x, float y)
 {
+    AscEmu::Threading::EpochManager::Guard guard;
+
     auto tile = this->GetTile(x, y);
     if (tile)
     {
@@ -61,15 +73,54 @@ TerrainTile* TerrainHolder::GetTile(float x, float y)
 
 TerrainTile* TerrainHolder::GetTile(int32 tx, int32 ty)
 {
-    m_lock[tx][ty].Acquire();
+    if (tx < 0 || tx >= TERRAIN_NUM_TILES || ty < 0 || ty >= TERRAIN_NUM_TILES)
+        return nullptr;
 
-    TerrainTile* terrain_tile = m_tiles[tx][ty];
-    if (terrain_tile != nullptr)
-        terrain_tile->AddRef();
+    return m_tiles[tx][ty].load();
+}
 
-    m_lock[tx][ty].Release();
+float TerrainHolder::getADTHeight(float x, float y)
+{
+    AscEmu::Threading::EpochManager::Guard guard;
+
+    TerrainTile* tile = GetTile(x, y);
+    if (tile == nullptr)
+        return TERRAIN_INVALID_HEIGHT;
+
+    return tile->m_map.GetHeight(x, y);
+}
+
+float TerrainHolder::getLiquidHeight(float x, float y)
+{
+    AscEmu::Threading::EpochManager::Guard guard;
+
+    TerrainTile* tile = GetTile(x, y);
+    if (tile == nullptr)
+        return TERRAIN_INVALID_HEIGHT;
 
-    return terrain_tile;
+    return tile->m_map.GetTileLiquidHeight(x, y);
+}
+
+uint8 TerrainHolder::getLiquidType(float x, float y)
+{
+    AscEmu::Threading::EpochManager::Guard guard;
+
+    TerrainTile* tile = GetTile(x, y);
+    if (tile == nullptr)
+        return 0;
+
+    return tile->m_map.GetTileLiquidType(x, y);
+}
+
+bool TerrainHolder::getFloorHeight(float x, float y, float z, float& height)
+{
+    AscEmu::Threading::EpochManager::Guard guard;
+
+    TerrainTile* tile = GetTile(x, y);
+    if (tile == nullptr || !tile->m_floorMap.isLoaded())
+        return false;
+
+    return tile->m_floorMap.GetFloorHeight(x, y, z, height);
 }
 
 void TerrainHolder::LoadTile(float x, float y)
@@ -84,10 +135,12 @@ void TerrainHolder::LoadTile(int32 tx, int32 ty)
     m_lock[tx][ty].Acquire();
 
     ++m_tilerefs[tx][ty];
-    if (m_tiles[tx][ty] == nullptr)
+    if (m_tiles[tx][ty].load(std::memory_order_relaxed) == nullptr)
     {
-        m_tiles[tx][ty] = new TerrainTile(this, m_mapid, tx, ty);
-        m_tiles[tx][ty]->Load();
+        // published after loading, readers never see a partially loaded tile
+        auto tile = new TerrainTile(this, m_mapid, tx, ty);
+        tile->Load();
+        m_tiles[tx][ty].store(tile, std::memory_order_release);
     }
 
     m_lock[tx][ty].Release();
@@ -104,43 +157,28 @@ void TerrainHolder::UnloadTile(int32 tx, int32 ty)
 {
     m_lock[tx][ty].Acquire();
 
-    if (m_tiles[tx][ty] == nullptr)
-    {
-        m_lock[tx][ty].Release();
-        return;
-    }
+    TerrainTile* tile = nullptr;
+    if (m_tilerefs[tx][ty] > 0 && --m_tilerefs[tx][ty] == 0)
+        tile = m_tiles[tx][ty].exchange(nullptr);
 
     m_lock[tx][ty].Release();
 
-    if (--m_tilerefs[tx][ty] == 0)
-    {
-        m_lock[tx][ty].Acquire();
-
-        if (m_tiles[tx][ty] != nullptr)
-            m_tiles[tx][ty]->DecRef();
-
-        m_tiles[tx][ty] = nullptr;
-
-        m_lock[tx][ty].Release();
-    }
+    // readers inside a guard may still use the tile
+    if (tile != nullptr)
+        sEpochManager.retire(tile);
 }
 
 uint32 TerrainHolder::GetAreaFlag(float x, float y)
 {
+    AscEmu::Threading::EpochManager::Guard guard;
+
     TerrainTile* tile = GetTile(x, y);
     if (tile == nullptr)
     {
         // No generated map for this area (usually instances)
         return 0;
     }
-    uint32 rv = tile->m_map.GetTileArea(x, y);
-    tile->DecRef();
-    return rv;
-}
-
-TerrainTile::~TerrainTile()
-{
-    m_parent->m_tiles[m_tx][m_ty] = NULL;
+    return tile->m_map.GetTileArea(x, y);
 }
 
 TerrainTile::TerrainTile(TerrainHolder* parent, uint32 mapid, int32 x, int32 y)
@@ -149,7 +187,6 @@ TerrainTile::TerrainTile(TerrainHolder* parent, uint32 mapid, int32 x, int32 y)
     m_mapid = mapid;
     m_tx = x;
     m_ty = y;
-    ++m_refs;
 }
 
 float TileMap::GetHeightB(float x, float y, int x_int, int y_int)
@@ -344,6 +381,8 @@ const bool TerrainHolder::GetAreaInfo(float x, float y, float z, uint32 &mogp_fl
     auto vmap_manager = VMAP::VMapFactory::createOrGetVMapManager();
     if (vmap_manager->getAreaInfo(m_mapid, x, y, vmap_z, mogp_flags, adt_id, root_id, group_id))
     {
+        AscEmu::Threading::EpochManager::Guard guard;
+
         if (auto tile = this->GetTile(x, y))
         {
             float map_height = tile->m_map.GetHeight(x, y);
@@ -562,3 +601,99 @@ uint32 TileMap::GetTileArea(float x, float y)
     int ly = (int)y & 15;
     return m_areaMap[lx * 16 + ly];
 }
+
+TileFloorMap::TileFloorMap()
+{
+    m_layerCounts = nullptr;
+    m_layerOffsets = nullptr;
+    m_layers = nullptr;
+}
+
+TileFloorMap::~TileFloorMap()
+{
+    delete[] m_layerCounts;
+    delete[] m_layerOffsets;
+    delete[] m_layers;
+}
+
+void TileFloorMap::Load(char* filename)
+{
+    // floors are optional, tiles without one ray cast every lookup
+    FILE* f = fopen(filename, "rb");
+    if (f == NULL)
+        return;
+
+    LOG_DEBUG("Loading %s", filename);
+
+    FloorTileHeader header;
+    if (fread(&header, sizeof(header), 1, f) != 1 || header.floorMagic != FLOOR_MAGIC || header.floorVersion != FLOOR_VERSION || header.gridSize != FLOOR_GRID_SIZE)
+    {
+        LOG_ERROR("%s: invalid floor map, rebuild it with floor_baker", filename);
+        fclose(f);
+        return;
+    }
+
+    const uint32 cellCount = FLOOR_GRID_SIZE * FLOOR_GRID_SIZE;
+
+    uint8* layerCounts = new uint8[cellCount];
+    float* layers = new float[header.layerCount > 0 ? header.layerCount : 1];
+
+    if (fread(layerCounts, sizeof(uint8), cellCount, f) != cellCount || fread(layers, sizeof(float), header.layerCount, f) != header.layerCount)
+    {
+        LOG_ERROR("%s: floor map is truncated", filename);
+        delete[] layerCounts;
+        delete[] layers;
+        fclose(f);
+        return;
+    }
+
+    fclose(f);
+
+    // first layer of every cell
+    uint32* layerOffsets = new uint32[cellCount];
+    uint32 offset = 0;
+    for (uint32 i = 0; i < cellCount; ++i)
+    {
+        layerOffsets[i] = offset;
+        if (layerCounts[i] != FLOOR_CELL_RAY_CAST)
+            offset += layerCounts[i];
+    }
+
+    if (offset != header.layerCount)
+    {
+        LOG_ERROR("%s: floor map layer count does not match its cells", filename);
+        delete[] layerCounts;
+        delete[] layerOffsets;
+        delete[] layers;
+        return;
+    }
+
+    m_layerCounts = layerCounts;
+    m_layerOffsets = layerOffsets;
+    m_layers = layers;
+}
+
+bool TileFloorMap::GetFloorHeight(float x, float y, float z, float& height)
+{
+    int32 cellX = (int32)(FLOOR_GRID_SIZE * (32 - x / TERRAIN_TILE_SIZE)) & (FLOOR_GRID_SIZE - 1);
+    int32 cellY = (int32)(FLOOR_GRID_SIZE * (32 - y / TERRAIN_TILE_SIZE)) & (FLOOR_GRID_SIZE - 1);
+
+    const uint32 cell = cellX * FLOOR_GRID_SIZE + cellY;
+    const uint8 layerCount = m_layerCounts[cell];
+    if (layerCount == FLOOR_CELL_RAY_CAST)
+        return false;
+
+    // layers are stored from top to bottom, the first one below z is the floor
+    const float* layers = m_layers + m_layerOffsets[cell];
+    for (uint8 i = 0; i < layerCount; ++i)
+    {
+        if (layers[i] <= z)
+        {
+            height = layers[i];
+            return true;
+        }
+    }
+
+    height = VMAP_INVALID_HEIGHT_VALUE;
+    return true;
+}
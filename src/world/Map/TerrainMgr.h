@@ -21,7 +21,10 @@
 #pragma once
 
 #include "Threading/Mutex.h"
+#include "Threading/EpochManager.h"
+#include "FloorMapDefines.h"
 #include "../world/Server/World.h"
+#include <atomic>
 #include <cstdio>
 
 namespace VMAP
@@ -145,11 +148,29 @@ class TileMap
         uint32_t GetTileArea(float x, float y);
 };
 
-class TerrainTile
+// vmap floor layers of a tile, baked by floor_baker
+class TileFloorMap
 {
     public:
 
-        std::atomic<unsigned long> m_refs;
+        uint8_t* m_layerCounts;
+        uint32_t* m_layerOffsets;
+        float* m_layers;
+
+        TileFloorMap();
+        ~TileFloorMap();
+
+        void Load(char* filename);
+
+        bool isLoaded() const { return m_layerCounts != nullptr; }
+
+        // returns false if the cell has to be ray cast. height is VMAP_INVALID_HEIGHT_VALUE without a floor below z
+        bool GetFloorHeight(float x, float y, float z, float& height);
+};
+
+class TerrainTile
+{
+    public:
 
         TerrainHolder* m_parent;
         uint32_t m_mapid;
@@ -158,12 +179,9 @@ class TerrainTile
 
         //Children
         TileMap m_map;
+        TileFloorMap m_floorMap;
 
         TerrainTile(TerrainHolder* parent, uint32_t mapid, int32_t x, int32_t y);
-        ~TerrainTile();
-
-        void AddRef() { ++m_refs; }
-        void DecRef() { if (--m_refs == 0) delete this; }
 
         void Load()
         {
@@ -172,6 +190,12 @@ class TerrainTile
             //Normal map stuff
             sprintf(filename, "%smaps/%04u_%02u_%02u.map", sWorld.settings.server.dataDir.c_str(), m_mapid, m_tx, m_ty);
             m_map.Load(filename);
+
+            if (worldConfig.terrainCollision.isCollisionEnabled)
+            {
+                sprintf(filename, "%sfloors/%04u_%02u_%02u.flr", sWorld.settings.server.dataDir.c_str(), m_mapid, m_tx, m_ty);
+                m_floorMap.Load(filename);
+            }
         }
 };
 
@@ -183,18 +207,29 @@ class TerrainHolder
         const bool GetAreaInfo(float x, float y, float z, uint32_t &mogp_flags, int32_t &adt_id, int32_t &root_id, int32_t &group_id);
 
         uint32_t m_mapid;
-        TerrainTile* m_tiles[TERRAIN_NUM_TILES][TERRAIN_NUM_TILES];
+
+        // Tiles are published for lock free readers. Loading and unloading take the tile lock, an unloaded tile
+        // is retired to the EpochManager and deleted once no reader can use it anymore.
+        std::atomic<TerrainTile*> m_tiles[TERRAIN_NUM_TILES][TERRAIN_NUM_TILES];
         FastMutex m_lock[TERRAIN_NUM_TILES][TERRAIN_NUM_TILES];
-        std::atomic<unsigned long> m_tilerefs[TERRAIN_NUM_TILES][TERRAIN_NUM_TILES];
+        uint32_t m_tilerefs[TERRAIN_NUM_TILES][TERRAIN_NUM_TILES];
 
         TerrainHolder(uint32_t mapid);
         ~TerrainHolder();
 
         uint32_t GetAreaFlagWithoutAdtId(float x, float y);
 
+        // the returned tile is only valid inside an EpochManager::Guard
         TerrainTile* GetTile(float x, float y);
         TerrainTile* GetTile(int32_t tx, int32_t ty);
 
+        float getADTHeight(float x, float y);
+        float getLiquidHeight(float x, float y);
+        uint8_t getLiquidType(float x, float y);
+
+        // baked vmap height below z, returns false if the tile has no floor map or the cell has to be ray cast
+        bool getFloorHeight(float x, float y, float z, float& height);
+
         void LoadTile(float x, float y);
         void LoadTile(int32_t tx, int32_t ty);
 
@@ -1350,17 +1350,14 @@ uint32 Object::BuildValuesUpdateBlockForPlayer(ByteBuffer* data, Player* target)
     UpdateMask updateMask;
     updateMask.SetCount(m_valuesCount);
     _SetUpdateBits(&updateMask, target);
-    for (uint32 x = 0; x < m_valuesCount; ++x)
+    if (updateMask.HasAnyBit())
     {
-        if (updateMask.GetBit(x))
-        {
-            *data << uint8(UPDATETYPE_VALUES);              // update type == update
-            ARCEMU_ASSERT(m_wowGuid.GetNewGuidLen() > 0);
-            *data << m_wowGuid;
+        *data << uint8(UPDATETYPE_VALUES);              // update type == update
+        ARCEMU_ASSERT(m_wowGuid.GetNewGuidLen() > 0);
+        *data << m_wowGuid;
 
-            buildValuesUpdate(data, &updateMask, target);
-            return 1;
-        }
+        buildValuesUpdate(data, &updateMask, target);
+        return 1;
     }
 
     return 0;
@@ -2302,25 +2299,18 @@ void Object::buildValuesUpdate(ByteBuffer* data, UpdateMask* updateMask, Player*
 
     ARCEMU_ASSERT(updateMask && updateMask->GetCount() == m_valuesCount);
 
-    uint32_t block_count, values_count;
+    uint32_t block_count;
     if (m_valuesCount > 2 * 0x20)
-    {
         block_count = updateMask->GetUpdateBlockCount();
-        values_count = std::min<uint32_t>(block_count * 0x20, m_valuesCount);
-    }
     else
-    {
         block_count = updateMask->GetBlockCount();
-        values_count = m_valuesCount;
-    }
 
     *data << uint8_t(block_count);
     data->append(updateMask->GetMask(), block_count * 4);
-    for (uint32_t idx = 0; idx < values_count; ++idx)
+    updateMask->ForEachSetBit(block_count, [this, data](uint32_t idx)
     {
-        if (updateMask->GetBit(idx))
-            *data << m_uint32Values[idx];
-    }
+        *data << m_uint32Values[idx];
+    });
 
     if (reset)
     {
@@ -2451,10 +2441,8 @@ void Object::_SetUpdateBits(UpdateMask* updateMask, Player* /*target*/) const
 
 void Object::_SetCreateBits(UpdateMask* updateMask, Player* /*target*/) const
 {
-
-    for (uint32 i = 0; i < m_valuesCount; ++i)
-        if (m_uint32Values[i] != 0)
-            updateMask->SetBit(i);
+    ARCEMU_ASSERT(updateMask->GetCount() == m_valuesCount);
+    updateMask->SetNonZeroBits(m_uint32Values);
 }
 
 void Object::AddToWorld()
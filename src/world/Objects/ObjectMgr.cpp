@@ -992,50 +992,12 @@ uint32 ObjectMgr::GenerateLowGuid(uint32 guidhigh)
 
 Player* ObjectMgr::GetPlayer(const char* name, bool caseSensitive)
 {
-    Player* rv = nullptr;
-    PlayerStorageMap::const_iterator itr;
-    _playerslock.AcquireReadLock();
-
-    if (!caseSensitive)
-    {
-        std::string strName = name;
-        Util::StringToLowerCase(strName);
-        for (itr = _players.begin(); itr != _players.end(); ++itr)
-        {
-            if (!stricmp(itr->second->getName().c_str(), strName.c_str()))
-            {
-                rv = itr->second;
-                break;
-            }
-        }
-    }
-    else
-    {
-        for (itr = _players.begin(); itr != _players.end(); ++itr)
-        {
-            if (!strcmp(itr->second->getName().c_str(), name))
-            {
-                rv = itr->second;
-                break;
-            }
-        }
-    }
-
-    _playerslock.ReleaseReadLock();
-
-    return rv;
+    return m_onlinePlayers.findByName(name, caseSensitive);
 }
 
 Player* ObjectMgr::GetPlayer(uint32 guid)
 {
-    Player* rv = nullptr;
-
-    _playerslock.AcquireReadLock();
-    PlayerStorageMap::const_iterator itr = _players.find(guid);
-    rv = (itr != _players.end()) ? itr->second : nullptr;
-    _playerslock.ReleaseReadLock();
-
-    return rv;
+    return m_onlinePlayers.findByGuid(guid);
 }
 
 void ObjectMgr::AddGMTicket(GM_Ticket* ticket, bool startup)
@@ -2379,14 +2341,22 @@ void ObjectMgr::AddPlayer(Player* p) //add it to global storage
     _playerslock.AcquireWriteLock();
     _players[p->getGuidLow()] = p;
     _playerslock.ReleaseWriteLock();
+
+    m_onlinePlayers.addPlayer(p);
 }
 
 void ObjectMgr::RemovePlayer(Player* p)
 {
+    m_onlinePlayers.removePlayer(p);
+
     _playerslock.AcquireWriteLock();
     _players.erase(p->getGuidLow());
     _playerslock.ReleaseWriteLock();
+}
 
+void ObjectMgr::RenameOnlinePlayer(Player* p, std::string const& newName)
+{
+    m_onlinePlayers.renamePlayer(p, newName);
 }
 
 Corpse* ObjectMgr::CreateCorpse()
@@ -3043,6 +3013,8 @@ void ObjectMgr::ResetDailies()
         pPlayer->DailyMutex.Release();
     }
     _playerslock.ReleaseReadLock();
+
+    sQuestMgr.invalidateQuestgiverStatus();
 }
 
 void ObjectMgr::LoadSpellTargetConstraints()
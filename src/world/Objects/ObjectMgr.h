@@ -37,6 +37,7 @@
 #include "Management/TransporterHandler.h"
 #include "Management/Gossip/GossipDefines.hpp"
 #include "Objects/GameObject.h"
+#include "Objects/OnlinePlayerRegistry.h"
 #include "Spell/Spell.h"
 #include "Management/Group.h"
 
@@ -510,11 +511,13 @@ class SERVER_DECL ObjectMgr : public EventableObject
         uint32 GenerateArenaTeamId();
 
         Player* CreatePlayer(uint8 _class);
+        // online players for iterating, single players are looked up in m_onlinePlayers
         PlayerStorageMap _players;
         RWLock _playerslock;
 
         void AddPlayer(Player* p); //add it to global storage
         void RemovePlayer(Player* p);
+        void RenameOnlinePlayer(Player* p, std::string const& newName);
 
 
         // Serialization
@@ -711,6 +714,7 @@ class SERVER_DECL ObjectMgr : public EventableObject
         std::set<uint32> m_disabled_spells;
 
         uint64 TransportersCount;
+        OnlinePlayerRegistry m_onlinePlayers;
         std::unordered_map<uint32, PlayerInfo*> m_playersinfo;
         PlayerNameStringIndexMap m_playersInfoByName;
 
@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "StdAfx.h"
+#include "Objects/OnlinePlayerRegistry.h"
+#include "Units/Players/Player.h"
+#include "Util.hpp"
+
+#include <mutex>
+
+std::string OnlinePlayerRegistry::normalizeName(std::string const& name)
+{
+    std::string normalizedName = name;
+    Util::StringToLowerCase(normalizedName);
+    return normalizedName;
+}
+
+void OnlinePlayerRegistry::addPlayer(Player* player)
+{
+    {
+        GuidShard& shard = guidShard(player->getGuidLow());
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.players[player->getGuidLow()] = player;
+    }
+
+    addName(player, player->getName());
+}
+
+void OnlinePlayerRegistry::removePlayer(Player* player)
+{
+    {
+        GuidShard& shard = guidShard(player->getGuidLow());
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        const auto itr = shard.players.find(player->getGuidLow());
+        if (itr != shard.players.end() && itr->second == player)
+            shard.players.erase(itr);
+    }
+
+    removeName(player, player->getName());
+}
+
+void OnlinePlayerRegistry::renamePlayer(Player* player, std::string const& newName)
+{
+    removeName(player, player->getName());
+    player->setName(newName);
+    addName(player, newName);
+}
+
+void OnlinePlayerRegistry::addName(Player* player, std::string const& name)
+{
+    const std::string normalizedName = normalizeName(name);
+    NameShard& shard = nameShard(normalizedName);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.players[normalizedName] = { player, name };
+}
+
+void OnlinePlayerRegistry::removeName(Player* player, std::string const& name)
+{
+    const std::string normalizedName = normalizeName(name);
+    NameShard& shard = nameShard(normalizedName);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    // a new login with the same name may already own the entry
+    const auto itr = shard.players.find(normalizedName);
+    if (itr != shard.players.end() && itr->second.player == player)
+        shard.players.erase(itr);
+}
+
+Player* OnlinePlayerRegistry::findByGuid(uint32_t guid) const
+{
+    GuidShard const& shard = guidShard(guid);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const auto itr = shard.players.find(guid);
+    return itr != shard.players.end() ? itr->second : nullptr;
+}
+
+Player* OnlinePlayerRegistry::findByName(std::string const& name, bool caseSensitive) const
+{
+    const std::string normalizedName = normalizeName(name);
+    NameShard const& shard = nameShard(normalizedName);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    const auto itr = shard.players.find(normalizedName);
+    if (itr == shard.players.end())
+        return nullptr;
+
+    if (caseSensitive && itr->second.name != name)
+        return nullptr;
+
+    return itr->second.player;
+}
@@ -0,0 +1,67 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+class Player;
+
+// Online players by guid and by lower case name for ObjectMgr::GetPlayer.
+// Both indexes are split into shards with their own shared lock, lookups only lock the shard of the
+// requested guid or name and never wait for lookups of other players or for readers of the same shard.
+class OnlinePlayerRegistry
+{
+public:
+
+    void addPlayer(Player* player);
+    void removePlayer(Player* player);
+
+    // the name index has to follow Player::setName of online players
+    void renamePlayer(Player* player, std::string const& newName);
+
+    Player* findByGuid(uint32_t guid) const;
+    Player* findByName(std::string const& name, bool caseSensitive) const;
+
+private:
+
+    static const size_t ShardCount = 16;
+
+    struct GuidShard
+    {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<uint32_t, Player*> players;
+    };
+
+    // the name is kept as registered, case sensitive lookups do not read the name of the player
+    struct NameEntry
+    {
+        Player* player;
+        std::string name;
+    };
+
+    struct NameShard
+    {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, NameEntry> players;
+    };
+
+    static std::string normalizeName(std::string const& name);
+
+    GuidShard& guidShard(uint32_t guid) { return m_guidShards[guid % ShardCount]; }
+    GuidShard const& guidShard(uint32_t guid) const { return m_guidShards[guid % ShardCount]; }
+    NameShard& nameShard(std::string const& normalizedName) { return m_nameShards[std::hash<std::string>()(normalizedName) % ShardCount]; }
+    NameShard const& nameShard(std::string const& normalizedName) const { return m_nameShards[std::hash<std::string>()(normalizedName) % ShardCount]; }
+
+    void addName(Player* player, std::string const& name);
+    void removeName(Player* player, std::string const& name);
+
+    std::array<GuidShard, ShardCount> m_guidShards;
+    std::array<NameShard, ShardCount> m_nameShards;
+};
@@ -15,6 +15,8 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Server/World.h"
 #include "Server/World.Legacy.h"
 #include "Objects/ObjectMgr.h"
+#include "Management/GuildSaveQueue.h"
+#include "Management/ObjectUpdates/UpdateCompressor.h"
 
 
 bool handleSendChatAnnounceCommand(BaseConsole* baseConsole, int argumentCount, std::string consoleInput, bool /*isWebClient*/)
@@ -152,6 +154,12 @@ bool handleServerInfoCommand(BaseConsole* baseConsole, int /*argumentCount*/, st
         baseConsole->Write("RAM Usage: %4.2f MB\r\n", sWorld.getRAMUsage());
         baseConsole->Write("SQL Query Cache Size (World): %u queries delayed\r\n", WorldDatabase.GetQueueSize());
         baseConsole->Write("SQL Query Cache Size (Character): %u queries delayed\r\n", CharacterDatabase.GetQueueSize());
+        baseConsole->Write("Guild Write Queue: %u writes pending (%llu coalesced)\r\n", static_cast<uint32_t>(sGuildSaveQueue.getQueueDepth()), sGuildSaveQueue.getCoalescedCount());
+
+        const auto compression = UpdateCompressor::getStats();
+        baseConsole->Write("Update Compression: %llu packets, ratio %.2f, %.1f us per packet (large packet level %d)\r\n", compression.packetCount,
+            compression.inputBytes > 0 ? static_cast<double>(compression.outputBytes) / compression.inputBytes : 0.0,
+            compression.packetCount > 0 ? static_cast<double>(compression.microseconds) / compression.packetCount : 0.0, compression.largeBufferLevel);
     }
 
     sSocketMgr.ShowStatus();
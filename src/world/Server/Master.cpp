@@ -32,6 +32,7 @@
 #include "Management/ChannelMgr.h"
 #include "Management/AddonMgr.h"
 #include "Management/AuctionMgr.h"
+#include "Management/GuildSaveQueue.h"
 #include "Spell/SpellTarget.h"
 #include "Util.hpp"
 #include "DatabaseUpdater.h"
@@ -240,6 +241,9 @@ bool Master::Run(int /*argc*/, char** /*argv*/)
 
     sWorld.setWorldStartTime((uint32)UNIXTIME);
 
+    sWorld.startPacketWorkerPool();
+    sWorld.startMapUpdateWorkerPool();
+
     worldRunnable = std::move(std::make_unique<WorldRunnable>());
 
     _HookSignals();
@@ -328,6 +332,9 @@ bool Master::Run(int /*argc*/, char** /*argv*/)
     // send a query to wake it up if its inactive
     LogNotice("Database : Clearing all pending queries...");
 
+    // pending guild changes go into the query buffer before its thread is stopped
+    sGuildSaveQueue.flush();
+
     // kill the database thread first so we don't lose any queries/data
     CharacterDatabase.EndThreads();
     WorldDatabase.EndThreads();
@@ -343,6 +350,9 @@ bool Master::Run(int /*argc*/, char** /*argv*/)
 #endif
     sSocketMgr.CloseAll();
 
+    sWorld.stopPacketWorkerPool();
+    sWorld.stopMapUpdateWorkerPool();
+
     bServerShutdown = true;
     ThreadPool.Shutdown();
 
@@ -575,6 +585,7 @@ void OnCrash(bool Terminate)
     try
     {
         LogNotice("sql : Waiting for all database queries to finish...");
+        sGuildSaveQueue.flush();
         WorldDatabase.EndThreads();
         CharacterDatabase.EndThreads();
         LogNotice("sql : All pending database operations cleared.");
@@ -43,6 +43,7 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Server/Packets/CmsgItemQuerySingle.h"
 #include "Spell/Definitions/AuraInterruptFlags.h"
 #include "Server/Packets/SmsgBuyFailed.h"
+#include "Server/QueryResponseCache.h"
 
 using namespace AscEmu::Packets;
 
@@ -1212,6 +1213,9 @@ void WorldSession::handleItemQuerySingleOpcode(WorldPacket& recvPacket)
     if (!srlPacket.deserialise(recvPacket))
         return;
 
+    if (sQueryResponseCache.sendCachedResponse(this, CMSG_ITEM_QUERY_SINGLE, srlPacket.item_id))
+        return;
+
     ItemProperties const* itemProto = sMySQLStore.getItemProperties(srlPacket.item_id);
     if (!itemProto)
     {
@@ -1338,6 +1342,7 @@ void WorldSession::handleItemQuerySingleOpcode(WorldPacket& recvPacket)
     data << itemProto->ArmorDamageModifier;
     data << itemProto->ExistingDuration;                    // 2.4.2 Item duration in seconds
 
+    sQueryResponseCache.storeResponse(CMSG_ITEM_QUERY_SINGLE, srlPacket.item_id, language, data);
     SendPacket(&data);
 }
 #else
@@ -1347,6 +1352,9 @@ void WorldSession::handleItemQuerySingleOpcode(WorldPacket& recvPacket)
     if (!srlPacket.deserialise(recvPacket))
         return;
 
+    if (sQueryResponseCache.sendCachedResponse(this, CMSG_ITEM_QUERY_SINGLE, srlPacket.item_id))
+        return;
+
     auto itemProperties = sMySQLStore.getItemProperties(srlPacket.item_id);
     if (!itemProperties)
     {
@@ -1467,6 +1475,7 @@ void WorldSession::handleItemQuerySingleOpcode(WorldPacket& recvPacket)
     data << itemProperties->ExistingDuration;                    // 2.4.2 Item duration in seconds
     data << itemProperties->ItemLimitCategory;
     data << itemProperties->HolidayId;                           // HolidayNames.dbc
+    sQueryResponseCache.storeResponse(CMSG_ITEM_QUERY_SINGLE, srlPacket.item_id, language, data);
     SendPacket(&data);
 }
 #endif
@@ -2736,6 +2745,7 @@ void WorldSession::handleWrapItemOpcode(WorldPacket& recvPacket)
     // change the dest item's entry
     dst->wrapped_item_id = dst->getEntry();
     dst->setEntry(itemid);
+    _player->getItemInterface()->invalidateItemCounts();
 
     // set the giftwrapper fields
     dst->setGiftCreatorGuid(_player->getGuid());
@@ -586,6 +586,7 @@ void WorldSession::handleOpenItemOpcode(WorldPacket& recvPacket)
         item->setEntry(item->wrapped_item_id);
         item->wrapped_item_id = 0;
         item->setItemProperties(wrappedItem);
+        _player->getItemInterface()->invalidateItemCounts();
 
         if (wrappedItem->Bonding == ITEM_BIND_ON_PICKUP)
             item->addFlags(ITEM_FLAG_SOULBOUND);
@@ -34,6 +34,7 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Spell/SpellMgr.h"
 #include "Server/Packets/CmsgBuyBankSlot.h"
 #include "Server/Packets/SmsgBuyBankSlotResult.h"
+#include "Server/QueryResponseCache.h"
 
 using namespace AscEmu::Packets;
 
@@ -689,6 +690,9 @@ void WorldSession::handleNpcTextQueryOpcode(WorldPacket& recvPacket)
 
     _player->setTargetGuid(srlPacket.guid);
 
+    if (sQueryResponseCache.sendCachedResponse(this, CMSG_NPC_TEXT_QUERY, srlPacket.text_id))
+        return;
+
     const auto localesNpcText = (language > 0) ? sMySQLStore.getLocalizedNpcText(srlPacket.text_id, language) : nullptr;
 
     WorldPacket data;
@@ -752,6 +756,7 @@ void WorldSession::handleNpcTextQueryOpcode(WorldPacket& recvPacket)
         }
     }
 
+    sQueryResponseCache.storeResponse(CMSG_NPC_TEXT_QUERY, srlPacket.text_id, language, data);
     SendPacket(&data);
 }
 
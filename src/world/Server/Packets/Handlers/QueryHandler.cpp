@@ -21,6 +21,7 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Server/Packets/CmsgItemNameQuery.h"
 #include "Server/Packets/SmsgItemNameQueryResponse.h"
 #include "Server/Packets/MsgCorpseQuery.h"
+#include "Server/QueryResponseCache.h"
 
 using namespace AscEmu::Packets;
 
@@ -50,6 +51,11 @@ void WorldSession::handleGameObjectQueryOpcode(WorldPacket& recvData)
         return;
     }
 
+    LogDebugFlag(LF_OPCODE, "Received CMSG_GAMEOBJECT_QUERY for entry: %u", srlPacket.entry);
+
+    if (sQueryResponseCache.sendCachedResponse(this, CMSG_GAMEOBJECT_QUERY, srlPacket.entry))
+        return;
+
     const auto gameobject_info = sMySQLStore.getGameObjectProperties(srlPacket.entry);
     if (!gameobject_info)
         return;
@@ -57,9 +63,9 @@ void WorldSession::handleGameObjectQueryOpcode(WorldPacket& recvData)
     const auto loc = (language > 0) ? sMySQLStore.getLocalizedGameobject(srlPacket.entry, language) : nullptr;
     const auto name = loc ? loc->name : gameobject_info->name.c_str();
 
-
-    LogDebugFlag(LF_OPCODE, "Received CMSG_GAMEOBJECT_QUERY for entry: %u", srlPacket.entry);
-    SendPacket(SmsgGameobjectQueryResponse(*gameobject_info, name).serialise().get());
+    const auto response = SmsgGameobjectQueryResponse(*gameobject_info, name).serialise();
+    sQueryResponseCache.storeResponse(CMSG_GAMEOBJECT_QUERY, srlPacket.entry, language, *response);
+    SendPacket(response.get());
 }
 
 void WorldSession::handleCreatureQueryOpcode(WorldPacket& recvData)
@@ -71,6 +77,11 @@ void WorldSession::handleCreatureQueryOpcode(WorldPacket& recvData)
         return;
     }
 
+    LogDebugFlag(LF_OPCODE, "Received SMSG_CREATURE_QUERY_RESPONSE for entry: %u", srlPacket.entry);
+
+    if (sQueryResponseCache.sendCachedResponse(this, CMSG_CREATURE_QUERY, srlPacket.entry))
+        return;
+
     const auto creature_info = sMySQLStore.getCreatureProperties(srlPacket.entry);
     if (!creature_info)
         return;
@@ -79,8 +90,9 @@ void WorldSession::handleCreatureQueryOpcode(WorldPacket& recvData)
     const auto name = loc ? loc->name : creature_info->Name.c_str();
     const auto subName = loc ? loc->subName : creature_info->SubName.c_str();
 
-    LogDebugFlag(LF_OPCODE, "Received SMSG_CREATURE_QUERY_RESPONSE for entry: %u", srlPacket.entry);
-    SendPacket(SmsgCreatureQueryResponse(*creature_info, srlPacket.entry, name, subName).serialise().get());
+    const auto response = SmsgCreatureQueryResponse(*creature_info, srlPacket.entry, name, subName).serialise();
+    sQueryResponseCache.storeResponse(CMSG_CREATURE_QUERY, srlPacket.entry, language, *response);
+    SendPacket(response.get());
 }
 
 void WorldSession::handleQueryTimeOpcode(WorldPacket& /*recvPacket*/)
@@ -118,7 +130,7 @@ void WorldSession::handleInrangeQuestgiverQuery(WorldPacket& /*recvPacket*/)
             if (creature->isQuestGiver())
             {
                 temp.rawGuid = creature->getGuid();
-                temp.status = uint8_t(sQuestMgr.CalcStatus(creature, _player));
+                temp.status = uint8_t(_player->getQuestgiverStatus(creature));
                 questgiverSet.push_back(temp);
             }
         }
@@ -135,20 +147,35 @@ void WorldSession::handlePageTextQueryOpcode(WorldPacket& recvPacket)
 
     LogDebugFlag(LF_OPCODE, "Received CMSG_PAGE_TEXT_QUERY: %u (pageId)", srlPacket.pageId);
 
+    if (sQueryResponseCache.sendCachedResponse(this, CMSG_PAGE_TEXT_QUERY, srlPacket.pageId))
+        return;
+
+    // the whole page chain is cached under the first page id
+    std::vector<WorldPacket> responses;
+
     uint32_t pageId = srlPacket.pageId;
     while (pageId)
     {
         const auto itemPage = sMySQLStore.getItemPage(pageId);
         if (itemPage == nullptr)
-            return;
+            break;
 
         const auto localizedPage = language > 0 ? sMySQLStore.getLocalizedItemPages(pageId, language) : nullptr;
         const auto pageText = localizedPage ? localizedPage->text : itemPage->text.c_str();
 
-        SendPacket(SmsgPageTextQueryResponse(pageId, pageText, itemPage->nextPage).serialise().get());
+        const auto response = SmsgPageTextQueryResponse(pageId, pageText, itemPage->nextPage).serialise();
+        SendPacket(response.get());
+        responses.push_back(*response);
+
+        // broken page chains would loop forever
+        if (responses.size() > 100)
+            break;
 
         pageId = itemPage->nextPage;
     }
+
+    if (!responses.empty())
+        sQueryResponseCache.storeResponse(CMSG_PAGE_TEXT_QUERY, srlPacket.pageId, language, std::move(responses));
 }
 
 void WorldSession::handleItemNameQueryOpcode(WorldPacket& recvPacket)
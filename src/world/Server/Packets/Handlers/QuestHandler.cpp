@@ -21,6 +21,7 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Storage/MySQLDataStore.hpp"
 #include "Map/MapMgr.h"
 #include "Management/ItemInterface.h"
+#include "Server/QueryResponseCache.h"
 
 using namespace AscEmu::Packets;
 
@@ -325,9 +326,13 @@ void WorldSession::handleQuestQueryOpcode(WorldPacket& recvPacket)
     if (!srlPacket.deserialise(recvPacket))
         return;
 
+    if (sQueryResponseCache.sendCachedResponse(this, CMSG_QUEST_QUERY, srlPacket.questId))
+        return;
+
     if (const auto questProperties = sMySQLStore.getQuestProperties(srlPacket.questId))
     {
         WorldPacket* worldPacket = buildQuestQueryResponse(questProperties);
+        sQueryResponseCache.storeResponse(CMSG_QUEST_QUERY, srlPacket.questId, language, *worldPacket);
         SendPacket(worldPacket);
         delete worldPacket;
     }
@@ -449,7 +454,7 @@ void WorldSession::handleQuestgiverStatusQueryOpcode(WorldPacket& recvPacket)
         return;
     }
 
-    const uint32_t questStatus = sQuestMgr.CalcStatus(qst_giver, _player);
+    const uint32_t questStatus = qst_giver->isCreature() ? _player->getQuestgiverStatus(static_cast<Creature*>(qst_giver)) : sQuestMgr.CalcStatus(qst_giver, _player);
     SendPacket(SmsgQuestgiverStatus(srlPacket.questGiverGuid.GetOldGuid(), questStatus).serialise().get());
 }
 
@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "StdAfx.h"
+#include "QueryResponseCache.h"
+
+#include <mutex>
+
+QueryResponseCache& QueryResponseCache::getInstance()
+{
+    static QueryResponseCache mInstance;
+    return mInstance;
+}
+
+void QueryResponseCache::finalize()
+{
+    LogNotice("QueryResponseCache : %llu hits, %llu misses", static_cast<unsigned long long>(m_hits.load()), static_cast<unsigned long long>(m_misses.load()));
+    invalidateAll();
+}
+
+uint64_t QueryResponseCache::makeKey(uint16_t queryOpcode, uint32_t entry, uint32_t language)
+{
+    return (static_cast<uint64_t>(queryOpcode) << 48) | (static_cast<uint64_t>(language & 0xFFFF) << 32) | entry;
+}
+
+bool QueryResponseCache::sendCachedResponse(WorldSession* session, uint16_t queryOpcode, uint32_t entry)
+{
+    std::shared_ptr<const CachedResponse> response;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        const auto itr = m_responses.find(makeKey(queryOpcode, entry, session->language));
+        if (itr != m_responses.end())
+            response = itr->second;
+    }
+
+    if (response == nullptr)
+    {
+        ++m_misses;
+        return false;
+    }
+
+    ++m_hits;
+
+    // the shared_ptr keeps the packets alive even if the entry gets invalidated meanwhile
+    for (const auto& packet : *response)
+        session->SendPacket(const_cast<WorldPacket*>(&packet));
+
+    return true;
+}
+
+void QueryResponseCache::storeResponse(uint16_t queryOpcode, uint32_t entry, uint32_t language, WorldPacket const& response)
+{
+    storeResponse(queryOpcode, entry, language, std::vector<WorldPacket>{ response });
+}
+
+void QueryResponseCache::storeResponse(uint16_t queryOpcode, uint32_t entry, uint32_t language, std::vector<WorldPacket> responses)
+{
+    auto response = std::make_shared<const CachedResponse>(std::move(responses));
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_responses[makeKey(queryOpcode, entry, language)] = std::move(response);
+}
+
+void QueryResponseCache::invalidate(uint16_t queryOpcode)
+{
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    for (auto itr = m_responses.begin(); itr != m_responses.end();)
+    {
+        if ((itr->first >> 48) == queryOpcode)
+            itr = m_responses.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+void QueryResponseCache::invalidateAll()
+{
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_responses.clear();
+}
+
+size_t QueryResponseCache::getCachedResponseCount()
+{
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_responses.size();
+}
@@ -0,0 +1,65 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include "WorldPacket.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+class WorldSession;
+
+// Serialized responses of the static CMSG_*_QUERY opcodes. A response only depends on the
+// queried entry and the session language, so it is built once and then sent as is.
+// Entries are filled lazily by the query handlers and dropped by the .server reload commands.
+class SERVER_DECL QueryResponseCache
+{
+    // some queries (page text) are answered with more than one packet
+    typedef std::vector<WorldPacket> CachedResponse;
+    typedef std::unordered_map<uint64_t, std::shared_ptr<const CachedResponse>> CachedResponseMap;
+
+private:
+    QueryResponseCache() = default;
+    ~QueryResponseCache() = default;
+
+public:
+    static QueryResponseCache& getInstance();
+    void finalize();
+
+    QueryResponseCache(QueryResponseCache&&) = delete;
+    QueryResponseCache(QueryResponseCache const&) = delete;
+    QueryResponseCache& operator=(QueryResponseCache&&) = delete;
+    QueryResponseCache& operator=(QueryResponseCache const&) = delete;
+
+    // returns false on a miss, the handler has to build the response and store it then
+    bool sendCachedResponse(WorldSession* session, uint16_t queryOpcode, uint32_t entry);
+
+    void storeResponse(uint16_t queryOpcode, uint32_t entry, uint32_t language, WorldPacket const& response);
+    void storeResponse(uint16_t queryOpcode, uint32_t entry, uint32_t language, std::vector<WorldPacket> responses);
+
+    // drops every cached response of queryOpcode, called after the underlying table was reloaded
+    void invalidate(uint16_t queryOpcode);
+    void invalidateAll();
+
+    size_t getCachedResponseCount();
+    uint64_t getHitCount() const { return m_hits; }
+    uint64_t getMissCount() const { return m_misses; }
+
+private:
+    static uint64_t makeKey(uint16_t queryOpcode, uint32_t entry, uint32_t language);
+
+    std::shared_mutex m_mutex;
+    CachedResponseMap m_responses;
+
+    std::atomic<uint64_t> m_hits{ 0 };
+    std::atomic<uint64_t> m_misses{ 0 };
+};
+
+#define sQueryResponseCache QueryResponseCache::getInstance()
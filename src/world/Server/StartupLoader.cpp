@@ -0,0 +1,241 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "StdAfx.h"
+#include "StartupLoader.h"
+#include "Threading/WorkerPool.h"
+
+#include <mutex>
+
+StartupLoader::StartupLoader(std::string name) : m_name(std::move(name))
+{
+}
+
+void StartupLoader::addLoader(std::string name, LoaderFunction function, std::vector<std::string> dependencies)
+{
+    if (m_loaderIndex.find(name) != m_loaderIndex.end())
+    {
+        LogError("%s : Loader %s is added twice, ignoring the second one", m_name.c_str(), name.c_str());
+        return;
+    }
+
+    m_loaderIndex[name] = m_loaders.size();
+
+    Loader loader;
+    loader.name = std::move(name);
+    loader.function = std::move(function);
+    loader.dependencyNames = std::move(dependencies);
+    m_loaders.push_back(std::move(loader));
+}
+
+void StartupLoader::addBarrier(std::string name, std::vector<std::string> dependencies)
+{
+    addLoader(std::move(name), nullptr, std::move(dependencies));
+}
+
+bool StartupLoader::resolveDependencies()
+{
+    for (size_t i = 0; i < m_loaders.size(); ++i)
+    {
+        Loader& loader = m_loaders[i];
+        loader.dependencies.clear();
+        loader.dependents.clear();
+    }
+
+    for (size_t i = 0; i < m_loaders.size(); ++i)
+    {
+        Loader& loader = m_loaders[i];
+        for (const auto& dependencyName : loader.dependencyNames)
+        {
+            auto itr = m_loaderIndex.find(dependencyName);
+            if (itr == m_loaderIndex.end())
+            {
+                LogError("%s : Loader %s depends on unknown loader %s", m_name.c_str(), loader.name.c_str(), dependencyName.c_str());
+                return false;
+            }
+
+            loader.dependencies.push_back(itr->second);
+            m_loaders[itr->second].dependents.push_back(i);
+        }
+
+        loader.pendingDependencies = static_cast<uint32_t>(loader.dependencies.size());
+    }
+
+    // make sure the graph has no cycle, otherwise run() would never finish
+    std::vector<uint32_t> pending(m_loaders.size());
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < m_loaders.size(); ++i)
+    {
+        pending[i] = m_loaders[i].pendingDependencies;
+        if (pending[i] == 0)
+            ready.push_back(i);
+    }
+
+    size_t visited = 0;
+    while (!ready.empty())
+    {
+        const size_t index = ready.back();
+        ready.pop_back();
+        ++visited;
+
+        for (auto dependent : m_loaders[index].dependents)
+        {
+            if (--pending[dependent] == 0)
+                ready.push_back(dependent);
+        }
+    }
+
+    if (visited != m_loaders.size())
+    {
+        for (size_t i = 0; i < m_loaders.size(); ++i)
+        {
+            if (pending[i] != 0)
+                LogError("%s : Loader %s is part of a dependency cycle", m_name.c_str(), m_loaders[i].name.c_str());
+        }
+
+        return false;
+    }
+
+    return true;
+}
+
+void StartupLoader::run(uint32_t threadCount)
+{
+    const auto startTime = Util::TimeNow();
+
+    if (!resolveDependencies())
+    {
+        LogError("%s : Invalid loader graph, loading everything in order of registration", m_name.c_str());
+
+        for (auto& loader : m_loaders)
+        {
+            if (loader.function)
+                loader.function();
+        }
+
+        return;
+    }
+
+    size_t usedThreads;
+    {
+        AscEmu::Threading::WorkerPool pool(m_name, threadCount);
+        usedThreads = pool.getThreadCount();
+
+        std::mutex graphMutex;
+        std::function<void(size_t)> queueLoader;
+        queueLoader = [&](size_t index)
+        {
+            pool.queueJob([&, index]()
+            {
+                Loader& loader = m_loaders[index];
+                loader.startMs = static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime));
+
+                const auto loaderStartTime = Util::TimeNow();
+                if (loader.function)
+                    loader.function();
+                loader.durationMs = static_cast<uint32_t>(Util::GetTimeDifferenceToNow(loaderStartTime));
+
+                std::vector<size_t> readyLoaders;
+                {
+                    std::lock_guard<std::mutex> guard(graphMutex);
+                    for (auto dependent : loader.dependents)
+                    {
+                        if (--m_loaders[dependent].pendingDependencies == 0)
+                            readyLoaders.push_back(dependent);
+                    }
+                }
+
+                // queued before this job is finished, so waitForIdle can not return in between
+                for (auto ready : readyLoaders)
+                    queueLoader(ready);
+            });
+        };
+
+        for (size_t i = 0; i < m_loaders.size(); ++i)
+        {
+            if (m_loaders[i].dependencies.empty())
+                queueLoader(i);
+        }
+
+        pool.waitForIdle();
+        pool.shutdown();
+    }
+
+    const auto totalMs = static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime));
+    LogNotice("%s : %u loaders finished in %u ms on %u threads", m_name.c_str(), static_cast<uint32_t>(m_loaders.size()), totalMs, static_cast<uint32_t>(usedThreads));
+
+    logTimings(totalMs);
+}
+
+void StartupLoader::logTimings(uint32_t totalMs) const
+{
+    uint64_t workMs = 0;
+    for (const auto& loader : m_loaders)
+    {
+        workMs += loader.durationMs;
+
+        if (loader.function)
+            LogDetail("%s : %s took %u ms (started after %u ms)", m_name.c_str(), loader.name.c_str(), loader.durationMs, loader.startMs);
+    }
+
+    // longest chain of loaders by duration, every loader is visited after its dependencies
+    std::vector<uint64_t> pathMs(m_loaders.size(), 0);
+    std::vector<size_t> predecessor(m_loaders.size(), m_loaders.size());
+    std::vector<uint32_t> pending(m_loaders.size());
+    std::vector<size_t> ready;
+
+    for (size_t i = 0; i < m_loaders.size(); ++i)
+    {
+        pending[i] = static_cast<uint32_t>(m_loaders[i].dependencies.size());
+        if (pending[i] == 0)
+            ready.push_back(i);
+    }
+
+    size_t criticalEnd = m_loaders.size();
+    while (!ready.empty())
+    {
+        const size_t index = ready.back();
+        ready.pop_back();
+
+        for (auto dependency : m_loaders[index].dependencies)
+        {
+            if (pathMs[dependency] > pathMs[index] || predecessor[index] == m_loaders.size())
+            {
+                pathMs[index] = pathMs[dependency];
+                predecessor[index] = dependency;
+            }
+        }
+        pathMs[index] += m_loaders[index].durationMs;
+
+        if (criticalEnd == m_loaders.size() || pathMs[index] > pathMs[criticalEnd])
+            criticalEnd = index;
+
+        for (auto dependent : m_loaders[index].dependents)
+        {
+            if (--pending[dependent] == 0)
+                ready.push_back(dependent);
+        }
+    }
+
+    if (criticalEnd == m_loaders.size())
+        return;
+
+    std::vector<std::string> criticalPath;
+    for (size_t index = criticalEnd; index != m_loaders.size(); index = predecessor[index])
+    {
+        if (m_loaders[index].function)
+            criticalPath.push_back(m_loaders[index].name);
+    }
+
+    std::stringstream path;
+    for (auto itr = criticalPath.rbegin(); itr != criticalPath.rend(); ++itr)
+    {
+        if (itr != criticalPath.rbegin())
+            path << " -> ";
+        path << *itr;
+    }
+
+    LogNotice("%s : Critical path %u ms of %u ms total, %llu ms of work: %s", m_name.c_str(), static_cast<uint32_t>(pathMs[criticalEnd]), totalMs, static_cast<unsigned long long>(workMs), path.str().c_str());
+}
@@ -0,0 +1,54 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Runs the startup loaders as a dependency graph. Every loader names the loaders it needs,
+// it is queued on the worker pool as soon as all of them are finished.
+// After the run the time of each loader and the critical path of the graph are logged.
+class StartupLoader
+{
+public:
+    typedef std::function<void()> LoaderFunction;
+
+    explicit StartupLoader(std::string name);
+
+    // dependencies have to be added before run() is called, the order of addLoader calls does not matter
+    void addLoader(std::string name, LoaderFunction function, std::vector<std::string> dependencies = {});
+
+    // empty loader to group other loaders, e.g. "MySQLDataStore" depends on every store table
+    void addBarrier(std::string name, std::vector<std::string> dependencies);
+
+    // blocks until every loader is finished, threadCount 0 = one thread per hardware thread
+    void run(uint32_t threadCount);
+
+private:
+    struct Loader
+    {
+        std::string name;
+        LoaderFunction function;
+        std::vector<std::string> dependencyNames;
+
+        std::vector<size_t> dependencies;
+        std::vector<size_t> dependents;
+        uint32_t pendingDependencies = 0;
+
+        uint32_t startMs = 0;
+        uint32_t durationMs = 0;
+    };
+
+    bool resolveDependencies();
+    void logTimings(uint32_t totalMs) const;
+
+    std::string m_name;
+    std::vector<Loader> m_loaders;
+    std::unordered_map<std::string, size_t> m_loaderIndex;
+};
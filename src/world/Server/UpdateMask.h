@@ -22,6 +22,7 @@
 #define UPDATEMASK_H
 
 #include "Errors.h"
+#include "Server/UpdateMaskKernels.h"
 #include <cstring>
 
 class UpdateMask
@@ -44,19 +45,56 @@ class UpdateMask
         void SetBit(const uint32 index)
         {
             ARCEMU_ASSERT(index < mCount);
-            ((uint8*)mUpdateMask)[ index >> 3 ] |= 1 << (index & 0x7);
+            mUpdateMask[index >> 5] |= 1u << (index & 0x1F);
         }
 
         void UnsetBit(const uint32 index)
         {
             ARCEMU_ASSERT(index < mCount);
-            ((uint8*)mUpdateMask)[ index >> 3 ] &= (0xff ^ (1 << (index & 0x7)));
+            mUpdateMask[index >> 5] &= ~(1u << (index & 0x1F));
         }
 
         bool GetBit(const uint32 index) const
         {
             ARCEMU_ASSERT(index < mCount);
-            return (((uint8*)mUpdateMask)[ index >> 3 ] & (1 << (index & 0x7))) != 0;
+            return (mUpdateMask[index >> 5] & (1u << (index & 0x1F))) != 0;
+        }
+
+        // sets the bit of every non zero value, values has to hold GetCount() values
+        void SetNonZeroBits(const uint32* values)
+        {
+            UpdateMaskKernels::setNonZeroBits(values, mCount, mUpdateMask);
+        }
+
+        // same as above, restricted to the bits set in filter
+        void SetNonZeroBits(const uint32* values, const UpdateMask& filter)
+        {
+            ARCEMU_ASSERT(filter.mCount >= mCount);
+            UpdateMaskKernels::setNonZeroBits(values, mCount, mUpdateMask, filter.mUpdateMask);
+        }
+
+        bool HasAnyBit() const
+        {
+            for (uint32 i = 0; i < mBlocks; ++i)
+                if (mUpdateMask[i])
+                    return true;
+
+            return false;
+        }
+
+        // calls function(index) for every set bit of the first blockCount blocks in ascending order
+        template <typename Function>
+        void ForEachSetBit(uint32 blockCount, Function function) const
+        {
+            for (uint32 block = 0; block < blockCount; ++block)
+            {
+                uint32 bits = mUpdateMask[block];
+                while (bits)
+                {
+                    function((block << 5) + UpdateMaskKernels::countTrailingZeros(bits));
+                    bits &= bits - 1;
+                }
+            }
         }
 
         uint32 GetUpdateBlockCount() const
@@ -0,0 +1,166 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "UpdateMaskKernels.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define UPDATEMASK_X86_KERNELS
+    #include <immintrin.h>
+#endif
+
+#if defined(UPDATEMASK_X86_KERNELS) && (defined(__GNUC__) || defined(__clang__))
+    #define UPDATEMASK_TARGET(features) __attribute__((target(features)))
+#else
+    #define UPDATEMASK_TARGET(features)
+#endif
+
+namespace
+{
+    typedef void(*SetNonZeroBitsKernel)(const uint32_t*, uint32_t, uint32_t*, const uint32_t*);
+
+    inline uint32_t filterBits(uint32_t bits, const uint32_t* filterBlocks, uint32_t block)
+    {
+        return filterBlocks ? bits & filterBlocks[block] : bits;
+    }
+
+    void setNonZeroBitsScalar(const uint32_t* values, uint32_t count, uint32_t* maskBlocks, const uint32_t* filterBlocks)
+    {
+        for (uint32_t block = 0; block * 32 < count; ++block)
+        {
+            const uint32_t first = block * 32;
+            const uint32_t last = count - first < 32 ? count - first : 32;
+
+            uint32_t bits = 0;
+            for (uint32_t i = 0; i < last; ++i)
+                bits |= static_cast<uint32_t>(values[first + i] != 0) << i;
+
+            maskBlocks[block] |= filterBits(bits, filterBlocks, block);
+        }
+    }
+
+#ifdef UPDATEMASK_X86_KERNELS
+    UPDATEMASK_TARGET("sse2")
+    void setNonZeroBitsSse2(const uint32_t* values, uint32_t count, uint32_t* maskBlocks, const uint32_t* filterBlocks)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const uint32_t fullBlocks = count / 32;
+
+        for (uint32_t block = 0; block < fullBlocks; ++block)
+        {
+            const uint32_t* blockValues = values + block * 32;
+
+            // movemask returns a set bit for every value equal to zero
+            uint32_t zeroBits = 0;
+            for (uint32_t i = 0; i < 32; i += 4)
+            {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blockValues + i));
+                zeroBits |= static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(chunk, zero)))) << i;
+            }
+
+            maskBlocks[block] |= filterBits(~zeroBits, filterBlocks, block);
+        }
+
+        if (count % 32)
+            setNonZeroBitsScalar(values + fullBlocks * 32, count % 32, maskBlocks + fullBlocks, filterBlocks ? filterBlocks + fullBlocks : nullptr);
+    }
+
+    UPDATEMASK_TARGET("avx2")
+    void setNonZeroBitsAvx2(const uint32_t* values, uint32_t count, uint32_t* maskBlocks, const uint32_t* filterBlocks)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const uint32_t fullBlocks = count / 32;
+
+        for (uint32_t block = 0; block < fullBlocks; ++block)
+        {
+            const uint32_t* blockValues = values + block * 32;
+
+            uint32_t zeroBits = 0;
+            for (uint32_t i = 0; i < 32; i += 8)
+            {
+                const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blockValues + i));
+                zeroBits |= static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(chunk, zero)))) << i;
+            }
+
+            maskBlocks[block] |= filterBits(~zeroBits, filterBlocks, block);
+        }
+
+        if (count % 32)
+            setNonZeroBitsScalar(values + fullBlocks * 32, count % 32, maskBlocks + fullBlocks, filterBlocks ? filterBlocks + fullBlocks : nullptr);
+    }
+
+    bool cpuHasAvx2()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        // the os has to save the ymm registers
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        if (!osxsave || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    }
+
+    bool cpuHasSse2()
+    {
+#if defined(_M_X64) || defined(__x86_64__)
+        return true;
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[3] & (1 << 26)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2") != 0;
+#endif
+    }
+#endif
+
+    struct SelectedKernel
+    {
+        SetNonZeroBitsKernel setNonZeroBits;
+        const char* name;
+    };
+
+    SelectedKernel selectKernel()
+    {
+#ifdef UPDATEMASK_X86_KERNELS
+        if (cpuHasAvx2())
+            return { setNonZeroBitsAvx2, "avx2" };
+
+        if (cpuHasSse2())
+            return { setNonZeroBitsSse2, "sse2" };
+#endif
+        return { setNonZeroBitsScalar, "scalar" };
+    }
+
+    const SelectedKernel& getSelectedKernel()
+    {
+        static const SelectedKernel kernel = selectKernel();
+        return kernel;
+    }
+}
+
+namespace UpdateMaskKernels
+{
+    void setNonZeroBits(const uint32_t* values, uint32_t count, uint32_t* maskBlocks, const uint32_t* filterBlocks)
+    {
+        getSelectedKernel().setNonZeroBits(values, count, maskBlocks, filterBlocks);
+    }
+
+    const char* getKernelName()
+    {
+        return getSelectedKernel().name;
+    }
+}
@@ -0,0 +1,35 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Bulk kernels for UpdateMask. The SSE2 and AVX2 variants are picked once at runtime
+// from the cpu features, every other cpu uses the scalar kernels.
+namespace UpdateMaskKernels
+{
+    // sets bit i of maskBlocks for every values[i] != 0, bits of zero values are left as they are.
+    // With filterBlocks only the bits also set in filterBlocks are added.
+    void setNonZeroBits(const uint32_t* values, uint32_t count, uint32_t* maskBlocks, const uint32_t* filterBlocks = nullptr);
+
+    // "avx2", "sse2" or "scalar"
+    const char* getKernelName();
+
+    inline uint32_t countTrailingZeros(uint32_t value)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return index;
+#else
+        return static_cast<uint32_t>(__builtin_ctz(value));
+#endif
+    }
+}
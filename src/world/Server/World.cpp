@@ -19,6 +19,7 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Management/ChannelMgr.h"
 #include "WorldSocket.h"
 #include "Storage/MySQLDataStore.hpp"
+#include "Storage/WorldDatabaseSnapshot.h"
 #include <CrashHandler.h>
 #include "Server/MainServerDefines.h"
 //#include "Config/Config.h"
@@ -26,6 +27,9 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Map/WorldCreator.h"
 #include "Storage/DayWatcherThread.h"
 #include "BroadcastMgr.h"
+#include "QueryResponseCache.h"
+#include "UpdateMaskKernels.h"
+#include "StartupLoader.h"
 #include "World.Legacy.h"
 #include "Spell/SpellMgr.h"
 #include "Management/GuildMgr.h"
@@ -91,6 +95,9 @@ void World::finalize()
     LogNotice("WorldLog : ~WorldLog()");
     sWorldPacketLog.finalize();
 
+    LogNotice("QueryResponseCache : ~QueryResponseCache()");
+    sQueryResponseCache.finalize();
+
     LogNotice("ObjectMgr : ~ObjectMgr()");
     sObjectMgr.finalize();
 
@@ -443,6 +450,67 @@ void World::disconnectSessionByPlayerName(const std::string& playerName, WorldSe
         worldSession->SystemMessage("There is no body online with the name [%s]", playerName.c_str());
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Thread safe packet processing
+void World::startPacketWorkerPool()
+{
+    if (worldConfig.server.queryPacketThreads == 0)
+    {
+        LogNotice("World : Packet worker pool disabled, all packets are handled by map threads");
+        return;
+    }
+
+    mPacketWorkerPool = std::make_unique<AscEmu::Threading::WorkerPool>("PacketWorkerPool", worldConfig.server.queryPacketThreads);
+    LogNotice("World : Started %u packet worker threads", static_cast<uint32_t>(mPacketWorkerPool->getThreadCount()));
+}
+
+void World::stopPacketWorkerPool()
+{
+    if (mPacketWorkerPool == nullptr)
+        return;
+
+    mPacketWorkerPool->shutdown();
+    mPacketWorkerPool.reset();
+}
+
+bool World::queueThreadSafePacket(WorldSession* worldSession, WorldPacket* worldPacket)
+{
+    if (mPacketWorkerPool == nullptr)
+        return false;
+
+    ++worldSession->m_pendingThreadSafePackets;
+    mPacketWorkerPool->queueJob([worldSession, worldPacket]()
+    {
+        worldSession->processThreadSafePacket(worldPacket);
+        --worldSession->m_pendingThreadSafePackets;
+    });
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Map update workers
+void World::startMapUpdateWorkerPool()
+{
+    if (worldConfig.server.mapUpdateThreads == 0)
+    {
+        LogNotice("World : Map update worker pool disabled, update blocks are built by map threads");
+        return;
+    }
+
+    mMapUpdateWorkerPool = std::make_unique<AscEmu::Threading::WorkerPool>("MapUpdateWorkerPool", worldConfig.server.mapUpdateThreads);
+    LogNotice("World : Started %u map update worker threads", static_cast<uint32_t>(mMapUpdateWorkerPool->getThreadCount()));
+}
+
+void World::stopMapUpdateWorkerPool()
+{
+    if (mMapUpdateWorkerPool == nullptr)
+        return;
+
+    mMapUpdateWorkerPool->shutdown();
+    mMapUpdateWorkerPool.reset();
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // GlobalSession functions - not used?
 void World::addGlobalSession(WorldSession* worldSession)
@@ -740,16 +808,10 @@ bool World::setInitialWorldSettings()
     std::string vmapPath = worldConfig.server.dataDir + "vmaps";
     LoadGameObjectModelList(vmapPath);
 
-    loadMySQLStores();
-    loadMySQLTablesByTask();
+    loadWorldDatabase();
     logEntitySize();
 
-    sSpellMgr.loadSpellDataFromDatabase();
-
-#if VERSION_STRING > TBC
-    LogDetail("World : Starting Achievement System...");
-    sObjectMgr.LoadAchievementCriteriaList();
-#endif
+    LogDetail("World : Building update masks with %s kernels", UpdateMaskKernels::getKernelName());
 
     LogDetail("World : Starting Transport System...");
     sObjectMgr.LoadTransports();
@@ -757,29 +819,8 @@ bool World::setInitialWorldSettings()
     LogDetail("World : Starting Mail System...");
     sMailSystem.StartMailSystem();
 
-    LogDetail("World : Starting Auction System...");
-    sAuctionMgr.initialize();
-    sAuctionMgr.LoadAuctionHouses();
-
-    LogDetail("World : Loading LFG rewards...");
-    sLfgMgr.initialize();
-    sLfgMgr.LoadRewards();
-
-    sGuildMgr.loadGuildDataFromDB();
-
-#if VERSION_STRING >= Cata
-    sGuildMgr.loadGuildXpForLevelFromDB();
-    sGuildMgr.loadGuildRewardsFromDB();
-
-    sGuildFinderMgr.loadGuildFinderDataFromDB();
-#endif
-
     mQueueUpdateTimer = settings.server.queueUpdateInterval;
 
-    LogNotice("World : Loading loot data...");
-    sLootMgr.initialize();
-    sLootMgr.LoadLoot();
-
     sChannelMgr.loadConfigSettings();
 
     LogDetail("World : Starting BattlegroundManager...");
@@ -808,6 +849,7 @@ bool World::loadDbcDb2Stores()
 #endif
 
     LogNotice("World : Loading DBC files...");
+    DBC::DBCLoader::SetMapFiles(worldConfig.startup.enableMappedDbcFiles);
     if (!LoadDBCs())
     {
         AscLog.ConsoleLogMajorError("One or more of the DBC files are missing.", "These are absolutely necessary for the server to function.", "The server will not start without them.", "");
@@ -817,159 +859,206 @@ bool World::loadDbcDb2Stores()
     return true;
 }
 
-void World::loadMySQLStores()
+void World::loadWorldDatabase()
 {
+    auto startTime = Util::TimeNow();
+
+    sObjectMgr.initialize();
+    sAddonMgr.initialize();
+    sGameEventMgr.initialize();
+    sAuctionMgr.initialize();
+    sLfgMgr.initialize();
+    sLootMgr.initialize();
+
+    // read by every store loader
     sMySQLStore.loadAdditionalTableConfig();
 
-    sMySQLStore.loadItemPagesTable();
-    sMySQLStore.loadItemPropertiesTable();
-    sMySQLStore.loadCreaturePropertiesTable();
-    sMySQLStore.loadGameObjectPropertiesTable();
-    sMySQLStore.loadQuestPropertiesTable();
-    sMySQLStore.loadGameObjectQuestItemBindingTable();
-    sMySQLStore.loadGameObjectQuestPickupBindingTable();
-
-    sMySQLStore.loadCreatureDifficultyTable();
-    sMySQLStore.loadDisplayBoundingBoxesTable();
-    sMySQLStore.loadVendorRestrictionsTable();
-
-    sMySQLStore.loadNpcTextTable();
-    sMySQLStore.loadNpcScriptTextTable();
-    sMySQLStore.loadGossipMenuOptionTable();
-    sMySQLStore.loadGraveyardsTable();
-    sMySQLStore.loadTeleportCoordsTable();
-    sMySQLStore.loadFishingTable();
-    sMySQLStore.loadWorldMapInfoTable();
-    sMySQLStore.loadZoneGuardsTable();
-    sMySQLStore.loadBattleMastersTable();
-    sMySQLStore.loadTotemDisplayIdsTable();
-    sMySQLStore.loadSpellClickSpellsTable();
-
-    sMySQLStore.loadWorldStringsTable();
-    sMySQLStore.loadPointsOfInterestTable();
-    sMySQLStore.loadItemSetLinkedSetBonusTable();
-    sMySQLStore.loadCreatureInitialEquipmentTable();
-
-    sMySQLStore.loadPlayerCreateInfoTable();
-    sMySQLStore.loadPlayerCreateInfoSkillsTable();
-    sMySQLStore.loadPlayerCreateInfoSpellsTable();
-    sMySQLStore.loadPlayerCreateInfoItemsTable();
-    sMySQLStore.loadPlayerXpToLevelTable();
-
-    sMySQLStore.loadSpellOverrideTable();
-
-    sMySQLStore.loadNpcGossipTextIdTable();
-    sMySQLStore.loadPetLevelAbilitiesTable();
-    sMySQLStore.loadBroadcastTable();
-
-    sMySQLStore.loadAreaTriggerTable();
-    sMySQLStore.loadWordFilterCharacterNames();
-    sMySQLStore.loadWordFilterChat();
-    sMySQLStore.loadCreatureFormationsTable();
-
-    sMySQLStore.loadLocalesCreature();
-    sMySQLStore.loadLocalesGameobject();
-    sMySQLStore.loadLocalesGossipMenuOption();
-    sMySQLStore.loadLocalesItem();
-    sMySQLStore.loadLocalesItemPages();
-    sMySQLStore.loadLocalesNPCMonstersay();
-    sMySQLStore.loadLocalesNpcScriptText();
-    sMySQLStore.loadLocalesNpcText();
-    sMySQLStore.loadLocalesQuest();
-    sMySQLStore.loadLocalesWorldbroadcast();
-    sMySQLStore.loadLocalesWorldmapInfo();
-    sMySQLStore.loadLocalesWorldStringTable();
-
-    sMySQLStore.loadNpcMonstersayTable();
-    //sMySQLStore.loadDefaultPetSpellsTable();      Zyres 2017/07/16 not used
-    sMySQLStore.loadProfessionDiscoveriesTable();
+    if (worldConfig.startup.enableWorldDbSnapshot)
+        sWorldDatabaseSnapshot.initialize(worldConfig.startup.worldDbSnapshotFile);
+
+    StartupLoader loader("StartupLoader");
+    addMySQLStoreLoaders(loader);
+    addManagerLoaders(loader);
+
+    // one worker per world database connection, a running loader never waits for a free connection
+    uint32_t loaderThreads = 1;
+    if (worldConfig.startup.enableMultithreadedLoading)
+        loaderThreads = static_cast<uint32_t>(std::max(1, worldConfig.worldDb.connections));
 
-    sMySQLStore.loadTransportCreaturesTable();
-    sMySQLStore.loadTransportDataTable();
-    sMySQLStore.loadGossipMenuItemsTable();
+    loader.run(loaderThreads);
+
+    sWorldDatabaseSnapshot.finishLoading();
+
+    //sMySQLStore.loadDefaultPetSpellsTable();      Zyres 2017/07/16 not used
 
     //check functions
     //sMySQLStore.checkCreatureEquipment();
+
+    sCommandTableStorage.Load();
+    LogNotice("WordFilter : Loading...");
+
+    g_chatFilter = new WordFilter();
+
+    LogDetail("Done. Database loaded in %u ms.", static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
+
+    sInstanceMgr.Load();
 }
 
-void World::loadMySQLTablesByTask()
+void World::addMySQLStoreLoaders(StartupLoader& loader)
 {
-    auto startTime = Util::TimeNow();
-
-    sObjectMgr.initialize();
-    sAddonMgr.initialize();
-    sGameEventMgr.initialize();
+    std::vector<std::string> storeLoaders;
+
+#define ADD_STORE_LOADER(function, ...) \
+    loader.addLoader("MySQLDataStore::" #function, [] { sMySQLStore.function(); }, { __VA_ARGS__ }); \
+    storeLoaders.emplace_back("MySQLDataStore::" #function)
+
+    ADD_STORE_LOADER(loadItemPagesTable);
+    ADD_STORE_LOADER(loadItemPropertiesTable, "MySQLDataStore::loadItemPagesTable");
+    ADD_STORE_LOADER(loadCreaturePropertiesTable);
+    ADD_STORE_LOADER(loadGameObjectPropertiesTable, "MySQLDataStore::loadItemPropertiesTable");
+    ADD_STORE_LOADER(loadQuestPropertiesTable, "MySQLDataStore::loadCreaturePropertiesTable", "MySQLDataStore::loadGameObjectPropertiesTable");
+    ADD_STORE_LOADER(loadGameObjectQuestItemBindingTable, "MySQLDataStore::loadQuestPropertiesTable");
+    // both bindings write to the gameobject properties
+    ADD_STORE_LOADER(loadGameObjectQuestPickupBindingTable, "MySQLDataStore::loadGameObjectQuestItemBindingTable");
+
+    ADD_STORE_LOADER(loadCreatureDifficultyTable);
+    ADD_STORE_LOADER(loadDisplayBoundingBoxesTable);
+    ADD_STORE_LOADER(loadVendorRestrictionsTable);
+
+    ADD_STORE_LOADER(loadNpcTextTable);
+    ADD_STORE_LOADER(loadNpcScriptTextTable);
+    ADD_STORE_LOADER(loadGossipMenuOptionTable);
+    ADD_STORE_LOADER(loadGraveyardsTable);
+    ADD_STORE_LOADER(loadTeleportCoordsTable);
+    ADD_STORE_LOADER(loadFishingTable);
+    ADD_STORE_LOADER(loadWorldMapInfoTable);
+    ADD_STORE_LOADER(loadZoneGuardsTable);
+    ADD_STORE_LOADER(loadBattleMastersTable);
+    ADD_STORE_LOADER(loadTotemDisplayIdsTable);
+    ADD_STORE_LOADER(loadSpellClickSpellsTable);
+
+    ADD_STORE_LOADER(loadWorldStringsTable);
+    ADD_STORE_LOADER(loadPointsOfInterestTable);
+    ADD_STORE_LOADER(loadItemSetLinkedSetBonusTable);
+    ADD_STORE_LOADER(loadCreatureInitialEquipmentTable, "MySQLDataStore::loadCreaturePropertiesTable", "MySQLDataStore::loadItemPropertiesTable");
+
+    ADD_STORE_LOADER(loadPlayerCreateInfoTable);
+    ADD_STORE_LOADER(loadPlayerCreateInfoSkillsTable, "MySQLDataStore::loadPlayerCreateInfoTable");
+    ADD_STORE_LOADER(loadPlayerCreateInfoSpellsTable, "MySQLDataStore::loadPlayerCreateInfoTable");
+    ADD_STORE_LOADER(loadPlayerCreateInfoItemsTable, "MySQLDataStore::loadPlayerCreateInfoTable", "MySQLDataStore::loadItemPropertiesTable");
+    ADD_STORE_LOADER(loadPlayerXpToLevelTable);
+
+    ADD_STORE_LOADER(loadSpellOverrideTable);
+
+    ADD_STORE_LOADER(loadNpcGossipTextIdTable, "MySQLDataStore::loadCreaturePropertiesTable");
+    ADD_STORE_LOADER(loadPetLevelAbilitiesTable);
+    ADD_STORE_LOADER(loadBroadcastTable);
+
+    ADD_STORE_LOADER(loadAreaTriggerTable);
+    ADD_STORE_LOADER(loadWordFilterCharacterNames);
+    ADD_STORE_LOADER(loadWordFilterChat);
+    ADD_STORE_LOADER(loadCreatureFormationsTable);
+
+    ADD_STORE_LOADER(loadLocalesCreature);
+    ADD_STORE_LOADER(loadLocalesGameobject);
+    ADD_STORE_LOADER(loadLocalesGossipMenuOption);
+    ADD_STORE_LOADER(loadLocalesItem);
+    ADD_STORE_LOADER(loadLocalesItemPages);
+    ADD_STORE_LOADER(loadLocalesNPCMonstersay);
+    ADD_STORE_LOADER(loadLocalesNpcScriptText);
+    ADD_STORE_LOADER(loadLocalesNpcText);
+    ADD_STORE_LOADER(loadLocalesQuest);
+    ADD_STORE_LOADER(loadLocalesWorldbroadcast);
+    ADD_STORE_LOADER(loadLocalesWorldmapInfo);
+    ADD_STORE_LOADER(loadLocalesWorldStringTable);
+
+    ADD_STORE_LOADER(loadNpcMonstersayTable);
+    ADD_STORE_LOADER(loadProfessionDiscoveriesTable);
+
+    ADD_STORE_LOADER(loadTransportCreaturesTable);
+    ADD_STORE_LOADER(loadTransportDataTable, "MySQLDataStore::loadGameObjectPropertiesTable");
+    ADD_STORE_LOADER(loadGossipMenuItemsTable, "MySQLDataStore::loadItemPropertiesTable");
+
+#undef ADD_STORE_LOADER
+
+    loader.addBarrier("MySQLDataStore", storeLoaders);
+}
 
-#define MAKE_TASK(sp, ptr) tl.AddTask(new Task(new CallbackP0<sp>(&sp::getInstance(), &sp::ptr)))
-    // Fill the task list with jobs to do.
-    TaskList tl;
+void World::addManagerLoaders(StartupLoader& loader)
+{
+#define ADD_LOADER(sp, function, ...) loader.addLoader(#sp "::" #function, [] { sp::getInstance().function(); }, { __VA_ARGS__ })
 
-    // spawn worker threads (2 * number of cpus)
-    tl.spawn();
+    // ObjectMgr is loaded after the complete storage
+    ADD_LOADER(ObjectMgr, GenerateLevelUpInfo, "MySQLDataStore");
+    ADD_LOADER(ObjectMgr, LoadPlayersInfo, "MySQLDataStore");
 
-    // storage stuff has to be loaded first
-    tl.wait();
+    std::vector<std::string> objectMgrLoaders;
 
-    MAKE_TASK(ObjectMgr, GenerateLevelUpInfo);
-    MAKE_TASK(ObjectMgr, LoadPlayersInfo);
-    tl.wait();
+#define ADD_OBJECTMGR_LOADER(function) \
+    ADD_LOADER(ObjectMgr, function, "ObjectMgr::GenerateLevelUpInfo", "ObjectMgr::LoadPlayersInfo"); \
+    objectMgrLoaders.emplace_back("ObjectMgr::" #function)
 
-    MAKE_TASK(ObjectMgr, LoadInstanceBossInfos);
-    MAKE_TASK(ObjectMgr, LoadCreatureWaypoints);
-    MAKE_TASK(ObjectMgr, LoadCreatureTimedEmotes);
-    MAKE_TASK(ObjectMgr, LoadTrainers);
-    MAKE_TASK(ObjectMgr, LoadSpellSkills);
-    MAKE_TASK(ObjectMgr, LoadVendors);
-    MAKE_TASK(ObjectMgr, LoadSpellTargetConstraints);
+    ADD_OBJECTMGR_LOADER(LoadInstanceBossInfos);
+    ADD_OBJECTMGR_LOADER(LoadCreatureWaypoints);
+    ADD_OBJECTMGR_LOADER(LoadCreatureTimedEmotes);
+    ADD_OBJECTMGR_LOADER(LoadTrainers);
+    ADD_OBJECTMGR_LOADER(LoadSpellSkills);
+    ADD_OBJECTMGR_LOADER(LoadVendors);
+    ADD_OBJECTMGR_LOADER(LoadSpellTargetConstraints);
 #if VERSION_STRING >= Cata
-    MAKE_TASK(ObjectMgr, LoadSpellRequired);
-    MAKE_TASK(ObjectMgr, LoadSkillLineAbilityMap);
+    ADD_OBJECTMGR_LOADER(LoadSpellRequired);
+    ADD_OBJECTMGR_LOADER(LoadSkillLineAbilityMap);
 #endif
-    MAKE_TASK(ObjectMgr, LoadPetSpellCooldowns);
-    MAKE_TASK(ObjectMgr, LoadGuildCharters);
-    MAKE_TASK(ObjectMgr, LoadGMTickets);
-    MAKE_TASK(ObjectMgr, SetHighestGuids);
-    MAKE_TASK(ObjectMgr, LoadReputationModifiers);
-    MAKE_TASK(ObjectMgr, LoadGroups);
-    MAKE_TASK(ObjectMgr, LoadCreatureAIAgents);
-    MAKE_TASK(ObjectMgr, LoadArenaTeams);
-    MAKE_TASK(ObjectMgr, LoadVehicleAccessories);
-    MAKE_TASK(ObjectMgr, LoadWorldStateTemplates);
+    ADD_OBJECTMGR_LOADER(LoadPetSpellCooldowns);
+    ADD_OBJECTMGR_LOADER(LoadGuildCharters);
+    ADD_OBJECTMGR_LOADER(LoadGMTickets);
+    ADD_OBJECTMGR_LOADER(SetHighestGuids);
+    ADD_OBJECTMGR_LOADER(LoadReputationModifiers);
+    ADD_OBJECTMGR_LOADER(LoadGroups);
+    ADD_OBJECTMGR_LOADER(LoadCreatureAIAgents);
+    ADD_OBJECTMGR_LOADER(LoadArenaTeams);
+    ADD_OBJECTMGR_LOADER(LoadVehicleAccessories);
+    ADD_OBJECTMGR_LOADER(LoadWorldStateTemplates);
 
 #if VERSION_STRING > TBC
-    MAKE_TASK(ObjectMgr, LoadAchievementRewards);
+    ADD_OBJECTMGR_LOADER(LoadAchievementRewards);
 #endif
 
-    tl.wait();
+#undef ADD_OBJECTMGR_LOADER
 
-    MAKE_TASK(QuestMgr, LoadExtraQuestStuff);
-    MAKE_TASK(ObjectMgr, LoadEventScripts);
-    MAKE_TASK(WeatherMgr, LoadFromDB);
-    MAKE_TASK(AddonMgr, LoadFromDB);
-    MAKE_TASK(GameEventMgr, LoadFromDB);
-    MAKE_TASK(CalendarMgr, LoadFromDB);
+    loader.addBarrier("ObjectMgr", objectMgrLoaders);
 
-#undef MAKE_TASK
+    ADD_LOADER(QuestMgr, LoadExtraQuestStuff, "ObjectMgr");
+    ADD_LOADER(ObjectMgr, LoadEventScripts, "ObjectMgr");
+    ADD_LOADER(GameEventMgr, LoadFromDB, "ObjectMgr");
 
-    // wait for tasks above
-    tl.wait();
-
-    sCommandTableStorage.Load();
-    LogNotice("WordFilter : Loading...");
+    // these only read their own tables
+    ADD_LOADER(WeatherMgr, LoadFromDB);
+    ADD_LOADER(AddonMgr, LoadFromDB);
+    ADD_LOADER(CalendarMgr, LoadFromDB);
+#if VERSION_STRING > TBC
+    ADD_LOADER(ObjectMgr, LoadAchievementCriteriaList);
+#endif
 
-    g_chatFilter = new WordFilter();
+    // changes SpellInfo, which is read by the storage and ObjectMgr loaders. The quest, event script and
+    // game event loaders ran before it in the serial startup, it keeps waiting for them.
+    ADD_LOADER(SpellMgr, loadSpellDataFromDatabase, "ObjectMgr", "QuestMgr::LoadExtraQuestStuff", "ObjectMgr::LoadEventScripts", "GameEventMgr::LoadFromDB");
 
-    LogDetail("Done. Database loaded in %u ms.", static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
+    // items from the character database need item properties, spell data and player infos
+    ADD_LOADER(AuctionMgr, LoadAuctionHouses, "SpellMgr::loadSpellDataFromDatabase");
+    ADD_LOADER(GuildMgr, loadGuildDataFromDB, "SpellMgr::loadSpellDataFromDatabase");
+#if VERSION_STRING >= Cata
+    ADD_LOADER(GuildMgr, loadGuildXpForLevelFromDB, "GuildMgr::loadGuildDataFromDB");
+    ADD_LOADER(GuildMgr, loadGuildRewardsFromDB, "GuildMgr::loadGuildDataFromDB");
+    ADD_LOADER(GuildFinderMgr, loadGuildFinderDataFromDB, "GuildMgr::loadGuildDataFromDB");
+#endif
 
-    // calling this puts all maps into our task list.
-    sInstanceMgr.Load();
+    ADD_LOADER(LfgMgr, LoadRewards, "MySQLDataStore::loadQuestPropertiesTable");
 
-    // wait for the events to complete.
-    tl.wait();
+    // loot needs the item properties, the gameobject loot links the quest properties (QuestMgr::SetGameObjectLootQuest)
+    ADD_LOADER(LootMgr, LoadLoot, "MySQLDataStore");
 
-    // wait for them to exit, now.
-    tl.kill();
-    tl.waitForThreadsToExit();
+#undef ADD_LOADER
 }
 
 void World::logEntitySize()
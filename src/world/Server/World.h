@@ -12,11 +12,15 @@ This file is released under the MIT license. See README-MIT for more information
 #include "WorldSession.h"
 #include "WorldConfig.h"
 #include "World.Legacy.h"
+#include "Threading/WorkerPool.h"
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+class StartupLoader;
+
 class SERVER_DECL World : public EventableObject, public IUpdatable
 {
     private:
@@ -139,6 +143,34 @@ class SERVER_DECL World : public EventableObject, public IUpdatable
         void addGlobalSession(WorldSession* worldSession);
         void updateGlobalSession(uint32_t diff);
 
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // Thread safe packet processing
+    private:
+
+        std::unique_ptr<AscEmu::Threading::WorkerPool> mPacketWorkerPool;
+
+    public:
+
+        void startPacketWorkerPool();
+        void stopPacketWorkerPool();
+
+        // false when the pool is disabled, the packet has to be queued for the map thread then
+        bool queueThreadSafePacket(WorldSession* worldSession, WorldPacket* worldPacket);
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // Map update workers
+    private:
+
+        std::unique_ptr<AscEmu::Threading::WorkerPool> mMapUpdateWorkerPool;
+
+    public:
+
+        void startMapUpdateWorkerPool();
+        void stopMapUpdateWorkerPool();
+
+        // nullptr when the pool is disabled, update blocks are serialized on the map thread then
+        AscEmu::Threading::WorkerPool* getMapUpdateWorkerPool() const { return mMapUpdateWorkerPool.get(); }
+
     //////////////////////////////////////////////////////////////////////////////////////////
     // Session queue
     private:
@@ -190,8 +222,9 @@ class SERVER_DECL World : public EventableObject, public IUpdatable
         void resetCharacterLoginBannState();
         bool loadDbcDb2Stores();
 
-        void loadMySQLStores();
-        void loadMySQLTablesByTask();
+        void loadWorldDatabase();
+        void addMySQLStoreLoaders(StartupLoader& loader);
+        void addManagerLoaders(StartupLoader& loader);
         void logEntitySize();
 
         void Update(unsigned long timePassed);
@@ -53,6 +53,7 @@ WorldConfig::WorldConfig(): mFloatRates{}, mIntRates{}
     server.sendStatsOnJoin = true;
     server.gmtTimeZone = 0;
     server.compressionThreshold = 1000;
+    server.compressionBudget = 25;
     server.enableAdjustPriority = false;
     server.mapUnloadTime = MAP_CELL_DEFAULT_UNLOAD_TIME;
     server.mapCellNumber = 1;
@@ -64,6 +65,8 @@ WorldConfig::WorldConfig(): mFloatRates{}, mIntRates{}
     server.requireGmForCommands = false;
     server.saveExtendedCharData = false;
     server.dataDir = "";
+    server.queryPacketThreads = 2;
+    server.mapUpdateThreads = 2;
 
     // world.conf - Player Settings
     player.playerStartingLevel = 1;
@@ -107,6 +110,7 @@ WorldConfig::WorldConfig(): mFloatRates{}, mIntRates{}
     guild.newsLogCount = 0;
     guild.bankLogCount = 0;
     guild.saveInterval = 300;
+    guild.flushInterval = 10;
 
     // world.conf - Announce Settings
     announce.enableGmAdminTag = true;
@@ -154,6 +158,9 @@ WorldConfig::WorldConfig(): mFloatRates{}, mIntRates{}
     // world.conf - Startup Options
     startup.enableMultithreadedLoading = false;
     startup.enableSpellIdDump = false;
+    startup.enableWorldDbSnapshot = false;
+    startup.worldDbSnapshotFile = "world_db.snapshot";
+    startup.enableMappedDbcFiles = false;
 
     // world.conf - AntiHack Setup
     antiHack.isTeleportHackCheckEnabled = false;
@@ -292,6 +299,7 @@ void WorldConfig::loadWorldConfigValues(bool reload /*false*/)
     ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Server", "SendStatsOnJoin", &server.sendStatsOnJoin));
     ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Server", "TimeZone", &server.gmtTimeZone));
     ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Server", "CompressionThreshold", &server.compressionThreshold));
+    Config.MainConfig.tryGetInt("Server", "CompressionBudget", &server.compressionBudget);
     ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Server", "AdjustPriority", &server.enableAdjustPriority));
 #ifdef WIN32
     DWORD current_priority_class = GetPriorityClass(GetCurrentProcess());
@@ -329,6 +337,8 @@ void WorldConfig::loadWorldConfigValues(bool reload /*false*/)
     ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Server", "AllowPlayerCommands", &server.requireGmForCommands));
     ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Server", "SaveExtendedCharData", &server.saveExtendedCharData));
     ARCEMU_ASSERT(Config.MainConfig.tryGetString("Server", "DataDir", &server.dataDir));
+    Config.MainConfig.tryGetInt("Server", "QueryPacketThreads", &server.queryPacketThreads);
+    Config.MainConfig.tryGetInt("Server", "MapUpdateThreads", &server.mapUpdateThreads);
     if (server.dataDir == "")
         server.dataDir = "./";
     else if (server.dataDir != "./")
@@ -384,6 +394,7 @@ void WorldConfig::loadWorldConfigValues(bool reload /*false*/)
     ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Guild", "NewsLogCount", &guild.newsLogCount));
     ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Guild", "BankLogCount", &guild.bankLogCount));
     ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Guild", "SaveInterval", &guild.saveInterval));
+    Config.MainConfig.tryGetInt("Guild", "FlushInterval", &guild.flushInterval);
 
     // world.conf - Announce Settings
     ARCEMU_ASSERT(Config.MainConfig.tryGetString("Announce", "Tag", &announce.announceTag));
@@ -475,6 +486,9 @@ void WorldConfig::loadWorldConfigValues(bool reload /*false*/)
     ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Startup", "EnableMultithreadedLoading", &startup.enableMultithreadedLoading));
     ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Startup", "EnableSpellIDDump", &startup.enableSpellIdDump));
     ARCEMU_ASSERT(Config.MainConfig.tryGetString("Startup", "LoadAdditionalTables", &startup.additionalTableLoads));
+    Config.MainConfig.tryGetBool("Startup", "EnableWorldDatabaseSnapshot", &startup.enableWorldDbSnapshot);
+    Config.MainConfig.tryGetString("Startup", "WorldDatabaseSnapshotFile", &startup.worldDbSnapshotFile);
+    Config.MainConfig.tryGetBool("Startup", "EnableMappedDbcFiles", &startup.enableMappedDbcFiles);
 
     // world.conf - AntiHack Setup
     ARCEMU_ASSERT(Config.MainConfig.tryGetBool("AntiHack", "Teleport", &antiHack.isTeleportHackCheckEnabled));
@@ -123,6 +123,7 @@ class SERVER_DECL WorldConfig
             bool sendStatsOnJoin;
             int gmtTimeZone;
             uint32_t compressionThreshold;
+            uint32_t compressionBudget;
             bool enableAdjustPriority;
             uint32_t mapUnloadTime;
             uint8_t mapCellNumber;
@@ -134,6 +135,8 @@ class SERVER_DECL WorldConfig
             bool requireGmForCommands;
             bool saveExtendedCharData;
             std::string dataDir;
+            uint32_t queryPacketThreads;
+            uint32_t mapUpdateThreads;
         } server;
 
         uint32_t getPlayerLimit() const;
@@ -190,6 +193,7 @@ class SERVER_DECL WorldConfig
             uint32_t newsLogCount;
             uint32_t bankLogCount;
             uint32_t saveInterval;
+            uint32_t flushInterval;
         } guild;
 
         // world.conf - Announce Settings
@@ -276,6 +280,9 @@ class SERVER_DECL WorldConfig
             bool enableMultithreadedLoading;
             bool enableSpellIdDump;
             std::string additionalTableLoads;
+            bool enableWorldDbSnapshot;
+            std::string worldDbSnapshotFile;
+            bool enableMappedDbcFiles;
         } startup;
 
         // world.conf - AntiHack Setup
@@ -83,10 +83,16 @@ WorldSession::WorldSession(uint32 id, std::string name, WorldSocket* sock) :
 
     for (uint8 x = 0; x < 8; x++)
         sAccountData[x].data = nullptr;
+
+    m_pendingThreadSafePackets = 0;
 }
 
 WorldSession::~WorldSession()
 {
+    // packets handed to the world packet worker pool still reference this session
+    while (m_pendingThreadSafePackets != 0)
+        Arcemu::Sleep(1);
+
     deleteMutex.Acquire();
 
     if (_player)
@@ -532,10 +538,25 @@ void WorldSession::InitPacketHandlerTable()
     for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
     {
         WorldPacketHandlers[i].status = STATUS_LOGGEDIN;
+        WorldPacketHandlers[i].processing = PROCESS_THREADUNSAFE;
         WorldPacketHandlers[i].handler = nullptr;
     }
 
     loadSpecificHandlers();
+    loadThreadSafeHandlers();
+}
+
+void WorldSession::loadThreadSafeHandlers()
+{
+    // These handlers only read static db data (sMySQLStore, player info) and do not touch
+    // the player or its map. Everything else has to stay PROCESS_THREADUNSAFE!
+    WorldPacketHandlers[CMSG_NAME_QUERY].processing = PROCESS_THREADSAFE;
+    WorldPacketHandlers[CMSG_QUERY_TIME].processing = PROCESS_THREADSAFE;
+    WorldPacketHandlers[CMSG_CREATURE_QUERY].processing = PROCESS_THREADSAFE;
+    WorldPacketHandlers[CMSG_GAMEOBJECT_QUERY].processing = PROCESS_THREADSAFE;
+    WorldPacketHandlers[CMSG_PAGE_TEXT_QUERY].processing = PROCESS_THREADSAFE;
+    WorldPacketHandlers[CMSG_ITEM_NAME_QUERY].processing = PROCESS_THREADSAFE;
+    WorldPacketHandlers[CMSG_ITEM_QUERY_SINGLE].processing = PROCESS_THREADSAFE;
 }
 
 void SessionLog::writefromsession(WorldSession* session, const char* format, ...)
@@ -737,6 +758,20 @@ void WorldSession::SendPacket(StackBufferBase* packet)
     }
 }
 
+void WorldSession::SendSharedPacket(const std::shared_ptr<const WorldPacket>& packet)
+{
+    if (packet->GetOpcode() == 0x0000)
+    {
+        LOG_ERROR("Return, packet 0x0000 is not a valid packet!");
+        return;
+    }
+
+    if (_socket && _socket->IsConnected())
+    {
+        _socket->SendSharedPacket(packet);
+    }
+}
+
 void WorldSession::OutPacket(uint16 opcode)
 {
     if (_socket && _socket->IsConnected())
@@ -756,9 +791,36 @@ void WorldSession::OutPacket(uint16 opcode, uint16 len, const void* data)
 void WorldSession::QueuePacket(WorldPacket* packet)
 {
     m_lastPing = static_cast<uint32>(UNIXTIME);
+
+    // read only queries don't have to wait for the map thread
+    if (packet->GetOpcode() < NUM_MSG_TYPES && WorldPacketHandlers[packet->GetOpcode()].processing == PROCESS_THREADSAFE)
+    {
+        if (sWorld.queueThreadSafePacket(this, packet))
+            return;
+    }
+
     _recvQueue.Push(packet);
 }
 
+void WorldSession::processThreadSafePacket(WorldPacket* packet)
+{
+    OpcodeHandler* handler = &WorldPacketHandlers[packet->GetOpcode()];
+    if (handler->handler == nullptr)
+    {
+        LogDebugFlag(LF_OPCODE, "[Session] Received unhandled packet with opcode %s (0x%.4X)", getOpcodeName(packet->GetOpcode()).c_str(), packet->GetOpcode());
+    }
+    else if (handler->status == STATUS_LOGGEDIN && !_player)
+    {
+        LogDebugFlag(LF_OPCODE, "[Session] Received unexpected/wrong state packet with opcode %s (0x%.4X)", getOpcodeName(packet->GetOpcode()).c_str(), packet->GetOpcode());
+    }
+    else if (!bDeleted)
+    {
+        (this->*handler->handler)(*packet);
+    }
+
+    delete packet;
+}
+
 void WorldSession::Disconnect()
 {
     if (_socket && _socket->IsConnected())
@@ -36,6 +36,8 @@
 #endif
 
 #include <stddef.h>
+#include <atomic>
+#include <memory>
 #include <string>
 
 class Player;
@@ -65,9 +67,17 @@ struct AddonEntry;
 #define WORLDSOCKET_TIMEOUT 120
 #define PLAYER_LOGOUT_DELAY (20 * 1000) // 20 seconds should be more than enough.
 
+// Where a received packet gets handled
+enum PacketProcessing
+{
+    PROCESS_THREADUNSAFE = 0,   // queued and handled by the map thread in WorldSession::Update
+    PROCESS_THREADSAFE,         // read only handlers (static db queries), handled by the world packet worker pool
+};
+
 struct OpcodeHandler
 {
     uint16 status;
+    uint8 processing;
     void (WorldSession::*handler)(WorldPacket& recvPacket);
 };
 
@@ -133,6 +143,9 @@ class SERVER_DECL WorldSession
 
         void SendPacket(StackBufferBase* packet);
 
+        // for broadcasts, every recipient references the same payload
+        void SendSharedPacket(const std::shared_ptr<const WorldPacket>& packet);
+
         void OutPacket(uint16 opcode);
 
         void Delete();
@@ -208,6 +221,10 @@ class SERVER_DECL WorldSession
 
         void QueuePacket(WorldPacket* packet);
 
+        // Called by the world packet worker pool for PROCESS_THREADSAFE opcodes
+        void processThreadSafePacket(WorldPacket* packet);
+        std::atomic<uint32_t> m_pendingThreadSafePackets;
+
         void OutPacket(uint16 opcode, uint16 len, const void* data);
 
         WorldSocket* GetSocket() { return _socket; }
@@ -971,6 +988,7 @@ class SERVER_DECL WorldSession
         const MovementInfo* GetMovementInfo() const { return &movement_info; }
         static void InitPacketHandlerTable();
         static void loadSpecificHandlers();
+        static void loadThreadSafeHandlers();
 
         uint32 floodLines;
         time_t floodTime;
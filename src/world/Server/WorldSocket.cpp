@@ -148,12 +148,8 @@ WorldSocket::WorldSocket(SOCKET fd)
 
 WorldSocket::~WorldSocket()
 {
-    WorldPacket* pck;
     queueLock.Acquire();
-    while ((pck = _queue.Pop()) != nullptr)
-    {
-        delete pck;
-    }
+    _queue.clear();
     queueLock.Release();
 
     delete pAuthenticationPacket;
@@ -211,12 +207,32 @@ void WorldSocket::OutPacket(uint32_t opcode, size_t len, const void* data)
     if (res == OUTPACKET_RESULT_NO_ROOM_IN_BUFFER)
     {
         /* queue the packet */
-        queueLock.Acquire();
-        WorldPacket* packet = new WorldPacket(opcode, len);
+        auto packet = std::make_shared<WorldPacket>(opcode, len);
         if (len)
             packet->append(static_cast<const uint8_t*>(data), len);
 
-        _queue.Push(packet);
+        queueLock.Acquire();
+        _queue.push_back(std::move(packet));
+        queueLock.Release();
+    }
+}
+
+void WorldSocket::SendSharedPacket(const std::shared_ptr<const WorldPacket>& packet)
+{
+    if (!packet)
+        return;
+
+    const size_t len = packet->size();
+    if ((len + 10) > WORLDSOCKET_SENDBUF_SIZE)
+    {
+        LOG_ERROR("WARNING: Tried to send a packet of %u bytes (which is too large) to a socket. Opcode was: %u (0x%03X)", static_cast<unsigned int>(len), static_cast<unsigned int>(packet->GetOpcode()), static_cast<unsigned int>(packet->GetOpcode()));
+        return;
+    }
+
+    if (_OutPacket(packet->GetOpcode(), len, len ? packet->contents() : nullptr) == OUTPACKET_RESULT_NO_ROOM_IN_BUFFER)
+    {
+        queueLock.Acquire();
+        _queue.push_back(packet);
         queueLock.Release();
     }
 }
@@ -224,21 +240,21 @@ void WorldSocket::OutPacket(uint32_t opcode, size_t len, const void* data)
 void WorldSocket::UpdateQueuedPackets()
 {
     queueLock.Acquire();
-    if (!_queue.HasItems())
+    if (_queue.empty())
     {
         queueLock.Release();
         return;
     }
 
-    WorldPacket* pck;
-    while ((pck = _queue.front()) != nullptr)
+    while (!_queue.empty())
     {
+        const WorldPacket* pck = _queue.front().get();
+
         /* try to push out as many as you can */
         switch (_OutPacket(pck->GetOpcode(), pck->size(), pck->size() ? pck->contents() : nullptr))
         {
             case OUTPACKET_RESULT_SUCCESS:
             {
-                delete pck;
                 _queue.pop_front();
             }
             break;
@@ -253,10 +269,7 @@ void WorldSocket::UpdateQueuedPackets()
         default:
             {
                 /* kill everything in the buffer */
-                while ((pck == _queue.Pop()) != 0)
-                {
-                    delete pck;
-                }
+                _queue.clear();
                 queueLock.Release();
                 return;
             }
@@ -22,11 +22,12 @@
 #define WORLDSOCKET_H
 
 #include "StackBuffer.h"
-#include "FastQueue.h"
 #include "Auth/WowCrypt.h"
 #include "WorldPacket.h"
 #include "Network/Network.h"
 
+#include <deque>
+#include <memory>
 #include <string>
 
 #define WORLDSOCKET_SENDBUF_SIZE 131078
@@ -74,6 +75,9 @@ class SERVER_DECL WorldSocket : public Socket
         inline void SendPacket(WorldPacket* packet) { if (!packet) return; OutPacket(packet->GetOpcode(), packet->size(), (packet->size() ? (const void*)packet->contents() : NULL)); }
         inline void SendPacket(StackBufferBase* packet) { if (!packet) return; OutPacket(packet->GetOpcode(), packet->GetSize(), (packet->GetSize() ? (const void*)packet->GetBufferPointer() : NULL)); }
 
+        // The packet may be shared by many sockets. It is copied into the send buffer, a full buffer queues a reference.
+        void SendSharedPacket(const std::shared_ptr<const WorldPacket>& packet);
+
 #if VERSION_STRING != Mop
         void OutPacket(uint16 opcode, size_t len, const void* data);
         OUTPACKET_RESULT _OutPacket(uint16 opcode, size_t len, const void* data);
@@ -116,7 +120,7 @@ class SERVER_DECL WorldSocket : public Socket
 
         WorldSession* mSession;
         WorldPacket* pAuthenticationPacket;
-        FastQueue<WorldPacket*, DummyLock> _queue;
+        std::deque<std::shared_ptr<const WorldPacket>> _queue;
         Mutex queueLock;
 
         WowCrypt _crypt;
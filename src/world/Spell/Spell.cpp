@@ -1106,8 +1106,7 @@ SpellCastResult Spell::canCast(const bool secondCheck, uint32_t* parameter1, uin
                 if (dynamic_cast<Creature*>(target)->IsPickPocketed())
                     return SPELL_FAILED_TARGET_NO_POCKETS;
 
-                const auto itr = sLootMgr.PickpocketingLoot.find(dynamic_cast<Creature*>(target)->getEntry());
-                if (itr == sLootMgr.PickpocketingLoot.end())
+                if (!sLootMgr.IsPickpocketable(dynamic_cast<Creature*>(target)->getEntry()))
                     return SPELL_FAILED_TARGET_NO_POCKETS;
             } break;
 #if VERSION_STRING >= WotLK
@@ -5,8 +5,96 @@ This file is released under the MIT license. See README-MIT for more information
 
 #include "DBCLoader.hpp"
 
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace DBC
 {
+    // 'WDBC' magic, record count, field count, record size, string size
+    const uint32 C_DBC_HEADER_SIZE = 5 * sizeof(uint32);
+
+    bool DBCLoader::s_map_files = false;
+
+    DBCMappedFile::~DBCMappedFile()
+    {
+        if (m_data == nullptr)
+            return;
+
+#ifdef WIN32
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping_handle);
+        CloseHandle(m_file_handle);
+#else
+        munmap(m_data, m_size);
+#endif
+    }
+
+    bool DBCMappedFile::Open(const char* filename)
+    {
+#ifdef WIN32
+        HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < static_cast<LONGLONG>(C_DBC_HEADER_SIZE))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+        if (data == nullptr)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        m_file_handle = file;
+        m_mapping_handle = mapping;
+        m_size = static_cast<size_t>(file_size.QuadPart);
+#else
+        int fd = open(filename, O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < C_DBC_HEADER_SIZE)
+        {
+            close(fd);
+            return false;
+        }
+
+        // private and writable, a store entry written to gets its own copy of the page
+        void* data = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+        // the mapping stays valid without the descriptor
+        close(fd);
+
+        if (data == MAP_FAILED)
+            return false;
+
+        m_size = static_cast<size_t>(file_stat.st_size);
+#endif
+
+        m_data = static_cast<unsigned char*>(data);
+        return true;
+    }
+
     DBCLoader::DBCLoader() : m_record_size(0), m_record_count(0), m_field_count(0), m_string_size(0), m_fields_offset(NULL), m_data(NULL), m_string_table(NULL)
     {
         /* No Body */
@@ -14,7 +102,8 @@ namespace DBC
 
     DBCLoader::~DBCLoader()
     {
-        delete[] m_data;
+        if (!m_mapped_file)
+            delete[] m_data;
         delete[] m_fields_offset;
     }
 
@@ -99,13 +188,50 @@ namespace DBC
 
     bool DBCLoader::Load(const char* dbc_filename, const char* dbc_format)
     {
-        uint32 header;
-        if (m_data)
+        if (m_mapped_file)
+        {
+            m_mapped_file.reset();
+            m_data = NULL;
+        }
+        else if (m_data)
         {
             delete[] m_data;
             m_data = NULL;
         }
 
+        delete[] m_fields_offset;
+        m_fields_offset = NULL;
+
+        if (!(s_map_files ? MapFile(dbc_filename) : ReadFile(dbc_filename)))
+        {
+            return false;
+        }
+
+        m_fields_offset = new uint32[m_field_count];
+        m_fields_offset[0] = 0;
+
+        for (uint32 i = 1; i < m_field_count; ++i)
+        {
+            m_fields_offset[i] = m_fields_offset[i - 1];
+            /* Byte fields */
+            if (dbc_format[i - 1] == 'b' || dbc_format[i - 1] == 'X')
+            {
+                m_fields_offset[i] += sizeof(uint8);
+            }
+            /* 4 byte fields (int32, float, strings) */
+            else
+            {
+                m_fields_offset[i] += sizeof(uint32);
+            }
+        }
+
+        return true;
+    }
+
+    bool DBCLoader::ReadFile(const char* dbc_filename)
+    {
+        uint32 header;
+
         auto file = fopen(dbc_filename, "rb");
         if (!file)
         {
@@ -154,24 +280,6 @@ namespace DBC
             return false;
         }
 
-        m_fields_offset = new uint32[m_field_count];
-        m_fields_offset[0] = 0;
-
-        for (uint32 i = 1; i < m_field_count; ++i)
-        {
-            m_fields_offset[i] = m_fields_offset[i - 1];
-            /* Byte fields */
-            if (dbc_format[i - 1] == 'b' || dbc_format[i - 1] == 'X')
-            {
-                m_fields_offset[i] += sizeof(uint8);
-            }
-            /* 4 byte fields (int32, float, strings) */
-            else
-            {
-                m_fields_offset[i] += sizeof(uint32);
-            }
-        }
-
         m_data = new unsigned char[m_record_size * m_record_count + m_string_size];
         m_string_table = m_data + m_record_size * m_record_count;
 
@@ -185,6 +293,58 @@ namespace DBC
         return true;
     }
 
+    bool DBCLoader::MapFile(const char* dbc_filename)
+    {
+        auto mapped_file = std::make_shared<DBCMappedFile>();
+        if (!mapped_file->Open(dbc_filename))
+        {
+            return false;
+        }
+
+        uint32 header[5];
+        memcpy(header, mapped_file->GetData(), C_DBC_HEADER_SIZE);
+
+        /* 'WDBC' magic string */
+        if (header[0] != 0x43424457)
+        {
+            return false;
+        }
+
+        m_record_count = header[1];
+        m_field_count = header[2];
+        m_record_size = header[3];
+        m_string_size = header[4];
+
+        if (mapped_file->GetSize() < C_DBC_HEADER_SIZE + static_cast<size_t>(m_record_size) * m_record_count + m_string_size)
+        {
+            return false;
+        }
+
+        m_data = mapped_file->GetData() + C_DBC_HEADER_SIZE;
+        m_string_table = m_data + m_record_size * m_record_count;
+        m_mapped_file = mapped_file;
+        return true;
+    }
+
+    bool DBCLoader::HasMappedRecords(const char* dbc_format) const
+    {
+        if (!m_mapped_file)
+        {
+            return false;
+        }
+
+        // only 4 byte fields which are all part of the struct keep the file layout
+        for (uint32 x = 0; dbc_format[x]; ++x)
+        {
+            if (dbc_format[x] != DBC::DbcFieldFormat::FT_INT && dbc_format[x] != DBC::DbcFieldFormat::FT_FLOAT && dbc_format[x] != DBC::DbcFieldFormat::FT_IND)
+            {
+                return false;
+            }
+        }
+
+        return GetFormatRecordSize(dbc_format) == m_record_size;
+    }
+
     char* DBCLoader::AutoProduceData(const char* dbc_format, uint32& record_count, char**& index_table, uint32 sql_record_count, uint32 sql_highest_index, char *& sql_data_table)
     {
         if (strlen(dbc_format) != m_field_count) return NULL;
@@ -221,6 +381,26 @@ namespace DBC
             index_table = new char*[m_record_count + sql_record_count];
         }
 
+        /* Mapped records are indexed in place */
+        if (sql_record_count == 0 && this->HasMappedRecords(dbc_format))
+        {
+            char* mapped_table = reinterpret_cast<char*>(m_data);
+            for (uint32 y = 0; y < m_record_count; ++y)
+            {
+                if (i >= 0)
+                {
+                    index_table[this->GetRecord(y).GetUInt32(i, m_field_count, this->GetOffset(i))] = &mapped_table[y * record_size];
+                }
+                else
+                {
+                    index_table[y] = &mapped_table[y * record_size];
+                }
+            }
+
+            sql_data_table = mapped_table + m_record_count * record_size;
+            return mapped_table;
+        }
+
         char* data_table = new char[(m_record_count + sql_record_count) * record_size];
         uint32 offset = 0;
 
@@ -279,8 +459,13 @@ namespace DBC
     {
         if (strlen(dbc_format) != m_field_count) return NULL;
 
-        char* string_pool = new char[m_string_size];
-        memcpy(string_pool, m_string_table, m_string_size);
+        /* Strings of a mapped file are used in place, their pages are only read in when a string is accessed */
+        char* string_pool = NULL;
+        if (!m_mapped_file)
+        {
+            string_pool = new char[m_string_size];
+            memcpy(string_pool, m_string_table, m_string_size);
+        }
 
         uint32 offset = 0;
 
@@ -307,7 +492,7 @@ namespace DBC
                     if (!*slot || !**slot)
                     {
                         const char* st = this->GetRecord(y).GetString(x, m_field_count, this->GetOffset(x), m_string_size, m_string_table);
-                        *slot = string_pool + (st - (const char*)m_string_table);
+                        *slot = string_pool ? string_pool + (st - (const char*)m_string_table) : const_cast<char*>(st);
                     }
                     offset += sizeof (char*);
                     break;
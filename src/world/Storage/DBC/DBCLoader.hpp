@@ -7,6 +7,8 @@ This file is released under the MIT license. See README-MIT for more information
 
 #include "DBCRecord.hpp"
 
+#include <memory>
+
 namespace DBC
 {
     enum DbcFieldFormat
@@ -24,6 +26,32 @@ namespace DBC
         FT_SQL_ABSENT = 'a'                                       //Used in sql format to mark column absent in sql dbc
     };
 
+    // Copy on write mapping of a DBC file. Pages nobody writes to are shared with every process mapping the file.
+    class DBCMappedFile
+    {
+        public:
+
+            DBCMappedFile() = default;
+            ~DBCMappedFile();
+
+            DBCMappedFile(DBCMappedFile const& right) = delete;
+            DBCMappedFile& operator=(DBCMappedFile const& right) = delete;
+
+            bool Open(const char* filename);
+
+            unsigned char* GetData() const { return m_data; }
+            size_t GetSize() const { return m_size; }
+
+        private:
+
+            unsigned char* m_data = nullptr;
+            size_t m_size = 0;
+#ifdef WIN32
+            void* m_file_handle = nullptr;
+            void* m_mapping_handle = nullptr;
+#endif
+    };
+
     class DBCLoader
     {
         protected:
@@ -36,8 +64,25 @@ namespace DBC
             unsigned char* m_data;
             unsigned char* m_string_table;
 
+            // set when the file is mapped instead of read into m_data
+            std::shared_ptr<DBCMappedFile> m_mapped_file;
+
+            static bool s_map_files;
+
+            bool ReadFile(const char* dbc_filename);
+            bool MapFile(const char* dbc_filename);
+
         public:
 
+            // maps the DBC files instead of reading them, must be set before the stores are loaded
+            static void SetMapFiles(bool map_files) { s_map_files = map_files; }
+
+            // the file stays mapped as long as a store holds this, records and strings of a mapped file point into it
+            std::shared_ptr<DBCMappedFile> GetMappedFile() const { return m_mapped_file; }
+
+            // true if the format matches the file records byte by byte, the records are used in place then
+            bool HasMappedRecords(const char* dbc_format) const;
+
             DBC::DBCRecord GetRecord(size_t record_id) const;
             uint32 GetNumRows() const;
             uint32 GetRowSize() const;
@@ -10,16 +10,19 @@ This file is released under the MIT license. See README-MIT for more information
 #include "DBCLoader.hpp"
 #include "Database/Field.h"
 
+#include <memory>
+
 namespace DBC
 {
     template <class T>
     class DBCStorage
     {
         typedef std::list<char*> StringPoolList;
+        typedef std::list<std::shared_ptr<DBC::DBCMappedFile>> MappedFileList;
 
         public:
 
-            DBCStorage(char const* f) : m_format(f), m_row_count(0), m_field_count(0), m_data_table(NULL)
+            DBCStorage(char const* f) : m_format(f), m_row_count(0), m_field_count(0), m_data_table(NULL), m_data_table_mapped(false)
             {
                 m_index_table.as_t = NULL;
             }
@@ -83,9 +86,12 @@ namespace DBC
                 char* sql_data_table = NULL;
                 m_field_count = dbc_loader.GetNumColumns();
 
+                m_data_table_mapped = sql_record_count == 0 && dbc_loader.HasMappedRecords(m_format);
                 m_data_table = reinterpret_cast<T*>(dbc_loader.AutoProduceData(m_format, m_row_count, m_index_table.as_char, sql_record_count, sql_highest_index, sql_data_table));
 
                 m_string_pool_list.push_back(dbc_loader.AutoProduceStrings(m_format, reinterpret_cast<char*>(m_data_table)));
+                if (auto mapped_file = dbc_loader.GetMappedFile())
+                    m_mapped_file_list.push_back(mapped_file);
 
                 /*if (result)
                 {
@@ -105,6 +111,8 @@ namespace DBC
                 if (!dbc_loader.Load(dbc_filename, m_format)) return false;
 
                 m_string_pool_list.push_back(dbc_loader.AutoProduceStrings(m_format, reinterpret_cast<char*>(m_data_table)));
+                if (auto mapped_file = dbc_loader.GetMappedFile())
+                    m_mapped_file_list.push_back(mapped_file);
                 return true;
             }
 
@@ -114,8 +122,10 @@ namespace DBC
 
                 delete[] reinterpret_cast<char*>(m_index_table.as_t);
                 m_index_table.as_t = NULL;
-                delete[] reinterpret_cast<char*>(m_data_table);
+                if (!m_data_table_mapped)
+                    delete[] reinterpret_cast<char*>(m_data_table);
                 m_data_table = NULL;
+                m_data_table_mapped = false;
 
                 while (!m_string_pool_list.empty())
                 {
@@ -123,6 +133,9 @@ namespace DBC
                     m_string_pool_list.pop_front();
                 }
 
+                // records and strings of mapped files are gone now
+                m_mapped_file_list.clear();
+
                 m_row_count = 0;
             }
 
@@ -139,7 +152,9 @@ namespace DBC
             } m_index_table;
 
             T* m_data_table;
+            bool m_data_table_mapped;
             StringPoolList m_string_pool_list;
+            MappedFileList m_mapped_file_list;
 
             DBCStorage(DBCStorage const& right) = delete;
             DBCStorage& operator=(DBCStorage const& right) = delete;
@@ -5,6 +5,8 @@ This file is released under the MIT license. See README-MIT for more information
 
 #include "StdAfx.h"
 #include "Storage/MySQLDataStore.hpp"
+#include "Management/WordFilter.h"
+#include "Storage/WorldDatabaseSnapshot.h"
 #include "Server/MainServerDefines.h"
 #include "Config/Config.h"
 #include "Spell/SpellMgr.h"
@@ -124,7 +126,7 @@ void MySQLDataStore::loadItemPagesTable()
 {
     auto startTime = Util::TimeNow();
 
-    QueryResult* itempages_result = WorldDatabase.Query("SELECT entry, text, next_page FROM item_pages");
+    QueryResult* itempages_result = sWorldDatabaseSnapshot.query("SELECT entry, text, next_page FROM item_pages");
     if (itempages_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `item_pages` is empty!");
@@ -177,7 +179,7 @@ void MySQLDataStore::loadItemPropertiesTable()
     for (tableiterator = ItemPropertiesTables.begin(); tableiterator != ItemPropertiesTables.end(); ++tableiterator)
     {
         std::string table_name = *tableiterator;
-        QueryResult* item_result = WorldDatabase.Query("SELECT * FROM %s base "
+        QueryResult* item_result = sWorldDatabaseSnapshot.query("SELECT * FROM %s base "
             "WHERE build=(SELECT MAX(build) FROM %s spec WHERE base.entry = spec.entry AND build <= %u)", table_name.c_str(), table_name.c_str(), VERSION_STRING);
 
         //                                                         0      1       2        3       4        5         6       7       8       9          10
@@ -564,7 +566,7 @@ void MySQLDataStore::loadCreaturePropertiesTable()
     {
         std::string table_name = *tableiterator;
         //                                                                      0          1           2             3                 4               5                  6
-        QueryResult* creature_properties_result = WorldDatabase.Query("SELECT entry, killcredit1, killcredit2, male_displayid, female_displayid, male_displayid2, female_displayid2, "
+        QueryResult* creature_properties_result = sWorldDatabaseSnapshot.query("SELECT entry, killcredit1, killcredit2, male_displayid, female_displayid, male_displayid2, female_displayid2, "
         //                                                         7      8         9         10       11     12     13       14            15              16           17
                                                                 "name, subname, info_str, type_flags, type, family, `rank`, encounter, base_attack_mod, range_attack_mod, leader, "
         //                                                          18        19        20        21         22      23     24      25          26           27
@@ -860,7 +862,7 @@ void MySQLDataStore::loadGameObjectPropertiesTable()
     {
         std::string table_name = *tableiterator;
         //                                                                        0       1        2        3         4              5          6          7            8             9
-        QueryResult* gameobject_properties_result = WorldDatabase.Query("SELECT entry, type, display_id, name, category_name, cast_bar_text, UnkStr, parameter_0, parameter_1, parameter_2, "
+        QueryResult* gameobject_properties_result = sWorldDatabaseSnapshot.query("SELECT entry, type, display_id, name, category_name, cast_bar_text, UnkStr, parameter_0, parameter_1, parameter_2, "
         //                                                                10           11          12           13           14            15           16           17           18
                                                                     "parameter_3, parameter_4, parameter_5, parameter_6, parameter_7, parameter_8, parameter_9, parameter_10, parameter_11, "
         //                                                                19            20            21            22           23            24            25            26
@@ -990,7 +992,7 @@ void MySQLDataStore::loadQuestPropertiesTable()
     {
         std::string table_name = *tableiterator;
         //                                                        0       1     2      3       4          5        6          7              8                 9
-        QueryResult* quest_result = WorldDatabase.Query("SELECT entry, ZoneId, sort, flags, MinLevel, questlevel, Type, RequiredRaces, RequiredClass, RequiredTradeskill, "
+        QueryResult* quest_result = sWorldDatabaseSnapshot.query("SELECT entry, ZoneId, sort, flags, MinLevel, questlevel, Type, RequiredRaces, RequiredClass, RequiredTradeskill, "
         //                                                          10                    11                 12             13          14            15           16         17
                                                         "RequiredTradeskillValue, RequiredRepFaction, RequiredRepValue, LimitTime, SpecialFlags, PrevQuestId, NextQuestId, srcItem, "
         //                                                     18        19     20         21            22              23          24          25               26
@@ -1246,7 +1248,7 @@ void MySQLDataStore::loadGameObjectQuestItemBindingTable()
     auto startTime = Util::TimeNow();
 
     //                                                                        0      1     2        3
-    QueryResult* gameobject_quest_item_result = WorldDatabase.Query("SELECT entry, quest, item, item_count FROM gameobject_quest_item_binding");
+    QueryResult* gameobject_quest_item_result = sWorldDatabaseSnapshot.query("SELECT entry, quest, item, item_count FROM gameobject_quest_item_binding");
 
     uint32_t gameobject_quest_item_count = 0;
 
@@ -1290,7 +1292,7 @@ void MySQLDataStore::loadGameObjectQuestPickupBindingTable()
     auto startTime = Util::TimeNow();
 
     //                                                                          0      1           2
-    QueryResult* gameobject_quest_pickup_result = WorldDatabase.Query("SELECT entry, quest, required_count FROM gameobject_quest_pickup_binding");
+    QueryResult* gameobject_quest_pickup_result = sWorldDatabaseSnapshot.query("SELECT entry, quest, required_count FROM gameobject_quest_pickup_binding");
 
     uint32_t gameobject_quest_pickup_count = 0;
 
@@ -1336,7 +1338,7 @@ void MySQLDataStore::loadCreatureDifficultyTable()
     auto startTime = Util::TimeNow();
 
     //                                                                         0          1            2             3
-    QueryResult* creature_difficulty_result = WorldDatabase.Query("SELECT entry, difficulty_1, difficulty_2, difficulty_3 FROM creature_difficulty");
+    QueryResult* creature_difficulty_result = sWorldDatabaseSnapshot.query("SELECT entry, difficulty_1, difficulty_2, difficulty_3 FROM creature_difficulty");
 
     if (creature_difficulty_result == nullptr)
     {
@@ -1409,7 +1411,7 @@ void MySQLDataStore::loadDisplayBoundingBoxesTable()
 
     //                                                                            0       1    2     3      4      5      6         7
     //QueryResult* display_bounding_boxes_result = WorldDatabase.Query("SELECT displayid, lowx, lowy, lowz, highx, highy, highz, boundradius FROM display_bounding_boxes");
-    QueryResult* display_bounding_boxes_result = WorldDatabase.Query("SELECT displayid, highz FROM display_bounding_boxes");
+    QueryResult* display_bounding_boxes_result = sWorldDatabaseSnapshot.query("SELECT displayid, highz FROM display_bounding_boxes");
 
     if (display_bounding_boxes_result == nullptr)
     {
@@ -1466,7 +1468,7 @@ void MySQLDataStore::loadVendorRestrictionsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                      0       1          2            3              4
-    QueryResult* vendor_restricitons_result = WorldDatabase.Query("SELECT entry, racemask, classmask, reqrepfaction, reqrepfactionvalue, "
+    QueryResult* vendor_restricitons_result = sWorldDatabaseSnapshot.query("SELECT entry, racemask, classmask, reqrepfaction, reqrepfactionvalue, "
     //                                                                    5                 6           7
                                                                   "canbuyattextid, cannotbuyattextid, flags FROM vendor_restrictions");
 
@@ -1520,7 +1522,7 @@ void MySQLDataStore::loadNpcTextTable()
     auto startTime = Util::TimeNow();
 
     //                                                           0
-    QueryResult* npc_text_result = WorldDatabase.Query("SELECT entry, "
+    QueryResult* npc_text_result = sWorldDatabaseSnapshot.query("SELECT entry, "
     //                                                     1       2        3       4          5           6            7           8            9           10
                                                         "prob0, text0_0, text0_1, lang0, EmoteDelay0_0, Emote0_0, EmoteDelay0_1, Emote0_1, EmoteDelay0_2, Emote0_2, "
     //                                                     11      12       13      14         15          16           17          18           19          20
@@ -1601,7 +1603,7 @@ void MySQLDataStore::loadNpcScriptTextTable()
     auto startTime = Util::TimeNow();
 
     //                                                                  0      1           2       3     4       5          6         7       8        9         10
-    QueryResult* npc_script_text_result = WorldDatabase.Query("SELECT entry, text, creature_entry, id, type, language, probability, emote, duration, sound, broadcast_id FROM npc_script_text");
+    QueryResult* npc_script_text_result = sWorldDatabaseSnapshot.query("SELECT entry, text, creature_entry, id, type, language, probability, emote, duration, sound, broadcast_id FROM npc_script_text");
 
     if (npc_script_text_result == nullptr)
     {
@@ -1656,7 +1658,7 @@ void MySQLDataStore::loadGossipMenuOptionTable()
     auto startTime = Util::TimeNow();
 
     //                                                                      0         1
-    QueryResult* gossip_menu_optiont_result = WorldDatabase.Query("SELECT entry, option_text FROM gossip_menu_option");
+    QueryResult* gossip_menu_optiont_result = sWorldDatabaseSnapshot.query("SELECT entry, option_text FROM gossip_menu_option");
 
     if (gossip_menu_optiont_result == nullptr)
     {
@@ -1702,7 +1704,7 @@ void MySQLDataStore::loadGraveyardsTable()
     auto startTime = Util::TimeNow();
 
     //                                                            0         1         2           3            4         5          6           7       8
-    QueryResult* graveyards_result = WorldDatabase.Query("SELECT id, position_x, position_y, position_z, orientation, zoneid, adjacentzoneid, mapid, faction FROM graveyards");
+    QueryResult* graveyards_result = sWorldDatabaseSnapshot.query("SELECT id, position_x, position_y, position_z, orientation, zoneid, adjacentzoneid, mapid, faction FROM graveyards");
     if (graveyards_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `graveyards` is empty!");
@@ -1754,7 +1756,7 @@ void MySQLDataStore::loadTeleportCoordsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                0     1         2           3           4
-    QueryResult* teleport_coords_result = WorldDatabase.Query("SELECT id, mapId, position_x, position_y, position_z FROM spell_teleport_coords");
+    QueryResult* teleport_coords_result = sWorldDatabaseSnapshot.query("SELECT id, mapId, position_x, position_y, position_z FROM spell_teleport_coords");
     if (teleport_coords_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `spell_teleport_coords` is empty!");
@@ -1802,7 +1804,7 @@ void MySQLDataStore::loadFishingTable()
     auto startTime = Util::TimeNow();
 
     //                                                          0      1         2
-    QueryResult* fishing_result = WorldDatabase.Query("SELECT zone, MinSkill, MaxSkill FROM fishing");
+    QueryResult* fishing_result = sWorldDatabaseSnapshot.query("SELECT zone, MinSkill, MaxSkill FROM fishing");
     if (fishing_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `fishing` is empty!");
@@ -1848,7 +1850,7 @@ void MySQLDataStore::loadWorldMapInfoTable()
     auto startTime = Util::TimeNow();
 
     //                                                                0        1       2       3           4             5          6        7      8          9
-    QueryResult* worldmap_info_result = WorldDatabase.Query("SELECT entry, screenid, type, maxplayers, minlevel, minlevel_heroic, repopx, repopy, repopz, repopentry, "
+    QueryResult* worldmap_info_result = sWorldDatabaseSnapshot.query("SELECT entry, screenid, type, maxplayers, minlevel, minlevel_heroic, repopx, repopy, repopz, repopentry, "
     //                                                           10       11      12         13           14                15              16
                                                             "area_name, flags, cooldown, lvl_mod_a, required_quest_A, required_quest_H, required_item, "
     //                                                              17              18              19                20
@@ -1917,7 +1919,7 @@ void MySQLDataStore::loadZoneGuardsTable()
     auto startTime = Util::TimeNow();
 
     //                                                             0         1              2
-    QueryResult* zone_guards_result = WorldDatabase.Query("SELECT zone, horde_entry, alliance_entry FROM zoneguards");
+    QueryResult* zone_guards_result = sWorldDatabaseSnapshot.query("SELECT zone, horde_entry, alliance_entry FROM zoneguards");
     if (zone_guards_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `zoneguards` is empty!");
@@ -1963,7 +1965,7 @@ void MySQLDataStore::loadBattleMastersTable()
     auto startTime = Util::TimeNow();
 
     //                                                                      0                1
-    QueryResult* battlemasters_result = WorldDatabase.Query("SELECT creature_entry, battleground_id FROM battlemasters");
+    QueryResult* battlemasters_result = sWorldDatabaseSnapshot.query("SELECT creature_entry, battleground_id FROM battlemasters");
     if (battlemasters_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `battlemasters` is empty!");
@@ -2010,7 +2012,7 @@ void MySQLDataStore::loadTotemDisplayIdsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                  0     1        2
-    QueryResult* totemdisplayids_result = WorldDatabase.Query("SELECT race, totem, displayid FROM totemdisplayids base "
+    QueryResult* totemdisplayids_result = sWorldDatabaseSnapshot.query("SELECT race, totem, displayid FROM totemdisplayids base "
         "WHERE build=(SELECT MAX(build) FROM totemdisplayids spec WHERE base.race = spec.race AND base.totem = spec.totem AND build <= %u)", VERSION_STRING);
 
     if (totemdisplayids_result == nullptr)
@@ -2057,7 +2059,7 @@ void MySQLDataStore::loadSpellClickSpellsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                      0         1
-    QueryResult* spellclickspells_result = WorldDatabase.Query("SELECT CreatureID, SpellID FROM spellclickspells");
+    QueryResult* spellclickspells_result = sWorldDatabaseSnapshot.query("SELECT CreatureID, SpellID FROM spellclickspells");
     if (spellclickspells_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `spellclickspells` is empty!");
@@ -2102,7 +2104,7 @@ void MySQLDataStore::loadWorldStringsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                     0     1
-    QueryResult* worldstring_tables_result = WorldDatabase.Query("SELECT entry, text FROM worldstring_tables");
+    QueryResult* worldstring_tables_result = sWorldDatabaseSnapshot.query("SELECT entry, text FROM worldstring_tables");
     if (worldstring_tables_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `worldstring_tables` is empty!");
@@ -2147,7 +2149,7 @@ void MySQLDataStore::loadPointsOfInterestTable()
     auto startTime = Util::TimeNow();
 
     //                                                                      0   1  2    3     4     5        6
-    QueryResult* points_of_interest_result = WorldDatabase.Query("SELECT entry, x, y, icon, flags, data, icon_name FROM points_of_interest");
+    QueryResult* points_of_interest_result = sWorldDatabaseSnapshot.query("SELECT entry, x, y, icon, flags, data, icon_name FROM points_of_interest");
     if (points_of_interest_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `points_of_interest` is empty!");
@@ -2197,7 +2199,7 @@ void MySQLDataStore::loadItemSetLinkedSetBonusTable()
     auto startTime = Util::TimeNow();
 
     //                                                                    0            1
-    QueryResult* linked_set_bonus_result = WorldDatabase.Query("SELECT itemset, itemset_bonus FROM itemset_linked_itemsetbonus");
+    QueryResult* linked_set_bonus_result = sWorldDatabaseSnapshot.query("SELECT itemset, itemset_bonus FROM itemset_linked_itemsetbonus");
     if (linked_set_bonus_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `itemset_linked_itemsetbonus` is empty!");
@@ -2247,7 +2249,7 @@ void MySQLDataStore::loadCreatureInitialEquipmentTable()
     auto startTime = Util::TimeNow();
 
     //                                                                        0              1           2          3
-    QueryResult* initial_equipment_result = WorldDatabase.Query("SELECT creature_entry, itemslot_1, itemslot_2, itemslot_3 FROM creature_initial_equip;");
+    QueryResult* initial_equipment_result = sWorldDatabaseSnapshot.query("SELECT creature_entry, itemslot_1, itemslot_2, itemslot_3 FROM creature_initial_equip;");
     if (initial_equipment_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `creature_initial_equip` is empty!");
@@ -2286,7 +2288,7 @@ void MySQLDataStore::loadPlayerCreateInfoTable()
     auto startTime = Util::TimeNow();
 
     //                                                                     0       1      2       3      4       5          6          7           8
-    QueryResult* player_create_info_result = WorldDatabase.Query("SELECT `Index`, race, class, mapID, zoneID, positionX, positionY, positionZ, orientation, "
+    QueryResult* player_create_info_result = sWorldDatabaseSnapshot.query("SELECT `Index`, race, class, mapID, zoneID, positionX, positionY, positionZ, orientation, "
     //                                                                9            10           11           12           13           14         15        16        17
                                                                 "BaseStrength, BaseAgility, BaseStamina, BaseIntellect, BaseSpirit, BaseHealth, BaseMana, BaseRage, BaseFocus, "
     //                                                                18         19         20      21       22
@@ -2353,7 +2355,7 @@ void MySQLDataStore::loadPlayerCreateInfoSkillsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                              0       1       2        3
-    QueryResult* player_create_info_skills_result = WorldDatabase.Query("SELECT Indexid, skillid, level, maxlevel FROM playercreateinfo_skills "
+    QueryResult* player_create_info_skills_result = sWorldDatabaseSnapshot.query("SELECT Indexid, skillid, level, maxlevel FROM playercreateinfo_skills "
                                                                         "WHERE build = %u", VERSION_STRING);
 
     if (player_create_info_skills_result == nullptr)
@@ -2402,7 +2404,7 @@ void MySQLDataStore::loadPlayerCreateInfoSpellsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                            0       1
-    QueryResult* player_create_info_spells_result = WorldDatabase.Query("SELECT indexid, spellid FROM playercreateinfo_spells WHERE build = %u", VERSION_STRING);
+    QueryResult* player_create_info_spells_result = sWorldDatabaseSnapshot.query("SELECT indexid, spellid FROM playercreateinfo_spells WHERE build = %u", VERSION_STRING);
 
     if (player_create_info_spells_result == nullptr)
     {
@@ -2445,7 +2447,7 @@ void MySQLDataStore::loadPlayerCreateInfoItemsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                            0        1       2        3
-    QueryResult* player_create_info_items_result = WorldDatabase.Query("SELECT indexid, protoid, slotid, amount FROM playercreateinfo_items WHERE build = %u", VERSION_STRING);
+    QueryResult* player_create_info_items_result = sWorldDatabaseSnapshot.query("SELECT indexid, protoid, slotid, amount FROM playercreateinfo_items WHERE build = %u", VERSION_STRING);
 
     if (player_create_info_items_result == nullptr)
     {
@@ -2497,7 +2499,7 @@ void MySQLDataStore::loadPlayerCreateInfoBarsTable(uint32_t player_info_index)
     PlayerCreateInfo& playerCreateInfo = _playerCreateInfoStore[player_info_index];
 
     //                                                                          0     1      2        3      4     5
-    QueryResult* player_create_info_bars_result = WorldDatabase.Query("SELECT race, class, button, action, type, misc FROM playercreateinfo_bars "
+    QueryResult* player_create_info_bars_result = sWorldDatabaseSnapshot.query("SELECT race, class, button, action, type, misc FROM playercreateinfo_bars "
                                                                       "WHERE build = %u AND class = %u", VERSION_STRING, uint32_t(playerCreateInfo.class_));
 
     if (player_create_info_bars_result == nullptr)
@@ -2550,7 +2552,7 @@ void MySQLDataStore::loadPlayerXpToLevelTable()
     for (uint32_t level = 0; level < worldConfig.player.playerLevelCap; ++level)
         _playerXPperLevelStore[level] = 0;
 
-    QueryResult* player_xp_to_level_result = WorldDatabase.Query("SELECT player_lvl, next_lvl_req_xp FROM player_xp_for_level base "
+    QueryResult* player_xp_to_level_result = sWorldDatabaseSnapshot.query("SELECT player_lvl, next_lvl_req_xp FROM player_xp_for_level base "
         "WHERE build=(SELECT MAX(build) FROM player_xp_for_level spec WHERE base.player_lvl = spec.player_lvl AND build <= %u)", VERSION_STRING);
 
     if (player_xp_to_level_result == nullptr)
@@ -2600,7 +2602,7 @@ uint32_t MySQLDataStore::getPlayerXPForLevel(uint32_t level)
 
 void MySQLDataStore::loadSpellOverrideTable()
 {
-    QueryResult* spelloverride_result = WorldDatabase.Query("SELECT DISTINCT overrideId FROM spelloverride");
+    QueryResult* spelloverride_result = sWorldDatabaseSnapshot.query("SELECT DISTINCT overrideId FROM spelloverride");
     if (spelloverride_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `spelloverride` is empty!");
@@ -2612,7 +2614,7 @@ void MySQLDataStore::loadSpellOverrideTable()
         Field* fields = spelloverride_result->Fetch();
         uint32_t distinct_override_id = fields[0].GetUInt32();
 
-        QueryResult* spellid_for_overrideid_result = WorldDatabase.Query("SELECT spellId FROM spelloverride WHERE overrideId = %u", distinct_override_id);
+        QueryResult* spellid_for_overrideid_result = sWorldDatabaseSnapshot.query("SELECT spellId FROM spelloverride WHERE overrideId = %u", distinct_override_id);
         std::list<SpellInfo const*>* list = new std::list <SpellInfo const*>;
         if (spellid_for_overrideid_result != nullptr)
         {
@@ -2654,7 +2656,7 @@ void MySQLDataStore::loadNpcGossipTextIdTable()
 {
     auto startTime = Util::TimeNow();
     //                                                    0         1
-    QueryResult* npc_gossip_textid_result = WorldDatabase.Query("SELECT creatureid, textid FROM npc_gossip_textid");
+    QueryResult* npc_gossip_textid_result = sWorldDatabaseSnapshot.query("SELECT creatureid, textid FROM npc_gossip_textid");
     if (npc_gossip_textid_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `npc_gossip_textid` is empty!");
@@ -2697,7 +2699,7 @@ void MySQLDataStore::loadPetLevelAbilitiesTable()
 {
     auto startTime = Util::TimeNow();
     //                                                                      0       1      2        3        4        5         6         7
-    QueryResult* pet_level_abilities_result = WorldDatabase.Query("SELECT level, health, armor, strength, agility, stamina, intellect, spirit FROM pet_level_abilities");
+    QueryResult* pet_level_abilities_result = sWorldDatabaseSnapshot.query("SELECT level, health, armor, strength, agility, stamina, intellect, spirit FROM pet_level_abilities");
     if (pet_level_abilities_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `pet_level_abilities` is empty!");
@@ -2751,7 +2753,7 @@ void MySQLDataStore::loadBroadcastTable()
 {
     auto startTime = Util::TimeNow();
 
-    QueryResult* broadcast_result = WorldDatabase.Query("SELECT * FROM worldbroadcast");
+    QueryResult* broadcast_result = sWorldDatabaseSnapshot.query("SELECT * FROM worldbroadcast");
     if (broadcast_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `worldbroadcast` is empty!");
@@ -2802,7 +2804,7 @@ void MySQLDataStore::loadAreaTriggerTable()
 {
     auto startTime = Util::TimeNow();
     //                                                               0      1    2     3       4       5           6          7             8               9                  10
-    QueryResult* area_trigger_result = WorldDatabase.Query("SELECT entry, type, map, screen, name, position_x, position_y, position_z, orientation, required_honor_rank, required_level FROM areatriggers");
+    QueryResult* area_trigger_result = sWorldDatabaseSnapshot.query("SELECT entry, type, map, screen, name, position_x, position_y, position_z, orientation, required_honor_rank, required_level FROM areatriggers");
     if (area_trigger_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `areatriggers` is empty!");
@@ -2888,7 +2890,7 @@ void MySQLDataStore::loadWordFilterCharacterNames()
 {
     auto startTime = Util::TimeNow();
 
-    QueryResult* filter_character_names_result = WorldDatabase.Query("SELECT * FROM wordfilter_character_names");
+    QueryResult* filter_character_names_result = sWorldDatabaseSnapshot.query("SELECT * FROM wordfilter_character_names");
     if (filter_character_names_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `wordfilter_character_names` is empty!");
@@ -2942,7 +2944,7 @@ void MySQLDataStore::loadWordFilterChat()
 {
     auto startTime = Util::TimeNow();
 
-    QueryResult* filter_chat_result = WorldDatabase.Query("SELECT * FROM wordfilter_chat");
+    QueryResult* filter_chat_result = sWorldDatabaseSnapshot.query("SELECT * FROM wordfilter_chat");
     if (filter_chat_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `wordfilter_chat` is empty!");
@@ -2979,13 +2981,17 @@ void MySQLDataStore::loadWordFilterChat()
     delete filter_chat_result;
 
     LogDetail("MySQLDataLoads : Loaded %u rows from `wordfilter_chat` table in %u ms!", filter_chat_count, static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
+
+    // on a reload chat switches to the new words
+    if (g_chatFilter != nullptr)
+        g_chatFilter->compile();
 }
 
 void MySQLDataStore::loadCreatureFormationsTable()
 {
     auto startTime = Util::TimeNow();
     //                                                                       0              1              2            3
-    QueryResult* creature_formations_result = WorldDatabase.Query("SELECT spawn_id, target_spawn_id, follow_angle, follow_dist FROM creature_formations");
+    QueryResult* creature_formations_result = sWorldDatabaseSnapshot.query("SELECT spawn_id, target_spawn_id, follow_angle, follow_dist FROM creature_formations");
     if (creature_formations_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `creature_formations` is empty!");
@@ -3002,7 +3008,7 @@ void MySQLDataStore::loadCreatureFormationsTable()
         Field* fields = creature_formations_result->Fetch();
 
         uint32_t spawnId = fields[0].GetInt32();
-        QueryResult* spawn_result = WorldDatabase.Query("SELECT id FROM creature_spawns WHERE id = %u AND min_build <= %u AND max_build >= %u;", spawnId, VERSION_STRING, VERSION_STRING);
+        QueryResult* spawn_result = sWorldDatabaseSnapshot.query("SELECT id FROM creature_spawns WHERE id = %u AND min_build <= %u AND max_build >= %u;", spawnId, VERSION_STRING, VERSION_STRING);
         if (spawn_result == nullptr)
         {
             LogError("Table `creature_formations` includes formation data for invalid spawn id %u. Skipped!", spawnId);
@@ -3039,7 +3045,7 @@ void MySQLDataStore::loadLocalesCreature()
 {
     auto startTime = Util::TimeNow();
     //                                                0         1          2      3
-    QueryResult* result = WorldDatabase.Query("SELECT id, language_code, name, subname FROM locales_creature");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT id, language_code, name, subname FROM locales_creature");
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `locales_creature` is empty!");
@@ -3093,7 +3099,7 @@ void MySQLDataStore::loadLocalesGameobject()
 {
     auto startTime = Util::TimeNow();
     //                                                  0         1          2
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, name FROM locales_gameobject");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, name FROM locales_gameobject");
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `locales_gameobject` is empty!");
@@ -3146,7 +3152,7 @@ void MySQLDataStore::loadLocalesGossipMenuOption()
 {
     auto startTime = Util::TimeNow();
     //                                                   0         1             2
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, option_text FROM locales_gossip_menu_option");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, option_text FROM locales_gossip_menu_option");
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `locales_gossip_menu_option` is empty!");
@@ -3199,7 +3205,7 @@ void MySQLDataStore::loadLocalesItem()
 {
     auto startTime = Util::TimeNow();
     //                                                  0         1          2         3
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, name, description FROM locales_item");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, name, description FROM locales_item");
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `locales_item` is empty!");
@@ -3253,7 +3259,7 @@ void MySQLDataStore::loadLocalesItemPages()
 {
     auto startTime = Util::TimeNow();
     //                                                 0         1           2
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, text FROM locales_item_pages");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, text FROM locales_item_pages");
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `locales_item_pages` is empty!");
@@ -3306,7 +3312,7 @@ void MySQLDataStore::loadLocalesNPCMonstersay()
 {
     auto startTime = Util::TimeNow();
     //                                                                   0      1          2            3         4      5      6      7      8
-    QueryResult* local_monstersay_result = WorldDatabase.Query("SELECT entry, type, language_code, monstername, text0, text1, text2, text3, text4 FROM locales_npc_monstersay");
+    QueryResult* local_monstersay_result = sWorldDatabaseSnapshot.query("SELECT entry, type, language_code, monstername, text0, text1, text2, text3, text4 FROM locales_npc_monstersay");
     if (local_monstersay_result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `locales_npc_monstersay` is empty!");
@@ -3368,7 +3374,7 @@ void MySQLDataStore::loadLocalesNpcScriptText()
 {
     auto startTime = Util::TimeNow();
     //                                                  0         1          2
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, text FROM locales_npc_script_text");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, text FROM locales_npc_script_text");
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `locales_npc_script_text` is empty!");
@@ -3421,7 +3427,7 @@ void MySQLDataStore::loadLocalesNpcText()
 {
     auto startTime = Util::TimeNow();
     //                                                  0         1           2       3       4       5       6       7       8       9       10      11     12      13      14      15      16      17
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, text0, text0_1, text1, text1_1, text2, text2_1, text3, text3_1, text4, text4_1, text5, text5_1, text6, text6_1, text7, text7_1 FROM locales_npc_text");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, text0, text0_1, text1, text1_1, text2, text2_1, text3, text3_1, text4, text4_1, text5, text5_1, text6, text6_1, text7, text7_1 FROM locales_npc_text");
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `locales_npc_text` is empty!");
@@ -3479,7 +3485,7 @@ void MySQLDataStore::loadLocalesQuest()
 {
     auto startTime = Util::TimeNow();
     //                                                  0         1           2       3         4            5                 6           7           8                9              10             11
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, Title, Details, Objectives, CompletionText, IncompleteText, EndText, ObjectiveText1, ObjectiveText2, ObjectiveText3, ObjectiveText4 FROM locales_quest");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, Title, Details, Objectives, CompletionText, IncompleteText, EndText, ObjectiveText1, ObjectiveText2, ObjectiveText3, ObjectiveText4 FROM locales_quest");
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `locales_quest` is empty!");
@@ -3541,7 +3547,7 @@ void MySQLDataStore::loadLocalesWorldbroadcast()
 {
     auto startTime = Util::TimeNow();
     //                                                  0         1          2
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, text FROM locales_worldbroadcast");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, text FROM locales_worldbroadcast");
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `locales_worldbroadcast` is empty!");
@@ -3594,7 +3600,7 @@ void MySQLDataStore::loadLocalesWorldmapInfo()
 {
     auto startTime = Util::TimeNow();
     //                                                  0           1         2
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, text FROM locales_worldmap_info");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, text FROM locales_worldmap_info");
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `locales_worldmap_info` is empty!");
@@ -3647,7 +3653,7 @@ void MySQLDataStore::loadLocalesWorldStringTable()
 {
     auto startTime = Util::TimeNow();
     //                                                  0           1         2
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, text FROM locales_worldstring_table");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, text FROM locales_worldstring_table");
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `locales_worldstring_table` is empty!");
@@ -3730,7 +3736,7 @@ void MySQLDataStore::loadNpcMonstersayTable()
 {
     auto startTime = Util::TimeNow();
     //                                                  0      1       2        3       4       5          6      7      8      9     10
-    QueryResult* result = WorldDatabase.Query("SELECT entry, event, chance, language, type, monstername, text0, text1, text2, text3, text4 FROM npc_monstersay");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, event, chance, language, type, monstername, text0, text1, text2, text3, text4 FROM npc_monstersay");
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `npc_monstersay` is empty!");
@@ -3886,7 +3892,7 @@ void MySQLDataStore::loadProfessionDiscoveriesTable()
 {
     auto startTime = Util::TimeNow();
     //                                                   0           1              2          3
-    QueryResult* result = WorldDatabase.Query("SELECT SpellId, SpellToDiscover, SkillValue, Chance FROM professiondiscoveries");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT SpellId, SpellToDiscover, SkillValue, Chance FROM professiondiscoveries");
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `professiondiscoveries` is empty!");
@@ -3922,7 +3928,7 @@ void MySQLDataStore::loadTransportCreaturesTable()
 {
     auto startTime = Util::TimeNow();
     //                                                  0       1        2            3             4              5            6              7         8
-    QueryResult* result = WorldDatabase.Query("SELECT guid, npc_entry, build, transport_entry, TransOffsetX, TransOffsetY, TransOffsetZ, TransOffsetO, emote FROM transport_creatures "
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT guid, npc_entry, build, transport_entry, TransOffsetX, TransOffsetY, TransOffsetZ, TransOffsetO, emote FROM transport_creatures "
                                               "WHERE build = %u", VERSION_STRING);
     if (result == nullptr)
     {
@@ -3962,7 +3968,7 @@ void MySQLDataStore::loadTransportDataTable()
 {
     auto startTime = Util::TimeNow();
     //                                                  0      1     2       3
-    QueryResult* result = WorldDatabase.Query("SELECT entry, build, name, period FROM transport_data WHERE build = %u", VERSION_STRING);
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, build, name, period FROM transport_data WHERE build = %u", VERSION_STRING);
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `transport_data` is empty!");
@@ -4012,7 +4018,7 @@ void MySQLDataStore::loadGossipMenuItemsTable()
     auto startTime = Util::TimeNow();
 
     //                                                      0          1
-    QueryResult* result = WorldDatabase.Query("SELECT gossip_menu, text_id FROM gossip_menu ORDER BY gossip_menu");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT gossip_menu, text_id FROM gossip_menu ORDER BY gossip_menu");
     if (result == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `gossip_menu` is empty!");
@@ -4044,7 +4050,7 @@ void MySQLDataStore::loadGossipMenuItemsTable()
     _gossipMenuItemsStores.clear();
 
     //                                                      0       1            2        3            4                  5                6
-    QueryResult* resultItems = WorldDatabase.Query("SELECT id, item_order, menu_option, icon, point_of_interest, next_gossip_menu, next_gossip_text FROM gossip_menu_items ORDER BY id, item_order");
+    QueryResult* resultItems = sWorldDatabaseSnapshot.query("SELECT id, item_order, menu_option, icon, point_of_interest, next_gossip_menu, next_gossip_text FROM gossip_menu_items ORDER BY id, item_order");
     if (resultItems == nullptr)
     {
         LogNotice("MySQLDataLoads : Table `gossip_menu_items` is empty!");
@@ -4084,7 +4090,7 @@ void MySQLDataStore::checkCreatureEquipment()
 {
     LogDebugFlag(LF_DB_TABLES, "===================== Start check for creature_initial_equip ================================");
 
-    QueryResult* resultItems = WorldDatabase.Query("SELECT itemslot_1, itemslot_2, itemslot_3 FROM creature_initial_equip");
+    QueryResult* resultItems = sWorldDatabaseSnapshot.query("SELECT itemslot_1, itemslot_2, itemslot_3 FROM creature_initial_equip");
     if (resultItems)
     {
         do
@@ -4105,7 +4111,7 @@ void MySQLDataStore::checkCreatureEquipment()
     LogDebugFlag(LF_DB_TABLES, "===================== End check for creature_initial_equip ================================");
     LogDebugFlag(LF_DB_TABLES, "===================== Start check for creature_spawns ================================");
 
-    QueryResult* resultItemsSpawn = WorldDatabase.Query("SELECT slot1item, slot2item, slot3item FROM creature_spawns WHERE min_build <= %u AND max_build >= %u", getAEVersion(), getAEVersion());
+    QueryResult* resultItemsSpawn = sWorldDatabaseSnapshot.query("SELECT slot1item, slot2item, slot3item FROM creature_spawns WHERE min_build <= %u AND max_build >= %u", getAEVersion(), getAEVersion());
     if (resultItemsSpawn)
     {
         do
@@ -0,0 +1,506 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "StdAfx.h"
+#include "WorldDatabaseSnapshot.h"
+#include "WorldConf.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const char snapshotMagic[8] = { 'A', 'E', 'W', 'D', 'B', 'S', 'N', 'P' };
+    const uint32_t snapshotFormatVersion = 1;
+
+    // magic, format version, build, database key, payload size, payload checksum, result count
+    const uint64_t snapshotHeaderSize = sizeof(snapshotMagic) + 4 + 4 + 8 + 8 + 8 + 4;
+
+    const uint64_t fnvOffsetBasis = 14695981039346656037ULL;
+    const uint64_t fnvPrime = 1099511628211ULL;
+
+    uint64_t fnv1a(const char* data, size_t size, uint64_t hash = fnvOffsetBasis)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<uint8_t>(data[i]);
+            hash *= fnvPrime;
+        }
+
+        return hash;
+    }
+
+    template <typename T>
+    T readValue(const char*& cursor)
+    {
+        T value;
+        memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return value;
+    }
+
+    template <typename T>
+    void appendValue(std::vector<char>& buffer, T value)
+    {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    // writes to the file and keeps the checksum of everything written
+    class ChecksumWriter
+    {
+    public:
+        explicit ChecksumWriter(std::ofstream& file) : m_file(file) {}
+
+        void write(const char* data, size_t size)
+        {
+            m_file.write(data, static_cast<std::streamsize>(size));
+            m_checksum = fnv1a(data, size, m_checksum);
+            m_size += size;
+        }
+
+        template <typename T>
+        void writeValue(T value) { write(reinterpret_cast<const char*>(&value), sizeof(T)); }
+
+        uint64_t getChecksum() const { return m_checksum; }
+        uint64_t getSize() const { return m_size; }
+
+    private:
+        std::ofstream& m_file;
+        uint64_t m_checksum = fnvOffsetBasis;
+        uint64_t m_size = 0;
+    };
+
+    // walks the encoded rows of a stored or recorded result, values point into that buffer
+    class SnapshotQueryResult : public QueryResult
+    {
+    public:
+        SnapshotQueryResult(uint32_t fieldCount, uint32_t rowCount, const char* data, uint64_t dataSize) :
+            QueryResult(fieldCount, rowCount), m_cursor(data), m_end(data + dataSize)
+        {
+            mCurrentRow = new Field[fieldCount];
+        }
+
+        ~SnapshotQueryResult()
+        {
+            delete[] mCurrentRow;
+        }
+
+        bool NextRow() override
+        {
+            if (m_cursor >= m_end)
+                return false;
+
+            for (uint32_t i = 0; i < mFieldCount; ++i)
+            {
+                const auto length = readValue<uint32_t>(m_cursor);
+                if (length == 0)
+                {
+                    mCurrentRow[i].SetValue(nullptr);
+                }
+                else
+                {
+                    // Field only hands out const char*
+                    mCurrentRow[i].SetValue(const_cast<char*>(m_cursor));
+                    m_cursor += length;
+                }
+            }
+
+            return true;
+        }
+
+    private:
+        const char* m_cursor;
+        const char* m_end;
+    };
+
+    QueryResult* createResult(uint32_t fieldCount, uint32_t rowCount, const char* data, uint64_t dataSize)
+    {
+        // WorldDatabase returns no result for an empty set
+        if (rowCount == 0 || fieldCount == 0)
+            return nullptr;
+
+        auto result = new SnapshotQueryResult(fieldCount, rowCount, data, dataSize);
+        result->NextRow();
+        return result;
+    }
+}
+
+WorldDatabaseSnapshot& WorldDatabaseSnapshot::getInstance()
+{
+    static WorldDatabaseSnapshot mInstance;
+    return mInstance;
+}
+
+void WorldDatabaseSnapshot::initialize(std::string const& fileName)
+{
+    m_fileName = fileName;
+    m_databaseKey = calculateDatabaseKey();
+    if (m_databaseKey == 0)
+    {
+        LogError("WorldDatabaseSnapshot : Could not calculate the checksum of the world database, snapshot disabled");
+        m_state = SNAPSHOT_DISABLED;
+        return;
+    }
+
+    if (mapSnapshotFile())
+    {
+        if (readSnapshotIndex())
+        {
+            LogNotice("WorldDatabaseSnapshot : Loading %u result sets from %s", static_cast<uint32_t>(m_storedResults.size()), m_fileName.c_str());
+            m_state = SNAPSHOT_REPLAYING;
+            return;
+        }
+
+        unmapSnapshotFile();
+        m_storedResults.clear();
+    }
+
+    LogNotice("WorldDatabaseSnapshot : No valid snapshot found, %s will be written after loading", m_fileName.c_str());
+    m_state = SNAPSHOT_RECORDING;
+}
+
+void WorldDatabaseSnapshot::finishLoading()
+{
+    if (m_state == SNAPSHOT_RECORDING)
+    {
+        std::lock_guard<std::mutex> guard(m_recordMutex);
+
+        if (writeSnapshotFile())
+            LogNotice("WorldDatabaseSnapshot : Written %u result sets to %s", static_cast<uint32_t>(m_recordedResults.size()), m_fileName.c_str());
+
+        m_recordedResults.clear();
+    }
+    else if (m_state == SNAPSHOT_REPLAYING)
+    {
+        unmapSnapshotFile();
+        m_storedResults.clear();
+
+        // rebuild the snapshot on the next start, this one does not know all queries of this build
+        if (m_replayMisses > 0)
+        {
+            LogNotice("WorldDatabaseSnapshot : %u queries were not part of the snapshot, it will be recreated on next start", m_replayMisses.load());
+            std::remove(m_fileName.c_str());
+        }
+    }
+
+    m_state = SNAPSHOT_DISABLED;
+}
+
+QueryResult* WorldDatabaseSnapshot::query(const char* queryString, ...)
+{
+    char sql[16384];
+    va_list vlist;
+    va_start(vlist, queryString);
+    vsnprintf(sql, 16384, queryString, vlist);
+    va_end(vlist);
+
+    switch (m_state)
+    {
+        case SNAPSHOT_REPLAYING:
+        {
+            auto itr = m_storedResults.find(sql);
+            if (itr != m_storedResults.end())
+                return createResult(itr->second.fieldCount, itr->second.rowCount, itr->second.data, itr->second.dataSize);
+
+            ++m_replayMisses;
+            return WorldDatabase.QueryNA(sql);
+        }
+        case SNAPSHOT_RECORDING:
+            return recordQuery(sql);
+        default:
+            return WorldDatabase.QueryNA(sql);
+    }
+}
+
+uint64_t WorldDatabaseSnapshot::calculateDatabaseKey()
+{
+    std::stringstream key;
+
+    QueryResult* result = WorldDatabase.Query("SELECT LastUpdate FROM world_db_version ORDER BY id DESC LIMIT 1");
+    if (result == nullptr)
+        return 0;
+
+    key << result->Fetch()[0].GetString() << ';';
+    delete result;
+
+    result = WorldDatabase.Query("SHOW TABLES");
+    if (result == nullptr)
+        return 0;
+
+    std::stringstream checksumQuery;
+    checksumQuery << "CHECKSUM TABLE ";
+    bool first = true;
+    do
+    {
+        if (!first)
+            checksumQuery << ", ";
+
+        checksumQuery << '`' << result->Fetch()[0].GetString() << '`';
+        first = false;
+    } while (result->NextRow());
+    delete result;
+
+    // CHECKSUM TABLE has to read every table, still a lot cheaper than sending all rows
+    result = WorldDatabase.QueryNA(checksumQuery.str().c_str());
+    if (result == nullptr)
+        return 0;
+
+    do
+    {
+        Field* fields = result->Fetch();
+        key << fields[0].GetString() << '=' << (fields[1].GetString() ? fields[1].GetString() : "NULL") << ';';
+    } while (result->NextRow());
+    delete result;
+
+    const std::string keyString = key.str();
+    return fnv1a(keyString.c_str(), keyString.size());
+}
+
+bool WorldDatabaseSnapshot::mapSnapshotFile()
+{
+#ifdef WIN32
+    HANDLE file = CreateFileA(m_fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(snapshotHeaderSize))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_mappedSize = static_cast<uint64_t>(fileSize.QuadPart);
+#else
+    int fd = open(m_fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || static_cast<uint64_t>(fileStat.st_size) < snapshotHeaderSize)
+    {
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // the mapping stays valid without the descriptor
+    close(fd);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    // loaders read every result from start to end
+    madvise(data, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+
+    m_mappedSize = static_cast<uint64_t>(fileStat.st_size);
+#endif
+
+    m_mappedData = static_cast<const char*>(data);
+    return true;
+}
+
+void WorldDatabaseSnapshot::unmapSnapshotFile()
+{
+    if (m_mappedData == nullptr)
+        return;
+
+#ifdef WIN32
+    UnmapViewOfFile(m_mappedData);
+    CloseHandle(m_mappingHandle);
+    CloseHandle(m_fileHandle);
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+#else
+    munmap(const_cast<char*>(m_mappedData), static_cast<size_t>(m_mappedSize));
+#endif
+
+    m_mappedData = nullptr;
+    m_mappedSize = 0;
+}
+
+bool WorldDatabaseSnapshot::readSnapshotIndex()
+{
+    const char* cursor = m_mappedData;
+    if (memcmp(cursor, snapshotMagic, sizeof(snapshotMagic)) != 0)
+        return false;
+    cursor += sizeof(snapshotMagic);
+
+    const auto formatVersion = readValue<uint32_t>(cursor);
+    const auto build = readValue<uint32_t>(cursor);
+    const auto databaseKey = readValue<uint64_t>(cursor);
+    const auto payloadSize = readValue<uint64_t>(cursor);
+    const auto payloadChecksum = readValue<uint64_t>(cursor);
+    const auto resultCount = readValue<uint32_t>(cursor);
+
+    if (formatVersion != snapshotFormatVersion || build != VERSION_STRING)
+        return false;
+
+    if (databaseKey != m_databaseKey)
+    {
+        LogNotice("WorldDatabaseSnapshot : World database has changed since %s was written", m_fileName.c_str());
+        return false;
+    }
+
+    if (payloadSize != m_mappedSize - snapshotHeaderSize || fnv1a(cursor, static_cast<size_t>(payloadSize)) != payloadChecksum)
+    {
+        LogError("WorldDatabaseSnapshot : Checksum mismatch in %s", m_fileName.c_str());
+        return false;
+    }
+
+    const char* end = cursor + payloadSize;
+    m_storedResults.reserve(resultCount);
+
+    for (uint32_t i = 0; i < resultCount; ++i)
+    {
+        if (end - cursor < 4)
+            return false;
+
+        const auto sqlLength = readValue<uint32_t>(cursor);
+        if (static_cast<uint64_t>(end - cursor) < static_cast<uint64_t>(sqlLength) + 16)
+            return false;
+
+        std::string sql(cursor, sqlLength);
+        cursor += sqlLength;
+
+        StoredResult stored;
+        stored.fieldCount = readValue<uint32_t>(cursor);
+        stored.rowCount = readValue<uint32_t>(cursor);
+        stored.dataSize = readValue<uint64_t>(cursor);
+        if (static_cast<uint64_t>(end - cursor) < stored.dataSize)
+            return false;
+
+        stored.data = cursor;
+        cursor += stored.dataSize;
+
+        m_storedResults.emplace(std::move(sql), stored);
+    }
+
+    return cursor == end;
+}
+
+bool WorldDatabaseSnapshot::writeSnapshotFile()
+{
+    const std::string tempFileName = m_fileName + ".tmp";
+
+    std::ofstream file(tempFileName, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        LogError("WorldDatabaseSnapshot : Could not create %s", tempFileName.c_str());
+        return false;
+    }
+
+    // header is written again once the payload checksum is known
+    std::vector<char> header(static_cast<size_t>(snapshotHeaderSize), 0);
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    ChecksumWriter payload(file);
+    for (const auto& recorded : m_recordedResults)
+    {
+        payload.writeValue(static_cast<uint32_t>(recorded.first.size()));
+        payload.write(recorded.first.c_str(), recorded.first.size());
+        payload.writeValue(recorded.second.fieldCount);
+        payload.writeValue(recorded.second.rowCount);
+        payload.writeValue(static_cast<uint64_t>(recorded.second.data.size()));
+        payload.write(recorded.second.data.data(), recorded.second.data.size());
+    }
+
+    header.clear();
+    header.insert(header.end(), snapshotMagic, snapshotMagic + sizeof(snapshotMagic));
+    appendValue(header, snapshotFormatVersion);
+    appendValue(header, static_cast<uint32_t>(VERSION_STRING));
+    appendValue(header, m_databaseKey);
+    appendValue(header, payload.getSize());
+    appendValue(header, payload.getChecksum());
+    appendValue(header, static_cast<uint32_t>(m_recordedResults.size()));
+
+    file.seekp(0);
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    file.close();
+
+    if (file.fail())
+    {
+        LogError("WorldDatabaseSnapshot : Could not write %s", tempFileName.c_str());
+        std::remove(tempFileName.c_str());
+        return false;
+    }
+
+    std::remove(m_fileName.c_str());
+    if (std::rename(tempFileName.c_str(), m_fileName.c_str()) != 0)
+    {
+        LogError("WorldDatabaseSnapshot : Could not rename %s to %s", tempFileName.c_str(), m_fileName.c_str());
+        std::remove(tempFileName.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+QueryResult* WorldDatabaseSnapshot::recordQuery(std::string const& sql)
+{
+    RecordedResult recorded;
+
+    if (QueryResult* result = WorldDatabase.QueryNA(sql.c_str()))
+    {
+        recorded.fieldCount = result->GetFieldCount();
+        recorded.rowCount = result->GetRowCount();
+
+        do
+        {
+            Field* fields = result->Fetch();
+            for (uint32_t i = 0; i < recorded.fieldCount; ++i)
+            {
+                const char* value = fields[i].GetString();
+                if (value == nullptr)
+                {
+                    appendValue(recorded.data, static_cast<uint32_t>(0));
+                    continue;
+                }
+
+                const auto length = static_cast<uint32_t>(strlen(value) + 1);
+                appendValue(recorded.data, length);
+                recorded.data.insert(recorded.data.end(), value, value + length);
+            }
+        } while (result->NextRow());
+
+        delete result;
+    }
+
+    std::lock_guard<std::mutex> guard(m_recordMutex);
+
+    // map nodes are never moved, the returned result can keep pointing into the stored rows
+    auto itr = m_recordedResults.emplace(sql, std::move(recorded)).first;
+    return createResult(itr->second.fieldCount, itr->second.rowCount, itr->second.data.data(), itr->second.data.size());
+}
@@ -0,0 +1,100 @@
+/*
+Copyright (c) 2014-2020 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include "Database/Database.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Binary snapshot of the world database results read by MySQLDataStore.
+// The first start records every result set and writes them to one file, the following starts
+// map that file and hand the stored rows to the loaders instead of querying MySQL.
+// The snapshot is keyed by the world db revision and the checksums of all world tables,
+// a different key, build or a broken file falls back to SQL and records a new snapshot.
+class SERVER_DECL WorldDatabaseSnapshot
+{
+private:
+
+    WorldDatabaseSnapshot() = default;
+    ~WorldDatabaseSnapshot() = default;
+
+public:
+
+    static WorldDatabaseSnapshot& getInstance();
+
+    WorldDatabaseSnapshot(WorldDatabaseSnapshot&&) = delete;
+    WorldDatabaseSnapshot(WorldDatabaseSnapshot const&) = delete;
+    WorldDatabaseSnapshot& operator=(WorldDatabaseSnapshot&&) = delete;
+    WorldDatabaseSnapshot& operator=(WorldDatabaseSnapshot const&) = delete;
+
+    // has to be called before the first loader runs
+    void initialize(std::string const& fileName);
+
+    // writes a recorded snapshot, releases the mapped file. Queries after this go straight to WorldDatabase.
+    void finishLoading();
+
+    // same as WorldDatabase.Query, thread safe
+    QueryResult* query(const char* queryString, ...);
+
+private:
+
+    enum SnapshotState
+    {
+        SNAPSHOT_DISABLED,
+        SNAPSHOT_RECORDING,
+        SNAPSHOT_REPLAYING
+    };
+
+    // rows are stored as (uint32 length incl. terminator, 0 = NULL)(value)... for each field
+    struct StoredResult
+    {
+        uint32_t fieldCount = 0;
+        uint32_t rowCount = 0;
+        const char* data = nullptr;
+        uint64_t dataSize = 0;
+    };
+
+    struct RecordedResult
+    {
+        uint32_t fieldCount = 0;
+        uint32_t rowCount = 0;
+        std::vector<char> data;
+    };
+
+    uint64_t calculateDatabaseKey();
+
+    bool mapSnapshotFile();
+    void unmapSnapshotFile();
+    bool readSnapshotIndex();
+    bool writeSnapshotFile();
+
+    QueryResult* recordQuery(std::string const& sql);
+
+    std::string m_fileName;
+    SnapshotState m_state = SNAPSHOT_DISABLED;
+    uint64_t m_databaseKey = 0;
+
+    // replaying
+    const char* m_mappedData = nullptr;
+    uint64_t m_mappedSize = 0;
+#ifdef WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+    std::unordered_map<std::string, StoredResult> m_storedResults;
+    std::atomic<uint32_t> m_replayMisses = 0;
+
+    // recording
+    std::mutex m_recordMutex;
+    std::unordered_map<std::string, RecordedResult> m_recordedResults;
+};
+
+#define sWorldDatabaseSnapshot WorldDatabaseSnapshot::getInstance()
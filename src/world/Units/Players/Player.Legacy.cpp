@@ -73,6 +73,7 @@
 #include "Server/Packets/SmsgNewWorld.h"
 #include "Server/Packets/SmsgFriendStatus.h"
 #include "Management/GuildMgr.h"
+#include "Management/ObjectUpdates/UpdateCompressor.h"
 #include "Server/Packets/SmsgDeathReleaseLoc.h"
 #include "Server/Packets/SmsgCorpseReclaimDelay.h"
 #include "Server/Packets/SmsgDuelWinner.h"
@@ -2036,11 +2037,8 @@ void Player::_SetCreateBits(UpdateMask* updateMask, Player* target) const
     }
     else
     {
-        for (uint32 index = 0; index < m_valuesCount; index++)
-        {
-            if (m_uint32Values[index] != 0 && Player::m_visibleUpdateMask.GetBit(index))
-                updateMask->SetBit(index);
-        }
+        ARCEMU_ASSERT(updateMask->GetCount() == m_valuesCount);
+        updateMask->SetNonZeroBits(m_uint32Values, Player::m_visibleUpdateMask);
     }
 }
 
@@ -4246,6 +4244,7 @@ QuestLogEntry* Player::GetQuestLogForEntry(uint32 quest)
 void Player::SetQuestLogSlot(QuestLogEntry* entry, uint32 slot)
 {
     m_questlog[slot] = entry;
+    invalidateQuestgiverStatus();
 }
 
 void Player::AddToWorld()
@@ -5496,6 +5495,7 @@ void Player::AddToFinishedQuests(uint32 quest_id)
         return;
 
     m_finishedQuests.insert(quest_id);
+    invalidateQuestgiverStatus();
 }
 
 bool Player::HasFinishedQuest(uint32 quest_id)
@@ -5516,6 +5516,7 @@ void Player::ClearQuest(uint32 id)
 {
     m_finishedQuests.erase(id);
     m_finishedDailies.erase(id);
+    invalidateQuestgiverStatus();
 }
 
 bool Player::GetQuestRewardStatus(uint32 quest_id)
@@ -7307,70 +7308,18 @@ void Player::ResetAllCooldowns()
 
 bool Player::CompressAndSendUpdateBuffer(uint32 size, const uint8* update_buffer)
 {
-    uint32 destsize = size + size / 10 + 16;
-    int rate = worldConfig.getIntRate(INTRATE_COMPRESSION);
-    if (size >= 40000 && rate < 6)
-        rate = 6;
-
-    // set up stream
-    z_stream stream;
-    stream.zalloc = nullptr;
-    stream.zfree = nullptr;
-    stream.opaque = nullptr;
-
-    if (deflateInit(&stream, rate) != Z_OK)
-    {
-        LOG_ERROR("deflateInit failed.");
+    uint32_t compressedSize;
+    const auto buffer = UpdateCompressor::getThreadInstance().compress(update_buffer, size, compressedSize);
+    if (buffer == nullptr)
         return false;
-    }
-
-    uint8* buffer = new uint8[destsize];
-
-    // set up stream pointers
-    stream.next_out = (Bytef*)buffer + 4;
-    stream.avail_out = destsize;
-    stream.next_in = (Bytef*)update_buffer;
-    stream.avail_in = size;
-
-    // call the actual process
-    if (deflate(&stream, Z_NO_FLUSH) != Z_OK ||
-        stream.avail_in != 0)
-    {
-        LOG_ERROR("deflate failed.");
-        delete[] buffer;
-        return false;
-    }
-
-    // finish the deflate
-    if (deflate(&stream, Z_FINISH) != Z_STREAM_END)
-    {
-        LOG_ERROR("deflate failed: did not end stream");
-        delete[] buffer;
-        return false;
-    }
-
-    // finish up
-    if (deflateEnd(&stream) != Z_OK)
-    {
-        LOG_ERROR("deflateEnd failed.");
-        delete[] buffer;
-        return false;
-    }
-
-    // fill in the full size of the compressed stream
-
-    *(uint32*)&buffer[0] = size;
 
     // send it
 #if VERSION_STRING < Cata
-    m_session->OutPacket(SMSG_COMPRESSED_UPDATE_OBJECT, (uint16)stream.total_out + 4, buffer);
+    m_session->OutPacket(SMSG_COMPRESSED_UPDATE_OBJECT, (uint16)compressedSize, buffer);
 #else
-    m_session->OutPacket(SMSG_UPDATE_OBJECT, (uint16)stream.total_out + 4, buffer);
+    m_session->OutPacket(SMSG_UPDATE_OBJECT, (uint16)compressedSize, buffer);
 #endif
 
-    // cleanup memory
-    delete[] buffer;
-
     return true;
 }
 
@@ -9686,6 +9635,8 @@ void Player::_AddSkillLine(uint32 SkillLine, uint32 Curr_sk, uint32 Max_sk)
     if (!skill_line)
         return;
 
+    invalidateQuestgiverStatus();
+
     // force to be within limits
     Curr_sk = (Curr_sk > DBC_PLAYER_SKILL_MAX ? DBC_PLAYER_SKILL_MAX : (Curr_sk < 1 ? 1 : Curr_sk));
     Max_sk = (Max_sk > DBC_PLAYER_SKILL_MAX ? DBC_PLAYER_SKILL_MAX : Max_sk);
@@ -9803,6 +9754,8 @@ bool Player::_HasSkillLine(uint32 SkillLine)
 
 void Player::_AdvanceSkillLine(uint32 SkillLine, uint32 Count /* = 1 */)
 {
+    invalidateQuestgiverStatus();
+
     SkillMap::iterator itr = m_skills.find(SkillLine);
     uint32 curr_sk = Count;
     if (itr == m_skills.end())
@@ -9919,6 +9872,7 @@ void Player::_RemoveSkillLine(uint32 SkillLine)
         return;
 
     m_skills.erase(itr);
+    invalidateQuestgiverStatus();
     _UpdateSkillFields();
 }
 
@@ -9983,6 +9937,7 @@ void Player::_ModifySkillBonus(uint32 SkillLine, int32 Delta)
 
     itr->second.BonusValue += Delta;
     _UpdateSkillFields();
+    invalidateQuestgiverStatus();
 }
 
 void Player::_ModifySkillBonusByType(uint32 SkillType, int32 Delta)
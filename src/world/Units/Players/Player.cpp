@@ -216,6 +216,7 @@ void Player::resendSpeed()
 void Player::ProcessPendingUpdates()
 {
     m_updateMgr.processPendingUpdates();
+    resendSpeed();
 }
 
 UpdateManager & Player::getUpdateMgr()
@@ -2522,6 +2523,47 @@ ItemInterface* Player::getItemInterface() const
     return m_itemInterface;
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Quests
+uint32_t Player::getQuestgiverStatus(Creature* questgiver)
+{
+    const uint32_t generation = sQuestMgr.getQuestgiverStatusGeneration();
+    if (generation != m_questgiverStatusGeneration)
+    {
+        m_questgiverStatusCache.clear();
+        m_questgiverStatusGeneration = generation;
+    }
+
+    const auto itr = m_questgiverStatusCache.find(questgiver->getEntry());
+    if (itr != m_questgiverStatusCache.end())
+    {
+#ifdef _DEBUG
+        const uint32_t calculatedStatus = sQuestMgr.CalcStatus(questgiver, this);
+        if (itr->second != calculatedStatus)
+        {
+            LogError("Player::getQuestgiverStatus : stale status for questgiver %u of player %u (cached %u, calculated %u)",
+                questgiver->getEntry(), getGuidLow(), itr->second, calculatedStatus);
+            m_questgiverStatusCache.erase(itr);
+            return calculatedStatus;
+        }
+#endif
+        return itr->second;
+    }
+
+    const uint32_t status = sQuestMgr.CalcStatus(questgiver, this);
+
+    // item and money requirements change without a quest state change
+    if (!sQuestMgr.isQuestgiverStatusVolatile(questgiver, this))
+        m_questgiverStatusCache.emplace(questgiver->getEntry(), status);
+
+    return status;
+}
+
+void Player::invalidateQuestgiverStatus()
+{
+    m_questgiverStatusCache.clear();
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Misc
 bool Player::isGMFlagSet()
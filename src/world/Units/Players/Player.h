@@ -846,6 +846,19 @@ public:
 private:
     ItemInterface* m_itemInterface;
 
+public:
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // Quests
+
+    // cached QuestMgr::CalcStatus for quest giver creatures, keyed by creature entry
+    uint32_t getQuestgiverStatus(Creature* questgiver);
+    // has to be called whenever quest log, finished quests, level, skills or reputation change
+    void invalidateQuestgiverStatus();
+
+private:
+    std::unordered_map<uint32_t, uint32_t> m_questgiverStatusCache;
+    uint32_t m_questgiverStatusGeneration = 0;
+
 public:
     //////////////////////////////////////////////////////////////////////////////////////////
     // Misc
@@ -1119,7 +1132,7 @@ public:
         void SetQuestLogSlot(QuestLogEntry* entry, uint32 slot);
 
         void PushToRemovedQuests(uint32 questid) { m_removequests.insert(questid);}
-        void PushToFinishedDailies(uint32 questid) { DailyMutex.Acquire(); m_finishedDailies.insert(questid); DailyMutex.Release();}
+        void PushToFinishedDailies(uint32 questid) { DailyMutex.Acquire(); m_finishedDailies.insert(questid); DailyMutex.Release(); invalidateQuestgiverStatus(); }
         bool HasFinishedDaily(uint32 questid) { return (m_finishedDailies.find(questid) == m_finishedDailies.end() ? false : true); }
         void AddToFinishedQuests(uint32 quest_id);
         void AreaExploredOrEventHappens(uint32 questId);   // scriptdev2
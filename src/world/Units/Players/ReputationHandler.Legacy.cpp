@@ -196,6 +196,8 @@ void Player::SetStanding(uint32 Faction, int32 Value)
         return;
     ReputationMap::iterator itr = m_reputation.find(Faction);
 
+    invalidateQuestgiverStatus();
+
     if (newValue < minReputation)
         newValue = minReputation;
     else if (newValue > maxReputation)
@@ -279,6 +281,8 @@ void Player::ModStanding(uint32 Faction, int32 Value)
     int32 newValue = Value;
     if (f == NULL || f->RepListId < 0)
         return;
+
+    invalidateQuestgiverStatus();
     ReputationMap::iterator itr = m_reputation.find(Faction);
 
     if (itr == m_reputation.end())
@@ -466,7 +466,10 @@ void Unit::setLevel(uint32_t level)
 {
     write(unitData()->level, level);
     if (isPlayer())
+    {
         static_cast<Player*>(this)->setNextLevelXp(sMySQLStore.getPlayerXPForLevel(level));
+        static_cast<Player*>(this)->invalidateQuestgiverStatus();
+    }
 
 #if VERSION_STRING == TBC
     // TODO Fix this later